@@ -0,0 +1,25 @@
+#ifndef BATCH_RENDER_H
+#define BATCH_RENDER_H
+
+#include <stdbool.h>
+
+// Mode sans fenêtre : applique un shader à une image, à toutes les images d'un dossier
+// ou à une vidéo, puis écrit le résultat.
+//
+//   main.exe --input in.png --shader shaders/effect.glsl --mouse 320,240 --radius 80
+//            --power 1 --time 0 --output out.png [--engine auto|cpu|gpu|vm] [--threads n]
+//
+// Les shaders qui ont une implémentation CPU (effect.glsl) sont rendus par cpu_filter,
+// une image (ou une frame) par cœur ; effect2.glsl a une version CPU approchée (cpu_blur),
+// utilisée seulement avec --engine cpu. Les autres passent par le render graph dans un
+// contexte GL caché (un rendu logiciel Mesa convient), ou par cpu_shader quand aucun
+// contexte GL n'est disponible (--engine vm l'impose). Les vidéos sont décodées et
+// encodées par ffmpeg via des pipes ; en sortie, une vidéo (.mp4, .mov, .mkv, .webm,
+// .avi) ou une suite d'images PNG ("frames/out_%06d.png").
+
+// Vrai si la ligne de commande demande le mode sans fenêtre
+bool IsBatchCommandLine(int argc, char** argv);
+// Exécute le traitement et retourne le code de sortie du programme
+int RunBatchRender(int argc, char** argv);
+
+#endif // BATCH_RENDER_H
@@ -0,0 +1,61 @@
+#ifndef COLOR_CONVERT_H
+#define COLOR_CONVERT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Conversion des frames YUV 4:2:0 (I420 planaire ou NV12 entrelacé) en RGBA 8 bits,
+// telles que les sortent les décodeurs vidéo. Matrices BT.601 et BT.709, plage limitée
+// (16-235) ou complète (0-255). Les calculs sont en virgule fixe 16 bits (écart d'au plus
+// 1 avec la formule exacte) et tous les chemins donnent les mêmes octets : scalaire, SSE4.1
+// et AVX2. Le noyau suit le niveau choisi par cpu_filter (SetCpuFilterSimd) : AVX2, SSE4.1
+// au niveau SSE2 quand le processeur l'a, scalaire sinon. Les lignes sont réparties sur
+// les threads de cpu_filter.
+
+typedef enum {
+    YUV_MATRIX_BT601,
+    YUV_MATRIX_BT709
+} YuvMatrix;
+
+typedef enum {
+    YUV_RANGE_LIMITED,               // Luma 16-235, chroma 16-240 (vidéo)
+    YUV_RANGE_FULL                   // 0-255 (JPEG, yuvj420p)
+} YuvRange;
+
+typedef enum {
+    YUV_LAYOUT_I420,                 // Plans Y, U, V (yuv420p)
+    YUV_LAYOUT_NV12                  // Plan Y puis plan UV entrelacé
+} YuvLayout;
+
+typedef struct {
+    YuvMatrix matrix;
+    YuvRange range;
+} YuvColorSpace;
+
+// Vue sur une frame : la chroma a (width+1)/2 x (height+1)/2 échantillons
+typedef struct {
+    const unsigned char* y;
+    const unsigned char* u;          // NV12 : plan UV
+    const unsigned char* v;          // I420 uniquement
+    int yStride;                     // Octets par ligne
+    int uvStride;                    // Octets par ligne de u (et de v)
+    int width;
+    int height;
+    YuvLayout layout;
+} YuvImage;
+
+// Taille d'une frame contiguë sans marges (format rawvideo de ffmpeg)
+size_t GetYuvFrameSize(int width, int height);
+// Vue sur une frame contiguë de GetYuvFrameSize octets
+YuvImage GetPackedYuvImage(const unsigned char* data, int width, int height, YuvLayout layout);
+
+// Noyau utilisé au niveau SIMD courant ("scalar", "SSE4.1" ou "AVX2")
+const char* GetYuvKernelName(void);
+
+// Écrit width x height pixels RGBA (alpha 255) dans rgba, lignes contiguës de haut en bas
+// comme les Image de raylib
+void ConvertYuvToRgba(const YuvImage* image, YuvColorSpace colorSpace, unsigned char* rgba);
+// Même conversion sur les lignes [rowStart, rowEnd), dans le thread appelant
+void ConvertYuvRowsToRgba(const YuvImage* image, YuvColorSpace colorSpace, unsigned char* rgba, int rowStart, int rowEnd);
+
+#endif // COLOR_CONVERT_H
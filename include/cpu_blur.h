@@ -0,0 +1,32 @@
+#ifndef CPU_BLUR_H
+#define CPU_BLUR_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// Flou gaussien CPU équivalent à gaussianBlur() de shaders/lib/blur.glsl : sigma = radius/2,
+// noyau tronqué à ceil(radius) pixels, voisins bouclés comme la texture (GL_REPEAT).
+// Images RGBA 8 bits, même découpage en threads et même choix SIMD que cpu_filter.
+
+typedef enum {
+    CPU_BLUR_REFERENCE,  // Noyau 2D complet, mêmes calculs que le shader (O(r²) par pixel)
+    CPU_BLUR_SEPARABLE,  // Mêmes poids en deux passes 1D (O(r) par pixel, écart d'arrondi seulement)
+    CPU_BLUR_RECURSIVE   // Filtre récursif de Young-van Vliet : temps constant quel que soit le rayon,
+                         // de même variance que le noyau du shader (approché)
+} CpuBlurMode;
+
+const char* GetCpuBlurModeName(CpuBlurMode mode);
+
+// output doit avoir la taille et le format de source et être distinct.
+// Un rayon nul ou négatif copie l'image.
+bool CpuGaussianBlur(Image source, Image* output, float radius, CpuBlurMode mode);
+
+// Version CPU de shaders/effect2.glsl (moteur cpu du mode sans fenêtre) : anneau flouté et
+// animé autour du curseur, cercle noir au bord. Le shader floute en deux passes 1D à
+// mi-résolution ; ici le flou séparable est fait en pleine résolution avec le même
+// sigma (EFFECT2_BLUR_RADIUS / 2 pixels de l'image), le résultat est donc approché.
+// Seul le carré autour de l'anneau est flouté (même résultat que le flou de l'image entière).
+#define EFFECT2_BLUR_RADIUS 8.0f
+bool CpuApplyBlurEffect(Image source, Image* output, Vector2 mousePos, float radius, float time);
+
+#endif // CPU_BLUR_H
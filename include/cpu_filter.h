@@ -0,0 +1,48 @@
+#ifndef CPU_FILTER_H
+#define CPU_FILTER_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// Implémentations CPU de référence des effets, sans contexte GL : utilisables en
+// mode sans fenêtre et pour les tests golden. Les images sont en RGBA 8 bits
+// (PIXELFORMAT_UNCOMPRESSED_R8G8B8A8), lignes de haut en bas comme les Image de raylib.
+// Le travail est découpé en bandes de lignes réparties sur plusieurs threads, et les
+// boucles internes utilisent le meilleur jeu SIMD disponible (choisi à l'exécution).
+// Tous les chemins (scalaire, SSE2, AVX2, NEON) donnent exactement les mêmes octets.
+
+typedef enum {
+    CPU_SIMD_SCALAR,
+    CPU_SIMD_SSE2,
+    CPU_SIMD_AVX2,
+    CPU_SIMD_NEON
+} CpuSimdLevel;
+
+// Meilleur jeu d'instructions supporté par le processeur
+CpuSimdLevel GetCpuSimdSupport(void);
+// Jeu utilisé par les filtres (le meilleur par défaut)
+CpuSimdLevel GetCpuFilterSimd(void);
+// Force un jeu moins rapide (comparaison des chemins), ramené au meilleur supporté
+void SetCpuFilterSimd(CpuSimdLevel level);
+const char* GetCpuSimdName(CpuSimdLevel level);
+
+// Nombre de threads des filtres (0 = un par cœur), celui de job_system
+void SetCpuFilterThreadCount(int count);
+int GetCpuFilterThreadCount(void);
+
+// Traitement d'un groupe de lignes [rowStart, rowEnd)
+typedef void (*CpuRowTask)(void* context, int rowStart, int rowEnd);
+// Répartit les lignes [0, rowCount) par bandes de bandRows sur les threads de
+// job_system (ParallelForTiles). Retourne quand toutes les bandes sont traitées.
+// Appelée depuis une tâche, ses bandes vont aux threads libres (vol de travail).
+void RunCpuRowTasks(int rowCount, int bandRows, CpuRowTask task, void* context);
+
+// Reproduit effect.glsl : netteté 3x3 à moins de radius du curseur, anneau noir
+// jusqu'à min(radius*1.05, radius+5), image d'origine au-delà. mousePos est en pixels
+// de l'image et la résolution est celle de source. Les voisins hors de l'image
+// bouclent comme la texture (GL_REPEAT). Le résultat est la couleur produite par le
+// fragment shader, alpha compris, avant tout mélange à l'écran.
+// output doit avoir la taille et le format de source (ImageCopy) et être distinct.
+bool CpuApplySharpenEffect(Image source, Image* output, Vector2 mousePos, float radius);
+
+#endif // CPU_FILTER_H
@@ -0,0 +1,51 @@
+#ifndef CPU_SHADER_H
+#define CPU_SHADER_H
+
+#include "raylib.h"
+#include "render_graph.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Exécution des fragment shaders sur le CPU, sans contexte GL : les fichiers de
+// shaders/ peuvent être rendus et testés sur une machine sans GPU.
+//
+// Le source (après #include, #define, #if...) est compilé en bytecode pour une machine
+// à registres où chaque registre contient une composante de VM_LANES pixels : une
+// instruction traite tous ces pixels d'un coup (boucles vectorisées, AVX2 si disponible)
+// et les lignes de l'image sont réparties sur les threads de cpu_filter. Les branches
+// qui divergent entre pixels sont exécutées sous masque, comme sur un GPU, et sautées
+// quand aucun pixel ne les prend.
+//
+// Sous-ensemble supporté : float, int, bool, vec2-4, mat2-4, sampler2D ; uniforms,
+// const, variables globales et locales ; fonctions (inlinées, sans récursion) ; if/else,
+// for, while, return, opérateur ?: ; swizzles et indices constants ; texture() et les
+// fonctions usuelles (mix, smoothstep, clamp, exp, atan, pow, dot, length...). Les
+// types entiers sont représentés en flottants (exacts jusqu'à 2^24). Les samplers
+// bouclent (GL_REPEAT) ; l'image source est lue au plus proche, les sorties des passes
+// intermédiaires en bilinéaire, comme les textures du render graph.
+
+#define VM_LANES 64                       // Pixels traités par instruction
+
+typedef struct CpuShader CpuShader;
+
+// Compile un fragment shader (source déjà passé par PreprocessShaderFile).
+// Retourne NULL en cas d'erreur (message "Ligne n: ..." dans error).
+CpuShader* CompileCpuShader(const char* source, char* error, size_t errorSize);
+void UnloadCpuShader(CpuShader* shader);
+bool CpuShaderUsesUniform(const CpuShader* shader, const char* name);
+
+// Graphe de passes (#pragma pass, bounded_by_radius...) exécuté comme RenderGraphToTexture,
+// en qualité complète et avec les programmes génériques (sans SPECIALIZE_*)
+typedef struct {
+    RenderGraphDesc desc;
+    CpuShader* programs[MAX_RENDER_PASSES];
+    int inputPass[MAX_RENDER_PASSES];     // -1 = image source
+} CpuShaderGraph;
+
+bool LoadCpuShaderGraph(const char* path, CpuShaderGraph* graph, char* error, size_t errorSize);
+void UnloadCpuShaderGraph(CpuShaderGraph* graph);
+// Rend le graphe sur source (RGBA8) dans output (même taille et format, distinct).
+// Les valeurs écrites sont les couleurs produites par la dernière passe, alpha compris.
+bool RenderCpuShaderGraph(const CpuShaderGraph* graph, Image source, Image* output, const EffectParams* params);
+
+#endif // CPU_SHADER_H
@@ -0,0 +1,36 @@
+#ifndef FILE_WATCH_H
+#define FILE_WATCH_H
+
+#include <stdbool.h>
+
+#define FILE_WATCH_MAX_PATH 320
+
+// Type d'événement sur un fichier surveillé
+typedef enum {
+    FILE_WATCH_MODIFIED,   // Fichier écrit (y compris sauvegarde par renommage)
+    FILE_WATCH_CREATED,
+    FILE_WATCH_DELETED
+} FileWatchEventType;
+
+typedef struct {
+    char path[FILE_WATCH_MAX_PATH]; // "dossier/nom" (sans "./" pour le dossier courant)
+    FileWatchEventType type;
+    bool isDirectory;
+} FileWatchEvent;
+
+// Démarre le thread de surveillance (inotify sous Linux, notifications de changement
+// sous Windows, sinon scrutation périodique des dossiers)
+bool InitFileWatch(void);
+void CloseFileWatch(void);
+
+// Surveille les fichiers d'un dossier (non récursif)
+bool FileWatchAddDirectory(const char* directory);
+void FileWatchRemoveDirectory(const char* directory);
+
+// Récupère les événements prêts (regroupés par fichier après le délai anti-rebond).
+// Sans activité, ne fait aucun appel système.
+int PollFileWatch(FileWatchEvent* events, int maxEvents);
+
+const char* GetFileWatchBackendName(void);
+
+#endif // FILE_WATCH_H
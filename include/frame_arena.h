@@ -0,0 +1,35 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Arène contiguë pour les frames vidéo : une seule réservation d'espace d'adressage
+// découpée en slots de taille fixe (une frame par slot, indexés par numéro de frame).
+// Les pages ne sont consommées qu'au premier accès et rendues à l'OS au reset.
+
+// Initialise (ou réinitialise si la taille de frame change) l'arène pour des frames
+// de frameBytes octets. Les huge pages sont utilisées si SHADERLAB_HUGE_PAGES=1 : pages
+// hugetlb si le pool en a assez pour maxSlots slots, sinon transparent huge pages (avec
+// un avertissement). maxSlots doit donc être le nombre de frames du clip, pas un maximum.
+bool InitFrameArena(size_t frameBytes, int maxSlots);
+// Libère toute la réservation
+void DestroyFrameArena(void);
+// Rend toutes les pages à l'OS en un seul appel (les slots restent utilisables)
+void ResetFrameArena(void);
+
+bool IsFrameArenaReady(void);
+// Vrai si aucun slot n'a été utilisé depuis le dernier reset (l'arène peut changer de taille)
+bool IsFrameArenaEmpty(void);
+size_t GetFrameArenaSlotBytes(void);
+size_t GetFrameArenaFrameBytes(void);
+int GetFrameArenaSlotCapacity(void);
+// Adresse du slot (NULL si hors capacité)
+void* GetFrameArenaSlot(int index);
+// Rend les pages d'un slot à l'OS
+void DiscardFrameArenaSlot(int index);
+// Vrai si le pointeur appartient à l'arène (pour ne pas le passer à free)
+bool IsFrameArenaPointer(const void* pointer);
+int GetFrameArenaSlotIndex(const void* pointer);
+
+#endif // FRAME_ARENA_H
@@ -0,0 +1,120 @@
+#ifndef GL_EXT_H
+#define GL_EXT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Accès direct aux fonctions OpenGL dont raylib n'expose pas d'équivalent
+// (compilation non bloquante, requêtes GPU...). Les pointeurs sont chargés
+// via glfwGetProcAddress, donc après InitWindow et sur le thread du contexte.
+
+typedef unsigned int GLenum;
+typedef unsigned int GLuint;
+typedef int GLint;
+typedef int GLsizei;
+typedef char GLchar;
+typedef unsigned char GLubyte;
+typedef unsigned char GLboolean;
+typedef unsigned long long GLuint64;
+typedef unsigned int GLbitfield;
+typedef ptrdiff_t GLsizeiptr;
+typedef ptrdiff_t GLintptr;
+typedef struct __GLsync* GLsync;
+
+#define GL_VENDOR                   0x1F00
+#define GL_RENDERER                 0x1F01
+#define GL_VERSION                  0x1F02
+#define GL_MAJOR_VERSION            0x821B
+#define GL_MINOR_VERSION            0x821C
+#define GL_FRAGMENT_SHADER          0x8B30
+#define GL_VERTEX_SHADER            0x8B31
+#define GL_COMPILE_STATUS           0x8B81
+#define GL_LINK_STATUS              0x8B82
+#define GL_INFO_LOG_LENGTH          0x8B84
+#define GL_ACTIVE_UNIFORMS          0x8B86
+#define GL_ACTIVE_UNIFORM_MAX_LENGTH 0x8B87
+#define GL_COMPLETION_STATUS_KHR    0x91B1
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH    0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#define GL_TIME_ELAPSED             0x88BF
+#define GL_QUERY_RESULT             0x8866
+#define GL_QUERY_RESULT_AVAILABLE   0x8867
+#define GL_RGBA                     0x1908
+#define GL_UNSIGNED_BYTE            0x1401
+#define GL_READ_FRAMEBUFFER         0x8CA8
+#define GL_PIXEL_PACK_BUFFER        0x88EB
+#define GL_STREAM_READ              0x88E1
+#define GL_MAP_READ_BIT             0x0001
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_FLUSH_COMMANDS_BIT  0x00000001
+#define GL_ALREADY_SIGNALED         0x911A
+#define GL_CONDITION_SATISFIED      0x911C
+
+#ifdef _WIN32
+#define GLEXT_APIENTRY __stdcall
+#else
+#define GLEXT_APIENTRY
+#endif
+
+// Table des fonctions chargées
+typedef struct {
+    const GLubyte* (GLEXT_APIENTRY *GetString)(GLenum name);
+    void (GLEXT_APIENTRY *GetIntegerv)(GLenum pname, GLint* data);
+    GLuint (GLEXT_APIENTRY *CreateShader)(GLenum type);
+    void (GLEXT_APIENTRY *ShaderSource)(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length);
+    void (GLEXT_APIENTRY *CompileShader)(GLuint shader);
+    void (GLEXT_APIENTRY *GetShaderiv)(GLuint shader, GLenum pname, GLint* params);
+    void (GLEXT_APIENTRY *GetShaderInfoLog)(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+    void (GLEXT_APIENTRY *DeleteShader)(GLuint shader);
+    GLuint (GLEXT_APIENTRY *CreateProgram)(void);
+    void (GLEXT_APIENTRY *AttachShader)(GLuint program, GLuint shader);
+    void (GLEXT_APIENTRY *DetachShader)(GLuint program, GLuint shader);
+    void (GLEXT_APIENTRY *BindAttribLocation)(GLuint program, GLuint index, const GLchar* name);
+    void (GLEXT_APIENTRY *LinkProgram)(GLuint program);
+    void (GLEXT_APIENTRY *GetProgramiv)(GLuint program, GLenum pname, GLint* params);
+    void (GLEXT_APIENTRY *GetProgramInfoLog)(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+    void (GLEXT_APIENTRY *DeleteProgram)(GLuint program);
+    void (GLEXT_APIENTRY *GetActiveUniform)(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
+    void (GLEXT_APIENTRY *MaxShaderCompilerThreadsKHR)(GLuint count); // Optionnel
+    void (GLEXT_APIENTRY *GetProgramBinary)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary); // Optionnel
+    void (GLEXT_APIENTRY *ProgramBinary)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length); // Optionnel
+    void (GLEXT_APIENTRY *ProgramParameteri)(GLuint program, GLenum pname, GLint value); // Optionnel
+    void (GLEXT_APIENTRY *GenQueries)(GLsizei n, GLuint* ids); // Optionnel (requêtes de temps)
+    void (GLEXT_APIENTRY *DeleteQueries)(GLsizei n, const GLuint* ids); // Optionnel
+    void (GLEXT_APIENTRY *BeginQuery)(GLenum target, GLuint id); // Optionnel
+    void (GLEXT_APIENTRY *EndQuery)(GLenum target); // Optionnel
+    void (GLEXT_APIENTRY *GetQueryObjectiv)(GLuint id, GLenum pname, GLint* params); // Optionnel
+    void (GLEXT_APIENTRY *GetQueryObjectui64v)(GLuint id, GLenum pname, GLuint64* params); // Optionnel
+    void (GLEXT_APIENTRY *ReadPixels)(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels);
+    void (GLEXT_APIENTRY *BindFramebuffer)(GLenum target, GLuint framebuffer);
+    void (GLEXT_APIENTRY *GenBuffers)(GLsizei n, GLuint* buffers); // Optionnel (lecture asynchrone)
+    void (GLEXT_APIENTRY *DeleteBuffers)(GLsizei n, const GLuint* buffers); // Optionnel
+    void (GLEXT_APIENTRY *BindBuffer)(GLenum target, GLuint buffer); // Optionnel
+    void (GLEXT_APIENTRY *BufferData)(GLenum target, GLsizeiptr size, const void* data, GLenum usage); // Optionnel
+    void* (GLEXT_APIENTRY *MapBufferRange)(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access); // Optionnel
+    GLboolean (GLEXT_APIENTRY *UnmapBuffer)(GLenum target); // Optionnel
+    GLsync (GLEXT_APIENTRY *FenceSync)(GLenum condition, GLbitfield flags); // Optionnel
+    GLenum (GLEXT_APIENTRY *ClientWaitSync)(GLsync sync, GLbitfield flags, GLuint64 timeout); // Optionnel
+    void (GLEXT_APIENTRY *DeleteSync)(GLsync sync); // Optionnel
+} GLExtFunctions;
+
+extern GLExtFunctions gGL;
+
+// Charge les fonctions (contexte courant requis). Retourne false si une fonction
+// indispensable manque.
+bool InitGLExtensions(void);
+bool IsGLExtensionsReady(void);
+
+// KHR/ARB_parallel_shader_compile : le statut de compilation peut être interrogé
+// sans bloquer via GL_COMPLETION_STATUS_KHR
+bool HasParallelShaderCompile(void);
+// ARB_get_program_binary (GL 4.1) avec au moins un format de binaire disponible
+bool HasProgramBinary(void);
+// ARB_timer_query (GL 3.3) : requêtes GL_TIME_ELAPSED
+bool HasTimerQuery(void);
+// Pixel buffer objects et fences (GL 3.2) : glReadPixels vers un buffer GPU, lu
+// quelques frames plus tard sans attendre le pipeline
+bool HasAsyncReadback(void);
+
+#endif // GL_EXT_H
@@ -0,0 +1,40 @@
+#ifndef GPU_TIMER_H
+#define GPU_TIMER_H
+
+#include "gl_ext.h"
+#include <stdbool.h>
+
+// Mesure du temps GPU d'une suite de commandes avec des requêtes GL_TIME_ELAPSED.
+// Chaque minuteur tourne sur plusieurs requêtes : le résultat d'une frame est lu
+// quelques frames plus tard, uniquement s'il est disponible, donc sans jamais
+// attendre le GPU. Sans support des requêtes, les fonctions ne font rien.
+
+#define GPU_TIMER_QUERIES 4       // Requêtes en vol par minuteur
+#define GPU_TIMER_HISTORY 120     // Échantillons gardés (moyenne glissante et graphe)
+
+typedef struct {
+    GLuint queries[GPU_TIMER_QUERIES];
+    bool isPending[GPU_TIMER_QUERIES];
+    int nextQuery;
+    bool isRunning;
+    float history[GPU_TIMER_HISTORY];  // En millisecondes
+    int historyCount;
+    int historyHead;                    // Prochain emplacement écrit
+} GpuTimer;
+
+bool AreGpuTimersAvailable(void);
+
+// Encadre les commandes mesurées (un seul minuteur actif à la fois, contrainte GL).
+// Les draws raylib étant différés, le batch doit être envoyé avant EndGpuTimer
+// (EndShaderMode, EndTextureMode...).
+void BeginGpuTimer(GpuTimer* timer);
+void EndGpuTimer(GpuTimer* timer);
+// Lit les résultats disponibles (non bloquant), à appeler une fois par frame
+void CollectGpuTimer(GpuTimer* timer);
+
+// Moyenne des derniers échantillons (ms), -1 sans mesure
+float GetGpuTimerAverage(const GpuTimer* timer);
+void ResetGpuTimer(GpuTimer* timer);
+void FreeGpuTimer(GpuTimer* timer);
+
+#endif // GPU_TIMER_H
@@ -0,0 +1,71 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <stdbool.h>
+
+// Système de tâches partagé par tous les traitements CPU (filtres, conversions, VM de
+// shaders, mode sans fenêtre). Les threads sont créés une fois et attendent du travail :
+// chacun a sa propre file (deque) où il empile les tâches qu'il crée et les reprend
+// dans l'ordre inverse ; un thread sans travail en vole au bout opposé de la file des
+// autres. Les threads extérieurs (principal, lecture vidéo...) passent par une file
+// commune. Un thread qui attend une tâche en exécute d'autres en attendant, ce qui
+// permet d'imbriquer les ParallelForTiles sans bloquer de cœur.
+//
+// Les tâches marquées "thread principal" (uploads GL...) ne s'exécutent que dans
+// RunMainThreadJobs, appelée à chaque frame par la boucle raylib.
+
+#define JOB_MAX_THREADS 64
+#define JOB_MAX_JOBS 4096                 // Tâches en vol (créées et non terminées)
+#define JOB_MAX_DEPENDENCIES 8            // Tâches qui peuvent attendre une même tâche
+
+// Handle vers une tâche : index + compteur de génération, comme TextureHandle.
+// La tâche est terminée quand la génération du slot a changé.
+typedef struct {
+    unsigned int index;
+    unsigned int generation;
+} JobHandle;
+
+#define JOB_HANDLE_NULL ((JobHandle){0, 0})  // Toujours terminée
+
+typedef void (*JobFunction)(void* context);
+
+// Rectangle de pixels [x, x+width) x [y, y+height)
+typedef struct {
+    int x;
+    int y;
+    int width;
+    int height;
+} JobTile;
+
+typedef void (*JobTileFunction)(void* context, JobTile tile);
+
+// Marque le thread appelant comme thread principal et démarre les threads.
+// Facultatif hors de la boucle raylib : les threads démarrent à la première tâche.
+void InitJobSystem(void);
+// Termine les tâches en cours et arrête les threads
+void CloseJobSystem(void);
+
+// Nombre de threads, appelant compris (0 = un par cœur). Les threads sont recréés au
+// prochain usage si le nombre change.
+void SetJobThreadCount(int count);
+int GetJobThreadCount(void);
+
+// Lance function(context) quand les tâches de dependencies sont terminées (une tâche
+// qui en attend déjà JOB_MAX_DEPENDENCIES autres est attendue ici)
+JobHandle ScheduleJob(JobFunction function, void* context, const JobHandle* dependencies, int dependencyCount);
+// Même chose, exécutée par RunMainThreadJobs
+JobHandle ScheduleMainThreadJob(JobFunction function, void* context, const JobHandle* dependencies, int dependencyCount);
+bool IsJobDone(JobHandle job);
+// Exécute d'autres tâches jusqu'à la fin de job (depuis n'importe quel thread)
+void WaitForJob(JobHandle job);
+
+// Découpe [0, width) x [0, height) en tuiles et les répartit sur les threads ; l'appelant
+// en traite aussi et retourne quand toutes sont faites. Les tuiles partent ligne par
+// ligne, de haut en bas.
+void ParallelForTiles(int width, int height, int tileWidth, int tileHeight, JobTileFunction function, void* context);
+
+// Exécute les tâches du thread principal prêtes, dans la limite du budget
+// (au moins une). Retourne le nombre de tâches exécutées.
+int RunMainThreadJobs(double budgetSeconds);
+
+#endif // JOB_SYSTEM_H
@@ -0,0 +1,63 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <stdbool.h>
+
+// Journal asynchrone (debug.log). Les threads qui écrivent ne font que copier le message
+// dans un slot d'un tampon circulaire sans verrou (plusieurs écrivains, un lecteur) ;
+// un thread d'écriture vide le tampon par lots, regroupe les messages répétés
+// ("message xN", écrit au moins toutes les secondes ou toutes les 1000 occurrences) et
+// écrit le fichier. Si le tampon est plein, le message est perdu (et compté) plutôt que
+// de bloquer la boucle de rendu. Tant que le journal n'est pas démarré (modes ligne de
+// commande), les messages vont directement sur stdout.
+//
+// Les niveaux sous LOG_MIN_SEVERITY ne sont pas compilés : les appels LOG_xxxF
+// deviennent du code mort (arguments vérifiés mais jamais évalués).
+
+#define LOG_SEVERITY_DEBUG 0
+#define LOG_SEVERITY_INFO 1
+#define LOG_SEVERITY_WARNING 2      // Écrit aussi sur stdout
+#define LOG_SEVERITY_ERROR 3        // Écrit aussi sur stdout
+#define LOG_SEVERITY_NONE 4
+
+#ifndef LOG_MIN_SEVERITY
+#define LOG_MIN_SEVERITY LOG_SEVERITY_INFO
+#endif
+
+#define LOG_MAX_MESSAGE_LENGTH 256  // Tronqué au-delà
+#define LOG_RING_SIZE 1024          // Messages en attente d'écriture (puissance de 2)
+
+// Ouvre debug.log et démarre le thread d'écriture
+void InitLogger(void);
+// Écrit les messages en attente et arrête le thread
+void CloseLogger(void);
+
+// Message au niveau info, copié tel quel (sans formatage)
+void LogMessage(const char* message);
+void LogWrite(int severity, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+#if LOG_MIN_SEVERITY <= LOG_SEVERITY_DEBUG
+#define LOG_DEBUGF(...) LogWrite(LOG_SEVERITY_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUGF(...) do { if (0) LogWrite(LOG_SEVERITY_DEBUG, __VA_ARGS__); } while (0)
+#endif
+
+#if LOG_MIN_SEVERITY <= LOG_SEVERITY_INFO
+#define LOG_INFOF(...) LogWrite(LOG_SEVERITY_INFO, __VA_ARGS__)
+#else
+#define LOG_INFOF(...) do { if (0) LogWrite(LOG_SEVERITY_INFO, __VA_ARGS__); } while (0)
+#endif
+
+#if LOG_MIN_SEVERITY <= LOG_SEVERITY_WARNING
+#define LOG_WARNINGF(...) LogWrite(LOG_SEVERITY_WARNING, __VA_ARGS__)
+#else
+#define LOG_WARNINGF(...) do { if (0) LogWrite(LOG_SEVERITY_WARNING, __VA_ARGS__); } while (0)
+#endif
+
+#if LOG_MIN_SEVERITY <= LOG_SEVERITY_ERROR
+#define LOG_ERRORF(...) LogWrite(LOG_SEVERITY_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERRORF(...) do { if (0) LogWrite(LOG_SEVERITY_ERROR, __VA_ARGS__); } while (0)
+#endif
+
+#endif // LOGGER_H
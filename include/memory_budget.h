@@ -0,0 +1,52 @@
+#ifndef MEMORY_BUDGET_H
+#define MEMORY_BUDGET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Sous-systèmes suivis par le budget mémoire
+typedef enum {
+    MEM_SUBSYS_FRAMES,    // Frames vidéo décodées (RAM)
+    MEM_SUBSYS_TEXTURES,  // Textures GPU (image, frames vidéo)
+    MEM_SUBSYS_CACHES,    // Caches (programmes, rendus intermédiaires)
+    MEM_SUBSYS_LOGS,      // Buffers du logger
+    MEM_SUBSYS_COUNT
+} MemSubsystem;
+
+// Pools mémoire avec chacun leur plafond
+typedef enum {
+    MEM_POOL_RAM,
+    MEM_POOL_VRAM,
+    MEM_POOL_COUNT
+} MemPool;
+
+// Callback d'éviction : libère au moins bytesNeeded octets si possible
+// (en appelant MemoryBudgetRelease) et retourne le nombre d'octets libérés
+typedef size_t (*MemEvictCallback)(MemPool pool, size_t bytesNeeded, void* userData);
+
+// Initialise le budget (plafonds lus depuis SHADERLAB_RAM_BUDGET_MB / SHADERLAB_VRAM_BUDGET_MB)
+void InitMemoryBudget(void);
+void SetMemoryBudgetCap(MemPool pool, size_t bytes);
+// Plusieurs évicteurs peuvent être enregistrés par sous-système
+void RegisterMemoryEvictor(MemSubsystem subsys, MemEvictCallback callback, void* userData);
+void UnregisterMemoryEvictor(MemSubsystem subsys, MemEvictCallback callback);
+
+// Réserve des octets pour un sous-système : tente une éviction si le plafond est dépassé,
+// retourne false (refus) si la place n'a pas pu être libérée
+bool MemoryBudgetReserve(MemSubsystem subsys, MemPool pool, size_t bytes);
+// Même chose sans éviction, utilisable depuis un thread de travail
+bool MemoryBudgetTryReserve(MemSubsystem subsys, MemPool pool, size_t bytes);
+// Même chose pour une réservation facultative : un échec n'est pas compté dans "Refus"
+bool MemoryBudgetTryReserveOptional(MemSubsystem subsys, MemPool pool, size_t bytes);
+void MemoryBudgetRelease(MemSubsystem subsys, MemPool pool, size_t bytes);
+
+size_t GetMemoryBudgetUsed(MemPool pool);
+size_t GetMemoryBudgetPeak(MemPool pool);
+size_t GetMemoryBudgetCap(MemPool pool);
+size_t GetSubsystemMemoryUsed(MemSubsystem subsys, MemPool pool);
+const char* GetMemSubsystemName(MemSubsystem subsys);
+
+// Dessine les compteurs en direct (panneau latéral)
+void DrawMemoryBudgetPanel(int x, int y);
+
+#endif // MEMORY_BUDGET_H
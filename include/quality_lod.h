@@ -0,0 +1,37 @@
+#ifndef QUALITY_LOD_H
+#define QUALITY_LOD_H
+
+#include <stdbool.h>
+
+// Choix automatique du niveau de qualité d'un shader (#pragma quality) d'après le
+// temps de frame mesuré. Le niveau baisse quand le budget est dépassé pendant un
+// court moment, et ne remonte qu'après une période plus longue avec de la marge.
+// Une remontée aussitôt suivie d'une baisse double l'attente avant la suivante,
+// pour ne pas osciller entre deux niveaux.
+
+#define QUALITY_DOWNGRADE_DELAY 0.25f     // Secondes au-dessus du budget avant de baisser
+#define QUALITY_UPGRADE_DELAY 1.0f        // Secondes avec de la marge avant de remonter
+#define QUALITY_UPGRADE_DELAY_MAX 16.0f
+#define QUALITY_COOLDOWN 0.5f             // Pas de décision juste après un changement
+#define QUALITY_GPU_SHARE 0.6f            // Part du budget de frame laissée au shader
+#define QUALITY_HEADROOM 0.6f             // Remonter seulement sous 60 % de cette part
+
+typedef struct {
+    int quality;                  // Niveau choisi
+    int levelCount;
+    float frameTime;              // Moyenne glissante (secondes)
+    float overTime;               // Durée continue au-dessus du budget
+    float underTime;              // Durée continue avec de la marge
+    float cooldown;
+    float upgradeDelay;
+    float sinceUpgrade;
+} QualityController;
+
+// Retourne le niveau à utiliser (0 = le plus rapide). gpuMilliseconds est le temps GPU
+// du shader, -1 sans mesure : seul le temps de frame est alors utilisé.
+int UpdateQualityController(QualityController* controller, int levelCount, float frameSeconds,
+                            float gpuMilliseconds, float frameBudgetMilliseconds);
+// Repart de la qualité complète (changement de shader)
+void ResetQualityController(QualityController* controller, int levelCount);
+
+#endif // QUALITY_LOD_H
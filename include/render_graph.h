@@ -0,0 +1,212 @@
+#ifndef RENDER_GRAPH_H
+#define RENDER_GRAPH_H
+
+#include "raylib.h"
+#include "shader_uniforms.h"
+#include "gpu_timer.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Graphe de rendu multi-passes décrit dans le fichier shader :
+//
+//   #pragma pass blurH scale=0.5 input=source
+//   #pragma pass blurV scale=0.5
+//   #pragma pass composite input=source
+//
+// Chaque passe est compilée à partir du même source avec PASS_<NOM> défini
+// (en majuscules). texture0 est l'entrée de la passe (l'image source ou une passe
+// précédente, par défaut la passe précédente), la sortie de chaque passe précédente
+// est aussi accessible par un sampler2D portant son nom, et l'image d'origine
+// par sourceTexture. Les passes intermédiaires rendent dans des RenderTexture2D
+// (réutilisées en ping-pong), la dernière passe dessine à l'écran.
+// Sans #pragma pass, le fichier est une passe unique "main".
+//
+//   #pragma bounded_by_radius 1.05
+//
+// indique que la dernière passe ne modifie que les pixels à moins de radius * facteur
+// de mousePos (facteur 1 par défaut) : l'image est dessinée telle quelle et le shader
+// ne s'exécute que sur le carré englobant autour du curseur.
+//
+//   #pragma quality 3
+//
+// déclare des niveaux de qualité : chaque passe est compilée une fois par niveau avec
+// QUALITY défini de 0 (le plus rapide) à QUALITY_LEVELS - 1 (qualité complète, seul
+// niveau sans ce pragma). Le niveau actif se change sans recompiler.
+//
+//   #pragma specialize radius power
+//
+// marque des paramètres (radius, power) qui restent longtemps constants : quand leurs
+// valeurs ne changent plus, une variante est compilée en arrière-plan avec
+// SPECIALIZE_<NOM> défini à la valeur (le shader remplace alors l'uniform par une
+// constante), et le programme générique est utilisé en attendant. L'échelle de chaque
+// passe est toujours définie (PASS_SCALE), pour des boucles à bornes constantes.
+// Si aucune passe ne lit time, le résultat est gardé dans une cible et les passes ne
+// sont ré-exécutées que lorsqu'une entrée change (image, paramètres, programmes, taille).
+
+#define MAX_RENDER_PASSES 8
+#define MAX_PASS_NAME 32
+#define MAX_QUALITY_LEVELS 4
+#define MAX_RENDER_PROGRAMS (MAX_RENDER_PASSES * MAX_QUALITY_LEVELS)
+#define MAX_GRAPH_VARIANTS 8      // Variantes spécialisées gardées par graphe
+
+// Paramètres de l'effet qui peuvent être spécialisés
+typedef enum {
+    RENDER_PARAM_RADIUS,
+    RENDER_PARAM_POWER,
+    RENDER_PARAM_COUNT
+} RenderParam;
+
+typedef struct {
+    char name[MAX_PASS_NAME];
+    float scale;                  // Résolution de la cible relative à l'image
+    char input[MAX_PASS_NAME];    // "source" ou nom d'une passe précédente
+} RenderPassDesc;
+
+typedef struct {
+    RenderPassDesc passes[MAX_RENDER_PASSES];
+    int passCount;
+    float boundRadiusScale;       // 0 = la dernière passe couvre toute l'image
+    int qualityLevels;            // 1 sans #pragma quality
+    unsigned int specializedParams; // Bits (1 << RenderParam) des paramètres spécialisables
+} RenderGraphDesc;
+
+// Paramètres de l'effet envoyés à toutes les passes
+typedef struct {
+    float time;
+    Vector2 mousePos;             // En pixels de l'image
+    float radius;
+    float power;
+} EffectParams;
+
+// Uniforms résolus une fois par programme
+typedef struct {
+    int time;
+    int mousePos;
+    int radius;
+    int power;
+    int resolution;               // Taille de l'image source
+    int passResolution;           // Taille de la cible de la passe
+    int inputResolution;          // Taille de texture0
+    int sourceSamplerLocation;
+    int passSamplerLocations[MAX_RENDER_PASSES];
+} PassUniforms;
+
+// Entrées dont dépend le résultat mis en cache
+typedef struct {
+    unsigned int sourceId;
+    Rectangle sourceRect;
+    int width;
+    int height;
+    Vector2 mousePos;
+    float radius;
+    float power;
+} RenderGraphResultKey;
+
+// Valeurs d'une variante spécialisée (0 pour les paramètres non spécialisés)
+typedef struct {
+    float values[RENDER_PARAM_COUNT];
+    int quality;
+} RenderGraphVariantKey;
+
+// Programmes des passes d'un niveau de qualité, compilés pour des valeurs fixes
+typedef struct {
+    RenderGraphVariantKey key;
+    bool isFailed;                            // Compilation échouée : ne pas redemander
+    Shader shaders[MAX_RENDER_PASSES];
+    ShaderUniformTable uniforms[MAX_RENDER_PASSES];
+    PassUniforms passUniforms[MAX_RENDER_PASSES];
+    unsigned int lastUse;
+} RenderGraphVariant;
+
+typedef struct {
+    RenderGraphDesc desc;
+    unsigned long long sourceHash;            // Source développé des programmes (0 inconnu)
+    // Programmes rangés par niveau de qualité : index = niveau * passCount + passe
+    Shader shaders[MAX_RENDER_PROGRAMS];
+    ShaderUniformTable uniforms[MAX_RENDER_PROGRAMS];
+    PassUniforms passUniforms[MAX_RENDER_PROGRAMS];
+    int quality;                              // Niveau exécuté
+    int inputPass[MAX_RENDER_PASSES];         // -1 = image source
+    int targetSlot[MAX_RENDER_PASSES];        // -1 = écran
+    float slotScale[MAX_RENDER_PASSES];
+    RenderTexture2D targets[MAX_RENDER_PASSES];
+    int targetCount;
+    int sourceWidth;                          // Taille d'image pour laquelle les cibles existent
+    int sourceHeight;
+    size_t reservedBytes;
+
+    bool isTimeDependent;                     // Une passe lit time : pas de cache
+    RenderTexture2D result;                   // Dernier résultat (taille de destRect)
+    size_t resultBytes;
+    RenderGraphResultKey resultKey;
+    bool hasResult;
+
+    GpuTimer passTimers[MAX_RENDER_PASSES];   // Temps GPU de chaque passe
+
+    RenderGraphVariant variants[MAX_GRAPH_VARIANTS];
+    int variantCount;
+    unsigned int variantUseCounter;
+    RenderGraphVariantKey stableKey;          // Dernières valeurs vues, et depuis quand
+    double stableSince;
+    RenderGraphVariantKey variantRequest;     // Variante demandée, pas encore ajoutée
+    bool hasVariantRequest;
+    bool isSpecialized;                       // Dernière exécution faite par une variante
+} RenderGraph;
+
+// Lit les #pragma pass du source (une passe "main" s'il n'y en a pas)
+bool ParseRenderGraph(const char* source, RenderGraphDesc* desc, char* error, size_t errorSize);
+// Nombre de programmes à compiler (passes x niveaux de qualité)
+int GetRenderGraphProgramCount(const RenderGraphDesc* desc);
+// Source d'un programme : PASS_<NOM>, PASS_INDEX, PASS_SCALE, QUALITY et QUALITY_LEVELS
+// définis après #version, plus SPECIALIZE_<NOM> pour une variante (variant peut être
+// NULL). À libérer avec free.
+char* BuildRenderPassSource(const char* source, const RenderGraphDesc* desc, int programIndex,
+                            const RenderGraphVariantKey* variant);
+
+// Remplace les programmes du graphe (le graphe en devient propriétaire, les anciens
+// sont déchargés) et reconstruit les tables d'uniforms. Le graphe démarre en qualité complète.
+void SetRenderGraphPrograms(RenderGraph* graph, const RenderGraphDesc* desc, const Shader* shaders);
+// Graphe à une passe à partir d'un shader déjà chargé
+void SetRenderGraphShader(RenderGraph* graph, Shader shader);
+void UnloadRenderGraph(RenderGraph* graph);
+// Libère les cibles et le résultat en cache, et oublie les mesures GPU.
+// Les programmes restent chargés : les cibles sont recréées au prochain dessin.
+void ReleaseRenderGraphTargets(RenderGraph* graph);
+
+bool IsRenderGraphReady(const RenderGraph* graph);
+// Vrai si au moins une passe utilise l'uniform (non éliminé par le compilateur)
+bool RenderGraphUsesUniform(const RenderGraph* graph, const char* name);
+
+// Exécute toutes les passes, la dernière dans destRect à l'écran (ou redessine le
+// résultat en cache). Retourne false si rien n'a été dessiné (graphe vide, mémoire refusée).
+bool DrawRenderGraph(RenderGraph* graph, Texture2D source, Rectangle sourceRect, Rectangle destRect, const EffectParams* params);
+// Exécute toutes les passes sur l'image entière, la dernière dans target (sans cache de
+// résultat). Comme toute RenderTexture, target est à l'envers : ImageFlipVertical après lecture.
+bool RenderGraphToTexture(RenderGraph* graph, Texture2D source, RenderTexture2D* target, const EffectParams* params);
+// Temps GPU moyen d'une exécution du graphe (somme des passes, ms), -1 sans mesure
+float GetRenderGraphGpuTime(const RenderGraph* graph);
+float GetRenderPassGpuTime(const RenderGraph* graph, int passIndex);
+// Derniers temps GPU du graphe, du plus ancien au plus récent. Retourne le nombre d'échantillons.
+int GetRenderGraphGpuHistory(const RenderGraph* graph, float* samples, int maxSamples);
+
+// Niveau de qualité exécuté (borné aux niveaux du shader, mesures GPU remises à zéro)
+void SetRenderGraphQuality(RenderGraph* graph, int quality);
+int GetRenderGraphQuality(const RenderGraph* graph);
+int GetRenderGraphQualityLevels(const RenderGraph* graph);
+
+// Variante à compiler : vrai si des paramètres sont spécialisables, que leurs valeurs
+// (et le niveau de qualité) n'ont pas changé depuis delaySeconds et qu'aucune variante
+// n'existe ni n'a été demandée pour elles. La demande est mémorisée.
+bool GetRenderGraphVariantRequest(RenderGraph* graph, const EffectParams* params, double delaySeconds, RenderGraphVariantKey* key);
+// Ajoute une variante compilée (shaders NULL = échec, à ne pas redemander). Le graphe
+// devient propriétaire des programmes ; la variante la moins utilisée est remplacée.
+void AddRenderGraphVariant(RenderGraph* graph, const RenderGraphVariantKey* key, const Shader* shaders);
+int GetRenderGraphVariantCount(const RenderGraph* graph);
+// Vrai si la dernière exécution a utilisé une variante spécialisée
+bool IsRenderGraphSpecialized(const RenderGraph* graph);
+
+// À appeler quand le contenu de la texture source change sans changer d'id
+// (texture réutilisée par le pool)
+void InvalidateRenderGraphResult(RenderGraph* graph);
+
+#endif // RENDER_GRAPH_H
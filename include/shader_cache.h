@@ -0,0 +1,31 @@
+#ifndef SHADER_CACHE_H
+#define SHADER_CACHE_H
+
+#include "gl_ext.h"
+#include <stdbool.h>
+
+// Cache disque des binaires de programmes (ARB_get_program_binary). La clé combine
+// le hash des sources développés et l'identité du pilote (vendor, renderer, version) :
+// un changement de pilote invalide naturellement les anciens binaires.
+
+#define SHADER_CACHE_DIRECTORY "shader_cache"
+
+// À appeler après InitGLExtensions (lit l'identité du pilote). Désactivé si le pilote
+// ne supporte pas les binaires ou si SHADERLAB_NO_SHADER_CACHE=1.
+bool InitShaderBinaryCache(void);
+bool IsShaderBinaryCacheEnabled(void);
+
+unsigned long long GetShaderBinaryKey(unsigned long long fragmentHash, unsigned long long vertexHash);
+
+// Lit un binaire du disque (sans appel GL, utilisable depuis un autre thread).
+// Retourne les données à libérer avec free, NULL si absent ou invalide.
+void* LoadShaderBinary(unsigned long long key, GLenum* format, GLsizei* length);
+// Crée un programme lié à partir d'un binaire. Retourne 0 si le pilote le refuse
+// (le fichier est alors supprimé et l'appelant recompile depuis le source).
+GLuint CreateProgramFromBinary(unsigned long long key, GLenum format, const void* data, GLsizei length);
+// À appeler avant glLinkProgram pour que le binaire soit récupérable
+void PrepareProgramForBinary(GLuint program);
+// Enregistre le binaire d'un programme lié
+bool SaveShaderBinary(GLuint program, unsigned long long key);
+
+#endif // SHADER_CACHE_H
@@ -0,0 +1,35 @@
+#ifndef SHADER_PREPROCESS_H
+#define SHADER_PREPROCESS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define SHADER_PREPROCESS_MAX_PATH 320
+#define MAX_SHADER_DEPENDENCIES 32
+
+// Préprocesseur GLSL : développe les directives #include "fichier" (chemin relatif
+// au fichier qui inclut, puis au dossier shaders/). Chaque fichier n'est inclus
+// qu'une fois par shader. Les fichiers lus et les sources développés sont mis en
+// cache par hash de contenu, et le graphe de dépendances permet de savoir quels
+// shaders recompiler quand un fichier inclus change. Utilisable depuis n'importe
+// quel thread.
+
+// Source développé (à libérer avec free), NULL en cas d'erreur (message dans error).
+// sourceHash reçoit le hash du source développé (peut être NULL).
+char* PreprocessShaderFile(const char* path, unsigned long long* sourceHash, char* error, size_t errorSize);
+
+// Marque un fichier comme modifié sur disque : il sera relu au prochain prétraitement
+void InvalidateShaderSourceFile(const char* path);
+
+// Vrai si le shader racine utilise le fichier (lui-même ou une inclusion, directe ou non)
+bool ShaderDependsOn(const char* rootPath, const char* filePath);
+// Fichiers utilisés par le shader racine lors de son dernier prétraitement (racine comprise)
+int GetShaderDependencies(const char* rootPath, char paths[][SHADER_PREPROCESS_MAX_PATH], int maxPaths);
+
+// Libère tous les caches
+void ClearShaderPreprocessCache(void);
+
+// Hash FNV-1a 64 bits
+unsigned long long HashShaderSource(const void* data, size_t length);
+
+#endif // SHADER_PREPROCESS_H
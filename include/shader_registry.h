@@ -0,0 +1,36 @@
+#ifndef SHADER_REGISTRY_H
+#define SHADER_REGISTRY_H
+
+#include "file_watch.h"
+#include <stdbool.h>
+
+// Liste des shaders disponibles : fichiers .glsl du dossier courant et de shaders/
+// (récursivement, sauf les dossiers lib/ qui ne contiennent que des #include).
+// La liste est triée par chemin et tenue à jour par les événements de file_watch ;
+// la sélection est mémorisée par chemin et survit aux ajouts, suppressions et
+// sauvegardes par renommage.
+
+typedef struct {
+    char* path;          // "effect.glsl", "shaders/flous/gauss.glsl"
+    char* name;          // Nom affiché : chemin sous shaders/ sans extension ("flous/gauss")
+} ShaderEntry;
+
+// Parcourt les dossiers et les surveille (à appeler après InitFileWatch)
+void InitShaderRegistry(void);
+void CloseShaderRegistry(void);
+// Parcours complet, en gardant la sélection
+void RescanShaderRegistry(void);
+// Applique un événement de file_watch. Retourne true si la liste a changé.
+bool UpdateShaderRegistry(const FileWatchEvent* event);
+
+int GetShaderCount(void);
+const ShaderEntry* GetShaderEntry(int index);
+// Index d'un chemin dans la liste (recherche dichotomique), -1 si absent
+int FindShaderEntry(const char* path);
+
+void SelectShader(int index);
+// -1 si le shader sélectionné n'est plus dans la liste (il reste le shader actif)
+int GetSelectedShaderIndex(void);
+const char* GetSelectedShaderPath(void);
+
+#endif // SHADER_REGISTRY_H
@@ -0,0 +1,70 @@
+#ifndef SHADER_RELOAD_H
+#define SHADER_RELOAD_H
+
+#include "raylib.h"
+#include "render_graph.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Rechargement de shader en plusieurs étapes : lecture et prétraitement du source
+// sur un thread, compilation sur le thread GL réparti sur plusieurs frames
+// (non bloquante si le pilote supporte KHR_parallel_shader_compile), puis
+// remplacement du programme actif uniquement en cas de succès. Les programmes
+// déjà compilés sont repris du cache de binaires sur disque. Un shader multi-passes
+// (#pragma pass) est remplacé en entier : toutes ses passes ou aucune.
+//
+// Les autres shaders peuvent être compilés d'avance pendant les frames sans
+// rechargement, un à la fois et dans un budget de temps : passer à l'un d'eux
+// n'est alors qu'un échange de graphes.
+//
+// Les variantes spécialisées (#pragma specialize) sont compilées par le même
+// chemin, une à la fois, et ajoutées au graphe actif quand elles sont prêtes.
+
+typedef enum {
+    SHADER_RELOAD_NONE,     // Rien de nouveau cette frame
+    SHADER_RELOAD_SWAPPED,  // Le nouveau programme remplace l'ancien
+    SHADER_RELOAD_FAILED    // Échec : l'ancien programme reste actif
+} ShaderReloadResult;
+
+// À appeler après InitWindow (charge les fonctions GL et démarre le thread de lecture)
+bool InitShaderReload(void);
+void CloseShaderReload(void);
+
+// Demande le chargement d'un fragment shader (remplace une demande en cours)
+void RequestShaderReload(const char* fsFileName);
+// Fait avancer le rechargement, à appeler une fois par frame hors BeginShaderMode.
+// En cas de succès les passes du graphe sont remplacées (les anciennes sont déchargées) ;
+// en cas d'échec errorMessage reçoit le journal de compilation.
+ShaderReloadResult UpdateShaderReload(RenderGraph* graph, char* errorMessage, size_t errorSize);
+bool IsShaderReloadPending(void);
+
+// Chargement bloquant (démarrage) : binaires du cache si disponibles, sinon compilation.
+// Retourne false en cas d'échec (le graphe n'est pas modifié).
+bool LoadRenderGraphWithCache(const char* fsFileName, RenderGraph* graph, char* errorMessage, size_t errorSize);
+
+// Précompilation : ajoute un shader à la file (false si le cache est plein ou
+// sans les fonctions GL)
+bool QueueShaderPrecompile(const char* fsFileName);
+// Fait avancer la précompilation, à appeler une fois par frame hors BeginShaderMode.
+// Ne fait rien pendant un rechargement. Retourne le chemin du shader qui vient
+// d'entrer dans le cache, NULL sinon.
+const char* UpdateShaderPrecompile(double budgetSeconds);
+// Remplace le graphe actif par le shader précompilé (false s'il ne l'est pas).
+// L'ancien graphe est gardé dans le cache sous activePath, ou déchargé si NULL.
+// Un rechargement en cours est abandonné.
+bool SwapPrecompiledShader(const char* fsFileName, RenderGraph* graph, const char* activePath);
+// Un fichier a changé sur disque : les shaders qui l'utilisent sont recompilés
+void InvalidatePrecompiledShaders(const char* filePath);
+// Vide le cache et la file
+void ClearPrecompiledShaders(void);
+int GetPrecompiledShaderCount(void);
+int GetPendingPrecompileCount(void);
+
+// Variantes : compile en arrière-plan la variante demandée par le graphe actif
+// (GetRenderGraphVariantRequest), en remplaçant une demande en cours
+void RequestShaderVariant(const char* fsFileName, const RenderGraphVariantKey* key);
+// Fait avancer la variante et l'ajoute au graphe une fois compilée, à appeler une
+// fois par frame hors BeginShaderMode (ne fait rien pendant un rechargement)
+void UpdateShaderVariants(RenderGraph* graph);
+
+#endif // SHADER_RELOAD_H
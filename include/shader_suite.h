@@ -0,0 +1,29 @@
+#ifndef SHADER_SUITE_H
+#define SHADER_SUITE_H
+
+#include <stdbool.h>
+
+// Suite de non-régression des shaders, sans fenêtre ni GPU :
+//
+//   main.exe --suite [--golden golden] [--update] [--runs 5] [--psnr 40] [--max-error 16]
+//            [--vm-slowdown 1.25] [--threads n]
+//
+// Chaque shader de shaders/ (pas ceux de shaders/lib) est rendu par cpu_shader sur des
+// entrées fixes : sample.png (curseur au centre et près d'un coin, pour le bouclage
+// des textures) et quelques frames de video_mini.mov (si ffmpeg est disponible), avec
+// des uniforms fixes. Chaque rendu est comparé à son image de référence
+// (golden/<shader>/<cas>.png) : il échoue sous le PSNR minimal ou au-delà de l'écart
+// maximal sur un canal, et le rendu obtenu est écrit à côté (<cas>.actual.png).
+// Le temps de rendu par la VM (médiane de --runs) est comparé à celui enregistré dans
+// golden/vm_timings.txt : une alerte est levée au-delà de --vm-slowdown fois la référence
+// (0 pour ignorer les temps). Les mesures sont faites au nombre de threads enregistré dans
+// ce fichier (ligne "threads n", 1 par défaut), --threads ne règle que les rendus d'images. Ce n'est pas un temps GPU : il suit le coût des shaders
+// dans cpu_shader et les régressions de la VM ; le temps GPU reste affiché par le
+// viewer (gpu_timer). --update réécrit les références et les temps.
+
+// Vrai si la ligne de commande demande la suite (--suite)
+bool IsShaderSuiteCommandLine(int argc, char** argv);
+// Exécute la suite et retourne le code de sortie (0 si tout passe)
+int RunShaderSuite(int argc, char** argv);
+
+#endif // SHADER_SUITE_H
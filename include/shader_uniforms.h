@@ -0,0 +1,44 @@
+#ifndef SHADER_UNIFORMS_H
+#define SHADER_UNIFORMS_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+#define MAX_UNIFORM_NAME 64
+
+// Uniform actif d'un programme avec la dernière valeur envoyée
+typedef struct {
+    char name[MAX_UNIFORM_NAME];    // Sans le suffixe "[0]" des tableaux
+    int location;
+    int type;                       // ShaderUniformDataType, -1 si non géré (matrices...)
+    int count;                      // Nombre d'éléments (tableaux)
+    int valueSize;                  // Taille totale de la valeur en octets
+    unsigned char* value;           // Dernière valeur envoyée
+    bool hasValue;
+} ShaderUniform;
+
+// Table des uniforms d'un programme, construite une fois après la compilation
+typedef struct {
+    unsigned int programId;
+    ShaderUniform* uniforms;
+    int count;
+    unsigned char* values;          // Stockage des dernières valeurs de tous les uniforms
+    int uploadCount;                // Envois effectués depuis la construction
+    int skippedCount;               // Envois évités (valeur inchangée)
+} ShaderUniformTable;
+
+// Construit la table à partir des uniforms actifs du programme (libère l'ancienne)
+void BuildShaderUniformTable(ShaderUniformTable* table, Shader shader);
+void FreeShaderUniformTable(ShaderUniformTable* table);
+
+// Index de l'uniform dans la table, -1 s'il est absent ou éliminé par le compilateur.
+// À résoudre une fois par programme, pas à chaque frame.
+int FindShaderUniform(const ShaderUniformTable* table, const char* name);
+
+// Envoie la valeur uniquement si elle diffère de la dernière envoyée.
+// La valeur doit couvrir tout l'uniform (type x count). Retourne true si un envoi a eu lieu.
+bool SetShaderUniform(ShaderUniformTable* table, int index, const void* value);
+// Force le prochain envoi de tous les uniforms
+void InvalidateShaderUniforms(ShaderUniformTable* table);
+
+#endif // SHADER_UNIFORMS_H
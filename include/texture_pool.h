@@ -0,0 +1,38 @@
+#ifndef TEXTURE_POOL_H
+#define TEXTURE_POOL_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// Handle vers une texture de la table : index + compteur de génération.
+// Un handle dont la génération ne correspond plus au slot est périmé.
+typedef struct {
+    unsigned int index;
+    unsigned int generation;
+} TextureHandle;
+
+#define TEXTURE_HANDLE_NULL ((TextureHandle){0, 0})
+
+void InitTexturePool(void);
+// Décharge toutes les textures (vivantes et en réserve)
+void CloseTexturePool(void);
+
+// Crée une texture à partir d'une image (réutilise une texture en réserve de même format
+// si possible). Le handle retourné possède une référence.
+TextureHandle AcquireTextureFromImage(Image image);
+// Ajoute une référence et retourne le même handle (ou TEXTURE_HANDLE_NULL s'il est périmé)
+TextureHandle RetainTexture(TextureHandle handle);
+// Retire une référence et remet *handle à TEXTURE_HANDLE_NULL.
+// À zéro référence, la texture retourne immédiatement dans la réserve.
+void ReleaseTexture(TextureHandle* handle);
+
+bool IsTextureHandleValid(TextureHandle handle);
+// Pointeur vers la texture (non propriétaire), NULL si le handle est périmé.
+// Valable jusqu'au prochain AcquireTextureFromImage (la table peut grandir).
+Texture2D* ResolveTexture(TextureHandle handle);
+int GetTextureRefCount(TextureHandle handle);
+
+int GetTexturePoolLiveCount(void);
+int GetTexturePoolReserveCount(void);
+
+#endif // TEXTURE_POOL_H
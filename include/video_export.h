@@ -0,0 +1,59 @@
+#ifndef VIDEO_EXPORT_H
+#define VIDEO_EXPORT_H
+
+#include "render_graph.h"
+#include "color_convert.h"
+#include <stdbool.h>
+#include <stdio.h>
+
+// Export d'une vidéo passée dans le shader, en résolution native. Les étapes se
+// recouvrent : un thread lit les frames décodées par ffmpeg, le thread GL les rend
+// dans une RenderTexture2D et lance leur lecture asynchrone (pixel buffer objects,
+// plusieurs frames en vol), un autre thread envoie les frames lues à l'encodeur
+// ffmpeg par son entrée standard. Sans PBO, la lecture est synchrone. Le décodeur
+// sort du YUV 4:2:0 (2,7 fois moins d'octets dans le pipe que du RGBA), converti par
+// color_convert dans le thread de lecture.
+
+#define VIDEO_EXPORT_DECODE_FRAMES 4    // Frames décodées d'avance
+#define VIDEO_EXPORT_READBACKS 3        // Lectures GPU en vol
+#define VIDEO_EXPORT_ENCODE_FRAMES 4    // Frames en attente de l'encodeur
+
+typedef enum {
+    VIDEO_EXPORT_IDLE,
+    VIDEO_EXPORT_RUNNING,
+    VIDEO_EXPORT_DONE,
+    VIDEO_EXPORT_FAILED,
+    VIDEO_EXPORT_CANCELLED
+} VideoExportState;
+
+typedef struct {
+    VideoExportState state;
+    int encodedFrames;
+    int frameCount;               // Total attendu, 0 si inconnu
+    float framesPerSecond;        // Débit depuis le début de l'export
+    float seconds;
+    const char* outputPath;
+    const char* errorMessage;     // Vide sans erreur
+} VideoExportStatus;
+
+// Taille, cadence et espace couleur d'une vidéo (ffprobe). Sans matrice indiquée, BT.709
+// à partir de 720 lignes, BT.601 en dessous. Retourne false si la vidéo est illisible.
+bool ProbeVideoFile(const char* path, int* width, int* height, float* fps, YuvColorSpace* colorSpace);
+// Processus ffmpeg : frames I420 brutes (GetYuvFrameSize octets, dans la plage de
+// colorSpace) en sortie du décodeur, frames RGBA brutes en entrée de l'encodeur
+FILE* OpenVideoDecoder(const char* path, YuvColorSpace colorSpace);
+FILE* OpenVideoEncoder(const char* path, int width, int height, float fps);
+
+// Démarre l'export (un seul à la fois). params.time est le temps de la première
+// frame, augmenté de 1/fps à chaque frame. Thread GL uniquement.
+bool StartVideoExport(const char* videoPath, const char* outputPath, const EffectParams* params, int frameCount);
+// Fait avancer l'export avec graph dans la limite du budget, à appeler à chaque frame.
+// graph reste en qualité complète jusqu'à la fin de l'export.
+void UpdateVideoExport(RenderGraph* graph, double budgetSeconds);
+void CancelVideoExport(void);
+bool IsVideoExportRunning(void);
+void GetVideoExportStatus(VideoExportStatus* status);
+// Annule un export en cours et libère tout (avant CloseWindow)
+void CloseVideoExport(void);
+
+#endif // VIDEO_EXPORT_H
@@ -2,19 +2,91 @@
 #include "nob.h" // Make sure nob.h is in your project directory
 
 #include <stdio.h> // For snprintf
+#include <string.h> // For strcmp
 #include <errno.h> // For strerror with nob_copy_file
 
+// Sources shared by main.exe and the tests (everything but src/main.c)
+static const char* gSources[] = {
+    "src/memory_budget.c",
+    "src/texture_pool.c",
+    "src/frame_arena.c",
+    "src/file_watch.c",
+    "src/gl_ext.c",
+    "src/shader_reload.c",
+    "src/shader_uniforms.c",
+    "src/shader_preprocess.c",
+    "src/shader_cache.c",
+    "src/render_graph.c",
+    "src/shader_registry.c",
+    "src/gpu_timer.c",
+    "src/quality_lod.c",
+    "src/cpu_filter.c",
+    "src/cpu_blur.c",
+    "src/batch_render.c",
+    "src/video_export.c",
+    "src/cpu_shader.c",
+    "src/color_convert.c",
+    "src/job_system.c",
+    "src/shader_suite.c",
+    "src/logger.c",
+};
+
+// Test programs, run from the project directory by "nob test" (exit code 0 = passed)
+static const char* gTests[] = {
+    "test_cpu_filter",
+    "test_color_convert",
+    "test_job_system",
+    "test_logger",
+};
+
+#define ARRAY_LEN(array) (sizeof(array) / sizeof((array)[0]))
+
+static void AppendCommonFlags(Nob_Cmd* cmd) {
+    nob_cmd_append(cmd, "gcc", "-Wall", "-Wextra");
+    nob_cmd_append(cmd, "-Iinclude", "-Llib");
+    nob_cmd_append(cmd, "-O2");
+}
+
+static void AppendLibraries(Nob_Cmd* cmd) {
+    for (size_t i = 0; i < ARRAY_LEN(gSources); i++) nob_cmd_append(cmd, gSources[i]);
+    nob_cmd_append(cmd, "-lraylib", "-lopengl32", "-lgdi32", "-lwinmm", "-lpthread");
+}
+
+static int RunTests(void) {
+    Nob_Cmd cmd = {0};
+    int failures = 0;
+    for (size_t i = 0; i < ARRAY_LEN(gTests); i++) {
+        char source[256], executable[256];
+        snprintf(source, sizeof(source), "tests/%s.c", gTests[i]);
+        snprintf(executable, sizeof(executable), "tests/%s.exe", gTests[i]);
+
+        AppendCommonFlags(&cmd);
+        nob_cmd_append(&cmd, "-o", executable, source);
+        AppendLibraries(&cmd);
+        if (!nob_cmd_run_sync_and_reset(&cmd)) return 1;
+
+        nob_cmd_append(&cmd, executable);
+        if (!nob_cmd_run_sync_and_reset(&cmd)) {
+            nob_log(NOB_ERROR, "%s failed", gTests[i]);
+            failures++;
+        }
+    }
+    nob_log(failures == 0 ? NOB_INFO : NOB_ERROR, "%d/%zu tests passed", (int)ARRAY_LEN(gTests) - failures, ARRAY_LEN(gTests));
+    return failures == 0 ? 0 : 1;
+}
+
 int main(int argc, char **argv) {
     NOB_GO_REBUILD_URSELF(argc, argv);
 
+    // nob test : build and run the tests instead of main.exe
+    if (argc > 1 && strcmp(argv[1], "test") == 0) return RunTests();
+
     // gcc -Wall -Wextra -Iinclude -Llib -o main.exe -O2 src/main.c -lraylib -lopengl32 -lgdi32 -lwinmm -mwindows
     Nob_Cmd cmd = {0};
-    nob_cmd_append(&cmd, "gcc", "-Wall", "-Wextra");
-    nob_cmd_append(&cmd, "-Iinclude", "-Llib");
+    AppendCommonFlags(&cmd);
     nob_cmd_append(&cmd, "-o", "main.exe");
-    nob_cmd_append(&cmd, "-O2");
     nob_cmd_append(&cmd, "src/main.c");
-    nob_cmd_append(&cmd, "-lraylib", "-lopengl32", "-lgdi32", "-lwinmm");
+    AppendLibraries(&cmd);
     nob_cmd_append(&cmd, "-mwindows");
     if (!nob_cmd_run_sync(cmd)) return 1;
    
@@ -1,5 +1,8 @@
 #version 460
 
+// Seuls les pixels à moins de radius*1.05 du curseur sont modifiés
+#pragma bounded_by_radius 1.05
+
 in vec2 fragTexCoord;
 out vec4 fragColor;
 
@@ -9,29 +12,9 @@ uniform float radius;
 uniform float power;
 uniform vec2 resolution;
 uniform float time;
-#define PI 3.1415926535897932384626433832795
-
+#include "lib/common.glsl"
+#include "lib/blur.glsl"
 
-float angleBetween(vec2 a, vec2 b) {
-    return atan(b.y - a.y, b.x - a.x);
-}
-vec4 gaussianBlur(sampler2D tex, vec2 uv, vec2 resolution, float radius) {
-    float sigma = radius / 2.0;
-    float twoSigmaSq = 2.0 * sigma * sigma;
-    float blurRadius = ceil(radius);
-    vec4 color = vec4(0.0);
-    float total = 0.0;
-
-    for (float x = -blurRadius; x <= blurRadius; x++) {
-        for (float y = -blurRadius; y <= blurRadius; y++) {
-            vec2 offset = vec2(x, y) / resolution;
-            float weight = exp(-(x * x + y * y) / twoSigmaSq);
-            color += texture(tex, uv + offset) * weight;
-            total += weight;
-        }
-    }
-    return color / total;
-}
 void main() {
     vec2 uv = fragTexCoord;
     vec2 pixelPos = uv * resolution;
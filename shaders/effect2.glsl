@@ -1,37 +1,52 @@
 #version 460
 
+// Flou séparable : deux passes 1D à mi-résolution, puis composition à l'écran
+#pragma pass blurH scale=0.5 input=source
+#pragma pass blurV scale=0.5
+#pragma pass composite input=source
+// La composition ne modifie que le cercle autour du curseur
+#pragma bounded_by_radius 1.05
+// Niveaux de qualité : moins d'échantillons de flou quand la frame est trop lente
+#pragma quality 3
+// radius change rarement : une variante où c'est une constante est compilée quand il se stabilise
+#pragma specialize radius
+
 in vec2 fragTexCoord;
 out vec4 fragColor;
 
 uniform sampler2D texture0;
 uniform vec2 mousePos;
+#ifdef SPECIALIZE_RADIUS
+const float radius = SPECIALIZE_RADIUS;
+#else
 uniform float radius;
+#endif
 uniform float power;
 uniform vec2 resolution;
 uniform float time;
-#define PI 3.1415926535897932384626433832795
+uniform vec2 passResolution;
+#include "lib/common.glsl"
+#include "lib/blur.glsl"
 
+#if defined(PASS_BLURH) || defined(PASS_BLURV)
 
-float angleBetween(vec2 a, vec2 b) {
-    return atan(b.y - a.y, b.x - a.x);
+void main() {
+    // Rayon de 8 pixels de l'image, exprimé en pixels de la passe (constant : boucle déroulable)
+    const float blurRadius = 8.0 * PASS_SCALE;
+#ifdef PASS_BLURH
+    vec2 texelStep = vec2(1.0 / passResolution.x, 0.0);
+#else
+    vec2 texelStep = vec2(0.0, 1.0 / passResolution.y);
+#endif
+    // Qualité réduite : même étendue avec des échantillons espacés (filtrage bilinéaire entre eux)
+    const float stride = float(QUALITY_LEVELS - QUALITY);
+    fragColor = gaussianBlur1D(texture0, fragTexCoord, texelStep * stride, blurRadius / stride);
 }
-vec4 gaussianBlur(sampler2D tex, vec2 uv, vec2 resolution, float radius) {
-    float sigma = radius / 2.0;
-    float twoSigmaSq = 2.0 * sigma * sigma;
-    float blurRadius = ceil(radius);
-    vec4 color = vec4(0.0);
-    float total = 0.0;
 
-    for (float x = -blurRadius; x <= blurRadius; x++) {
-        for (float y = -blurRadius; y <= blurRadius; y++) {
-            vec2 offset = vec2(x, y) / resolution;
-            float weight = exp(-(x * x + y * y) / twoSigmaSq);
-            color += texture(tex, uv + offset) * weight;
-            total += weight;
-        }
-    }
-    return color / total;
-}
+#else
+
+uniform sampler2D blurV; // Sortie de la passe blurV
+
 void main() {
     vec2 uv = fragTexCoord;
     vec2 pixelPos = uv * resolution;
@@ -48,7 +63,7 @@ void main() {
     else if (dist < outer) {
         // 20% externe : flou progressif
         float blurAmount = smoothstep(center, outer, dist);
-        vec4 blurredColor = gaussianBlur(texture0, uv, resolution, 8.0);
+        vec4 blurredColor = texture(blurV, uv);
         float angle = angleBetween(mousePos, pixelPos);
         float animatedBlue = 0.5 + 0.3 * cos(time * 2.0 + angle * 2.0);
         float animatedRed = 0.5 + 0.3 * cos(time * 2.0 + angle * 2.0 + PI / 2.0);
@@ -61,4 +76,6 @@ void main() {
     else {
         fragColor = originalColor;
     }
-}
\ No newline at end of file
+}
+
+#endif
@@ -0,0 +1,34 @@
+// Flou gaussien 2D (rayon en pixels)
+vec4 gaussianBlur(sampler2D tex, vec2 uv, vec2 resolution, float radius) {
+    float sigma = radius / 2.0;
+    float twoSigmaSq = 2.0 * sigma * sigma;
+    float blurRadius = ceil(radius);
+    vec4 color = vec4(0.0);
+    float total = 0.0;
+
+    for (float x = -blurRadius; x <= blurRadius; x++) {
+        for (float y = -blurRadius; y <= blurRadius; y++) {
+            vec2 offset = vec2(x, y) / resolution;
+            float weight = exp(-(x * x + y * y) / twoSigmaSq);
+            color += texture(tex, uv + offset) * weight;
+            total += weight;
+        }
+    }
+    return color / total;
+}
+
+// Flou gaussien 1D le long de texelStep (une passe d'un flou séparable, rayon en texels)
+vec4 gaussianBlur1D(sampler2D tex, vec2 uv, vec2 texelStep, float radius) {
+    float sigma = max(radius / 2.0, 0.5);
+    float twoSigmaSq = 2.0 * sigma * sigma;
+    float blurRadius = ceil(radius);
+    vec4 color = vec4(0.0);
+    float total = 0.0;
+
+    for (float i = -blurRadius; i <= blurRadius; i++) {
+        float weight = exp(-(i * i) / twoSigmaSq);
+        color += texture(tex, uv + texelStep * i) * weight;
+        total += weight;
+    }
+    return color / total;
+}
@@ -0,0 +1,6 @@
+// Constantes et fonctions communes aux effets
+#define PI 3.1415926535897932384626433832795
+
+float angleBetween(vec2 a, vec2 b) {
+    return atan(b.y - a.y, b.x - a.x);
+}
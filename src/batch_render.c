@@ -0,0 +1,595 @@
+#include "batch_render.h"
+#include "raylib.h"
+#include "render_graph.h"
+#include "shader_reload.h"
+#include "cpu_filter.h"
+#include "cpu_blur.h"
+#include "cpu_shader.h"
+#include "video_export.h"
+#include <ctype.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BATCH_MAX_PATH 1024
+#define BATCH_DEFAULT_SHADER "shaders/effect.glsl"
+#define BATCH_PROGRESS_INTERVAL 100  // Frames entre deux lignes de progression
+
+typedef enum {
+    BATCH_ENGINE_AUTO,
+    BATCH_ENGINE_CPU,
+    BATCH_ENGINE_GPU,
+    BATCH_ENGINE_VM               // Shader exécuté par cpu_shader, même s'il a une version CPU
+} BatchEngine;
+
+typedef struct {
+    const char* inputPath;
+    const char* shaderPath;
+    const char* outputPath;
+    EffectParams params;
+    bool hasMouse;                // Sinon, centre de chaque image
+    BatchEngine engine;
+    int threadCount;              // 0 = un par cœur
+} BatchOptions;
+
+// Réimplémentation CPU d'un shader, reconnue au nom du fichier
+typedef bool (*CpuEffectFunc)(Image source, Image* output, const EffectParams* params);
+
+typedef struct {
+    const char* fileName;
+    CpuEffectFunc apply;
+    bool isExact;                 // Mêmes octets que le shader : choisie aussi par --engine auto
+} CpuEffect;
+
+// Moteur qui rend une frame : une fonction CPU ou le shader compilé pour le CPU
+// (appelables depuis plusieurs threads), ou le render graph dans le contexte GL
+// caché (thread principal uniquement)
+typedef struct {
+    const CpuEffect* cpuEffect;   // NULL = VM ou GPU
+    CpuShaderGraph vmGraph;
+    bool isVm;
+    RenderGraph graph;
+    Texture2D sourceTexture;
+    RenderTexture2D target;
+    bool hasWindow;
+} BatchRenderer;
+
+// Une image (ou une frame) à rendre
+typedef struct {
+    char inputPath[BATCH_MAX_PATH];  // Vide pour une frame vidéo
+    char outputPath[BATCH_MAX_PATH]; // Vide si la frame part vers l'encodeur
+    Image input;
+    Image output;
+    float time;
+    bool isDone;
+} BatchItem;
+
+typedef struct {
+    BatchRenderer* renderer;
+    const BatchOptions* options;
+    BatchItem* items;
+    atomic_int failedCount;
+} BatchWork;
+
+// Décodage d'une vidéo par ffmpeg, lu dans un thread pendant le rendu des frames précédentes
+typedef struct {
+    FILE* decoder;
+    BatchItem* items;
+    int capacity;
+    int count;                    // Frames lues par le dernier appel
+    size_t frameBytes;            // Frame I420 dans le pipe
+    unsigned char* yuvFrame;
+    YuvColorSpace colorSpace;
+} VideoReader;
+
+static bool ApplyCpuSharpen(Image source, Image* output, const EffectParams* params) {
+    return CpuApplySharpenEffect(source, output, params->mousePos, params->radius);
+}
+
+static bool ApplyCpuBlur(Image source, Image* output, const EffectParams* params) {
+    return CpuApplyBlurEffect(source, output, params->mousePos, params->radius, params->time);
+}
+
+static const CpuEffect gCpuEffects[] = {
+    { "effect.glsl", ApplyCpuSharpen, true },
+    { "effect2.glsl", ApplyCpuBlur, false },  // Flou approché (voir cpu_blur.h) : --engine cpu seulement
+};
+
+static double GetBatchTime(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Comparaison d'extension sans IsFileExtension (tampons statiques de raylib, pas sûr entre threads)
+static bool HasExtension(const char* path, const char* const* extensions, int count) {
+    const char* dot = strrchr(path, '.');
+    if (dot == NULL || strchr(dot, '/') != NULL || strchr(dot, '\\') != NULL) return false;
+    for (int i = 0; i < count; i++) {
+        const char* a = dot;
+        const char* b = extensions[i];
+        while (*a && *b && tolower((unsigned char)*a) == *b) { a++; b++; }
+        if (*a == '\0' && *b == '\0') return true;
+    }
+    return false;
+}
+
+static bool IsImagePath(const char* path) {
+    static const char* const extensions[] = { ".png", ".jpg", ".jpeg", ".bmp", ".tga", ".gif", ".hdr", ".pic", ".psd" };
+    return HasExtension(path, extensions, sizeof(extensions) / sizeof(extensions[0]));
+}
+
+static bool IsVideoPath(const char* path) {
+    static const char* const extensions[] = { ".mp4", ".mov", ".mkv", ".webm", ".avi" };
+    return HasExtension(path, extensions, sizeof(extensions) / sizeof(extensions[0]));
+}
+
+// Fonction pour vérifier un motif de frames utilisé comme format de snprintf : exactement
+// une conversion %d ou %0Nd (N sur 1 ou 2 chiffres), %% pour un signe pour cent
+static bool IsFramePattern(const char* pattern) {
+    int conversions = 0;
+    for (const char* c = pattern; *c != '\0'; c++) {
+        if (*c != '%') continue;
+        c++;
+        if (*c == '%') continue;
+        if (*c == '0') {
+            c++;
+            int digits = 0;
+            while (isdigit((unsigned char)*c) && digits < 3) {
+                c++;
+                digits++;
+            }
+            if (digits == 0 || digits > 2) return false;
+        }
+        if (*c != 'd') return false;
+        conversions++;
+    }
+    return conversions == 1;
+}
+
+static void PrintBatchUsage(void) {
+    printf("Usage: main.exe --input <image|dossier|vidéo> --output <fichier|dossier|vidéo|motif%%06d.png>\n"
+           "                [--shader %s] [--mouse x,y] [--radius 50] [--power 1] [--time 0]\n"
+           "                [--engine auto|cpu|gpu|vm] [--threads n]\n", BATCH_DEFAULT_SHADER);
+}
+
+// Fonction pour lire les options (false si la ligne de commande est invalide)
+static bool ParseBatchOptions(int argc, char** argv, BatchOptions* options) {
+    memset(options, 0, sizeof(*options));
+    options->shaderPath = BATCH_DEFAULT_SHADER;
+    options->params.radius = 50.0f;
+    options->params.power = 1.0f;
+
+    for (int i = 1; i < argc; i++) {
+        const char* name = argv[i];
+        if (strcmp(name, "--help") == 0) return false;
+        if (i + 1 >= argc) {
+            printf("ERROR: Missing value for %s\n", name);
+            return false;
+        }
+        const char* value = argv[++i];
+        char* end = NULL;
+
+        if (strcmp(name, "--input") == 0) options->inputPath = value;
+        else if (strcmp(name, "--output") == 0) options->outputPath = value;
+        else if (strcmp(name, "--shader") == 0) options->shaderPath = value;
+        else if (strcmp(name, "--mouse") == 0) {
+            if (sscanf(value, "%f,%f", &options->params.mousePos.x, &options->params.mousePos.y) != 2) {
+                printf("ERROR: --mouse expects x,y in image pixels\n");
+                return false;
+            }
+            options->hasMouse = true;
+        }
+        else if (strcmp(name, "--radius") == 0) options->params.radius = strtof(value, &end);
+        else if (strcmp(name, "--power") == 0) options->params.power = strtof(value, &end);
+        else if (strcmp(name, "--time") == 0) options->params.time = strtof(value, &end);
+        else if (strcmp(name, "--threads") == 0) options->threadCount = (int)strtol(value, &end, 10);
+        else if (strcmp(name, "--engine") == 0) {
+            if (strcmp(value, "auto") == 0) options->engine = BATCH_ENGINE_AUTO;
+            else if (strcmp(value, "cpu") == 0) options->engine = BATCH_ENGINE_CPU;
+            else if (strcmp(value, "gpu") == 0) options->engine = BATCH_ENGINE_GPU;
+            else if (strcmp(value, "vm") == 0) options->engine = BATCH_ENGINE_VM;
+            else {
+                printf("ERROR: Unknown engine '%s'\n", value);
+                return false;
+            }
+        }
+        else {
+            printf("ERROR: Unknown option %s\n", name);
+            return false;
+        }
+        if (end != NULL && (end == value || *end != '\0')) {
+            printf("ERROR: Invalid number '%s' for %s\n", value, name);
+            return false;
+        }
+    }
+
+    if (options->inputPath == NULL || options->outputPath == NULL) {
+        printf("ERROR: --input and --output are required\n");
+        return false;
+    }
+    return true;
+}
+
+static const CpuEffect* FindCpuEffect(const char* shaderPath) {
+    const char* fileName = GetFileName(shaderPath);
+    for (size_t i = 0; i < sizeof(gCpuEffects) / sizeof(gCpuEffects[0]); i++) {
+        if (strcmp(fileName, gCpuEffects[i].fileName) == 0) return &gCpuEffects[i];
+    }
+    return NULL;
+}
+
+// Fonction pour compiler le shader pour le CPU
+static bool InitVmRenderer(BatchRenderer* renderer, const BatchOptions* options) {
+    char error[256] = {0};
+    if (!LoadCpuShaderGraph(options->shaderPath, &renderer->vmGraph, error, sizeof(error))) {
+        printf("ERROR: Failed to compile shader '%s' for the CPU: %s\n", options->shaderPath, error);
+        return false;
+    }
+    renderer->isVm = true;
+    printf("Engine: VM (%s, %d threads)\n", options->shaderPath, GetCpuFilterThreadCount());
+    return true;
+}
+
+// Fonction pour préparer le moteur : CPU si le shader en a une version CPU exacte (ou
+// approchée avec --engine cpu), sinon contexte GL caché et chargement du shader. Sans
+// contexte GL (ou avec --engine cpu sans version CPU), le shader est compilé pour le CPU.
+static bool InitBatchRenderer(BatchRenderer* renderer, const BatchOptions* options) {
+    memset(renderer, 0, sizeof(*renderer));
+    if (options->engine == BATCH_ENGINE_VM) return InitVmRenderer(renderer, options);
+
+    const CpuEffect* cpuEffect = FindCpuEffect(options->shaderPath);
+    if (options->engine == BATCH_ENGINE_CPU && cpuEffect == NULL) return InitVmRenderer(renderer, options);
+    if (cpuEffect != NULL && (options->engine == BATCH_ENGINE_CPU || (options->engine == BATCH_ENGINE_AUTO && cpuEffect->isExact))) {
+        renderer->cpuEffect = cpuEffect;
+        printf("Engine: CPU (%s, %d threads)\n", GetCpuSimdName(GetCpuFilterSimd()), GetCpuFilterThreadCount());
+        return true;
+    }
+
+    // Fenêtre jamais affichée : seul le contexte GL sert
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(64, 64, "shaderlab batch");
+    if (!IsWindowReady()) {
+        if (options->engine == BATCH_ENGINE_AUTO) {
+            printf("WARNING: No OpenGL context, running the shader on the CPU\n");
+            return InitVmRenderer(renderer, options);
+        }
+        printf("ERROR: Failed to create an OpenGL context (try LIBGL_ALWAYS_SOFTWARE=1 with Mesa)\n");
+        return false;
+    }
+    renderer->hasWindow = true;
+    InitShaderReload();
+
+    char error[256] = {0};
+    if (!LoadRenderGraphWithCache(options->shaderPath, &renderer->graph, error, sizeof(error))) {
+        printf("ERROR: Failed to load shader '%s': %s\n", options->shaderPath, error);
+        return false;
+    }
+    printf("Engine: GPU (%s)\n", options->shaderPath);
+    return true;
+}
+
+static void CloseBatchRenderer(BatchRenderer* renderer) {
+    if (renderer->isVm) UnloadCpuShaderGraph(&renderer->vmGraph);
+    if (!renderer->hasWindow) return;
+    if (renderer->sourceTexture.id != 0) UnloadTexture(renderer->sourceTexture);
+    if (renderer->target.id != 0) UnloadRenderTexture(renderer->target);
+    UnloadRenderGraph(&renderer->graph);
+    CloseShaderReload();
+    CloseWindow();
+}
+
+// Fonction pour rendre une image RGBA8 dans output (même taille et format)
+static bool RenderBatchImage(BatchRenderer* renderer, Image source, Image* output, const EffectParams* params) {
+    if (renderer->cpuEffect != NULL) return renderer->cpuEffect->apply(source, output, params);
+    if (renderer->isVm) return RenderCpuShaderGraph(&renderer->vmGraph, source, output, params);
+
+    // Texture et cible recréées seulement quand la taille change
+    if (renderer->sourceTexture.width != source.width || renderer->sourceTexture.height != source.height) {
+        if (renderer->sourceTexture.id != 0) UnloadTexture(renderer->sourceTexture);
+        if (renderer->target.id != 0) UnloadRenderTexture(renderer->target);
+        renderer->sourceTexture = LoadTextureFromImage(source);
+        renderer->target = LoadRenderTexture(source.width, source.height);
+    } else {
+        UpdateTexture(renderer->sourceTexture, source.data);
+    }
+    if (renderer->sourceTexture.id == 0 || renderer->target.id == 0) return false;
+    if (!RenderGraphToTexture(&renderer->graph, renderer->sourceTexture, &renderer->target, params)) return false;
+
+    Image result = LoadImageFromTexture(renderer->target.texture);
+    if (result.data == NULL) return false;
+    ImageFlipVertical(&result);
+    ImageFormat(&result, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    bool isValid = result.width == output->width && result.height == output->height;
+    if (isValid) memcpy(output->data, result.data, (size_t)output->width * output->height * 4);
+    UnloadImage(result);
+    return isValid;
+}
+
+// Fonction pour écrire un PNG depuis un thread (ExportImage passe par les tampons
+// statiques de raylib ; l'encodage en mémoire n'y touche pas)
+static bool WritePngFile(Image image, const char* path) {
+    int size = 0;
+    unsigned char* data = ExportImageToMemory(image, ".png", &size);
+    if (data == NULL) return false;
+    bool isSaved = SaveFileData(path, data, size);
+    MemFree(data);
+    return isSaved;
+}
+
+// Fonction pour rendre un élément (chargé depuis son fichier s'il en a un)
+static bool RenderBatchItem(BatchWork* work, BatchItem* item) {
+    if (item->inputPath[0] != '\0') {
+        item->input = LoadImage(item->inputPath);
+        if (item->input.data == NULL) return false;
+        ImageFormat(&item->input, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        item->output = ImageCopy(item->input);
+    }
+    if (item->input.data == NULL || item->output.data == NULL) return false;
+
+    EffectParams params = work->options->params;
+    params.time = item->time;
+    if (!work->options->hasMouse) params.mousePos = (Vector2){ item->input.width / 2.0f, item->input.height / 2.0f };
+    if (!RenderBatchImage(work->renderer, item->input, &item->output, &params)) return false;
+
+    return item->outputPath[0] == '\0' || WritePngFile(item->output, item->outputPath);
+}
+
+static void RenderBatchItems(void* context, int start, int end) {
+    BatchWork* work = (BatchWork*)context;
+    for (int i = start; i < end; i++) {
+        BatchItem* item = &work->items[i];
+        item->isDone = RenderBatchItem(work, item);
+        if (!item->isDone) {
+            atomic_fetch_add(&work->failedCount, 1);
+            printf("ERROR: Failed to render %s\n", item->inputPath[0] ? item->inputPath : "frame");
+        }
+        // Les images chargées depuis un fichier ne servent plus
+        if (item->inputPath[0] != '\0') {
+            UnloadImage(item->input);
+            UnloadImage(item->output);
+            item->input = item->output = (Image){0};
+        }
+    }
+}
+
+// Un élément par tâche avec les moteurs CPU (les bandes de chaque filtre vont aux threads
+// libres en fin de paquet), dans l'ordre sur le thread principal avec le moteur GPU
+static void RunBatchItems(BatchWork* work, int count) {
+    if (work->renderer->cpuEffect != NULL || work->renderer->isVm) RunCpuRowTasks(count, 1, RenderBatchItems, work);
+    else RenderBatchItems(work, 0, count);
+}
+
+static int ProcessImageFile(BatchRenderer* renderer, const BatchOptions* options) {
+    Image input = LoadImage(options->inputPath);
+    if (input.data == NULL) {
+        printf("ERROR: Failed to load image '%s'\n", options->inputPath);
+        return 1;
+    }
+    ImageFormat(&input, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    Image output = ImageCopy(input);
+
+    EffectParams params = options->params;
+    if (!options->hasMouse) params.mousePos = (Vector2){ input.width / 2.0f, input.height / 2.0f };
+    bool isRendered = RenderBatchImage(renderer, input, &output, &params);
+    // Sur le thread principal : ExportImage accepte tous les formats de raylib
+    bool isSaved = isRendered && ExportImage(output, options->outputPath);
+    UnloadImage(input);
+    UnloadImage(output);
+
+    if (!isSaved) {
+        printf("ERROR: Failed to %s '%s'\n", isRendered ? "write" : "render", isRendered ? options->outputPath : options->inputPath);
+        return 1;
+    }
+    printf("Wrote %s\n", options->outputPath);
+    return 0;
+}
+
+// Fonction pour traiter toutes les images d'un dossier (sorties PNG de même nom)
+static int ProcessImageDirectory(BatchRenderer* renderer, const BatchOptions* options) {
+    if (!DirectoryExists(options->outputPath) && MakeDirectory(options->outputPath) != 0) {
+        printf("ERROR: Failed to create output directory '%s'\n", options->outputPath);
+        return 1;
+    }
+
+    FilePathList files = LoadDirectoryFiles(options->inputPath);
+    BatchItem* items = (BatchItem*)calloc(files.count > 0 ? files.count : 1, sizeof(BatchItem));
+    if (items == NULL) {
+        UnloadDirectoryFiles(files);
+        return 1;
+    }
+
+    int count = 0;
+    for (unsigned int i = 0; i < files.count; i++) {
+        if (!IsPathFile(files.paths[i]) || !IsImagePath(files.paths[i])) continue;
+        BatchItem* item = &items[count++];
+        snprintf(item->inputPath, sizeof(item->inputPath), "%s", files.paths[i]);
+        // Nom du fichier sans extension (GetFileNameWithoutExt n'est pas réentrante, calcul fait ici de toute façon)
+        const char* fileName = GetFileName(files.paths[i]);
+        const char* dot = strrchr(fileName, '.');
+        int nameLength = dot ? (int)(dot - fileName) : (int)strlen(fileName);
+        snprintf(item->outputPath, sizeof(item->outputPath), "%s/%.*s.png", options->outputPath, nameLength, fileName);
+        item->time = options->params.time;
+    }
+    UnloadDirectoryFiles(files);
+
+    BatchWork work = { .renderer = renderer, .options = options, .items = items };
+    double start = GetBatchTime();
+    RunBatchItems(&work, count);
+    double elapsed = GetBatchTime() - start;
+
+    int failed = atomic_load(&work.failedCount);
+    printf("Rendered %d/%d images in %.2f s (%.1f images/s)\n", count - failed, count, elapsed,
+           elapsed > 0.0 ? (count - failed) / elapsed : 0.0);
+    free(items);
+    return failed == 0 && count > 0 ? 0 : 1;
+}
+
+static void* ReadVideoFrames(void* arg) {
+    VideoReader* reader = (VideoReader*)arg;
+    reader->count = 0;
+    while (reader->count < reader->capacity && fread(reader->yuvFrame, 1, reader->frameBytes, reader->decoder) == reader->frameBytes) {
+        Image* input = &reader->items[reader->count].input;
+        YuvImage image = GetPackedYuvImage(reader->yuvFrame, input->width, input->height, YUV_LAYOUT_I420);
+        ConvertYuvToRgba(&image, reader->colorSpace, (unsigned char*)input->data);
+        reader->count++;
+    }
+    return NULL;
+}
+
+static bool AllocateVideoItems(BatchItem* items, int count, int width, int height) {
+    for (int i = 0; i < count; i++) {
+        items[i].input = GenImageColor(width, height, BLANK);
+        if (items[i].input.data == NULL) return false;
+    }
+    return true;
+}
+
+static void FreeVideoItems(BatchItem* items, int count) {
+    for (int i = 0; i < count; i++) {
+        if (items[i].input.data != NULL) UnloadImage(items[i].input);
+    }
+}
+
+// Fonction pour traiter une vidéo : ffmpeg décode vers un pipe, les frames sont rendues
+// par paquets (une par cœur) pendant que le paquet suivant est lu, puis envoyées dans
+// l'ordre à l'encodeur ou écrites en PNG
+static int ProcessVideo(BatchRenderer* renderer, const BatchOptions* options) {
+    int width = 0, height = 0;
+    float fps = 30.0f;
+    YuvColorSpace colorSpace = { 0 };
+    if (!ProbeVideoFile(options->inputPath, &width, &height, &fps, &colorSpace)) {
+        printf("ERROR: ffprobe could not read '%s'\n", options->inputPath);
+        return 1;
+    }
+
+    bool isVideoOutput = IsVideoPath(options->outputPath);
+    static const char* const pngExtension[] = { ".png" };
+    if (!isVideoOutput && (!IsFramePattern(options->outputPath) || !HasExtension(options->outputPath, pngExtension, 1))) {
+        printf("ERROR: Video output must be a video file or a PNG pattern with one %%d or %%0Nd, such as frames/out_%%06d.png\n");
+        PrintBatchUsage();
+        return 1;
+    }
+
+    // Paquets d'une frame par thread (quelques frames pour le GPU, juste pour recouvrir le décodage)
+    int chunkFrames = renderer->cpuEffect != NULL || renderer->isVm ? GetCpuFilterThreadCount() : 4;
+    BatchItem* chunks[2] = { (BatchItem*)calloc(chunkFrames, sizeof(BatchItem)), (BatchItem*)calloc(chunkFrames, sizeof(BatchItem)) };
+    unsigned char* yuvFrame = (unsigned char*)malloc(GetYuvFrameSize(width, height));
+    bool isAllocated = chunks[0] && chunks[1] && yuvFrame && AllocateVideoItems(chunks[0], chunkFrames, width, height) &&
+                       AllocateVideoItems(chunks[1], chunkFrames, width, height);
+
+    FILE* decoder = isAllocated ? OpenVideoDecoder(options->inputPath, colorSpace) : NULL;
+    FILE* encoder = decoder != NULL && isVideoOutput ? OpenVideoEncoder(options->outputPath, width, height, fps) : NULL;
+    if (decoder == NULL || (isVideoOutput && encoder == NULL)) {
+        printf("ERROR: Failed to start ffmpeg for '%s'\n", options->inputPath);
+        if (decoder) pclose(decoder);
+        if (chunks[0]) FreeVideoItems(chunks[0], chunkFrames);
+        if (chunks[1]) FreeVideoItems(chunks[1], chunkFrames);
+        free(chunks[0]);
+        free(chunks[1]);
+        free(yuvFrame);
+        return 1;
+    }
+
+    printf("Video: %dx%d at %.2f fps, %d frames per batch\n", width, height, fps, chunkFrames);
+    size_t frameBytes = (size_t)width * height * 4;
+    VideoReader reader = { .decoder = decoder, .items = chunks[0], .capacity = chunkFrames,
+                           .frameBytes = GetYuvFrameSize(width, height), .yuvFrame = yuvFrame, .colorSpace = colorSpace };
+    ReadVideoFrames(&reader);
+
+    BatchWork work = { .renderer = renderer, .options = options };
+    int frameIndex = 0;
+    int current = 0;
+    bool isWriteFailed = false;
+    double start = GetBatchTime();
+    while (reader.count > 0 && !isWriteFailed) {
+        BatchItem* items = chunks[current];
+        int count = reader.count;
+
+        // Le paquet suivant est décodé pendant le rendu de celui-ci
+        reader.items = chunks[1 - current];
+        pthread_t readThread;
+        bool isReading = pthread_create(&readThread, NULL, ReadVideoFrames, &reader) == 0;
+
+        // Sorties allouées au premier paquet puis réutilisées
+        for (int i = 0; i < count; i++) {
+            items[i].time = options->params.time + (float)(frameIndex + i) / fps;
+            items[i].isDone = false;
+            if (!isVideoOutput) snprintf(items[i].outputPath, sizeof(items[i].outputPath), options->outputPath, frameIndex + i + 1);
+            if (items[i].output.data == NULL) items[i].output = ImageCopy(items[i].input);
+        }
+        work.items = items;
+        RunBatchItems(&work, count);
+
+        for (int i = 0; i < count && encoder != NULL; i++) {
+            // Frame en échec : l'originale, pour garder la durée de la vidéo
+            const Image* frame = items[i].isDone ? &items[i].output : &items[i].input;
+            if (fwrite(frame->data, 1, frameBytes, encoder) != frameBytes) {
+                printf("ERROR: ffmpeg encoder stopped accepting frames\n");
+                isWriteFailed = true;
+                break;
+            }
+        }
+        frameIndex += count;
+        if (frameIndex / BATCH_PROGRESS_INTERVAL != (frameIndex - count) / BATCH_PROGRESS_INTERVAL) {
+            double elapsed = GetBatchTime() - start;
+            printf("Progress: %d frames (%.1f fps)\n", frameIndex, elapsed > 0.0 ? frameIndex / elapsed : 0.0);
+        }
+
+        if (isReading) pthread_join(readThread, NULL);
+        else ReadVideoFrames(&reader);
+        current = 1 - current;
+    }
+    double elapsed = GetBatchTime() - start;
+
+    pclose(decoder);
+    int encoderStatus = encoder != NULL ? pclose(encoder) : 0;
+    for (int c = 0; c < 2; c++) {
+        for (int i = 0; i < chunkFrames; i++) {
+            if (chunks[c][i].output.data != NULL) UnloadImage(chunks[c][i].output);
+        }
+        FreeVideoItems(chunks[c], chunkFrames);
+        free(chunks[c]);
+    }
+    free(yuvFrame);
+
+    int failed = atomic_load(&work.failedCount);
+    printf("Rendered %d frames in %.2f s (%.1f fps), %d failed\n", frameIndex, elapsed,
+           elapsed > 0.0 ? frameIndex / elapsed : 0.0, failed);
+    if (encoderStatus != 0) printf("ERROR: ffmpeg encoder exited with status %d\n", encoderStatus);
+    return frameIndex > 0 && failed == 0 && !isWriteFailed && encoderStatus == 0 ? 0 : 1;
+}
+
+bool IsBatchCommandLine(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--", 2) == 0) return true;
+    }
+    return false;
+}
+
+int RunBatchRender(int argc, char** argv) {
+    BatchOptions options;
+    if (!ParseBatchOptions(argc, argv, &options)) {
+        PrintBatchUsage();
+        return 1;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+    if (options.threadCount > 0) SetCpuFilterThreadCount(options.threadCount);
+
+    BatchRenderer renderer;
+    if (!InitBatchRenderer(&renderer, &options)) {
+        CloseBatchRenderer(&renderer);
+        return 1;
+    }
+
+    int status;
+    if (DirectoryExists(options.inputPath)) status = ProcessImageDirectory(&renderer, &options);
+    else if (IsImagePath(options.inputPath)) status = ProcessImageFile(&renderer, &options);
+    else status = ProcessVideo(&renderer, &options);
+
+    CloseBatchRenderer(&renderer);
+    return status;
+}
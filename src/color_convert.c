@@ -0,0 +1,276 @@
+#include "color_convert.h"
+#include "cpu_filter.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define COLOR_CONVERT_X86 1
+#include <immintrin.h> // Fonctions SSE4.1/AVX2 compilées avec target(...), choisies à l'exécution
+#endif
+
+#define YUV_BAND_ROWS 32         // Lignes par tâche
+#define YUV_FIXED_BITS 16
+
+typedef enum {
+    YUV_KERNEL_SCALAR,
+    YUV_KERNEL_SSE41,
+    YUV_KERNEL_AVX2
+} YuvKernel;
+
+// Coefficients en virgule fixe :
+//   R = (luma*Y + vr*V' + bias) >> 16
+//   G = (luma*Y - ug*U' - vg*V' + bias) >> 16
+//   B = (luma*Y + ub*U' + bias) >> 16
+// avec U' = U-128, V' = V-128 et bias = arrondi - luma*noir. Les sommes tiennent dans
+// 32 bits et leur résultat dans [-300, 600] : la saturation 16 puis 8 bits des SIMD
+// donne le même clamp que le scalaire.
+typedef struct {
+    int luma;
+    int bias;
+    int vr;
+    int ug;
+    int vg;
+    int ub;
+} YuvCoefs;
+
+typedef struct {
+    const YuvImage* image;
+    YuvColorSpace colorSpace;
+    unsigned char* rgba;
+} YuvJob;
+
+static int ToFixed(double value) {
+    return (int)floor(value * (1 << YUV_FIXED_BITS) + 0.5);
+}
+
+static YuvCoefs GetYuvCoefs(YuvColorSpace colorSpace) {
+    double kr = colorSpace.matrix == YUV_MATRIX_BT709 ? 0.2126 : 0.299;
+    double kb = colorSpace.matrix == YUV_MATRIX_BT709 ? 0.0722 : 0.114;
+    double kg = 1.0 - kr - kb;
+    bool isFull = colorSpace.range == YUV_RANGE_FULL;
+    double lumaScale = isFull ? 1.0 : 255.0 / 219.0;
+    double chromaScale = isFull ? 1.0 : 255.0 / 224.0;
+    int black = isFull ? 0 : 16;
+
+    YuvCoefs k;
+    k.luma = ToFixed(lumaScale);
+    k.bias = (1 << (YUV_FIXED_BITS - 1)) - k.luma * black;
+    k.vr = ToFixed(2.0 * (1.0 - kr) * chromaScale);
+    k.ug = ToFixed(2.0 * (1.0 - kb) * kb / kg * chromaScale);
+    k.vg = ToFixed(2.0 * (1.0 - kr) * kr / kg * chromaScale);
+    k.ub = ToFixed(2.0 * (1.0 - kb) * chromaScale);
+    return k;
+}
+
+static YuvKernel SelectYuvKernel(void) {
+    CpuSimdLevel simd = GetCpuFilterSimd();
+    #if defined(COLOR_CONVERT_X86)
+    if (simd == CPU_SIMD_AVX2) return YUV_KERNEL_AVX2;
+    if (simd == CPU_SIMD_SSE2 && __builtin_cpu_supports("sse4.1")) return YUV_KERNEL_SSE41;
+    #else
+    (void)simd;
+    #endif
+    return YUV_KERNEL_SCALAR;
+}
+
+const char* GetYuvKernelName(void) {
+    switch (SelectYuvKernel()) {
+        case YUV_KERNEL_AVX2: return "AVX2";
+        case YUV_KERNEL_SSE41: return "SSE4.1";
+        default: return "scalar";
+    }
+}
+
+size_t GetYuvFrameSize(int width, int height) {
+    size_t chroma = (size_t)((width + 1) / 2) * ((height + 1) / 2);
+    return (size_t)width * height + 2 * chroma;
+}
+
+YuvImage GetPackedYuvImage(const unsigned char* data, int width, int height, YuvLayout layout) {
+    int chromaWidth = (width + 1) / 2;
+    YuvImage image = { .width = width, .height = height, .layout = layout, .y = data, .yStride = width };
+    image.u = data + (size_t)width * height;
+    if (layout == YUV_LAYOUT_NV12) {
+        image.uvStride = 2 * chromaWidth;
+        image.v = NULL;
+    } else {
+        image.uvStride = chromaWidth;
+        image.v = image.u + (size_t)chromaWidth * ((height + 1) / 2);
+    }
+    return image;
+}
+
+static inline unsigned char ClampYuvChannel(int value) {
+    value >>= YUV_FIXED_BITS;
+    return (unsigned char)(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+// Pixels [start, end) d'une ligne ; start pair pour les noyaux SIMD (chroma alignée)
+static void ConvertSpanScalar(const unsigned char* y, const unsigned char* u, const unsigned char* v, int uvStep,
+                              unsigned char* out, int start, int end, const YuvCoefs* k) {
+    for (int x = start; x < end; x++) {
+        int j = (x >> 1) * uvStep;
+        int cu = u[j] - 128;
+        int cv = v[j] - 128;
+        int luma = k->luma * y[x] + k->bias;
+        out[4 * x + 0] = ClampYuvChannel(luma + k->vr * cv);
+        out[4 * x + 1] = ClampYuvChannel(luma - k->ug * cu - k->vg * cv);
+        out[4 * x + 2] = ClampYuvChannel(luma + k->ub * cu);
+        out[4 * x + 3] = 255;
+    }
+}
+
+#if defined(COLOR_CONVERT_X86)
+// 4 pixels RGBA à partir de la luma pondérée et des termes de chroma (déjà dupliqués) :
+// packus 32 -> 16 -> 8 bits donne r0-3 g0-3 b0-3 a0-3, remis dans l'ordre par pshufb
+__attribute__((target("sse4.1")))
+static inline __m128i PackYuvPixelsSSE41(__m128i luma, __m128i r, __m128i g, __m128i b) {
+    const __m128i alpha = _mm_set1_epi32(255);
+    const __m128i order = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    r = _mm_srai_epi32(_mm_add_epi32(luma, r), YUV_FIXED_BITS);
+    g = _mm_srai_epi32(_mm_add_epi32(luma, g), YUV_FIXED_BITS);
+    b = _mm_srai_epi32(_mm_add_epi32(luma, b), YUV_FIXED_BITS);
+    __m128i planar = _mm_packus_epi16(_mm_packus_epi32(r, g), _mm_packus_epi32(b, alpha));
+    return _mm_shuffle_epi8(planar, order);
+}
+
+// 8 pixels (4 échantillons de chroma) par itération, en 32 bits
+__attribute__((target("sse4.1")))
+static void ConvertSpanSSE41(const unsigned char* y, const unsigned char* u, const unsigned char* v, int uvStep,
+                             unsigned char* out, int width, const YuvCoefs* k) {
+    const __m128i offset = _mm_set1_epi32(128);
+    const __m128i lowByte = _mm_set1_epi32(0xFF);
+    const __m128i luma = _mm_set1_epi32(k->luma);
+    const __m128i bias = _mm_set1_epi32(k->bias);
+    const __m128i vr = _mm_set1_epi32(k->vr);
+    const __m128i ug = _mm_set1_epi32(k->ug);
+    const __m128i vg = _mm_set1_epi32(k->vg);
+    const __m128i ub = _mm_set1_epi32(k->ub);
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        __m128i cu, cv;
+        if (uvStep == 2) {
+            // Paires UV lues en 16 bits : U dans l'octet bas, V dans l'octet haut
+            __m128i uv = _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)(u + x)));
+            cu = _mm_and_si128(uv, lowByte);
+            cv = _mm_srli_epi32(uv, 8);
+        } else {
+            int packedU, packedV;
+            memcpy(&packedU, u + x / 2, 4);
+            memcpy(&packedV, v + x / 2, 4);
+            cu = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packedU));
+            cv = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packedV));
+        }
+        cu = _mm_sub_epi32(cu, offset);
+        cv = _mm_sub_epi32(cv, offset);
+        __m128i r = _mm_add_epi32(_mm_mullo_epi32(cv, vr), bias);
+        __m128i g = _mm_sub_epi32(_mm_sub_epi32(bias, _mm_mullo_epi32(cu, ug)), _mm_mullo_epi32(cv, vg));
+        __m128i b = _mm_add_epi32(_mm_mullo_epi32(cu, ub), bias);
+
+        __m128i bytes = _mm_loadl_epi64((const __m128i*)(y + x));
+        __m128i low = _mm_mullo_epi32(_mm_cvtepu8_epi32(bytes), luma);
+        __m128i high = _mm_mullo_epi32(_mm_cvtepu8_epi32(_mm_srli_si128(bytes, 4)), luma);
+        _mm_storeu_si128((__m128i*)(out + 4 * x),
+                         PackYuvPixelsSSE41(low, _mm_shuffle_epi32(r, 0x50), _mm_shuffle_epi32(g, 0x50), _mm_shuffle_epi32(b, 0x50)));
+        _mm_storeu_si128((__m128i*)(out + 4 * x + 16),
+                         PackYuvPixelsSSE41(high, _mm_shuffle_epi32(r, 0xFA), _mm_shuffle_epi32(g, 0xFA), _mm_shuffle_epi32(b, 0xFA)));
+    }
+    ConvertSpanScalar(y, u, v, uvStep, out, x, width, k);
+}
+
+// Même chose sur 8 pixels : pack et pshufb travaillent par moitié de 128 bits, ce qui
+// donne les pixels 0-3 dans la moitié basse et 4-7 dans la haute
+__attribute__((target("avx2")))
+static inline __m256i PackYuvPixelsAVX2(__m256i luma, __m256i r, __m256i g, __m256i b) {
+    const __m256i alpha = _mm256_set1_epi32(255);
+    const __m256i order = _mm256_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15,
+                                           0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    r = _mm256_srai_epi32(_mm256_add_epi32(luma, r), YUV_FIXED_BITS);
+    g = _mm256_srai_epi32(_mm256_add_epi32(luma, g), YUV_FIXED_BITS);
+    b = _mm256_srai_epi32(_mm256_add_epi32(luma, b), YUV_FIXED_BITS);
+    __m256i planar = _mm256_packus_epi16(_mm256_packus_epi32(r, g), _mm256_packus_epi32(b, alpha));
+    return _mm256_shuffle_epi8(planar, order);
+}
+
+// 16 pixels (8 échantillons de chroma) par itération
+__attribute__((target("avx2")))
+static void ConvertSpanAVX2(const unsigned char* y, const unsigned char* u, const unsigned char* v, int uvStep,
+                            unsigned char* out, int width, const YuvCoefs* k) {
+    const __m256i offset = _mm256_set1_epi32(128);
+    const __m256i lowByte = _mm256_set1_epi32(0xFF);
+    const __m256i luma = _mm256_set1_epi32(k->luma);
+    const __m256i bias = _mm256_set1_epi32(k->bias);
+    const __m256i vr = _mm256_set1_epi32(k->vr);
+    const __m256i ug = _mm256_set1_epi32(k->ug);
+    const __m256i vg = _mm256_set1_epi32(k->vg);
+    const __m256i ub = _mm256_set1_epi32(k->ub);
+    const __m256i firstHalf = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+    const __m256i secondHalf = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m256i cu, cv;
+        if (uvStep == 2) {
+            __m256i uv = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(u + x)));
+            cu = _mm256_and_si256(uv, lowByte);
+            cv = _mm256_srli_epi32(uv, 8);
+        } else {
+            cu = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(u + x / 2)));
+            cv = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(v + x / 2)));
+        }
+        cu = _mm256_sub_epi32(cu, offset);
+        cv = _mm256_sub_epi32(cv, offset);
+        __m256i r = _mm256_add_epi32(_mm256_mullo_epi32(cv, vr), bias);
+        __m256i g = _mm256_sub_epi32(_mm256_sub_epi32(bias, _mm256_mullo_epi32(cu, ug)), _mm256_mullo_epi32(cv, vg));
+        __m256i b = _mm256_add_epi32(_mm256_mullo_epi32(cu, ub), bias);
+
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(y + x));
+        __m256i low = _mm256_mullo_epi32(_mm256_cvtepu8_epi32(bytes), luma);
+        __m256i high = _mm256_mullo_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(bytes, 8)), luma);
+        _mm256_storeu_si256((__m256i*)(out + 4 * x),
+                            PackYuvPixelsAVX2(low, _mm256_permutevar8x32_epi32(r, firstHalf),
+                                              _mm256_permutevar8x32_epi32(g, firstHalf), _mm256_permutevar8x32_epi32(b, firstHalf)));
+        _mm256_storeu_si256((__m256i*)(out + 4 * x + 32),
+                            PackYuvPixelsAVX2(high, _mm256_permutevar8x32_epi32(r, secondHalf),
+                                              _mm256_permutevar8x32_epi32(g, secondHalf), _mm256_permutevar8x32_epi32(b, secondHalf)));
+    }
+    ConvertSpanSSE41(y + x, u + x / 2 * uvStep, v + x / 2 * uvStep, uvStep, out + 4 * x, width - x, k);
+}
+#endif
+
+static void ConvertSpan(YuvKernel kernel, const unsigned char* y, const unsigned char* u, const unsigned char* v, int uvStep,
+                        unsigned char* out, int width, const YuvCoefs* k) {
+    switch (kernel) {
+        #if defined(COLOR_CONVERT_X86)
+        case YUV_KERNEL_AVX2: ConvertSpanAVX2(y, u, v, uvStep, out, width, k); break;
+        case YUV_KERNEL_SSE41: ConvertSpanSSE41(y, u, v, uvStep, out, width, k); break;
+        #endif
+        default: ConvertSpanScalar(y, u, v, uvStep, out, 0, width, k); break;
+    }
+}
+
+static void ConvertYuvRows(const YuvImage* image, const YuvCoefs* k, YuvKernel kernel, unsigned char* rgba, int rowStart, int rowEnd) {
+    int uvStep = image->layout == YUV_LAYOUT_NV12 ? 2 : 1;
+    for (int row = rowStart; row < rowEnd; row++) {
+        const unsigned char* y = image->y + (size_t)row * image->yStride;
+        const unsigned char* u = image->u + (size_t)(row / 2) * image->uvStride;
+        // NV12 : V suit U dans chaque paire
+        const unsigned char* v = uvStep == 2 ? u + 1 : image->v + (size_t)(row / 2) * image->uvStride;
+        ConvertSpan(kernel, y, u, v, uvStep, rgba + (size_t)row * image->width * 4, image->width, k);
+    }
+}
+
+void ConvertYuvRowsToRgba(const YuvImage* image, YuvColorSpace colorSpace, unsigned char* rgba, int rowStart, int rowEnd) {
+    YuvCoefs k = GetYuvCoefs(colorSpace);
+    ConvertYuvRows(image, &k, SelectYuvKernel(), rgba, rowStart, rowEnd);
+}
+
+static void ConvertYuvBand(void* context, int rowStart, int rowEnd) {
+    YuvJob* job = (YuvJob*)context;
+    ConvertYuvRowsToRgba(job->image, job->colorSpace, job->rgba, rowStart, rowEnd);
+}
+
+void ConvertYuvToRgba(const YuvImage* image, YuvColorSpace colorSpace, unsigned char* rgba) {
+    if (image->width <= 0 || image->height <= 0) return;
+    YuvJob job = { .image = image, .colorSpace = colorSpace, .rgba = rgba };
+    RunCpuRowTasks(image->height, YUV_BAND_ROWS, ConvertYuvBand, &job);
+}
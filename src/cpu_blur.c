@@ -0,0 +1,763 @@
+#include "cpu_blur.h"
+#include "cpu_filter.h"
+#include "logger.h"
+#include <math.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CPU_BLUR_X86 1
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CPU_BLUR_NEON 1
+#include <arm_neon.h>
+#endif
+
+#define BLUR_BAND_ROWS 16
+#define RECURSIVE_STRIPE_PIXELS 16       // Colonnes traitées ensemble par la passe verticale récursive
+#define RECURSIVE_ROW_GROUP 16           // Lignes entrelacées par la passe horizontale récursive
+#define RECURSIVE_MIN_RADIUS 16.0f       // En dessous, la version séparable est exacte et aussi rapide
+
+// Poids 1D normalisés d'un axe : le pixel x reçoit sum(weights[t] * in[x + first + t]) (bouclé)
+typedef struct {
+    float* weights;
+    int taps;
+    int first;
+} BlurTaps;
+
+// Coefficients de Young-van Vliet : y = B*x + a1*y[-1] + a2*y[-2] + a3*y[-3]
+typedef struct {
+    float b;
+    float a1, a2, a3;
+    int warmup;           // Échantillons bouclés parcourus avant le bord pour amorcer le filtre
+} RecursiveCoefs;
+
+typedef struct {
+    const unsigned char* source;
+    unsigned char* output;
+    int width;
+    int height;
+    CpuSimdLevel simd;
+    atomic_bool failed;   // Allocation refusée dans un thread
+    // Référence
+    float* weights2D;     // (2R+1)² poids, x puis y comme les boucles du shader
+    int blurRadius;
+    // Séparable
+    BlurTaps horizontal;
+    BlurTaps vertical;
+    // Récursif
+    RecursiveCoefs horizontalCoefs;
+    RecursiveCoefs verticalCoefs;
+} BlurJob;
+
+const char* GetCpuBlurModeName(CpuBlurMode mode) {
+    switch (mode) {
+        case CPU_BLUR_REFERENCE: return "référence";
+        case CPU_BLUR_SEPARABLE: return "séparable";
+        case CPU_BLUR_RECURSIVE: return "récursif";
+        default: return "inconnu";
+    }
+}
+
+static inline int WrapIndex(int index, int size) {
+    index %= size;
+    return index < 0 ? index + size : index;
+}
+
+static inline unsigned char RoundToByte(float value) {
+    // Arrondi au plus proche comme la conversion float -> unorm8 du framebuffer
+    int rounded = (int)(value + 0.5f);
+    return (unsigned char)(rounded < 0 ? 0 : (rounded > 255 ? 255 : rounded));
+}
+
+//------------------------------------------------------------------------------------
+// Noyaux vectorisés (count est un multiple de 4). Tous les chemins font les mêmes
+// opérations dans le même ordre : le résultat ne dépend pas du jeu d'instructions.
+//------------------------------------------------------------------------------------
+
+// acc[i] += weight * src[i]
+static void AccumulateBytesScalar(float* acc, const unsigned char* src, float weight, int start, int count) {
+    for (int i = start; i < count; i++) acc[i] += weight * (float)src[i];
+}
+
+// dst[i] = arrondi de src[i] sur 8 bits
+static void StoreBytesScalar(unsigned char* dst, const float* src, int start, int count) {
+    for (int i = start; i < count; i++) dst[i] = RoundToByte(src[i]);
+}
+
+// out[j] = sum(weights[t] * in[j + t*step])
+static void ConvolveScalar(float* out, const float* in, const float* weights, int taps, int step, int start, int count) {
+    for (int j = start; j < count; j++) {
+        float sum = 0.0f;
+        for (int t = 0; t < taps; t++) sum += weights[t] * in[j + t * step];
+        out[j] = sum;
+    }
+}
+
+// x = B*x + a1*p1 + a2*p2 + a3*p3
+static void RecursiveStepScalar(float* x, const float* p1, const float* p2, const float* p3,
+                                const RecursiveCoefs* k, int start, int count) {
+    for (int i = start; i < count; i++) {
+        float value = k->b * x[i];
+        value += k->a1 * p1[i];
+        value += k->a2 * p2[i];
+        value += k->a3 * p3[i];
+        x[i] = value;
+    }
+}
+
+#if defined(CPU_BLUR_X86)
+__attribute__((target("sse2")))
+static void AccumulateBytesSSE2(float* acc, const unsigned char* src, float weight, int count) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 w = _mm_set1_ps(weight);
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i low = _mm_unpacklo_epi8(bytes, zero);
+        __m128i high = _mm_unpackhi_epi8(bytes, zero);
+        __m128i parts[4] = { _mm_unpacklo_epi16(low, zero), _mm_unpackhi_epi16(low, zero),
+                             _mm_unpacklo_epi16(high, zero), _mm_unpackhi_epi16(high, zero) };
+        for (int p = 0; p < 4; p++) {
+            __m128 value = _mm_cvtepi32_ps(parts[p]);
+            _mm_storeu_ps(acc + i + 4 * p, _mm_add_ps(_mm_loadu_ps(acc + i + 4 * p), _mm_mul_ps(w, value)));
+        }
+    }
+    AccumulateBytesScalar(acc, src, weight, i, count);
+}
+
+// Troncature de v + 0.5 puis saturation en deux étapes (int32 -> int16 -> uint8) : même
+// résultat que RoundToByte
+__attribute__((target("sse2")))
+static void StoreBytesSSE2(unsigned char* dst, const float* src, int count) {
+    const __m128 half = _mm_set1_ps(0.5f);
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i v0 = _mm_cvttps_epi32(_mm_add_ps(_mm_loadu_ps(src + i), half));
+        __m128i v1 = _mm_cvttps_epi32(_mm_add_ps(_mm_loadu_ps(src + i + 4), half));
+        __m128i v2 = _mm_cvttps_epi32(_mm_add_ps(_mm_loadu_ps(src + i + 8), half));
+        __m128i v3 = _mm_cvttps_epi32(_mm_add_ps(_mm_loadu_ps(src + i + 12), half));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3)));
+    }
+    StoreBytesScalar(dst, src, i, count);
+}
+
+__attribute__((target("sse2")))
+static void ConvolveSSE2(float* out, const float* in, const float* weights, int taps, int step, int count) {
+    int j = 0;
+    for (; j + 4 <= count; j += 4) {
+        __m128 sum = _mm_setzero_ps();
+        for (int t = 0; t < taps; t++) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[t]), _mm_loadu_ps(in + j + t * step)));
+        }
+        _mm_storeu_ps(out + j, sum);
+    }
+    ConvolveScalar(out, in, weights, taps, step, j, count);
+}
+
+__attribute__((target("sse2")))
+static void RecursiveStepSSE2(float* x, const float* p1, const float* p2, const float* p3, const RecursiveCoefs* k, int count) {
+    const __m128 b = _mm_set1_ps(k->b), a1 = _mm_set1_ps(k->a1), a2 = _mm_set1_ps(k->a2), a3 = _mm_set1_ps(k->a3);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 value = _mm_mul_ps(b, _mm_loadu_ps(x + i));
+        value = _mm_add_ps(value, _mm_mul_ps(a1, _mm_loadu_ps(p1 + i)));
+        value = _mm_add_ps(value, _mm_mul_ps(a2, _mm_loadu_ps(p2 + i)));
+        value = _mm_add_ps(value, _mm_mul_ps(a3, _mm_loadu_ps(p3 + i)));
+        _mm_storeu_ps(x + i, value);
+    }
+    RecursiveStepScalar(x, p1, p2, p3, k, i, count);
+}
+
+__attribute__((target("avx2")))
+static void AccumulateBytesAVX2(float* acc, const unsigned char* src, float weight, int count) {
+    const __m256 w = _mm256_set1_ps(weight);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 value = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + i))));
+        _mm256_storeu_ps(acc + i, _mm256_add_ps(_mm256_loadu_ps(acc + i), _mm256_mul_ps(w, value)));
+    }
+    AccumulateBytesScalar(acc, src, weight, i, count);
+}
+
+__attribute__((target("avx2")))
+static void ConvolveAVX2(float* out, const float* in, const float* weights, int taps, int step, int count) {
+    int j = 0;
+    // Deux accumulateurs indépendants par itération pour masquer la latence des additions
+    for (; j + 16 <= count; j += 16) {
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+        for (int t = 0; t < taps; t++) {
+            __m256 w = _mm256_set1_ps(weights[t]);
+            sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(w, _mm256_loadu_ps(in + j + t * step)));
+            sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(w, _mm256_loadu_ps(in + j + 8 + t * step)));
+        }
+        _mm256_storeu_ps(out + j, sum0);
+        _mm256_storeu_ps(out + j + 8, sum1);
+    }
+    ConvolveScalar(out, in, weights, taps, step, j, count);
+}
+
+__attribute__((target("avx2")))
+static void RecursiveStepAVX2(float* x, const float* p1, const float* p2, const float* p3, const RecursiveCoefs* k, int count) {
+    const __m256 b = _mm256_set1_ps(k->b), a1 = _mm256_set1_ps(k->a1), a2 = _mm256_set1_ps(k->a2), a3 = _mm256_set1_ps(k->a3);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 value = _mm256_mul_ps(b, _mm256_loadu_ps(x + i));
+        value = _mm256_add_ps(value, _mm256_mul_ps(a1, _mm256_loadu_ps(p1 + i)));
+        value = _mm256_add_ps(value, _mm256_mul_ps(a2, _mm256_loadu_ps(p2 + i)));
+        value = _mm256_add_ps(value, _mm256_mul_ps(a3, _mm256_loadu_ps(p3 + i)));
+        _mm256_storeu_ps(x + i, value);
+    }
+    RecursiveStepScalar(x, p1, p2, p3, k, i, count);
+}
+#endif
+
+#if defined(CPU_BLUR_NEON)
+static void AccumulateBytesNEON(float* acc, const unsigned char* src, float weight, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        uint16x8_t wide = vmovl_u8(vld1_u8(src + i));
+        float32x4_t low = vcvtq_f32_u32(vmovl_u16(vget_low_u16(wide)));
+        float32x4_t high = vcvtq_f32_u32(vmovl_u16(vget_high_u16(wide)));
+        vst1q_f32(acc + i, vaddq_f32(vld1q_f32(acc + i), vmulq_n_f32(low, weight)));
+        vst1q_f32(acc + i + 4, vaddq_f32(vld1q_f32(acc + i + 4), vmulq_n_f32(high, weight)));
+    }
+    AccumulateBytesScalar(acc, src, weight, i, count);
+}
+
+static void StoreBytesNEON(unsigned char* dst, const float* src, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        int32x4_t low = vcvtq_s32_f32(vaddq_f32(vld1q_f32(src + i), vdupq_n_f32(0.5f)));
+        int32x4_t high = vcvtq_s32_f32(vaddq_f32(vld1q_f32(src + i + 4), vdupq_n_f32(0.5f)));
+        vst1_u8(dst + i, vqmovun_s16(vcombine_s16(vqmovn_s32(low), vqmovn_s32(high))));
+    }
+    StoreBytesScalar(dst, src, i, count);
+}
+
+static void ConvolveNEON(float* out, const float* in, const float* weights, int taps, int step, int count) {
+    int j = 0;
+    for (; j + 4 <= count; j += 4) {
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        for (int t = 0; t < taps; t++) sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(in + j + t * step), weights[t]));
+        vst1q_f32(out + j, sum);
+    }
+    ConvolveScalar(out, in, weights, taps, step, j, count);
+}
+
+static void RecursiveStepNEON(float* x, const float* p1, const float* p2, const float* p3, const RecursiveCoefs* k, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t value = vmulq_n_f32(vld1q_f32(x + i), k->b);
+        value = vaddq_f32(value, vmulq_n_f32(vld1q_f32(p1 + i), k->a1));
+        value = vaddq_f32(value, vmulq_n_f32(vld1q_f32(p2 + i), k->a2));
+        value = vaddq_f32(value, vmulq_n_f32(vld1q_f32(p3 + i), k->a3));
+        vst1q_f32(x + i, value);
+    }
+    RecursiveStepScalar(x, p1, p2, p3, k, i, count);
+}
+#endif
+
+static void AccumulateBytes(CpuSimdLevel simd, float* acc, const unsigned char* src, float weight, int count) {
+    switch (simd) {
+        #if defined(CPU_BLUR_X86)
+        case CPU_SIMD_AVX2: AccumulateBytesAVX2(acc, src, weight, count); break;
+        case CPU_SIMD_SSE2: AccumulateBytesSSE2(acc, src, weight, count); break;
+        #endif
+        #if defined(CPU_BLUR_NEON)
+        case CPU_SIMD_NEON: AccumulateBytesNEON(acc, src, weight, count); break;
+        #endif
+        default: AccumulateBytesScalar(acc, src, weight, 0, count); break;
+    }
+}
+
+// dst[i] = src[i] (0 + 1*x est exact)
+static void LoadBytes(CpuSimdLevel simd, float* dst, const unsigned char* src, int count) {
+    memset(dst, 0, sizeof(float) * (size_t)count);
+    AccumulateBytes(simd, dst, src, 1.0f, count);
+}
+
+// La conversion est limitée par la mémoire : SSE2 suffit aussi pour AVX2
+static void StoreBytes(CpuSimdLevel simd, unsigned char* dst, const float* src, int count) {
+    switch (simd) {
+        #if defined(CPU_BLUR_X86)
+        case CPU_SIMD_AVX2:
+        case CPU_SIMD_SSE2: StoreBytesSSE2(dst, src, count); break;
+        #endif
+        #if defined(CPU_BLUR_NEON)
+        case CPU_SIMD_NEON: StoreBytesNEON(dst, src, count); break;
+        #endif
+        default: StoreBytesScalar(dst, src, 0, count); break;
+    }
+}
+
+static void Convolve(CpuSimdLevel simd, float* out, const float* in, const float* weights, int taps, int step, int count) {
+    switch (simd) {
+        #if defined(CPU_BLUR_X86)
+        case CPU_SIMD_AVX2: ConvolveAVX2(out, in, weights, taps, step, count); break;
+        case CPU_SIMD_SSE2: ConvolveSSE2(out, in, weights, taps, step, count); break;
+        #endif
+        #if defined(CPU_BLUR_NEON)
+        case CPU_SIMD_NEON: ConvolveNEON(out, in, weights, taps, step, count); break;
+        #endif
+        default: ConvolveScalar(out, in, weights, taps, step, 0, count); break;
+    }
+}
+
+static void RecursiveStep(CpuSimdLevel simd, float* x, const float* p1, const float* p2, const float* p3,
+                          const RecursiveCoefs* k, int count) {
+    switch (simd) {
+        #if defined(CPU_BLUR_X86)
+        case CPU_SIMD_AVX2: RecursiveStepAVX2(x, p1, p2, p3, k, count); break;
+        case CPU_SIMD_SSE2: RecursiveStepSSE2(x, p1, p2, p3, k, count); break;
+        #endif
+        #if defined(CPU_BLUR_NEON)
+        case CPU_SIMD_NEON: RecursiveStepNEON(x, p1, p2, p3, k, count); break;
+        #endif
+        default: RecursiveStepScalar(x, p1, p2, p3, k, 0, count); break;
+    }
+}
+
+//------------------------------------------------------------------------------------
+// Référence : boucles de gaussianBlur() pixel par pixel
+//------------------------------------------------------------------------------------
+
+static void BlurReferenceRows(void* context, int rowStart, int rowEnd) {
+    const BlurJob* job = (const BlurJob*)context;
+    int r = job->blurRadius;
+    int size = 2 * r + 1;
+
+    for (int y = rowStart; y < rowEnd; y++) {
+        for (int x = 0; x < job->width; x++) {
+            float color[4] = {0};
+            float total = 0.0f;
+            // Même ordre que le shader : x à l'extérieur, y à l'intérieur
+            for (int i = 0; i < size; i++) {
+                int sampleX = WrapIndex(x + i - r, job->width);
+                for (int j = 0; j < size; j++) {
+                    float weight = job->weights2D[i * size + j];
+                    const unsigned char* texel = job->source + ((size_t)WrapIndex(y + j - r, job->height) * job->width + sampleX) * 4;
+                    for (int c = 0; c < 4; c++) color[c] += (float)texel[c] * weight;
+                    total += weight;
+                }
+            }
+            unsigned char* out = job->output + ((size_t)y * job->width + x) * 4;
+            for (int c = 0; c < 4; c++) out[c] = RoundToByte(color[c] / total);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------------
+// Séparable : passe verticale dans une ligne flottante, puis horizontale
+//------------------------------------------------------------------------------------
+
+// Fonction pour calculer les poids 1D d'un axe de size pixels. Le noyau 2D du shader est
+// le produit des noyaux 1D (exp(-(x²+y²)/2s²) = exp(-x²/2s²) * exp(-y²/2s²)).
+// Un noyau plus large que l'image est replié modulo size (les échantillons bouclent).
+static bool BuildBlurTaps(float twoSigmaSq, int blurRadius, int size, BlurTaps* taps) {
+    bool isFolded = 2 * blurRadius + 1 > size;
+    taps->taps = isFolded ? size : 2 * blurRadius + 1;
+    taps->first = isFolded ? 0 : -blurRadius;
+    taps->weights = (float*)calloc(taps->taps, sizeof(float));
+    if (!taps->weights) return false;
+
+    double total = 0.0;
+    for (int i = -blurRadius; i <= blurRadius; i++) {
+        float weight = expf(-(float)(i * i) / twoSigmaSq);
+        taps->weights[isFolded ? WrapIndex(i, size) : i + blurRadius] += weight;
+        total += weight;
+    }
+    for (int t = 0; t < taps->taps; t++) taps->weights[t] = (float)(taps->weights[t] / total);
+    return true;
+}
+
+static void BlurSeparableRows(void* context, int rowStart, int rowEnd) {
+    BlurJob* job = (BlurJob*)context;
+    int rowFloats = job->width * 4;
+    int paddedPixels = job->width + job->horizontal.taps - 1;
+    float* row = (float*)malloc(sizeof(float) * (size_t)rowFloats);
+    float* padded = (float*)malloc(sizeof(float) * (size_t)paddedPixels * 4);
+    if (!row || !padded) {
+        job->failed = true;
+        free(row);
+        free(padded);
+        return;
+    }
+
+    size_t stride = (size_t)rowFloats;
+    for (int y = rowStart; y < rowEnd; y++) {
+        // Passe verticale sur toute la ligne
+        memset(row, 0, sizeof(float) * stride);
+        for (int t = 0; t < job->vertical.taps; t++) {
+            const unsigned char* src = job->source + (size_t)WrapIndex(y + job->vertical.first + t, job->height) * stride;
+            AccumulateBytes(job->simd, row, src, job->vertical.weights[t], rowFloats);
+        }
+
+        // Ligne étendue : padded[p] est le pixel first + p, bouclé
+        for (int p = 0; p < paddedPixels; p++) {
+            memcpy(padded + p * 4, row + WrapIndex(job->horizontal.first + p, job->width) * 4, sizeof(float) * 4);
+        }
+        Convolve(job->simd, row, padded, job->horizontal.weights, job->horizontal.taps, 4, rowFloats);
+
+        StoreBytes(job->simd, job->output + (size_t)y * stride, row, rowFloats);
+    }
+
+    free(row);
+    free(padded);
+}
+
+//------------------------------------------------------------------------------------
+// Récursif : filtre de Young-van Vliet aller-retour, vertical puis horizontal
+//------------------------------------------------------------------------------------
+
+static RecursiveCoefs GetRecursiveCoefs(float sigma, int size) {
+    float q = sigma >= 2.5f ? 0.98711f * sigma - 0.96330f : 3.97156f - 4.14554f * sqrtf(1.0f - 0.26891f * sigma);
+    float q2 = q * q;
+    float q3 = q2 * q;
+    float b0 = 1.57825f + 2.44413f * q + 1.4281f * q2 + 0.422205f * q3;
+    float b1 = 2.44413f * q + 2.85619f * q2 + 1.26661f * q3;
+    float b2 = -(1.4281f * q2 + 1.26661f * q3);
+    float b3 = 0.422205f * q3;
+
+    RecursiveCoefs coefs;
+    coefs.a1 = b1 / b0;
+    coefs.a2 = b2 / b0;
+    coefs.a3 = b3 / b0;
+    coefs.b = 1.0f - (coefs.a1 + coefs.a2 + coefs.a3);
+    // La réponse du filtre devient négligeable au-delà de 4 sigma
+    int warmup = (int)ceilf(4.0f * sigma);
+    coefs.warmup = warmup < size ? warmup : size;
+    return coefs;
+}
+
+// Fonction pour filtrer en place une suite de vectors vecteurs de count floats (aller puis
+// retour). Les k->warmup premiers et derniers vecteurs sont l'amorce bouclée : seuls ceux du
+// milieu sont exacts. L'état initial de chaque sens est le premier échantillon répété.
+static void RunRecursiveFilter(CpuSimdLevel simd, float* data, int vectors, int count, const RecursiveCoefs* k, float* edge) {
+    memcpy(edge, data, sizeof(float) * count);
+    for (int i = 0; i < vectors; i++) {
+        float* x = data + (size_t)i * count;
+        const float* p1 = i >= 1 ? x - count : edge;
+        const float* p2 = i >= 2 ? x - 2 * count : edge;
+        const float* p3 = i >= 3 ? x - 3 * count : edge;
+        RecursiveStep(simd, x, p1, p2, p3, k, count);
+    }
+
+    float* last = data + (size_t)(vectors - 1) * count;
+    memcpy(edge, last, sizeof(float) * count);
+    for (int i = vectors - 1; i >= 0; i--) {
+        float* x = data + (size_t)i * count;
+        const float* p1 = i + 1 < vectors ? x + count : edge;
+        const float* p2 = i + 2 < vectors ? x + 2 * count : edge;
+        const float* p3 = i + 3 < vectors ? x + 3 * count : edge;
+        RecursiveStep(simd, x, p1, p2, p3, k, count);
+    }
+}
+
+// Les tâches sont ici des bandes de colonnes (RECURSIVE_STRIPE_PIXELS pixels chacune)
+static void BlurRecursiveColumns(void* context, int stripeStart, int stripeEnd) {
+    BlurJob* job = (BlurJob*)context;
+    const RecursiveCoefs* k = &job->verticalCoefs;
+    int vectors = job->height + 2 * k->warmup;
+    float* data = (float*)malloc(sizeof(float) * (size_t)vectors * RECURSIVE_STRIPE_PIXELS * 4);
+    float* edge = (float*)malloc(sizeof(float) * RECURSIVE_STRIPE_PIXELS * 4);
+    if (!data || !edge) {
+        job->failed = true;
+        free(data);
+        free(edge);
+        return;
+    }
+
+    size_t stride = (size_t)job->width * 4;
+    for (int stripe = stripeStart; stripe < stripeEnd; stripe++) {
+        int x0 = stripe * RECURSIVE_STRIPE_PIXELS;
+        int pixels = job->width - x0 < RECURSIVE_STRIPE_PIXELS ? job->width - x0 : RECURSIVE_STRIPE_PIXELS;
+        int count = pixels * 4;
+
+        int y = WrapIndex(-k->warmup, job->height);
+        for (int v = 0; v < vectors; v++) {
+            LoadBytes(job->simd, data + (size_t)v * count, job->source + (size_t)y * stride + (size_t)x0 * 4, count);
+            if (++y == job->height) y = 0;
+        }
+        RunRecursiveFilter(job->simd, data, vectors, count, k, edge);
+
+        // Résultat intermédiaire arrondi en 8 bits dans la sortie (écart d'au plus un niveau)
+        for (y = 0; y < job->height; y++) {
+            StoreBytes(job->simd, job->output + (size_t)y * stride + (size_t)x0 * 4, data + (size_t)(y + k->warmup) * count, count);
+        }
+    }
+
+    free(data);
+    free(edge);
+}
+
+// Plusieurs lignes entrelacées (pixel x de chaque ligne côte à côte) : la même récurrence
+// que la passe verticale, sur des vecteurs de RECURSIVE_ROW_GROUP pixels
+static void BlurRecursiveRows(void* context, int rowStart, int rowEnd) {
+    BlurJob* job = (BlurJob*)context;
+    const RecursiveCoefs* k = &job->horizontalCoefs;
+    int rowFloats = job->width * 4;
+    int vectors = job->width + 2 * k->warmup;
+    float* data = (float*)malloc(sizeof(float) * (size_t)vectors * RECURSIVE_ROW_GROUP * 4);
+    float* rows = (float*)malloc(sizeof(float) * (size_t)rowFloats * RECURSIVE_ROW_GROUP);
+    float* edge = (float*)malloc(sizeof(float) * RECURSIVE_ROW_GROUP * 4);
+    if (!data || !rows || !edge) {
+        job->failed = true;
+        free(data);
+        free(rows);
+        free(edge);
+        return;
+    }
+
+    size_t stride = (size_t)rowFloats;
+    for (int y0 = rowStart; y0 < rowEnd; y0 += RECURSIVE_ROW_GROUP) {
+        int rowCount = rowEnd - y0 < RECURSIVE_ROW_GROUP ? rowEnd - y0 : RECURSIVE_ROW_GROUP;
+        int count = rowCount * 4;
+
+        for (int r = 0; r < rowCount; r++) LoadBytes(job->simd, rows + r * stride, job->output + (size_t)(y0 + r) * stride, rowFloats);
+        int x = WrapIndex(-k->warmup, job->width);
+        for (int v = 0; v < vectors; v++) {
+            float* dst = data + (size_t)v * count;
+            for (int r = 0; r < rowCount; r++) memcpy(dst + r * 4, rows + r * stride + x * 4, sizeof(float) * 4);
+            if (++x == job->width) x = 0;
+        }
+
+        RunRecursiveFilter(job->simd, data, vectors, count, k, edge);
+
+        for (x = 0; x < job->width; x++) {
+            const float* src = data + (size_t)(x + k->warmup) * count;
+            for (int r = 0; r < rowCount; r++) memcpy(rows + r * stride + x * 4, src + r * 4, sizeof(float) * 4);
+        }
+        for (int r = 0; r < rowCount; r++) StoreBytes(job->simd, job->output + (size_t)(y0 + r) * stride, rows + r * stride, rowFloats);
+    }
+
+    free(data);
+    free(rows);
+    free(edge);
+}
+
+// Fonction pour trouver le sigma gaussien de même variance que le noyau tronqué du shader
+static float GetTruncatedKernelSigma(float twoSigmaSq, int blurRadius) {
+    double total = 0.0;
+    double moment = 0.0;
+    for (int i = -blurRadius; i <= blurRadius; i++) {
+        double weight = exp(-(double)(i * i) / twoSigmaSq);
+        total += weight;
+        moment += weight * i * i;
+    }
+    return (float)sqrt(moment / total);
+}
+
+bool CpuGaussianBlur(Image source, Image* output, float radius, CpuBlurMode mode) {
+    if (source.data == NULL || source.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 || source.width <= 0 || source.height <= 0) {
+        LOG_ERRORF("CPU blur needs an RGBA8 source image");
+        return false;
+    }
+    if (output == NULL || output->data == NULL || output->data == source.data || output->width != source.width ||
+        output->height != source.height || output->format != source.format) {
+        LOG_ERRORF("CPU blur output must be a separate image of the same size and format");
+        return false;
+    }
+
+    size_t bytes = (size_t)source.width * source.height * 4;
+    // sigma nul dans le shader : poids indéfinis, rien à flouter
+    if (!(radius > 0.0f) || !isfinite(radius)) {
+        memcpy(output->data, source.data, bytes);
+        return true;
+    }
+
+    float sigma = radius / 2.0f;
+    float twoSigmaSq = 2.0f * sigma * sigma;
+    BlurJob job = {
+        .source = (const unsigned char*)source.data,
+        .output = (unsigned char*)output->data,
+        .width = source.width,
+        .height = source.height,
+        .simd = GetCpuFilterSimd(),
+        .blurRadius = (int)ceilf(radius)
+    };
+    if (mode == CPU_BLUR_RECURSIVE && radius < RECURSIVE_MIN_RADIUS) mode = CPU_BLUR_SEPARABLE;
+
+    bool isBuilt = true;
+    switch (mode) {
+        case CPU_BLUR_REFERENCE: {
+            int size = 2 * job.blurRadius + 1;
+            job.weights2D = (float*)malloc(sizeof(float) * (size_t)size * size);
+            if (!job.weights2D) {
+                isBuilt = false;
+                break;
+            }
+            for (int i = 0; i < size; i++) {
+                for (int j = 0; j < size; j++) {
+                    float x = (float)(i - job.blurRadius);
+                    float y = (float)(j - job.blurRadius);
+                    job.weights2D[i * size + j] = expf(-(x * x + y * y) / twoSigmaSq);
+                }
+            }
+            RunCpuRowTasks(job.height, BLUR_BAND_ROWS, BlurReferenceRows, &job);
+            break;
+        }
+        case CPU_BLUR_SEPARABLE:
+            isBuilt = BuildBlurTaps(twoSigmaSq, job.blurRadius, job.width, &job.horizontal) &&
+                      BuildBlurTaps(twoSigmaSq, job.blurRadius, job.height, &job.vertical);
+            if (isBuilt) RunCpuRowTasks(job.height, BLUR_BAND_ROWS, BlurSeparableRows, &job);
+            break;
+        case CPU_BLUR_RECURSIVE: {
+            float equivalentSigma = GetTruncatedKernelSigma(twoSigmaSq, job.blurRadius);
+            job.verticalCoefs = GetRecursiveCoefs(equivalentSigma, job.height);
+            job.horizontalCoefs = GetRecursiveCoefs(equivalentSigma, job.width);
+            int stripes = (job.width + RECURSIVE_STRIPE_PIXELS - 1) / RECURSIVE_STRIPE_PIXELS;
+            RunCpuRowTasks(stripes, 1, BlurRecursiveColumns, &job);
+            if (!job.failed) RunCpuRowTasks(job.height, BLUR_BAND_ROWS, BlurRecursiveRows, &job);
+            break;
+        }
+        default:
+            isBuilt = false;
+            break;
+    }
+
+    free(job.weights2D);
+    free(job.horizontal.weights);
+    free(job.vertical.weights);
+    if (!isBuilt || job.failed) {
+        LOG_ERRORF("CPU blur failed (mode %s, radius %.1f)", GetCpuBlurModeName(mode), radius);
+        return false;
+    }
+    return true;
+}
+
+static inline float SmoothStep(float edge0, float edge1, float x) {
+    float t = (x - edge0) / (edge1 - edge0);
+    t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+// Fonction pour copier dans block le rectangle [left, left + block->width) x [top, top + block->height)
+// de source, coordonnées bouclées comme les voisins du flou
+static void CopyWrappedBlock(Image source, Image* block, int left, int top) {
+    const unsigned char* src = (const unsigned char*)source.data;
+    unsigned char* dst = (unsigned char*)block->data;
+    for (int y = 0; y < block->height; y++) {
+        const unsigned char* row = src + (size_t)WrapIndex(top + y, source.height) * source.width * 4;
+        unsigned char* out = dst + (size_t)y * block->width * 4;
+        for (int x = 0; x < block->width;) {
+            // Segments contigus entre deux bords de l'image
+            int sourceX = WrapIndex(left + x, source.width);
+            int count = source.width - sourceX;
+            if (count > block->width - x) count = block->width - x;
+            memcpy(out + (size_t)x * 4, row + (size_t)sourceX * 4, (size_t)count * 4);
+            x += count;
+        }
+    }
+}
+
+bool CpuApplyBlurEffect(Image source, Image* output, Vector2 mousePos, float radius, float time) {
+    if (source.data == NULL || source.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 || source.width <= 0 || source.height <= 0) {
+        LOG_ERRORF("CPU blur effect needs an RGBA8 source image");
+        return false;
+    }
+    if (output == NULL || output->data == NULL || output->data == source.data || output->width != source.width ||
+        output->height != source.height || output->format != source.format) {
+        LOG_ERRORF("CPU blur effect output must be a separate image of the same size and format");
+        return false;
+    }
+
+    // Hors du carré autour du cercle, l'image est inchangée
+    size_t bytes = (size_t)source.width * source.height * 4;
+    memcpy(output->data, source.data, bytes);
+
+    // Curseur ou rayon invalide : aucune comparaison n'est vraie dans le shader
+    if (!isfinite(mousePos.x) || !isfinite(mousePos.y) || isnan(radius)) return true;
+
+    const unsigned char* src = (const unsigned char*)source.data;
+    unsigned char* out = (unsigned char*)output->data;
+    float center = radius * 0.6f;
+    float ringLimit = fminf(radius * 1.05f, radius + 5.0f);
+    int top = (int)fmaxf(floorf(mousePos.y - ringLimit - 1.0f), 0.0f);
+    int bottom = (int)fminf(ceilf(mousePos.y + ringLimit + 1.0f), (float)source.height);
+    int left = (int)fmaxf(floorf(mousePos.x - ringLimit - 1.0f), 0.0f);
+    int right = (int)fminf(ceilf(mousePos.x + ringLimit + 1.0f), (float)source.width);
+    if (left >= right || top >= bottom) return true;
+
+    // Le flou ne sert que dans l'anneau : seul le carré est flouté, avec une marge du rayon
+    // du noyau lue en bouclant comme dans le flou de l'image entière (résultat identique).
+    // Si la marge dépasse l'image, le noyau se replierait différemment : image entière.
+    int margin = (int)ceilf(EFFECT2_BLUR_RADIUS);
+    Image block = {
+        .width = right - left + 2 * margin,
+        .height = bottom - top + 2 * margin,
+        .mipmaps = 1,
+        .format = source.format
+    };
+    int blockLeft = left - margin;
+    int blockTop = top - margin;
+    bool isWholeImage = block.width >= source.width || block.height >= source.height;
+    if (isWholeImage) {
+        block.width = source.width;
+        block.height = source.height;
+        blockLeft = 0;
+        blockTop = 0;
+    }
+    size_t blockBytes = (size_t)block.width * block.height * 4;
+    Image blurred = block;
+    block.data = isWholeImage ? source.data : malloc(blockBytes);
+    blurred.data = malloc(blockBytes);
+    bool isBlurred = block.data != NULL && blurred.data != NULL;
+    if (isBlurred) {
+        if (!isWholeImage) CopyWrappedBlock(source, &block, blockLeft, blockTop);
+        isBlurred = CpuGaussianBlur(block, &blurred, EFFECT2_BLUR_RADIUS, CPU_BLUR_SEPARABLE);
+    } else {
+        LOG_ERRORF("CPU blur effect: out of memory for a %dx%d block", block.width, block.height);
+    }
+    if (!isWholeImage) free(block.data);
+    if (!isBlurred) {
+        free(blurred.data);
+        return false;
+    }
+
+    const unsigned char* blur = (const unsigned char*)blurred.data;
+    for (int y = top; y < bottom; y++) {
+        size_t rowOffset = (size_t)y * source.width * 4;
+        const unsigned char* blurRow = blur + (size_t)(y - blockTop) * block.width * 4;
+
+        // Centres des pixels calculés comme uv * resolution dans le shader
+        float pixelY = ((float)y + 0.5f) / (float)source.height * (float)source.height;
+        float dy = pixelY - mousePos.y;
+        for (int x = left; x < right; x++) {
+            const unsigned char* original = src + rowOffset + (size_t)x * 4;
+            const unsigned char* blurPixel = blurRow + (size_t)(x - blockLeft) * 4;
+            unsigned char* pixel = out + rowOffset + (size_t)x * 4;
+            float pixelX = ((float)x + 0.5f) / (float)source.width * (float)source.width;
+            float dx = pixelX - mousePos.x;
+            float dist = sqrtf(dx * dx + dy * dy);
+            if (dist < center) {
+                continue;
+            } else if (dist < radius) {
+                // Flou progressif, rouge et bleu animés selon l'angle autour du curseur
+                float blurAmount = SmoothStep(center, radius, dist);
+                float angle = atan2f(dy, dx);
+                float animated[4] = {
+                    0.5f + 0.3f * cosf(time * 2.0f + angle * 2.0f + 3.14159265358979f / 2.0f),
+                    blurPixel[1] / 255.0f,
+                    0.5f + 0.3f * cosf(time * 2.0f + angle * 2.0f),
+                    blurPixel[3] / 255.0f
+                };
+                for (int k = 0; k < 4; k++) {
+                    float value = original[k] / 255.0f;
+                    pixel[k] = RoundToByte((value * (1.0f - blurAmount) + animated[k] * blurAmount) * 255.0f);
+                }
+            } else if (dist <= ringLimit) {
+                pixel[0] = 0;
+                pixel[1] = 0;
+                pixel[2] = 0;
+                pixel[3] = 255;
+            }
+        }
+    }
+    free(blurred.data);
+    return true;
+}
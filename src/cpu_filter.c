@@ -0,0 +1,339 @@
+#include "cpu_filter.h"
+#include "job_system.h"
+#include "logger.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CPU_FILTER_X86 1
+#include <immintrin.h> // Fonctions AVX2 compilées avec target("avx2"), choisies à l'exécution
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CPU_FILTER_NEON 1
+#include <arm_neon.h>
+#endif
+
+#define SHARPEN_BAND_ROWS 16     // Lignes par tâche : assez pour amortir, assez peu pour équilibrer
+
+typedef struct {
+    bool isDetected;
+    CpuSimdLevel support;
+    CpuSimdLevel level;
+} CpuFilterState;
+
+static CpuFilterState gCpuFilter = {0};
+
+// Bandes de lignes vues comme des tuiles d'une colonne
+typedef struct {
+    CpuRowTask task;
+    void* context;
+} RowTaskJob;
+
+typedef struct {
+    const unsigned char* source;
+    unsigned char* output;
+    int width;
+    int height;
+    Vector2 mousePos;
+    float radius;
+    float ringLimit;
+    CpuSimdLevel simd;
+} SharpenJob;
+
+static void DetectCpuSimd(void) {
+    if (gCpuFilter.isDetected) return;
+    gCpuFilter.support = CPU_SIMD_SCALAR;
+    #if defined(CPU_FILTER_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) gCpuFilter.support = CPU_SIMD_SSE2;
+    if (__builtin_cpu_supports("avx2")) gCpuFilter.support = CPU_SIMD_AVX2;
+    #elif defined(CPU_FILTER_NEON)
+    gCpuFilter.support = CPU_SIMD_NEON;
+    #endif
+    gCpuFilter.level = gCpuFilter.support;
+    gCpuFilter.isDetected = true;
+}
+
+CpuSimdLevel GetCpuSimdSupport(void) {
+    DetectCpuSimd();
+    return gCpuFilter.support;
+}
+
+CpuSimdLevel GetCpuFilterSimd(void) {
+    DetectCpuSimd();
+    return gCpuFilter.level;
+}
+
+// Fonction pour choisir le jeu d'instructions (un jeu non supporté donne le meilleur disponible)
+void SetCpuFilterSimd(CpuSimdLevel level) {
+    DetectCpuSimd();
+    bool isSupported = level == CPU_SIMD_SCALAR || level == gCpuFilter.support ||
+                       (level == CPU_SIMD_SSE2 && gCpuFilter.support == CPU_SIMD_AVX2);
+    gCpuFilter.level = isSupported ? level : gCpuFilter.support;
+}
+
+const char* GetCpuSimdName(CpuSimdLevel level) {
+    switch (level) {
+        case CPU_SIMD_SSE2: return "SSE2";
+        case CPU_SIMD_AVX2: return "AVX2";
+        case CPU_SIMD_NEON: return "NEON";
+        default: return "scalaire";
+    }
+}
+
+void SetCpuFilterThreadCount(int count) {
+    SetJobThreadCount(count);
+}
+
+int GetCpuFilterThreadCount(void) {
+    return GetJobThreadCount();
+}
+
+static void RunRowTaskTile(void* context, JobTile tile) {
+    RowTaskJob* job = (RowTaskJob*)context;
+    job->task(job->context, tile.y, tile.y + tile.height);
+}
+
+void RunCpuRowTasks(int rowCount, int bandRows, CpuRowTask task, void* context) {
+    RowTaskJob job = { .task = task, .context = context };
+    ParallelForTiles(1, rowCount, 1, bandRows, RunRowTaskTile, &job);
+}
+
+//------------------------------------------------------------------------------------
+// Netteté (effect.glsl)
+//------------------------------------------------------------------------------------
+
+// Les échantillons tombent exactement au centre des texels : le noyau 3x3 (coins nuls)
+// se calcule en entiers, et la saturation de la sortie 8 bits donne le clamp du GPU.
+static inline unsigned char SharpenChannel(int center, int left, int right, int up, int down) {
+    int value = 5 * center - left - right - up - down;
+    return (unsigned char)(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+// Fonction pour un pixel, avec les colonnes voisines déjà bouclées
+static void SharpenPixel(const unsigned char* up, const unsigned char* row, const unsigned char* down,
+                         unsigned char* out, int x, int left, int right) {
+    for (int c = 0; c < 4; c++) {
+        out[4 * x + c] = SharpenChannel(row[4 * x + c], row[4 * left + c], row[4 * right + c], up[4 * x + c], down[4 * x + c]);
+    }
+}
+
+// Les noyaux suivants traitent [start, end) avec 1 <= start et end <= width - 1 :
+// les voisins gauche et droit sont toujours dans la ligne
+static void SharpenSpanScalar(const unsigned char* up, const unsigned char* row, const unsigned char* down,
+                              unsigned char* out, int start, int end) {
+    for (int x = start; x < end; x++) SharpenPixel(up, row, down, out, x, x - 1, x + 1);
+}
+
+#if defined(CPU_FILTER_X86)
+// 4 pixels par itération, calcul en 16 bits signés (plage [-1020, 1275])
+__attribute__((target("sse2")))
+static void SharpenSpanSSE2(const unsigned char* up, const unsigned char* row, const unsigned char* down,
+                            unsigned char* out, int start, int end) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i five = _mm_set1_epi16(5);
+    int x = start;
+    for (; x + 4 <= end; x += 4) {
+        __m128i center = _mm_loadu_si128((const __m128i*)(row + 4 * x));
+        __m128i left = _mm_loadu_si128((const __m128i*)(row + 4 * x - 4));
+        __m128i right = _mm_loadu_si128((const __m128i*)(row + 4 * x + 4));
+        __m128i above = _mm_loadu_si128((const __m128i*)(up + 4 * x));
+        __m128i below = _mm_loadu_si128((const __m128i*)(down + 4 * x));
+
+        __m128i sumLow = _mm_add_epi16(_mm_add_epi16(_mm_unpacklo_epi8(left, zero), _mm_unpacklo_epi8(right, zero)),
+                                       _mm_add_epi16(_mm_unpacklo_epi8(above, zero), _mm_unpacklo_epi8(below, zero)));
+        __m128i sumHigh = _mm_add_epi16(_mm_add_epi16(_mm_unpackhi_epi8(left, zero), _mm_unpackhi_epi8(right, zero)),
+                                        _mm_add_epi16(_mm_unpackhi_epi8(above, zero), _mm_unpackhi_epi8(below, zero)));
+        __m128i low = _mm_sub_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(center, zero), five), sumLow);
+        __m128i high = _mm_sub_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(center, zero), five), sumHigh);
+        _mm_storeu_si128((__m128i*)(out + 4 * x), _mm_packus_epi16(low, high));
+    }
+    SharpenSpanScalar(up, row, down, out, x, end);
+}
+
+// 8 pixels par itération (unpack et pack travaillent par moitié de 128 bits : l'ordre est conservé)
+__attribute__((target("avx2")))
+static void SharpenSpanAVX2(const unsigned char* up, const unsigned char* row, const unsigned char* down,
+                            unsigned char* out, int start, int end) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i five = _mm256_set1_epi16(5);
+    int x = start;
+    for (; x + 8 <= end; x += 8) {
+        __m256i center = _mm256_loadu_si256((const __m256i*)(row + 4 * x));
+        __m256i left = _mm256_loadu_si256((const __m256i*)(row + 4 * x - 4));
+        __m256i right = _mm256_loadu_si256((const __m256i*)(row + 4 * x + 4));
+        __m256i above = _mm256_loadu_si256((const __m256i*)(up + 4 * x));
+        __m256i below = _mm256_loadu_si256((const __m256i*)(down + 4 * x));
+
+        __m256i sumLow = _mm256_add_epi16(_mm256_add_epi16(_mm256_unpacklo_epi8(left, zero), _mm256_unpacklo_epi8(right, zero)),
+                                          _mm256_add_epi16(_mm256_unpacklo_epi8(above, zero), _mm256_unpacklo_epi8(below, zero)));
+        __m256i sumHigh = _mm256_add_epi16(_mm256_add_epi16(_mm256_unpackhi_epi8(left, zero), _mm256_unpackhi_epi8(right, zero)),
+                                           _mm256_add_epi16(_mm256_unpackhi_epi8(above, zero), _mm256_unpackhi_epi8(below, zero)));
+        __m256i low = _mm256_sub_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(center, zero), five), sumLow);
+        __m256i high = _mm256_sub_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(center, zero), five), sumHigh);
+        _mm256_storeu_si256((__m256i*)(out + 4 * x), _mm256_packus_epi16(low, high));
+    }
+    SharpenSpanSSE2(up, row, down, out, x, end);
+}
+#endif
+
+#if defined(CPU_FILTER_NEON)
+static void SharpenSpanNEON(const unsigned char* up, const unsigned char* row, const unsigned char* down,
+                            unsigned char* out, int start, int end) {
+    int x = start;
+    for (; x + 4 <= end; x += 4) {
+        uint8x16_t center = vld1q_u8(row + 4 * x);
+        uint8x16_t left = vld1q_u8(row + 4 * x - 4);
+        uint8x16_t right = vld1q_u8(row + 4 * x + 4);
+        uint8x16_t above = vld1q_u8(up + 4 * x);
+        uint8x16_t below = vld1q_u8(down + 4 * x);
+
+        uint16x8_t sumLow = vaddq_u16(vaddl_u8(vget_low_u8(left), vget_low_u8(right)),
+                                      vaddl_u8(vget_low_u8(above), vget_low_u8(below)));
+        uint16x8_t sumHigh = vaddq_u16(vaddl_u8(vget_high_u8(left), vget_high_u8(right)),
+                                       vaddl_u8(vget_high_u8(above), vget_high_u8(below)));
+        int16x8_t low = vsubq_s16(vreinterpretq_s16_u16(vmulq_n_u16(vmovl_u8(vget_low_u8(center)), 5)),
+                                  vreinterpretq_s16_u16(sumLow));
+        int16x8_t high = vsubq_s16(vreinterpretq_s16_u16(vmulq_n_u16(vmovl_u8(vget_high_u8(center)), 5)),
+                                   vreinterpretq_s16_u16(sumHigh));
+        vst1q_u8(out + 4 * x, vcombine_u8(vqmovun_s16(low), vqmovun_s16(high)));
+    }
+    SharpenSpanScalar(up, row, down, out, x, end);
+}
+#endif
+
+static void SharpenSpan(CpuSimdLevel simd, const unsigned char* up, const unsigned char* row, const unsigned char* down,
+                        unsigned char* out, int start, int end) {
+    switch (simd) {
+        #if defined(CPU_FILTER_X86)
+        case CPU_SIMD_AVX2: SharpenSpanAVX2(up, row, down, out, start, end); break;
+        case CPU_SIMD_SSE2: SharpenSpanSSE2(up, row, down, out, start, end); break;
+        #endif
+        #if defined(CPU_FILTER_NEON)
+        case CPU_SIMD_NEON: SharpenSpanNEON(up, row, down, out, start, end); break;
+        #endif
+        default: SharpenSpanScalar(up, row, down, out, start, end); break;
+    }
+}
+
+// Position du centre d'un pixel calculée comme le shader et cpu_shader : uv * resolution,
+// avec uv = (x + 0.5) / taille. L'arrondi de la division peut décaler le résultat d'un ulp
+// par rapport à x + 0.5, ce qui suffit à changer un pixel en bord de cercle.
+static float GetPixelCenter(int x, int size) {
+    return ((float)x + 0.5f) / (float)size * (float)size;
+}
+
+// Même calcul que le shader : distance en float entre le centre du pixel et le curseur
+static bool IsPixelWithin(int x, int width, float dy, float mouseX, float limit, bool isInclusive) {
+    float dx = GetPixelCenter(x, width) - mouseX;
+    float dist = sqrtf(dx * dx + dy * dy);
+    return isInclusive ? dist <= limit : dist < limit;
+}
+
+// Fonction pour trouver les colonnes [start, end) d'une ligne à distance limite du curseur.
+// La distance croît avec |dx| : l'ensemble est un intervalle qui contient la colonne
+// la plus proche du curseur. L'estimation analytique est corrigée par le test exact.
+static void FindPixelSpan(int width, float dy, float mouseX, float limit, bool isInclusive, int* start, int* end) {
+    float centerX = floorf(mouseX);
+    int center = centerX <= 0.0f ? 0 : (centerX >= (float)(width - 1) ? width - 1 : (int)centerX);
+    *start = *end = 0;
+    if (!IsPixelWithin(center, width, dy, mouseX, limit, isInclusive)) return;
+
+    float half = sqrtf(fmaxf(limit * limit - dy * dy, 0.0f));
+    float guess = floorf(mouseX - half - 0.5f);
+    int left = guess <= 0.0f ? 0 : (guess >= (float)center ? center : (int)guess);
+    while (left < center && !IsPixelWithin(left, width, dy, mouseX, limit, isInclusive)) left++;
+    while (left > 0 && IsPixelWithin(left - 1, width, dy, mouseX, limit, isInclusive)) left--;
+
+    guess = ceilf(mouseX + half - 0.5f);
+    int right = guess <= (float)center ? center : (guess >= (float)(width - 1) ? width - 1 : (int)guess);
+    while (right > center && !IsPixelWithin(right, width, dy, mouseX, limit, isInclusive)) right--;
+    while (right < width - 1 && IsPixelWithin(right + 1, width, dy, mouseX, limit, isInclusive)) right++;
+
+    *start = left;
+    *end = right + 1;
+}
+
+static void FillBlack(unsigned char* out, int start, int end) {
+    for (int x = start; x < end; x++) {
+        out[4 * x + 0] = 0;
+        out[4 * x + 1] = 0;
+        out[4 * x + 2] = 0;
+        out[4 * x + 3] = 255;
+    }
+}
+
+static void SharpenRows(void* context, int rowStart, int rowEnd) {
+    const SharpenJob* job = (const SharpenJob*)context;
+    size_t stride = (size_t)job->width * 4;
+
+    for (int y = rowStart; y < rowEnd; y++) {
+        const unsigned char* row = job->source + y * stride;
+        unsigned char* out = job->output + y * stride;
+        memcpy(out, row, stride);
+
+        float dy = GetPixelCenter(y, job->height) - job->mousePos.y;
+        int ringStart, ringEnd;
+        FindPixelSpan(job->width, dy, job->mousePos.x, job->ringLimit, true, &ringStart, &ringEnd);
+        if (ringStart == ringEnd) continue;
+
+        // L'intérieur (dist < radius) est contenu dans l'anneau (dist <= ringLimit)
+        int innerStart, innerEnd;
+        FindPixelSpan(job->width, dy, job->mousePos.x, job->radius, false, &innerStart, &innerEnd);
+        if (innerStart == innerEnd) {
+            FillBlack(out, ringStart, ringEnd);
+            continue;
+        }
+        FillBlack(out, ringStart, innerStart);
+        FillBlack(out, innerEnd, ringEnd);
+
+        // Lignes et colonnes voisines bouclées comme la texture (GL_REPEAT)
+        const unsigned char* up = job->source + (size_t)((y - 1 + job->height) % job->height) * stride;
+        const unsigned char* down = job->source + (size_t)((y + 1) % job->height) * stride;
+        int last = job->width - 1;
+        int start = innerStart;
+        int end = innerEnd;
+        if (start == 0) {
+            SharpenPixel(up, row, down, out, 0, last, job->width > 1 ? 1 : 0);
+            start = 1;
+        }
+        if (end == job->width && end > start) {
+            SharpenPixel(up, row, down, out, last, last - 1, 0);
+            end = last;
+        }
+        if (end > start) SharpenSpan(job->simd, up, row, down, out, start, end);
+    }
+}
+
+bool CpuApplySharpenEffect(Image source, Image* output, Vector2 mousePos, float radius) {
+    if (source.data == NULL || source.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 || source.width <= 0 || source.height <= 0) {
+        LOG_ERRORF("CPU sharpen needs an RGBA8 source image");
+        return false;
+    }
+    if (output == NULL || output->data == NULL || output->data == source.data || output->width != source.width ||
+        output->height != source.height || output->format != source.format) {
+        LOG_ERRORF("CPU sharpen output must be a separate image of the same size and format");
+        return false;
+    }
+
+    // Curseur ou rayon invalide : aucune comparaison n'est vraie dans le shader
+    if (!isfinite(mousePos.x) || !isfinite(mousePos.y) || isnan(radius)) {
+        memcpy(output->data, source.data, (size_t)source.width * source.height * 4);
+        return true;
+    }
+
+    SharpenJob job = {
+        .source = (const unsigned char*)source.data,
+        .output = (unsigned char*)output->data,
+        .width = source.width,
+        .height = source.height,
+        .mousePos = mousePos,
+        .radius = radius,
+        .ringLimit = fminf(radius * 1.05f, radius + 5.0f),
+        .simd = GetCpuFilterSimd()
+    };
+    RunCpuRowTasks(source.height, SHARPEN_BAND_ROWS, SharpenRows, &job);
+    return true;
+}
@@ -0,0 +1,2516 @@
+#include "cpu_shader.h"
+#include "cpu_filter.h"
+#include "shader_preprocess.h"
+#include "logger.h"
+#include <ctype.h>
+#include <math.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CPU_SHADER_X86 1                  // Boucle d'exécution aussi compilée avec target("avx2")
+#endif
+
+#define VM_VECTOR_FLOATS 8
+#define VM_VECTORS (VM_LANES / VM_VECTOR_FLOATS)
+#define VM_MAX_TOKEN 64
+#define VM_MAX_MACROS 128
+#define VM_MAX_MACRO_DEPTH 16
+#define VM_MAX_CONDITIONALS 32            // #if imbriqués
+#define VM_MAX_VARIABLES 512
+#define VM_MAX_FUNCTIONS 64
+#define VM_MAX_INLINE_DEPTH 16            // Appels imbriqués (les fonctions sont inlinées)
+#define VM_MAX_SAMPLERS 8
+#define VM_MAX_COMPONENTS 16              // mat4
+#define VM_MAX_REGISTERS 16384
+#define VM_MAX_LOOP_JUMPS (1 << 20)       // Tours de boucle par groupe de pixels avant abandon
+#define VM_BAND_ROWS 8
+#define VM_FIXED 0x40000000u              // Registre de la zone fixe (avant relocalisation)
+#define VM_NO_MASK 0xFFFFFFFFu            // Tous les pixels actifs
+
+// Une composante de VM_LANES pixels, manipulée par vecteurs de 8 flottants
+typedef float VmVector __attribute__((vector_size(32), may_alias));
+typedef int32_t VmMaskVector __attribute__((vector_size(32), may_alias));
+
+typedef enum {
+    VM_OP_MOVE,           // dst = a
+    VM_OP_SELECT,         // dst = a ? b : c (a masque)
+    VM_OP_ADD, VM_OP_SUB, VM_OP_MUL, VM_OP_DIV,
+    VM_OP_MIN, VM_OP_MAX, VM_OP_MOD, VM_OP_POW, VM_OP_ATAN2,
+    VM_OP_STEP,           // dst = b < a ? 0 : 1
+    VM_OP_NEG, VM_OP_FLOOR, VM_OP_CEIL, VM_OP_FRACT, VM_OP_TRUNC, VM_OP_ROUND,
+    VM_OP_ABS, VM_OP_SIGN, VM_OP_SQRT, VM_OP_RSQRT,
+    VM_OP_EXP, VM_OP_EXP2, VM_OP_LOG, VM_OP_LOG2,
+    VM_OP_SIN, VM_OP_COS, VM_OP_TAN, VM_OP_ASIN, VM_OP_ACOS, VM_OP_ATAN,
+    VM_OP_LT, VM_OP_LE, VM_OP_EQ, VM_OP_NE,          // Masques
+    VM_OP_AND, VM_OP_OR, VM_OP_XOR, VM_OP_ANDNOT,    // ANDNOT : a & ~b
+    VM_OP_NOT, VM_OP_MASK_ALL,
+    VM_OP_MASK_TO_FLOAT, VM_OP_FLOAT_TO_MASK,
+    VM_OP_TEXTURE,        // dst..dst+3 = texture(sampler c, vec2(a, b))
+    VM_OP_JUMP,           // pc = c
+    VM_OP_JUMP_IF_NONE,   // pc = c si aucun pixel de a
+    VM_OP_COUNT
+} VmOpcode;
+
+typedef struct {
+    uint32_t op;
+    uint32_t dst;
+    uint32_t a;
+    uint32_t b;
+    uint32_t c;
+} VmInstruction;
+
+// Opérandes qui sont des registres (à relocaliser) : bits dst, a, b, c
+#define VM_USES_DST 1u
+#define VM_USES_A 2u
+#define VM_USES_B 4u
+#define VM_USES_C 8u
+
+static unsigned int GetVmOperands(uint32_t op) {
+    switch (op) {
+        case VM_OP_SELECT: return VM_USES_DST | VM_USES_A | VM_USES_B | VM_USES_C;
+        case VM_OP_MOVE: case VM_OP_NEG: case VM_OP_FLOOR: case VM_OP_CEIL: case VM_OP_FRACT:
+        case VM_OP_TRUNC: case VM_OP_ROUND: case VM_OP_ABS: case VM_OP_SIGN: case VM_OP_SQRT:
+        case VM_OP_RSQRT: case VM_OP_EXP: case VM_OP_EXP2: case VM_OP_LOG: case VM_OP_LOG2:
+        case VM_OP_SIN: case VM_OP_COS: case VM_OP_TAN: case VM_OP_ASIN: case VM_OP_ACOS:
+        case VM_OP_ATAN: case VM_OP_NOT: case VM_OP_MASK_TO_FLOAT: case VM_OP_FLOAT_TO_MASK:
+            return VM_USES_DST | VM_USES_A;
+        case VM_OP_MASK_ALL: return VM_USES_DST;
+        case VM_OP_TEXTURE: return VM_USES_DST | VM_USES_A | VM_USES_B;
+        case VM_OP_JUMP: return 0;
+        case VM_OP_JUMP_IF_NONE: return VM_USES_A;
+        default: return VM_USES_DST | VM_USES_A | VM_USES_B;
+    }
+}
+
+// Uniforms du render graph, écrits dans leurs registres avant l'exécution
+typedef enum {
+    VM_UNIFORM_TIME,
+    VM_UNIFORM_MOUSE_POS,
+    VM_UNIFORM_RADIUS,
+    VM_UNIFORM_POWER,
+    VM_UNIFORM_RESOLUTION,
+    VM_UNIFORM_PASS_RESOLUTION,
+    VM_UNIFORM_INPUT_RESOLUTION,
+    VM_UNIFORM_COUNT
+} VmUniform;
+
+static const char* gVmUniformNames[VM_UNIFORM_COUNT] = {
+    "time", "mousePos", "radius", "power", "resolution", "passResolution", "inputResolution"
+};
+static const int gVmUniformSizes[VM_UNIFORM_COUNT] = { 1, 2, 1, 1, 2, 2, 2 };
+
+struct CpuShader {
+    VmInstruction* code;
+    int codeCount;
+    int registerCount;
+    // Valeurs initiales de la zone fixe [0, fixedCount) : constantes, uniforms, variables
+    // globales. En bits (les masques ne sont pas des flottants).
+    uint32_t* fixedValues;
+    int fixedCount;
+    int uniformRegisters[VM_UNIFORM_COUNT];   // Premier registre, -1 si inutilisé
+    int texCoordRegister;                     // fragTexCoord (2 registres), -1 si inutilisé
+    int outputRegister;                       // Sortie vec4 (4 registres consécutifs)
+    char samplerNames[VM_MAX_SAMPLERS][MAX_PASS_NAME];
+    int samplerCount;
+};
+
+// ---------------------------------------------------------------------------
+// Préprocesseur et découpage en tokens
+// ---------------------------------------------------------------------------
+
+typedef enum {
+    VM_TOKEN_END,
+    VM_TOKEN_IDENTIFIER,
+    VM_TOKEN_NUMBER,
+    VM_TOKEN_PUNCT
+} VmTokenKind;
+
+typedef struct {
+    VmTokenKind kind;
+    char text[VM_MAX_TOKEN];
+    float number;
+    bool isFloat;             // Littéral flottant (1.0, 1e3, 2.f), sinon entier
+    int line;
+    int sourceNumber;         // Fichier (#line N S), 0 pour le shader principal
+} VmToken;
+
+typedef struct {
+    char name[VM_MAX_TOKEN];
+    char* value;
+} VmMacro;
+
+typedef struct {
+    VmToken* tokens;
+    int count;
+    int capacity;
+    VmMacro macros[VM_MAX_MACROS];
+    int macroCount;
+    int line;
+    int sourceNumber;
+    char* error;
+    size_t errorSize;
+} VmLexer;
+
+static bool LexerError(VmLexer* lexer, const char* format, ...) {
+    char message[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+    if (lexer->sourceNumber > 0) {
+        snprintf(lexer->error, lexer->errorSize, "Fichier %d, ligne %d: %s", lexer->sourceNumber, lexer->line, message);
+    } else {
+        snprintf(lexer->error, lexer->errorSize, "Ligne %d: %s", lexer->line, message);
+    }
+    return false;
+}
+
+static VmMacro* FindMacro(VmLexer* lexer, const char* name, size_t length) {
+    for (int i = 0; i < lexer->macroCount; i++) {
+        if (strlen(lexer->macros[i].name) == length && strncmp(lexer->macros[i].name, name, length) == 0) {
+            return &lexer->macros[i];
+        }
+    }
+    return NULL;
+}
+
+static bool IsIdentifierStart(char c) {
+    return isalpha((unsigned char)c) || c == '_';
+}
+
+static bool IsIdentifierChar(char c) {
+    return isalnum((unsigned char)c) || c == '_';
+}
+
+// Fonction pour lire un token à partir de *text (false en fin de texte)
+static bool ReadRawToken(const char** text, const char* end, VmToken* token) {
+    const char* c = *text;
+    while (c < end && isspace((unsigned char)*c)) c++;
+    if (c >= end) {
+        *text = c;
+        return false;
+    }
+    memset(token, 0, sizeof(*token));
+    const char* start = c;
+    if (IsIdentifierStart(*c)) {
+        token->kind = VM_TOKEN_IDENTIFIER;
+        while (c < end && IsIdentifierChar(*c)) c++;
+    } else if (isdigit((unsigned char)*c) || (*c == '.' && c + 1 < end && isdigit((unsigned char)c[1]))) {
+        token->kind = VM_TOKEN_NUMBER;
+        char* numberEnd = NULL;
+        token->number = strtof(c, &numberEnd);
+        for (const char* p = c; p < numberEnd; p++) {
+            if (*p == '.' || *p == 'e' || *p == 'E') token->isFloat = true;
+        }
+        c = numberEnd;
+        // Suffixes f/F (flottant) et u/U (entier non signé, traité comme un entier)
+        if (c < end && (*c == 'f' || *c == 'F')) {
+            token->isFloat = true;
+            c++;
+        } else if (c < end && (*c == 'u' || *c == 'U')) {
+            c++;
+        }
+    } else {
+        static const char* operators[] = {
+            "<<=", ">>=", "++", "--", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=",
+            "==", "!=", "<=", ">=", "&&", "||", "^^", "<<", ">>"
+        };
+        token->kind = VM_TOKEN_PUNCT;
+        c++;
+        for (size_t i = 0; i < sizeof(operators) / sizeof(operators[0]); i++) {
+            size_t length = strlen(operators[i]);
+            if ((size_t)(end - start) >= length && strncmp(start, operators[i], length) == 0) {
+                c = start + length;
+                break;
+            }
+        }
+    }
+    size_t length = (size_t)(c - start);
+    if (length >= VM_MAX_TOKEN) length = VM_MAX_TOKEN - 1;
+    memcpy(token->text, start, length);
+    token->text[length] = '\0';
+    *text = c;
+    return true;
+}
+
+static bool PushToken(VmLexer* lexer, const VmToken* token) {
+    if (lexer->count + 1 >= lexer->capacity) {
+        int capacity = lexer->capacity ? lexer->capacity * 2 : 1024;
+        VmToken* tokens = realloc(lexer->tokens, (size_t)capacity * sizeof(VmToken));
+        if (tokens == NULL) return LexerError(lexer, "mémoire insuffisante");
+        lexer->tokens = tokens;
+        lexer->capacity = capacity;
+    }
+    VmToken* added = &lexer->tokens[lexer->count++];
+    *added = *token;
+    added->line = lexer->line;
+    added->sourceNumber = lexer->sourceNumber;
+    return true;
+}
+
+// Fonction pour découper une portion de ligne en développant les macros
+static bool TokenizeText(VmLexer* lexer, const char* text, const char* end, int depth) {
+    if (depth > VM_MAX_MACRO_DEPTH) return LexerError(lexer, "macros trop imbriquées");
+    VmToken token;
+    while (ReadRawToken(&text, end, &token)) {
+        if (token.kind == VM_TOKEN_IDENTIFIER) {
+            VmMacro* macro = FindMacro(lexer, token.text, strlen(token.text));
+            if (macro) {
+                if (!TokenizeText(lexer, macro->value, macro->value + strlen(macro->value), depth + 1)) return false;
+                continue;
+            }
+        }
+        if (!PushToken(lexer, &token)) return false;
+    }
+    return true;
+}
+
+// Évaluation des expressions de #if (entiers, defined, macros développées)
+typedef struct {
+    VmToken* tokens;
+    int count;
+    int position;
+    bool isValid;
+} VmConditionParser;
+
+static const char* PeekCondition(VmConditionParser* parser) {
+    return parser->position < parser->count ? parser->tokens[parser->position].text : "";
+}
+
+static long EvaluateConditionExpression(VmConditionParser* parser, int precedence);
+
+static long EvaluateConditionPrimary(VmConditionParser* parser) {
+    if (parser->position >= parser->count) {
+        parser->isValid = false;
+        return 0;
+    }
+    VmToken* token = &parser->tokens[parser->position++];
+    if (strcmp(token->text, "(") == 0) {
+        long value = EvaluateConditionExpression(parser, 0);
+        if (strcmp(PeekCondition(parser), ")") != 0) parser->isValid = false;
+        parser->position++;
+        return value;
+    }
+    if (strcmp(token->text, "!") == 0) return !EvaluateConditionPrimary(parser);
+    if (strcmp(token->text, "-") == 0) return -EvaluateConditionPrimary(parser);
+    if (strcmp(token->text, "+") == 0) return EvaluateConditionPrimary(parser);
+    if (token->kind == VM_TOKEN_NUMBER) return (long)token->number;
+    if (token->kind == VM_TOKEN_IDENTIFIER) return 0;   // Identifiant non défini
+    parser->isValid = false;
+    return 0;
+}
+
+static int GetConditionPrecedence(const char* op) {
+    static const struct { const char* op; int precedence; } operators[] = {
+        { "||", 1 }, { "&&", 2 }, { "==", 3 }, { "!=", 3 }, { "<", 4 }, { ">", 4 }, { "<=", 4 },
+        { ">=", 4 }, { "+", 5 }, { "-", 5 }, { "*", 6 }, { "/", 6 }, { "%", 6 }
+    };
+    for (size_t i = 0; i < sizeof(operators) / sizeof(operators[0]); i++) {
+        if (strcmp(operators[i].op, op) == 0) return operators[i].precedence;
+    }
+    return -1;
+}
+
+static long EvaluateConditionExpression(VmConditionParser* parser, int precedence) {
+    long left = EvaluateConditionPrimary(parser);
+    while (parser->isValid) {
+        const char* op = PeekCondition(parser);
+        int opPrecedence = GetConditionPrecedence(op);
+        if (opPrecedence <= precedence) break;
+        parser->position++;
+        long right = EvaluateConditionExpression(parser, opPrecedence);
+        if (strcmp(op, "||") == 0) left = left || right;
+        else if (strcmp(op, "&&") == 0) left = left && right;
+        else if (strcmp(op, "==") == 0) left = left == right;
+        else if (strcmp(op, "!=") == 0) left = left != right;
+        else if (strcmp(op, "<") == 0) left = left < right;
+        else if (strcmp(op, ">") == 0) left = left > right;
+        else if (strcmp(op, "<=") == 0) left = left <= right;
+        else if (strcmp(op, ">=") == 0) left = left >= right;
+        else if (strcmp(op, "+") == 0) left = left + right;
+        else if (strcmp(op, "-") == 0) left = left - right;
+        else if (strcmp(op, "*") == 0) left = left * right;
+        else if (right == 0) parser->isValid = false;
+        else if (strcmp(op, "/") == 0) left = left / right;
+        else left = left % right;
+    }
+    return left;
+}
+
+// Fonction pour évaluer la condition d'un #if / #elif
+static bool EvaluateCondition(VmLexer* lexer, const char* text, const char* end, bool* result) {
+    // defined(X) et defined X sont remplacés par 0 / 1 avant le développement des macros
+    char expanded[1024];
+    size_t length = 0;
+    VmToken token;
+    while (ReadRawToken(&text, end, &token)) {
+        const char* value = token.text;
+        if (strcmp(token.text, "defined") == 0) {
+            VmToken name;
+            if (!ReadRawToken(&text, end, &name)) return LexerError(lexer, "defined sans nom");
+            bool hasParenthesis = strcmp(name.text, "(") == 0;
+            if (hasParenthesis && !ReadRawToken(&text, end, &name)) return LexerError(lexer, "defined sans nom");
+            value = FindMacro(lexer, name.text, strlen(name.text)) ? "1" : "0";
+            if (hasParenthesis && (!ReadRawToken(&text, end, &token) || strcmp(token.text, ")") != 0)) {
+                return LexerError(lexer, "')' attendu après defined");
+            }
+        }
+        int written = snprintf(expanded + length, sizeof(expanded) - length, "%s ", value);
+        if (written < 0 || (size_t)written >= sizeof(expanded) - length) return LexerError(lexer, "condition trop longue");
+        length += (size_t)written;
+    }
+
+    int firstToken = lexer->count;
+    if (!TokenizeText(lexer, expanded, expanded + length, 0)) return false;
+    VmConditionParser parser = { lexer->tokens + firstToken, lexer->count - firstToken, 0, true };
+    long value = parser.count > 0 ? EvaluateConditionExpression(&parser, 0) : 0;
+    bool isValid = parser.isValid && parser.count > 0 && parser.position == parser.count;
+    lexer->count = firstToken;
+    if (!isValid) return LexerError(lexer, "condition de préprocesseur invalide");
+    *result = value != 0;
+    return true;
+}
+
+static bool DefineMacro(VmLexer* lexer, const char* text, const char* end) {
+    while (text < end && isspace((unsigned char)*text)) text++;
+    const char* name = text;
+    while (text < end && IsIdentifierChar(*text)) text++;
+    size_t nameLength = (size_t)(text - name);
+    if (nameLength == 0 || nameLength >= VM_MAX_TOKEN) return LexerError(lexer, "nom de macro invalide");
+    if (text < end && *text == '(') return LexerError(lexer, "macros avec paramètres non supportées");
+
+    VmMacro* macro = FindMacro(lexer, name, nameLength);
+    if (macro == NULL) {
+        if (lexer->macroCount >= VM_MAX_MACROS) return LexerError(lexer, "trop de macros");
+        macro = &lexer->macros[lexer->macroCount++];
+        memcpy(macro->name, name, nameLength);
+        macro->name[nameLength] = '\0';
+        macro->value = NULL;
+    }
+    while (text < end && isspace((unsigned char)*text)) text++;
+    while (end > text && isspace((unsigned char)end[-1])) end--;
+    free(macro->value);
+    macro->value = malloc((size_t)(end - text) + 1);
+    if (macro->value == NULL) return LexerError(lexer, "mémoire insuffisante");
+    memcpy(macro->value, text, (size_t)(end - text));
+    macro->value[end - text] = '\0';
+    return true;
+}
+
+static void UndefineMacro(VmLexer* lexer, const char* text, const char* end) {
+    VmToken name;
+    if (!ReadRawToken(&text, end, &name)) return;
+    VmMacro* macro = FindMacro(lexer, name.text, strlen(name.text));
+    if (macro == NULL) return;
+    free(macro->value);
+    *macro = lexer->macros[--lexer->macroCount];
+}
+
+// Fonction pour retirer les commentaires (remplacés par des espaces, retours à la ligne gardés)
+static char* StripComments(const char* source) {
+    size_t length = strlen(source);
+    char* text = malloc(length + 1);
+    if (text == NULL) return NULL;
+    for (size_t i = 0; i < length; i++) {
+        if (source[i] == '/' && source[i + 1] == '/') {
+            while (i < length && source[i] != '\n') text[i++] = ' ';
+            if (i < length) text[i] = '\n';
+        } else if (source[i] == '/' && source[i + 1] == '*') {
+            text[i] = text[i + 1] = ' ';
+            i += 2;
+            while (i < length && !(source[i] == '*' && source[i + 1] == '/')) {
+                text[i] = source[i] == '\n' ? '\n' : ' ';
+                i++;
+            }
+            if (i < length) text[i] = text[i + 1] = ' ';
+            i++;
+        } else {
+            text[i] = source[i];
+        }
+    }
+    text[length] = '\0';
+    return text;
+}
+
+// État d'un #if : branche active, branche déjà prise, #else vu
+typedef struct {
+    bool isActive;
+    bool wasTaken;
+    bool hasElse;
+    bool isParentActive;
+} VmConditional;
+
+// Fonction pour appliquer le préprocesseur et découper le source en tokens
+static bool TokenizeShader(VmLexer* lexer, const char* source) {
+    char* text = StripComments(source);
+    if (text == NULL) return LexerError(lexer, "mémoire insuffisante");
+    VmConditional conditionals[VM_MAX_CONDITIONALS];
+    int conditionalCount = 0;
+    bool isActive = true;
+    bool success = true;
+    lexer->line = 1;
+
+    const char* line = text;
+    while (success && *line) {
+        const char* end = strchr(line, '\n');
+        if (end == NULL) end = line + strlen(line);
+        const char* next = *end ? end + 1 : end;
+        int nextLine = lexer->line + 1;
+
+        const char* c = line;
+        while (c < end && isspace((unsigned char)*c)) c++;
+        if (c < end && *c == '#') {
+            c++;
+            while (c < end && isspace((unsigned char)*c)) c++;
+            const char* directive = c;
+            while (c < end && IsIdentifierChar(*c)) c++;
+            size_t directiveLength = (size_t)(c - directive);
+            #define IS_DIRECTIVE(name) (directiveLength == strlen(name) && strncmp(directive, name, directiveLength) == 0)
+            if (IS_DIRECTIVE("ifdef") || IS_DIRECTIVE("ifndef") || IS_DIRECTIVE("if")) {
+                if (conditionalCount >= VM_MAX_CONDITIONALS) {
+                    success = LexerError(lexer, "#if trop imbriqués");
+                    break;
+                }
+                bool value = false;
+                if (isActive) {
+                    if (IS_DIRECTIVE("if")) {
+                        success = EvaluateCondition(lexer, c, end, &value);
+                    } else {
+                        VmToken name;
+                        const char* cursor = c;
+                        bool isDefined = ReadRawToken(&cursor, end, &name) && FindMacro(lexer, name.text, strlen(name.text));
+                        value = IS_DIRECTIVE("ifdef") ? isDefined : !isDefined;
+                    }
+                }
+                conditionals[conditionalCount++] = (VmConditional){ isActive && value, isActive && value, false, isActive };
+                isActive = isActive && value;
+            } else if (IS_DIRECTIVE("elif") || IS_DIRECTIVE("else")) {
+                if (conditionalCount == 0 || conditionals[conditionalCount - 1].hasElse) {
+                    success = LexerError(lexer, "#%.*s inattendu", (int)directiveLength, directive);
+                    break;
+                }
+                VmConditional* conditional = &conditionals[conditionalCount - 1];
+                bool value = true;
+                if (IS_DIRECTIVE("elif")) {
+                    if (conditional->isParentActive && !conditional->wasTaken) success = EvaluateCondition(lexer, c, end, &value);
+                } else {
+                    conditional->hasElse = true;
+                }
+                conditional->isActive = conditional->isParentActive && !conditional->wasTaken && value;
+                conditional->wasTaken |= conditional->isActive;
+                isActive = conditional->isActive;
+            } else if (IS_DIRECTIVE("endif")) {
+                if (conditionalCount == 0) {
+                    success = LexerError(lexer, "#endif inattendu");
+                    break;
+                }
+                isActive = conditionals[--conditionalCount].isParentActive;
+            } else if (!isActive) {
+                // Directive d'une branche inactive
+            } else if (IS_DIRECTIVE("define")) {
+                success = DefineMacro(lexer, c, end);
+            } else if (IS_DIRECTIVE("undef")) {
+                UndefineMacro(lexer, c, end);
+            } else if (IS_DIRECTIVE("line")) {
+                // #line N [S] : numéro de la ligne suivante et du fichier
+                char* numberEnd = NULL;
+                long number = strtol(c, &numberEnd, 10);
+                if (numberEnd != c) {
+                    nextLine = (int)number;
+                    char* sourceEnd = NULL;
+                    long sourceNumber = strtol(numberEnd, &sourceEnd, 10);
+                    if (sourceEnd != numberEnd) lexer->sourceNumber = (int)sourceNumber;
+                }
+            } else if (IS_DIRECTIVE("error")) {
+                success = LexerError(lexer, "#error%.*s", (int)(end - c), c);
+            } else if (IS_DIRECTIVE("include")) {
+                success = LexerError(lexer, "#include non développé");
+            }
+            // #version, #extension, #pragma : sans effet sur le CPU
+            #undef IS_DIRECTIVE
+        } else if (isActive) {
+            success = TokenizeText(lexer, line, end, 0);
+        }
+        lexer->line = nextLine;
+        line = next;
+    }
+    if (success && conditionalCount > 0) success = LexerError(lexer, "#endif manquant");
+
+    VmToken endToken = { .kind = VM_TOKEN_END };
+    if (success) success = PushToken(lexer, &endToken);
+    for (int i = 0; i < lexer->macroCount; i++) free(lexer->macros[i].value);
+    lexer->macroCount = 0;
+    free(text);
+    return success;
+}
+
+// ---------------------------------------------------------------------------
+// Compilateur : analyse en une passe, fonctions inlinées à chaque appel
+// ---------------------------------------------------------------------------
+
+typedef enum {
+    VM_TYPE_VOID,
+    VM_TYPE_BOOL,
+    VM_TYPE_INT,
+    VM_TYPE_FLOAT,
+    VM_TYPE_VEC2,
+    VM_TYPE_VEC3,
+    VM_TYPE_VEC4,
+    VM_TYPE_MAT2,
+    VM_TYPE_MAT3,
+    VM_TYPE_MAT4,
+    VM_TYPE_SAMPLER,
+    VM_TYPE_COUNT
+} VmType;
+
+static const char* gVmTypeNames[VM_TYPE_COUNT] = {
+    "void", "bool", "int", "float", "vec2", "vec3", "vec4", "mat2", "mat3", "mat4", "sampler2D"
+};
+static const int gVmTypeComponents[VM_TYPE_COUNT] = { 0, 1, 1, 1, 2, 3, 4, 4, 9, 16, 0 };
+
+// Valeur d'une expression : un registre par composante (pas forcément consécutifs,
+// les swizzles et les indices ne coûtent rien)
+typedef struct {
+    VmType type;
+    uint32_t regs[VM_MAX_COMPONENTS];
+    int sampler;                  // Slot du sampler (VM_TYPE_SAMPLER)
+    bool isLValue;
+    int maskDepth;                // Niveau de masque de la variable, -1 pour une globale
+} VmValue;
+
+typedef struct {
+    char name[VM_MAX_TOKEN];
+    VmValue value;
+} VmVariable;
+
+#define VM_MAX_PARAMETERS 16
+
+typedef struct {
+    char name[VM_MAX_TOKEN];
+    VmType returnType;
+    VmType parameterTypes[VM_MAX_PARAMETERS];
+    int parameterCount;
+    int parameterToken;           // '(' des paramètres
+    int bodyToken;                // '{' du corps
+    bool hasEarlyReturn;          // return ailleurs qu'en dernière instruction
+} VmFunction;
+
+// Appel inliné en cours
+typedef struct {
+    const VmFunction* function;
+    VmValue result;               // Registres réservés par l'appelant
+    uint32_t alive;               // Pixels qui n'ont pas encore retourné (VM_NO_MASK sans return anticipé)
+    int returnCount;
+    bool isDead;                  // Tous les pixels ont retourné : la suite n'est pas compilée
+    int firstVariable;            // Variables visibles : globales et celles de l'appel
+} VmFrame;
+
+typedef struct {
+    VmToken* tokens;
+    int position;
+    VmInstruction* code;
+    int codeCount;
+    int codeCapacity;
+    // Zone fixe : valeurs initiales et constantes déjà créées (registres à relocaliser)
+    uint32_t* fixedValues;
+    bool* isFixedConstant;
+    int fixedCount;
+    uint32_t stackTop;
+    uint32_t stackMax;
+    VmVariable variables[VM_MAX_VARIABLES];
+    int variableCount;
+    int globalCount;
+    VmFunction functions[VM_MAX_FUNCTIONS];
+    int functionCount;
+    VmFrame frames[VM_MAX_INLINE_DEPTH];
+    int frameCount;
+    uint32_t mask;                // Pixels actifs (registre masque), VM_NO_MASK = tous
+    int maskDepth;
+    CpuShader* shader;
+    jmp_buf failure;
+    char* error;
+    size_t errorSize;
+} VmCompiler;
+
+static VmToken* PeekToken(VmCompiler* c) {
+    return &c->tokens[c->position];
+}
+
+static _Noreturn void CompileError(VmCompiler* c, const char* format, ...) {
+    char message[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+    const VmToken* token = PeekToken(c);
+    if (token->kind == VM_TOKEN_END && c->position > 0) token--;
+    if (token->sourceNumber > 0) {
+        snprintf(c->error, c->errorSize, "Fichier %d, ligne %d: %s", token->sourceNumber, token->line, message);
+    } else {
+        snprintf(c->error, c->errorSize, "Ligne %d: %s", token->line, message);
+    }
+    longjmp(c->failure, 1);
+}
+
+static bool IsToken(VmCompiler* c, const char* text) {
+    const VmToken* token = PeekToken(c);
+    return token->kind != VM_TOKEN_END && strcmp(token->text, text) == 0;
+}
+
+static bool AcceptToken(VmCompiler* c, const char* text) {
+    if (!IsToken(c, text)) return false;
+    c->position++;
+    return true;
+}
+
+static void ExpectToken(VmCompiler* c, const char* text) {
+    if (!AcceptToken(c, text)) CompileError(c, "'%s' attendu avant '%s'", text, PeekToken(c)->text);
+}
+
+static const char* ExpectIdentifier(VmCompiler* c) {
+    VmToken* token = PeekToken(c);
+    if (token->kind != VM_TOKEN_IDENTIFIER) CompileError(c, "identifiant attendu avant '%s'", token->text);
+    c->position++;
+    return token->text;
+}
+
+// Fonction pour passer un groupe entre parenthèses, crochets ou accolades (position sur l'ouvrant)
+static void SkipGroup(VmCompiler* c) {
+    int depth = 0;
+    do {
+        const VmToken* token = PeekToken(c);
+        if (token->kind == VM_TOKEN_END) CompileError(c, "fin du fichier inattendue");
+        if (strchr("({[", token->text[0]) && token->kind == VM_TOKEN_PUNCT) depth++;
+        if (strchr(")}]", token->text[0]) && token->kind == VM_TOKEN_PUNCT) depth--;
+        c->position++;
+    } while (depth > 0);
+}
+
+static VmType FindType(const char* name) {
+    for (int i = 0; i < VM_TYPE_COUNT; i++) {
+        if (strcmp(gVmTypeNames[i], name) == 0) return (VmType)i;
+    }
+    return VM_TYPE_COUNT;
+}
+
+static bool IsTypeToken(VmCompiler* c) {
+    return PeekToken(c)->kind == VM_TOKEN_IDENTIFIER && FindType(PeekToken(c)->text) != VM_TYPE_COUNT;
+}
+
+static VmType ParseType(VmCompiler* c) {
+    VmType type = FindType(PeekToken(c)->text);
+    if (PeekToken(c)->kind != VM_TOKEN_IDENTIFIER || type == VM_TYPE_COUNT) {
+        CompileError(c, "type non supporté '%s'", PeekToken(c)->text);
+    }
+    c->position++;
+    if (IsToken(c, "[")) CompileError(c, "tableaux non supportés");
+    return type;
+}
+
+static bool IsVectorType(VmType type) {
+    return type >= VM_TYPE_VEC2 && type <= VM_TYPE_VEC4;
+}
+
+static bool IsMatrixType(VmType type) {
+    return type >= VM_TYPE_MAT2 && type <= VM_TYPE_MAT4;
+}
+
+static bool IsScalarType(VmType type) {
+    return type == VM_TYPE_BOOL || type == VM_TYPE_INT || type == VM_TYPE_FLOAT;
+}
+
+static int GetMatrixSize(VmType type) {
+    return type - VM_TYPE_MAT2 + 2;
+}
+
+static VmType GetVectorType(int size) {
+    return size == 1 ? VM_TYPE_FLOAT : (VmType)(VM_TYPE_VEC2 + size - 2);
+}
+
+static int GetComponentCount(VmType type) {
+    return gVmTypeComponents[type];
+}
+
+// --- Registres et instructions ---
+
+static uint32_t AllocateRegisters(VmCompiler* c, int count) {
+    uint32_t first = c->stackTop;
+    c->stackTop += (uint32_t)count;
+    if (c->stackTop > c->stackMax) c->stackMax = c->stackTop;
+    if (c->stackTop + (uint32_t)c->fixedCount > VM_MAX_REGISTERS) CompileError(c, "shader trop complexe (registres)");
+    return first;
+}
+
+static uint32_t AllocateFixedRegisters(VmCompiler* c, int count, uint32_t value, bool isConstant) {
+    if (c->fixedCount + count + (int)c->stackMax > VM_MAX_REGISTERS) CompileError(c, "shader trop complexe (registres)");
+    uint32_t first = VM_FIXED | (uint32_t)c->fixedCount;
+    for (int i = 0; i < count; i++) {
+        c->fixedValues[c->fixedCount] = value;
+        c->isFixedConstant[c->fixedCount++] = isConstant;
+    }
+    return first;
+}
+
+static uint32_t FloatBits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float BitsFloat(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Fonction pour obtenir le registre d'une constante (partagé entre toutes les utilisations)
+static uint32_t GetConstantRegister(VmCompiler* c, uint32_t bits) {
+    for (int i = 0; i < c->fixedCount; i++) {
+        if (c->isFixedConstant[i] && c->fixedValues[i] == bits) return VM_FIXED | (uint32_t)i;
+    }
+    return AllocateFixedRegisters(c, 1, bits, true);
+}
+
+static uint32_t GetFloatConstant(VmCompiler* c, float value) {
+    return GetConstantRegister(c, FloatBits(value));
+}
+
+static bool GetRegisterConstant(const VmCompiler* c, uint32_t reg, uint32_t* bits) {
+    if (!(reg & VM_FIXED) || !c->isFixedConstant[reg & ~VM_FIXED]) return false;
+    *bits = c->fixedValues[reg & ~VM_FIXED];
+    return true;
+}
+
+static int Emit(VmCompiler* c, uint32_t op, uint32_t dst, uint32_t a, uint32_t b, uint32_t cc) {
+    if (c->codeCount >= c->codeCapacity) {
+        int capacity = c->codeCapacity ? c->codeCapacity * 2 : 1024;
+        VmInstruction* code = realloc(c->code, (size_t)capacity * sizeof(VmInstruction));
+        if (code == NULL) CompileError(c, "mémoire insuffisante");
+        c->code = code;
+        c->codeCapacity = capacity;
+    }
+    c->code[c->codeCount] = (VmInstruction){ op, dst, a, b, cc };
+    return c->codeCount++;
+}
+
+// Arithmétique d'une composante, partagée par le repliement des constantes et les
+// opérations sans équivalent vectoriel (fonctions de libm appelées pixel par pixel)
+static float EvaluateVmFloat(uint32_t op, float a, float b) {
+    switch (op) {
+        case VM_OP_ADD: return a + b;
+        case VM_OP_SUB: return a - b;
+        case VM_OP_MUL: return a * b;
+        case VM_OP_DIV: return a / b;
+        case VM_OP_MIN: return b < a ? b : a;
+        case VM_OP_MAX: return a < b ? b : a;
+        case VM_OP_MOD: return a - b * floorf(a / b);
+        case VM_OP_POW: return powf(a, b);
+        case VM_OP_ATAN2: return atan2f(a, b);
+        case VM_OP_STEP: return b < a ? 0.0f : 1.0f;
+        case VM_OP_NEG: return -a;
+        case VM_OP_FLOOR: return floorf(a);
+        case VM_OP_CEIL: return ceilf(a);
+        case VM_OP_FRACT: return a - floorf(a);
+        case VM_OP_TRUNC: return truncf(a);
+        case VM_OP_ROUND: return roundf(a);
+        case VM_OP_ABS: return fabsf(a);
+        case VM_OP_SIGN: return a > 0.0f ? 1.0f : (a < 0.0f ? -1.0f : 0.0f);
+        case VM_OP_SQRT: return sqrtf(a);
+        case VM_OP_RSQRT: return 1.0f / sqrtf(a);
+        case VM_OP_EXP: return expf(a);
+        case VM_OP_EXP2: return exp2f(a);
+        case VM_OP_LOG: return logf(a);
+        case VM_OP_LOG2: return log2f(a);
+        case VM_OP_SIN: return sinf(a);
+        case VM_OP_COS: return cosf(a);
+        case VM_OP_TAN: return tanf(a);
+        case VM_OP_ASIN: return asinf(a);
+        case VM_OP_ACOS: return acosf(a);
+        case VM_OP_ATAN: return atanf(a);
+        default: return 0.0f;
+    }
+}
+
+static uint32_t EvaluateVmBits(uint32_t op, uint32_t a, uint32_t b) {
+    float x = BitsFloat(a);
+    float y = BitsFloat(b);
+    switch (op) {
+        case VM_OP_LT: return x < y ? 0xFFFFFFFFu : 0;
+        case VM_OP_LE: return x <= y ? 0xFFFFFFFFu : 0;
+        case VM_OP_EQ: return x == y ? 0xFFFFFFFFu : 0;
+        case VM_OP_NE: return x != y ? 0xFFFFFFFFu : 0;
+        case VM_OP_AND: return a & b;
+        case VM_OP_OR: return a | b;
+        case VM_OP_XOR: return a ^ b;
+        case VM_OP_ANDNOT: return a & ~b;
+        case VM_OP_NOT: return ~a;
+        case VM_OP_MASK_TO_FLOAT: return a & FloatBits(1.0f);
+        case VM_OP_FLOAT_TO_MASK: return x != 0.0f ? 0xFFFFFFFFu : 0;
+        default: return FloatBits(EvaluateVmFloat(op, x, y));
+    }
+}
+
+// Fonction pour émettre une opération sur une composante (calculée à la compilation si
+// ses opérandes sont constants). b est ignoré par les opérations unaires.
+static uint32_t EmitOperation(VmCompiler* c, uint32_t op, uint32_t a, uint32_t b) {
+    uint32_t constantA;
+    uint32_t constantB = 0;
+    bool isUnary = !(GetVmOperands(op) & VM_USES_B);
+    if (GetRegisterConstant(c, a, &constantA) && (isUnary || GetRegisterConstant(c, b, &constantB))) {
+        return GetConstantRegister(c, EvaluateVmBits(op, constantA, constantB));
+    }
+    uint32_t dst = AllocateRegisters(c, 1);
+    Emit(c, op, dst, a, isUnary ? 0 : b, 0);
+    return dst;
+}
+
+static uint32_t EmitSelect(VmCompiler* c, uint32_t mask, uint32_t ifTrue, uint32_t ifFalse) {
+    uint32_t bits;
+    if (GetRegisterConstant(c, mask, &bits)) return bits ? ifTrue : ifFalse;
+    if (ifTrue == ifFalse) return ifTrue;
+    uint32_t dst = AllocateRegisters(c, 1);
+    Emit(c, VM_OP_SELECT, dst, mask, ifTrue, ifFalse);
+    return dst;
+}
+
+// Fonction pour rendre un registre modifiable en place (copie d'une constante ou d'une variable)
+static uint32_t CopyRegister(VmCompiler* c, uint32_t reg) {
+    uint32_t dst = AllocateRegisters(c, 1);
+    Emit(c, VM_OP_MOVE, dst, reg, 0, 0);
+    return dst;
+}
+
+// --- Valeurs et variables ---
+
+static VmValue MakeValue(VmType type) {
+    VmValue value;
+    memset(&value, 0, sizeof(value));
+    value.type = type;
+    value.sampler = -1;
+    return value;
+}
+
+// Valeur dans des registres consécutifs de la pile
+static VmValue AllocateValue(VmCompiler* c, VmType type) {
+    VmValue value = MakeValue(type);
+    uint32_t first = AllocateRegisters(c, GetComponentCount(type));
+    for (int i = 0; i < GetComponentCount(type); i++) value.regs[i] = first + (uint32_t)i;
+    return value;
+}
+
+static VmValue ConstantValue(VmCompiler* c, VmType type, float number) {
+    VmValue value = MakeValue(type);
+    uint32_t reg = type == VM_TYPE_BOOL ? GetConstantRegister(c, number != 0.0f ? 0xFFFFFFFFu : 0)
+                                        : GetFloatConstant(c, number);
+    for (int i = 0; i < GetComponentCount(type); i++) value.regs[i] = reg;
+    return value;
+}
+
+static bool IsConstantValue(const VmCompiler* c, const VmValue* value) {
+    uint32_t bits;
+    for (int i = 0; i < GetComponentCount(value->type); i++) {
+        if (!GetRegisterConstant(c, value->regs[i], &bits)) return false;
+    }
+    return true;
+}
+
+static VmValue RValue(VmValue value) {
+    value.isLValue = false;
+    return value;
+}
+
+// Fonction pour appliquer les conversions implicites (int vers float)
+static VmValue ConvertValue(VmCompiler* c, VmValue value, VmType type) {
+    if (value.type == type) return RValue(value);
+    if (value.type == VM_TYPE_INT && type == VM_TYPE_FLOAT) {
+        value.type = VM_TYPE_FLOAT;
+        return RValue(value);
+    }
+    CompileError(c, "type incompatible : %s attendu, %s trouvé", gVmTypeNames[type], gVmTypeNames[value.type]);
+}
+
+// Fonction pour écrire une valeur dans une variable (seulement pour les pixels actifs)
+static void StoreValue(VmCompiler* c, const VmValue* target, VmValue value) {
+    if (!target->isLValue) CompileError(c, "affectation d'une valeur non modifiable");
+    value = ConvertValue(c, value, target->type);
+    // Variable déclarée sous le masque actuel : les pixels inactifs ne la liront plus
+    bool isMasked = c->mask != VM_NO_MASK && target->maskDepth != c->maskDepth;
+    // Les composantes sont d'abord toutes lues (v = v.yx)
+    uint32_t sources[VM_MAX_COMPONENTS];
+    int count = GetComponentCount(target->type);
+    for (int i = 0; i < count; i++) {
+        sources[i] = value.regs[i];
+        for (int j = 0; j < i; j++) {
+            if (target->regs[j] == sources[i]) sources[i] = CopyRegister(c, sources[i]);
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        if (target->regs[i] == sources[i]) continue;
+        if (isMasked) {
+            Emit(c, VM_OP_SELECT, target->regs[i], c->mask, sources[i], target->regs[i]);
+        } else {
+            Emit(c, VM_OP_MOVE, target->regs[i], sources[i], 0, 0);
+        }
+    }
+}
+
+static VmVariable* FindVariable(VmCompiler* c, const char* name) {
+    int first = c->frameCount > 0 ? c->frames[c->frameCount - 1].firstVariable : 0;
+    for (int i = c->variableCount - 1; i >= first; i--) {
+        if (strcmp(c->variables[i].name, name) == 0) return &c->variables[i];
+    }
+    for (int i = c->globalCount - 1; i >= 0 && first > 0; i--) {
+        if (strcmp(c->variables[i].name, name) == 0) return &c->variables[i];
+    }
+    return NULL;
+}
+
+static VmVariable* DeclareVariable(VmCompiler* c, const char* name, const VmValue* value) {
+    if (c->variableCount >= VM_MAX_VARIABLES) CompileError(c, "trop de variables");
+    VmVariable* variable = &c->variables[c->variableCount++];
+    snprintf(variable->name, sizeof(variable->name), "%s", name);
+    variable->value = *value;
+    return variable;
+}
+
+// Variable locale initialisée à zéro (les pixels qui sautent l'initialisation lisent 0)
+static VmValue AllocateVariable(VmCompiler* c, VmType type) {
+    VmValue value = AllocateValue(c, type);
+    value.isLValue = true;
+    value.maskDepth = c->maskDepth;
+    return value;
+}
+
+// --- Expressions ---
+
+static VmValue ParseAssignment(VmCompiler* c);
+static VmValue ParseExpression(VmCompiler* c);
+static VmValue CallFunction(VmCompiler* c, const VmFunction* function, VmValue* arguments, int argumentCount);
+
+// Fonction pour appliquer une opération composante par composante (un scalaire est répété)
+static VmValue ApplyComponents(VmCompiler* c, uint32_t op, VmValue a, VmValue b, VmType type) {
+    VmValue result = MakeValue(type);
+    bool isUnary = !(GetVmOperands(op) & VM_USES_B);
+    for (int i = 0; i < GetComponentCount(type); i++) {
+        uint32_t regA = a.regs[GetComponentCount(a.type) == 1 ? 0 : i];
+        uint32_t regB = isUnary ? 0 : b.regs[GetComponentCount(b.type) == 1 ? 0 : i];
+        result.regs[i] = EmitOperation(c, op, regA, regB);
+    }
+    return result;
+}
+
+static VmValue ApplyUnary(VmCompiler* c, uint32_t op, VmValue a) {
+    return ApplyComponents(c, op, a, a, a.type);
+}
+
+// Type commun de deux opérandes numériques (scalaire répété, int converti en float)
+static VmType GetCommonType(VmCompiler* c, VmValue* a, VmValue* b) {
+    if (a->type == VM_TYPE_BOOL || b->type == VM_TYPE_BOOL || a->type == VM_TYPE_SAMPLER ||
+        b->type == VM_TYPE_SAMPLER || a->type == VM_TYPE_VOID || b->type == VM_TYPE_VOID) {
+        CompileError(c, "opérandes %s et %s incompatibles", gVmTypeNames[a->type], gVmTypeNames[b->type]);
+    }
+    if (a->type == VM_TYPE_INT && b->type == VM_TYPE_INT) return VM_TYPE_INT;
+    if (a->type == VM_TYPE_INT) a->type = VM_TYPE_FLOAT;
+    if (b->type == VM_TYPE_INT) b->type = VM_TYPE_FLOAT;
+    if (a->type == b->type || b->type == VM_TYPE_FLOAT) return a->type;
+    if (a->type == VM_TYPE_FLOAT) return b->type;
+    CompileError(c, "opérandes %s et %s incompatibles", gVmTypeNames[a->type], gVmTypeNames[b->type]);
+}
+
+// Somme des produits a[i] * b[i] sur count composantes espacées de strideA / strideB
+static uint32_t EmitDotProduct(VmCompiler* c, const uint32_t* a, int strideA, const uint32_t* b, int strideB, int count) {
+    uint32_t sum = EmitOperation(c, VM_OP_MUL, a[0], b[0]);
+    for (int i = 1; i < count; i++) {
+        sum = EmitOperation(c, VM_OP_ADD, sum, EmitOperation(c, VM_OP_MUL, a[i * strideA], b[i * strideB]));
+    }
+    return sum;
+}
+
+// Produits matrice x vecteur, vecteur x matrice et matrice x matrice (colonnes d'abord)
+static VmValue MultiplyMatrix(VmCompiler* c, VmValue a, VmValue b) {
+    if (IsMatrixType(a.type) && IsVectorType(b.type) && GetMatrixSize(a.type) == GetComponentCount(b.type)) {
+        int n = GetMatrixSize(a.type);
+        VmValue result = MakeValue(b.type);
+        for (int row = 0; row < n; row++) result.regs[row] = EmitDotProduct(c, a.regs + row, n, b.regs, 1, n);
+        return result;
+    }
+    if (IsVectorType(a.type) && IsMatrixType(b.type) && GetMatrixSize(b.type) == GetComponentCount(a.type)) {
+        int n = GetMatrixSize(b.type);
+        VmValue result = MakeValue(a.type);
+        for (int column = 0; column < n; column++) result.regs[column] = EmitDotProduct(c, a.regs, 1, b.regs + column * n, 1, n);
+        return result;
+    }
+    if (IsMatrixType(a.type) && a.type == b.type) {
+        int n = GetMatrixSize(a.type);
+        VmValue result = MakeValue(a.type);
+        for (int column = 0; column < n; column++) {
+            for (int row = 0; row < n; row++) {
+                result.regs[column * n + row] = EmitDotProduct(c, a.regs + row, n, b.regs + column * n, 1, n);
+            }
+        }
+        return result;
+    }
+    CompileError(c, "produit %s * %s non supporté", gVmTypeNames[a.type], gVmTypeNames[b.type]);
+}
+
+// Fonction pour appliquer + - * / % à deux valeurs
+static VmValue ApplyArithmetic(VmCompiler* c, const char* op, VmValue a, VmValue b) {
+    if (op[0] == '*' && (IsMatrixType(a.type) || IsMatrixType(b.type)) &&
+        !IsScalarType(a.type) && !IsScalarType(b.type)) {
+        return MultiplyMatrix(c, a, b);
+    }
+    VmType type = GetCommonType(c, &a, &b);
+    uint32_t opcode = op[0] == '+' ? VM_OP_ADD : op[0] == '-' ? VM_OP_SUB : op[0] == '*' ? VM_OP_MUL :
+                      op[0] == '/' ? VM_OP_DIV : VM_OP_MOD;
+    VmValue result = ApplyComponents(c, opcode, a, b, type);
+    // Division entière : quotient tronqué
+    if (type == VM_TYPE_INT && opcode == VM_OP_DIV) result = ApplyUnary(c, VM_OP_TRUNC, result);
+    return result;
+}
+
+static VmValue ApplyComparison(VmCompiler* c, const char* op, VmValue a, VmValue b) {
+    VmValue result = MakeValue(VM_TYPE_BOOL);
+    if (strcmp(op, "==") == 0 || strcmp(op, "!=") == 0) {
+        bool isEqual = op[0] == '=';
+        if (a.type == VM_TYPE_BOOL && b.type == VM_TYPE_BOOL) {
+            uint32_t different = EmitOperation(c, VM_OP_XOR, a.regs[0], b.regs[0]);
+            result.regs[0] = isEqual ? EmitOperation(c, VM_OP_NOT, different, 0) : different;
+            return result;
+        }
+        VmType type = GetCommonType(c, &a, &b);
+        if (GetComponentCount(a.type) != GetComponentCount(b.type)) CompileError(c, "comparaison de types différents");
+        // Vecteurs : égaux si toutes les composantes le sont
+        uint32_t all = 0;
+        for (int i = 0; i < GetComponentCount(type); i++) {
+            uint32_t equal = EmitOperation(c, VM_OP_EQ, a.regs[i], b.regs[i]);
+            all = i == 0 ? equal : EmitOperation(c, VM_OP_AND, all, equal);
+        }
+        result.regs[0] = isEqual ? all : EmitOperation(c, VM_OP_NOT, all, 0);
+        return result;
+    }
+    VmType type = GetCommonType(c, &a, &b);
+    if (!IsScalarType(type)) CompileError(c, "comparaison '%s' de %s", op, gVmTypeNames[type]);
+    bool isSwapped = op[0] == '>';
+    bool isOrEqual = op[1] == '=';
+    uint32_t left = isSwapped ? b.regs[0] : a.regs[0];
+    uint32_t right = isSwapped ? a.regs[0] : b.regs[0];
+    result.regs[0] = EmitOperation(c, isOrEqual ? VM_OP_LE : VM_OP_LT, left, right);
+    return result;
+}
+
+static void ExpectBool(VmCompiler* c, const VmValue* value) {
+    if (value->type != VM_TYPE_BOOL) CompileError(c, "bool attendu, %s trouvé", gVmTypeNames[value->type]);
+}
+
+// Fonction pour lire un swizzle (.xy, .rgb...) d'un vecteur ou d'un scalaire
+static VmValue ApplySwizzle(VmCompiler* c, VmValue value, const char* fields) {
+    static const char* sets[] = { "xyzw", "rgba", "stpq" };
+    int length = (int)strlen(fields);
+    int count = GetComponentCount(value.type);
+    if (!(IsVectorType(value.type) || IsScalarType(value.type)) || length < 1 || length > 4) {
+        CompileError(c, "champ '%s' invalide", fields);
+    }
+    VmValue result = value;
+    result.type = length == 1 && IsScalarType(value.type) ? value.type : GetVectorType(length);
+    if (IsScalarType(value.type) && value.type != VM_TYPE_FLOAT && length > 1) CompileError(c, "champ '%s' invalide", fields);
+    // Toutes les lettres d'un swizzle viennent du même ensemble
+    int set = 0;
+    while (set < 2 && strchr(sets[set], fields[0]) == NULL) set++;
+    for (int i = 0; i < length; i++) {
+        const char* position = strchr(sets[set], fields[i]);
+        int index = position ? (int)(position - sets[set]) : -1;
+        if (index < 0 || index >= count) CompileError(c, "champ '%s' invalide pour %s", fields, gVmTypeNames[value.type]);
+        result.regs[i] = value.regs[index];
+        for (int j = 0; j < i; j++) {
+            if (result.regs[j] == result.regs[i]) result.isLValue = false;   // .xx n'est pas modifiable
+        }
+    }
+    return result;
+}
+
+static int ParseConstantIndex(VmCompiler* c) {
+    VmValue index = ParseExpression(c);
+    uint32_t bits;
+    if (!IsScalarType(index.type) || index.type == VM_TYPE_BOOL || !GetRegisterConstant(c, index.regs[0], &bits)) {
+        CompileError(c, "indice constant attendu");
+    }
+    return (int)BitsFloat(bits);
+}
+
+static VmValue ParseCall(VmCompiler* c, const char* name);
+
+static VmValue ParsePrimary(VmCompiler* c) {
+    VmToken* token = PeekToken(c);
+    if (token->kind == VM_TOKEN_NUMBER) {
+        c->position++;
+        return ConstantValue(c, token->isFloat ? VM_TYPE_FLOAT : VM_TYPE_INT, token->number);
+    }
+    if (AcceptToken(c, "(")) {
+        VmValue value = ParseExpression(c);
+        ExpectToken(c, ")");
+        return value;
+    }
+    if (token->kind != VM_TOKEN_IDENTIFIER) CompileError(c, "expression attendue avant '%s'", token->text);
+    c->position++;
+    if (strcmp(token->text, "true") == 0) return ConstantValue(c, VM_TYPE_BOOL, 1.0f);
+    if (strcmp(token->text, "false") == 0) return ConstantValue(c, VM_TYPE_BOOL, 0.0f);
+    if (IsToken(c, "(")) return ParseCall(c, token->text);
+    VmVariable* variable = FindVariable(c, token->text);
+    if (variable == NULL) CompileError(c, "'%s' non déclaré", token->text);
+    return variable->value;
+}
+
+static VmValue ParsePostfix(VmCompiler* c) {
+    VmValue value = ParsePrimary(c);
+    for (;;) {
+        if (AcceptToken(c, ".")) {
+            value = ApplySwizzle(c, value, ExpectIdentifier(c));
+        } else if (AcceptToken(c, "[")) {
+            int index = ParseConstantIndex(c);
+            ExpectToken(c, "]");
+            if (IsMatrixType(value.type)) {
+                int n = GetMatrixSize(value.type);
+                if (index < 0 || index >= n) CompileError(c, "indice %d hors de %s", index, gVmTypeNames[value.type]);
+                VmValue column = value;
+                column.type = GetVectorType(n);
+                for (int i = 0; i < n; i++) column.regs[i] = value.regs[index * n + i];
+                value = column;
+            } else if (IsVectorType(value.type)) {
+                if (index < 0 || index >= GetComponentCount(value.type)) {
+                    CompileError(c, "indice %d hors de %s", index, gVmTypeNames[value.type]);
+                }
+                value.regs[0] = value.regs[index];
+                value.type = VM_TYPE_FLOAT;
+            } else {
+                CompileError(c, "indice sur %s", gVmTypeNames[value.type]);
+            }
+        } else if (IsToken(c, "++") || IsToken(c, "--")) {
+            // Ancienne valeur copiée, puis variable modifiée
+            const char* op = PeekToken(c)->text[0] == '+' ? "+" : "-";
+            c->position++;
+            VmValue old = MakeValue(value.type);
+            for (int i = 0; i < GetComponentCount(value.type); i++) old.regs[i] = CopyRegister(c, value.regs[i]);
+            StoreValue(c, &value, ApplyArithmetic(c, op, old, ConstantValue(c, VM_TYPE_INT, 1.0f)));
+            value = old;
+        } else {
+            return value;
+        }
+    }
+}
+
+static VmValue ParseUnary(VmCompiler* c) {
+    if (AcceptToken(c, "-")) {
+        VmValue value = ParseUnary(c);
+        if (value.type == VM_TYPE_BOOL || GetComponentCount(value.type) == 0) CompileError(c, "'-' sur %s", gVmTypeNames[value.type]);
+        return ApplyUnary(c, VM_OP_NEG, value);
+    }
+    if (AcceptToken(c, "+")) return RValue(ParseUnary(c));
+    if (AcceptToken(c, "!")) {
+        VmValue value = ParseUnary(c);
+        ExpectBool(c, &value);
+        return ApplyUnary(c, VM_OP_NOT, value);
+    }
+    if (IsToken(c, "++") || IsToken(c, "--")) {
+        const char* op = PeekToken(c)->text[0] == '+' ? "+" : "-";
+        c->position++;
+        VmValue value = ParseUnary(c);
+        StoreValue(c, &value, ApplyArithmetic(c, op, value, ConstantValue(c, VM_TYPE_INT, 1.0f)));
+        return RValue(value);
+    }
+    return ParsePostfix(c);
+}
+
+static int GetBinaryPrecedence(const VmToken* token) {
+    static const struct { const char* op; int precedence; } operators[] = {
+        { "||", 1 }, { "^^", 2 }, { "&&", 3 }, { "==", 4 }, { "!=", 4 }, { "<", 5 }, { ">", 5 },
+        { "<=", 5 }, { ">=", 5 }, { "+", 6 }, { "-", 6 }, { "*", 7 }, { "/", 7 }, { "%", 7 }
+    };
+    if (token->kind != VM_TOKEN_PUNCT) return -1;
+    for (size_t i = 0; i < sizeof(operators) / sizeof(operators[0]); i++) {
+        if (strcmp(operators[i].op, token->text) == 0) return operators[i].precedence;
+    }
+    return -1;
+}
+
+// Les deux côtés de && et || sont évalués (pas d'effets de bord dans les shaders visés)
+static VmValue ParseBinary(VmCompiler* c, int minPrecedence) {
+    VmValue left = ParseUnary(c);
+    for (;;) {
+        const VmToken* token = PeekToken(c);
+        int precedence = GetBinaryPrecedence(token);
+        if (precedence < minPrecedence) return left;
+        const char* op = token->text;
+        c->position++;
+        VmValue right = ParseBinary(c, precedence + 1);
+        if (precedence <= 3) {
+            ExpectBool(c, &left);
+            ExpectBool(c, &right);
+            uint32_t opcode = op[0] == '|' ? VM_OP_OR : op[0] == '^' ? VM_OP_XOR : VM_OP_AND;
+            left = ApplyComponents(c, opcode, left, right, VM_TYPE_BOOL);
+        } else if (precedence <= 5) {
+            left = ApplyComparison(c, op, left, right);
+        } else {
+            left = ApplyArithmetic(c, op, left, right);
+        }
+    }
+}
+
+static VmValue ParseConditional(VmCompiler* c) {
+    VmValue condition = ParseBinary(c, 1);
+    if (!AcceptToken(c, "?")) return condition;
+    ExpectBool(c, &condition);
+    VmValue ifTrue = ParseAssignment(c);
+    ExpectToken(c, ":");
+    VmValue ifFalse = ParseAssignment(c);
+    if (ifTrue.type != ifFalse.type) {
+        VmType type = GetCommonType(c, &ifTrue, &ifFalse);
+        ifTrue = ConvertValue(c, ifTrue, type);
+        ifFalse = ConvertValue(c, ifFalse, type);
+    }
+    VmValue result = MakeValue(ifTrue.type);
+    for (int i = 0; i < GetComponentCount(result.type); i++) {
+        result.regs[i] = EmitSelect(c, condition.regs[0], ifTrue.regs[i], ifFalse.regs[i]);
+    }
+    return result;
+}
+
+static VmValue ParseAssignment(VmCompiler* c) {
+    VmValue target = ParseConditional(c);
+    static const char* operators[] = { "=", "+=", "-=", "*=", "/=", "%=" };
+    for (size_t i = 0; i < sizeof(operators) / sizeof(operators[0]); i++) {
+        if (!AcceptToken(c, operators[i])) continue;
+        if (!target.isLValue) CompileError(c, "affectation d'une valeur non modifiable");
+        VmValue value = ParseAssignment(c);
+        if (i > 0) value = ApplyArithmetic(c, operators[i], target, value);
+        StoreValue(c, &target, value);
+        return RValue(target);
+    }
+    return target;
+}
+
+static VmValue ParseExpression(VmCompiler* c) {
+    VmValue value = ParseAssignment(c);
+    while (AcceptToken(c, ",")) value = ParseAssignment(c);
+    return value;
+}
+
+// --- Constructeurs, fonctions intégrées et appels ---
+
+// Composante convertie en flottant (un bool vaut 0 ou 1)
+static uint32_t GetFloatComponent(VmCompiler* c, const VmValue* value, int index) {
+    if (value->type == VM_TYPE_BOOL) return EmitOperation(c, VM_OP_MASK_TO_FLOAT, value->regs[index], 0);
+    return value->regs[index];
+}
+
+static VmValue BuildConstructor(VmCompiler* c, VmType type, VmValue* arguments, int argumentCount) {
+    if (type == VM_TYPE_VOID || type == VM_TYPE_SAMPLER || argumentCount == 0) {
+        CompileError(c, "constructeur %s invalide", gVmTypeNames[type]);
+    }
+    for (int i = 0; i < argumentCount; i++) {
+        if (GetComponentCount(arguments[i].type) == 0) CompileError(c, "argument %s invalide pour %s", gVmTypeNames[arguments[i].type], gVmTypeNames[type]);
+    }
+    VmValue result = MakeValue(type);
+    int count = GetComponentCount(type);
+    const VmValue* first = &arguments[0];
+
+    if (IsScalarType(type)) {
+        if (type == VM_TYPE_BOOL) {
+            result.regs[0] = first->type == VM_TYPE_BOOL ? first->regs[0] : EmitOperation(c, VM_OP_FLOAT_TO_MASK, first->regs[0], 0);
+        } else {
+            result.regs[0] = GetFloatComponent(c, first, 0);
+            // int(x) tronque vers zéro
+            if (type == VM_TYPE_INT && first->type != VM_TYPE_INT && first->type != VM_TYPE_BOOL) {
+                result.regs[0] = EmitOperation(c, VM_OP_TRUNC, result.regs[0], 0);
+            }
+        }
+        return result;
+    }
+
+    uint32_t zero = GetFloatConstant(c, 0.0f);
+    if (IsMatrixType(type) && argumentCount == 1 && (IsScalarType(first->type) || IsMatrixType(first->type))) {
+        // matN(s) : diagonale ; matN(matM) : recouvrement copié, identité ailleurs
+        int n = GetMatrixSize(type);
+        uint32_t diagonal = IsScalarType(first->type) ? GetFloatComponent(c, first, 0) : GetFloatConstant(c, 1.0f);
+        for (int column = 0; column < n; column++) {
+            for (int row = 0; row < n; row++) {
+                result.regs[column * n + row] = column == row ? diagonal : zero;
+                if (IsMatrixType(first->type) && column < GetMatrixSize(first->type) && row < GetMatrixSize(first->type)) {
+                    result.regs[column * n + row] = first->regs[column * GetMatrixSize(first->type) + row];
+                }
+            }
+        }
+        return result;
+    }
+    if (argumentCount == 1 && IsScalarType(first->type)) {
+        uint32_t reg = GetFloatComponent(c, first, 0);
+        for (int i = 0; i < count; i++) result.regs[i] = reg;
+        return result;
+    }
+
+    // Composantes des arguments dans l'ordre (colonnes d'abord pour les matrices)
+    int filled = 0;
+    for (int i = 0; i < argumentCount && filled < count; i++) {
+        for (int j = 0; j < GetComponentCount(arguments[i].type) && filled < count; j++) {
+            result.regs[filled++] = GetFloatComponent(c, &arguments[i], j);
+        }
+    }
+    if (filled < count) CompileError(c, "pas assez de composantes pour %s", gVmTypeNames[type]);
+    return result;
+}
+
+static VmValue ToFloatValue(VmCompiler* c, VmValue value) {
+    if (value.type == VM_TYPE_INT) value.type = VM_TYPE_FLOAT;
+    if (value.type == VM_TYPE_BOOL || GetComponentCount(value.type) == 0 || IsMatrixType(value.type)) {
+        CompileError(c, "argument %s invalide", gVmTypeNames[value.type]);
+    }
+    return RValue(value);
+}
+
+static VmValue ApplyFunction2(VmCompiler* c, uint32_t op, VmValue a, VmValue b) {
+    a = ToFloatValue(c, a);
+    b = ToFloatValue(c, b);
+    return ApplyComponents(c, op, a, b, GetCommonType(c, &a, &b));
+}
+
+static uint32_t EmitDot(VmCompiler* c, VmValue a, VmValue b) {
+    a = ToFloatValue(c, a);
+    b = ToFloatValue(c, b);
+    if (a.type != b.type) CompileError(c, "dot de %s et %s", gVmTypeNames[a.type], gVmTypeNames[b.type]);
+    return EmitDotProduct(c, a.regs, 1, b.regs, 1, GetComponentCount(a.type));
+}
+
+static VmValue ScalarValue(uint32_t reg) {
+    VmValue value = MakeValue(VM_TYPE_FLOAT);
+    value.regs[0] = reg;
+    return value;
+}
+
+static VmValue ApplyClamp(VmCompiler* c, VmValue x, VmValue low, VmValue high) {
+    return ApplyFunction2(c, VM_OP_MIN, ApplyFunction2(c, VM_OP_MAX, x, low), high);
+}
+
+typedef struct {
+    const char* name;
+    uint32_t op;
+} VmBuiltinOp;
+
+static const VmBuiltinOp gVmUnaryBuiltins[] = {
+    { "sin", VM_OP_SIN }, { "cos", VM_OP_COS }, { "tan", VM_OP_TAN }, { "asin", VM_OP_ASIN },
+    { "acos", VM_OP_ACOS }, { "exp", VM_OP_EXP }, { "exp2", VM_OP_EXP2 }, { "log", VM_OP_LOG },
+    { "log2", VM_OP_LOG2 }, { "sqrt", VM_OP_SQRT }, { "inversesqrt", VM_OP_RSQRT }, { "abs", VM_OP_ABS },
+    { "sign", VM_OP_SIGN }, { "floor", VM_OP_FLOOR }, { "ceil", VM_OP_CEIL }, { "fract", VM_OP_FRACT },
+    { "trunc", VM_OP_TRUNC }, { "round", VM_OP_ROUND }
+};
+
+static const VmBuiltinOp gVmBinaryBuiltins[] = {
+    { "pow", VM_OP_POW }, { "mod", VM_OP_MOD }, { "min", VM_OP_MIN }, { "max", VM_OP_MAX }, { "step", VM_OP_STEP }
+};
+
+static void ExpectArgumentCount(VmCompiler* c, const char* name, int argumentCount, int expected) {
+    if (argumentCount != expected) CompileError(c, "%s attend %d arguments", name, expected);
+}
+
+static VmValue CallBuiltin(VmCompiler* c, const char* name, VmValue* arguments, int argumentCount) {
+    for (size_t i = 0; i < sizeof(gVmUnaryBuiltins) / sizeof(gVmUnaryBuiltins[0]); i++) {
+        if (strcmp(gVmUnaryBuiltins[i].name, name) != 0) continue;
+        ExpectArgumentCount(c, name, argumentCount, 1);
+        // abs et sign d'un int restent des int
+        uint32_t op = gVmUnaryBuiltins[i].op;
+        bool keepsInt = arguments[0].type == VM_TYPE_INT && (op == VM_OP_ABS || op == VM_OP_SIGN);
+        VmValue value = keepsInt ? RValue(arguments[0]) : ToFloatValue(c, arguments[0]);
+        return ApplyUnary(c, op, value);
+    }
+    for (size_t i = 0; i < sizeof(gVmBinaryBuiltins) / sizeof(gVmBinaryBuiltins[0]); i++) {
+        if (strcmp(gVmBinaryBuiltins[i].name, name) != 0) continue;
+        ExpectArgumentCount(c, name, argumentCount, 2);
+        return ApplyFunction2(c, gVmBinaryBuiltins[i].op, arguments[0], arguments[1]);
+    }
+    if (strcmp(name, "atan") == 0) {
+        if (argumentCount == 1) return ApplyUnary(c, VM_OP_ATAN, ToFloatValue(c, arguments[0]));
+        ExpectArgumentCount(c, name, argumentCount, 2);
+        return ApplyFunction2(c, VM_OP_ATAN2, arguments[0], arguments[1]);
+    }
+    if (strcmp(name, "radians") == 0 || strcmp(name, "degrees") == 0) {
+        ExpectArgumentCount(c, name, argumentCount, 1);
+        float factor = name[0] == 'r' ? 3.14159265358979f / 180.0f : 180.0f / 3.14159265358979f;
+        return ApplyFunction2(c, VM_OP_MUL, arguments[0], ScalarValue(GetFloatConstant(c, factor)));
+    }
+    if (strcmp(name, "clamp") == 0) {
+        ExpectArgumentCount(c, name, argumentCount, 3);
+        return ApplyClamp(c, arguments[0], arguments[1], arguments[2]);
+    }
+    if (strcmp(name, "mix") == 0) {
+        // x * (1 - a) + y * a : exactement x en 0 et y en 1
+        ExpectArgumentCount(c, name, argumentCount, 3);
+        VmValue one = ScalarValue(GetFloatConstant(c, 1.0f));
+        VmValue x = ApplyFunction2(c, VM_OP_MUL, arguments[0], ApplyFunction2(c, VM_OP_SUB, one, arguments[2]));
+        return ApplyFunction2(c, VM_OP_ADD, x, ApplyFunction2(c, VM_OP_MUL, arguments[1], arguments[2]));
+    }
+    if (strcmp(name, "smoothstep") == 0) {
+        ExpectArgumentCount(c, name, argumentCount, 3);
+        VmValue range = ApplyFunction2(c, VM_OP_SUB, arguments[1], arguments[0]);
+        VmValue t = ApplyFunction2(c, VM_OP_DIV, ApplyFunction2(c, VM_OP_SUB, arguments[2], arguments[0]), range);
+        t = ApplyClamp(c, t, ScalarValue(GetFloatConstant(c, 0.0f)), ScalarValue(GetFloatConstant(c, 1.0f)));
+        VmValue slope = ApplyFunction2(c, VM_OP_SUB, ScalarValue(GetFloatConstant(c, 3.0f)),
+                                       ApplyFunction2(c, VM_OP_MUL, ScalarValue(GetFloatConstant(c, 2.0f)), t));
+        return ApplyFunction2(c, VM_OP_MUL, ApplyFunction2(c, VM_OP_MUL, t, t), slope);
+    }
+    if (strcmp(name, "dot") == 0) {
+        ExpectArgumentCount(c, name, argumentCount, 2);
+        return ScalarValue(EmitDot(c, arguments[0], arguments[1]));
+    }
+    if (strcmp(name, "length") == 0 || strcmp(name, "normalize") == 0) {
+        ExpectArgumentCount(c, name, argumentCount, 1);
+        VmValue length = ScalarValue(EmitOperation(c, VM_OP_SQRT, EmitDot(c, arguments[0], arguments[0]), 0));
+        return name[0] == 'l' ? length : ApplyFunction2(c, VM_OP_DIV, arguments[0], length);
+    }
+    if (strcmp(name, "distance") == 0) {
+        ExpectArgumentCount(c, name, argumentCount, 2);
+        VmValue delta = ApplyFunction2(c, VM_OP_SUB, arguments[0], arguments[1]);
+        return ScalarValue(EmitOperation(c, VM_OP_SQRT, EmitDot(c, delta, delta), 0));
+    }
+    if (strcmp(name, "cross") == 0) {
+        ExpectArgumentCount(c, name, argumentCount, 2);
+        VmValue a = ToFloatValue(c, arguments[0]);
+        VmValue b = ToFloatValue(c, arguments[1]);
+        if (a.type != VM_TYPE_VEC3 || b.type != VM_TYPE_VEC3) CompileError(c, "cross attend deux vec3");
+        VmValue result = MakeValue(VM_TYPE_VEC3);
+        for (int i = 0; i < 3; i++) {
+            int j = (i + 1) % 3;
+            int k = (i + 2) % 3;
+            result.regs[i] = EmitOperation(c, VM_OP_SUB, EmitOperation(c, VM_OP_MUL, a.regs[j], b.regs[k]),
+                                           EmitOperation(c, VM_OP_MUL, a.regs[k], b.regs[j]));
+        }
+        return result;
+    }
+    if (strcmp(name, "texture") == 0 || strcmp(name, "texture2D") == 0 || strcmp(name, "textureLod") == 0) {
+        // Biais et niveau de mip ignorés : les textures n'ont qu'un niveau
+        if (argumentCount < 2 || argumentCount > 3) CompileError(c, "%s attend 2 ou 3 arguments", name);
+        if (arguments[0].type != VM_TYPE_SAMPLER) CompileError(c, "%s attend un sampler2D", name);
+        VmValue uv = ToFloatValue(c, arguments[1]);
+        if (uv.type != VM_TYPE_VEC2) CompileError(c, "%s attend des coordonnées vec2", name);
+        VmValue result = AllocateValue(c, VM_TYPE_VEC4);
+        Emit(c, VM_OP_TEXTURE, result.regs[0], uv.regs[0], uv.regs[1], (uint32_t)arguments[0].sampler);
+        return result;
+    }
+    CompileError(c, "fonction '%s' non supportée", name);
+}
+
+// Fonction pour trouver la surcharge d'une fonction du shader (conversion int vers float permise)
+static const VmFunction* FindFunction(VmCompiler* c, const char* name, const VmValue* arguments, int argumentCount) {
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < c->functionCount; i++) {
+            const VmFunction* function = &c->functions[i];
+            if (strcmp(function->name, name) != 0 || function->parameterCount != argumentCount) continue;
+            bool isMatch = true;
+            for (int j = 0; j < argumentCount && isMatch; j++) {
+                VmType expected = function->parameterTypes[j];
+                isMatch = arguments[j].type == expected ||
+                          (pass == 1 && arguments[j].type == VM_TYPE_INT && expected == VM_TYPE_FLOAT);
+            }
+            if (isMatch) return function;
+        }
+    }
+    return NULL;
+}
+
+static VmValue ParseCall(VmCompiler* c, const char* name) {
+    ExpectToken(c, "(");
+    VmValue arguments[VM_MAX_PARAMETERS];
+    int argumentCount = 0;
+    if (!AcceptToken(c, ")")) {
+        do {
+            if (argumentCount >= VM_MAX_PARAMETERS) CompileError(c, "trop d'arguments");
+            arguments[argumentCount++] = ParseAssignment(c);
+        } while (AcceptToken(c, ","));
+        ExpectToken(c, ")");
+    }
+    VmType type = FindType(name);
+    if (type != VM_TYPE_COUNT) return BuildConstructor(c, type, arguments, argumentCount);
+    const VmFunction* function = FindFunction(c, name, arguments, argumentCount);
+    if (function) return CallFunction(c, function, arguments, argumentCount);
+    for (int i = 0; i < c->functionCount; i++) {
+        if (strcmp(c->functions[i].name, name) == 0) CompileError(c, "aucune surcharge de '%s' pour ces arguments", name);
+    }
+    return CallBuiltin(c, name, arguments, argumentCount);
+}
+
+// --- Instructions ---
+
+static void ParseStatement(VmCompiler* c);
+
+static VmFrame* GetFrame(VmCompiler* c) {
+    return c->frameCount > 0 ? &c->frames[c->frameCount - 1] : NULL;
+}
+
+// Après une instruction contenant un return : les pixels qui ont retourné quittent le masque actuel
+static void ApplyReturns(VmCompiler* c, int returnCount) {
+    VmFrame* frame = GetFrame(c);
+    if (frame == NULL || frame->returnCount == returnCount || frame->isDead) return;
+    if (c->mask != frame->alive) Emit(c, VM_OP_AND, c->mask, c->mask, frame->alive, 0);
+}
+
+#define VM_QUALIFIER_CONST 1u
+#define VM_QUALIFIER_UNIFORM 2u
+#define VM_QUALIFIER_IN 4u
+#define VM_QUALIFIER_OUT 8u
+
+// Fonction pour lire les qualificatifs d'une déclaration (ceux sans effet sur le CPU sont ignorés)
+static unsigned int ParseQualifiers(VmCompiler* c) {
+    static const char* ignored[] = { "highp", "mediump", "lowp", "flat", "smooth", "noperspective", "centroid", "invariant" };
+    unsigned int qualifiers = 0;
+    for (;;) {
+        if (AcceptToken(c, "const")) qualifiers |= VM_QUALIFIER_CONST;
+        else if (AcceptToken(c, "uniform")) qualifiers |= VM_QUALIFIER_UNIFORM;
+        else if (AcceptToken(c, "in") || AcceptToken(c, "varying") || AcceptToken(c, "attribute")) qualifiers |= VM_QUALIFIER_IN;
+        else if (AcceptToken(c, "out")) qualifiers |= VM_QUALIFIER_OUT;
+        else if (AcceptToken(c, "inout")) qualifiers |= VM_QUALIFIER_IN | VM_QUALIFIER_OUT;
+        else if (AcceptToken(c, "layout")) SkipGroup(c);
+        else {
+            bool isIgnored = false;
+            for (size_t i = 0; i < sizeof(ignored) / sizeof(ignored[0]) && !isIgnored; i++) isIgnored = AcceptToken(c, ignored[i]);
+            if (!isIgnored) return qualifiers;
+        }
+    }
+}
+
+static bool IsDeclaration(VmCompiler* c) {
+    if (IsToken(c, "const") || IsToken(c, "highp") || IsToken(c, "mediump") || IsToken(c, "lowp")) return true;
+    return IsTypeToken(c) && c->tokens[c->position + 1].kind == VM_TOKEN_IDENTIFIER;
+}
+
+// Fonction pour lire la valeur d'une constante : gardée telle quelle si elle est connue à
+// la compilation, copiée sinon (const n'exige pas une expression constante depuis GLSL 4.20)
+static VmValue ParseConstValue(VmCompiler* c, VmType type) {
+    VmValue value = ConvertValue(c, ParseAssignment(c), type);
+    if (IsConstantValue(c, &value)) return value;
+    VmValue copy = AllocateVariable(c, type);
+    StoreValue(c, &copy, value);
+    return RValue(copy);
+}
+
+// Déclaration locale. Les registres restent réservés jusqu'à la fin du bloc.
+static void ParseLocalDeclaration(VmCompiler* c) {
+    unsigned int qualifiers = ParseQualifiers(c);
+    if (qualifiers & ~VM_QUALIFIER_CONST) CompileError(c, "qualificatif invalide pour une variable locale");
+    VmType type = ParseType(c);
+    if (GetComponentCount(type) == 0) CompileError(c, "variable de type %s", gVmTypeNames[type]);
+    do {
+        const char* name = ExpectIdentifier(c);
+        if (IsToken(c, "[")) CompileError(c, "tableaux non supportés");
+        if (qualifiers & VM_QUALIFIER_CONST) {
+            ExpectToken(c, "=");
+            VmValue value = ParseConstValue(c, type);
+            DeclareVariable(c, name, &value);
+            continue;
+        }
+        VmValue variable = AllocateVariable(c, type);
+        uint32_t stackTop = c->stackTop;
+        StoreValue(c, &variable, AcceptToken(c, "=") ? ParseAssignment(c) : ConstantValue(c, type, 0.0f));
+        c->stackTop = stackTop;
+        DeclareVariable(c, name, &variable);
+    } while (AcceptToken(c, ","));
+    ExpectToken(c, ";");
+}
+
+static void ParseBlock(VmCompiler* c) {
+    ExpectToken(c, "{");
+    int variableCount = c->variableCount;
+    uint32_t stackTop = c->stackTop;
+    while (!AcceptToken(c, "}")) {
+        if (PeekToken(c)->kind == VM_TOKEN_END) CompileError(c, "'}' manquant");
+        VmFrame* frame = GetFrame(c);
+        if (frame && frame->isDead) {
+            // Tous les pixels ont retourné : la fin du bloc n'est pas compilée
+            int depth = 0;
+            while (depth > 0 || !IsToken(c, "}")) {
+                if (PeekToken(c)->kind == VM_TOKEN_END) CompileError(c, "'}' manquant");
+                if (IsToken(c, "{")) depth++;
+                if (IsToken(c, "}")) depth--;
+                c->position++;
+            }
+            continue;
+        }
+        ParseStatement(c);
+    }
+    c->variableCount = variableCount;
+    c->stackTop = stackTop;
+}
+
+// Fonction pour compiler une instruction exécutée seulement pour les pixels de mask
+static void ParseMaskedStatement(VmCompiler* c, uint32_t mask) {
+    int skip = Emit(c, VM_OP_JUMP_IF_NONE, 0, mask, 0, 0);
+    uint32_t outer = c->mask;
+    int depth = c->maskDepth;
+    c->mask = mask;
+    c->maskDepth = depth + 1;
+    ParseStatement(c);
+    c->mask = outer;
+    c->maskDepth = depth;
+    c->code[skip].c = (uint32_t)c->codeCount;
+}
+
+static void ParseIf(VmCompiler* c) {
+    ExpectToken(c, "(");
+    VmValue condition = ParseExpression(c);
+    ExpectToken(c, ")");
+    ExpectBool(c, &condition);
+    uint32_t outer = c->mask;
+    uint32_t cond = condition.regs[0];
+    ParseMaskedStatement(c, outer == VM_NO_MASK ? cond : EmitOperation(c, VM_OP_AND, outer, cond));
+    if (AcceptToken(c, "else")) {
+        ParseMaskedStatement(c, outer == VM_NO_MASK ? EmitOperation(c, VM_OP_NOT, cond, 0) : EmitOperation(c, VM_OP_ANDNOT, outer, cond));
+    }
+}
+
+// Boucle : les pixels dont la condition devient fausse sortent du masque de la boucle,
+// qui tourne tant qu'il en reste un. Position sur la condition (après '(' et l'initialisation).
+static void ParseLoop(VmCompiler* c, bool hasIncrement) {
+    uint32_t outer = c->mask;
+    int depth = c->maskDepth;
+    uint32_t loopMask = AllocateRegisters(c, 1);
+    Emit(c, outer == VM_NO_MASK ? VM_OP_MASK_ALL : VM_OP_MOVE, loopMask, outer == VM_NO_MASK ? 0 : outer, 0, 0);
+    uint32_t stackTop = c->stackTop;
+    int start = c->codeCount;
+    if (!IsToken(c, hasIncrement ? ";" : ")")) {
+        VmValue condition = ParseExpression(c);
+        ExpectBool(c, &condition);
+        Emit(c, VM_OP_AND, loopMask, loopMask, condition.regs[0], 0);
+        c->stackTop = stackTop;
+    }
+    int exitJump = Emit(c, VM_OP_JUMP_IF_NONE, 0, loopMask, 0, 0);
+
+    // L'incrément est compilé après le corps
+    int incrementPosition = -1;
+    if (hasIncrement) {
+        ExpectToken(c, ";");
+        incrementPosition = c->position;
+        while (!IsToken(c, ")")) {
+            if (IsToken(c, "(")) SkipGroup(c);
+            else if (PeekToken(c)->kind == VM_TOKEN_END) CompileError(c, "')' manquant");
+            else c->position++;
+        }
+    }
+    ExpectToken(c, ")");
+
+    c->mask = loopMask;
+    c->maskDepth = depth + 1;
+    ParseStatement(c);
+    if (incrementPosition >= 0) {
+        int bodyEnd = c->position;
+        c->position = incrementPosition;
+        if (!IsToken(c, ")")) ParseExpression(c);
+        c->stackTop = stackTop;
+        c->position = bodyEnd;
+    }
+    Emit(c, VM_OP_JUMP, 0, 0, 0, (uint32_t)start);
+    c->code[exitJump].c = (uint32_t)c->codeCount;
+    c->mask = outer;
+    c->maskDepth = depth;
+}
+
+static void ParseFor(VmCompiler* c) {
+    int variableCount = c->variableCount;
+    uint32_t stackTop = c->stackTop;
+    ExpectToken(c, "(");
+    if (IsDeclaration(c)) {
+        ParseLocalDeclaration(c);
+    } else {
+        if (!IsToken(c, ";")) ParseExpression(c);
+        ExpectToken(c, ";");
+    }
+    ParseLoop(c, true);
+    c->variableCount = variableCount;
+    c->stackTop = stackTop;
+}
+
+static void ParseReturn(VmCompiler* c) {
+    VmFrame* frame = GetFrame(c);
+    if (frame == NULL) CompileError(c, "return hors d'une fonction");
+    VmType returnType = frame->function->returnType;
+    if (!IsToken(c, ";")) {
+        if (returnType == VM_TYPE_VOID) CompileError(c, "return avec une valeur dans une fonction void");
+        VmValue target = frame->result;
+        target.isLValue = true;
+        // Sans return anticipé, le résultat est écrit une seule fois, pour tous les pixels
+        target.maskDepth = frame->alive == VM_NO_MASK ? c->maskDepth : -1;
+        StoreValue(c, &target, ParseExpression(c));
+    } else if (returnType != VM_TYPE_VOID) {
+        CompileError(c, "return sans valeur");
+    }
+    ExpectToken(c, ";");
+    frame->returnCount++;
+    if (frame->alive == VM_NO_MASK || c->mask == frame->alive) {
+        frame->isDead = true;
+    } else {
+        Emit(c, VM_OP_ANDNOT, frame->alive, frame->alive, c->mask, 0);
+    }
+}
+
+static void ParseStatement(VmCompiler* c) {
+    VmFrame* frame = GetFrame(c);
+    int returnCount = frame ? frame->returnCount : 0;
+    uint32_t stackTop = c->stackTop;
+    if (IsToken(c, "{")) {
+        ParseBlock(c);
+    } else if (AcceptToken(c, ";")) {
+        // Instruction vide
+    } else if (AcceptToken(c, "if")) {
+        ParseIf(c);
+    } else if (AcceptToken(c, "for")) {
+        ParseFor(c);
+    } else if (AcceptToken(c, "while")) {
+        ExpectToken(c, "(");
+        ParseLoop(c, false);
+    } else if (AcceptToken(c, "return")) {
+        ParseReturn(c);
+    } else if (IsToken(c, "break") || IsToken(c, "continue") || IsToken(c, "discard") ||
+               IsToken(c, "do") || IsToken(c, "switch")) {
+        CompileError(c, "'%s' non supporté", PeekToken(c)->text);
+    } else if (IsDeclaration(c)) {
+        ParseLocalDeclaration(c);
+        stackTop = c->stackTop;
+    } else {
+        ParseExpression(c);
+        ExpectToken(c, ";");
+    }
+    c->stackTop = stackTop;
+    ApplyReturns(c, returnCount);
+}
+
+// --- Fonctions ---
+
+// Fonction pour savoir si un corps de fonction contient un return ailleurs qu'en dernière instruction
+static bool HasEarlyReturn(const VmCompiler* c, int bodyToken) {
+    int depth = 0;
+    for (int position = bodyToken; c->tokens[position].kind != VM_TOKEN_END; position++) {
+        const char* text = c->tokens[position].text;
+        if (strcmp(text, "{") == 0) depth++;
+        if (strcmp(text, "}") == 0 && --depth == 0) return false;
+        if (strcmp(text, "return") != 0) continue;
+        if (depth != 1) return true;
+        while (c->tokens[position].kind != VM_TOKEN_END && strcmp(c->tokens[position].text, ";") != 0) position++;
+        if (c->tokens[position].kind == VM_TOKEN_END || strcmp(c->tokens[position + 1].text, "}") != 0) return true;
+    }
+    return false;
+}
+
+// Fonction pour lire la liste des paramètres (position sur '(')
+static int ParseParameterList(VmCompiler* c, VmType* types, unsigned int* qualifiers, const char** names) {
+    ExpectToken(c, "(");
+    if (IsToken(c, "void") && strcmp(c->tokens[c->position + 1].text, ")") == 0) c->position++;
+    int count = 0;
+    while (!AcceptToken(c, ")")) {
+        if (count > 0) ExpectToken(c, ",");
+        if (count >= VM_MAX_PARAMETERS) CompileError(c, "trop de paramètres");
+        qualifiers[count] = ParseQualifiers(c);
+        types[count] = ParseType(c);
+        names[count] = PeekToken(c)->kind == VM_TOKEN_IDENTIFIER ? ExpectIdentifier(c) : "";
+        if (types[count] == VM_TYPE_VOID) CompileError(c, "paramètre void");
+        count++;
+    }
+    return count;
+}
+
+static void DefineFunction(VmCompiler* c, VmType returnType, const char* name) {
+    if (c->functionCount >= VM_MAX_FUNCTIONS) CompileError(c, "trop de fonctions");
+    VmFunction* function = &c->functions[c->functionCount];
+    memset(function, 0, sizeof(*function));
+    snprintf(function->name, sizeof(function->name), "%s", name);
+    function->returnType = returnType;
+    function->parameterToken = c->position;
+    unsigned int qualifiers[VM_MAX_PARAMETERS];
+    const char* names[VM_MAX_PARAMETERS];
+    function->parameterCount = ParseParameterList(c, function->parameterTypes, qualifiers, names);
+    if (AcceptToken(c, ";")) return;   // Prototype : la définition suit
+    if (!IsToken(c, "{")) CompileError(c, "'{' attendu");
+    function->bodyToken = c->position;
+    SkipGroup(c);
+    function->hasEarlyReturn = HasEarlyReturn(c, function->bodyToken);
+    c->functionCount++;
+}
+
+// Fonction pour inliner un appel : paramètres copiés, corps recompilé à chaque appel
+static VmValue CallFunction(VmCompiler* c, const VmFunction* function, VmValue* arguments, int argumentCount) {
+    if (c->frameCount >= VM_MAX_INLINE_DEPTH) CompileError(c, "appels trop imbriqués (récursion non supportée)");
+    VmValue result = function->returnType == VM_TYPE_VOID ? MakeValue(VM_TYPE_VOID) : AllocateValue(c, function->returnType);
+    int callPosition = c->position;
+    uint32_t outerMask = c->mask;
+    int outerDepth = c->maskDepth;
+
+    VmFrame* frame = &c->frames[c->frameCount++];
+    memset(frame, 0, sizeof(*frame));
+    frame->function = function;
+    frame->result = result;
+    frame->alive = VM_NO_MASK;
+    frame->firstVariable = c->variableCount;
+
+    VmType types[VM_MAX_PARAMETERS];
+    unsigned int qualifiers[VM_MAX_PARAMETERS];
+    const char* names[VM_MAX_PARAMETERS];
+    VmValue parameters[VM_MAX_PARAMETERS];
+    c->position = function->parameterToken;
+    ParseParameterList(c, types, qualifiers, names);
+    for (int i = 0; i < argumentCount; i++) {
+        if (qualifiers[i] & VM_QUALIFIER_OUT && !arguments[i].isLValue) {
+            c->position = callPosition;
+            CompileError(c, "argument %d de '%s' non modifiable", i + 1, function->name);
+        }
+        if (types[i] == VM_TYPE_SAMPLER) {
+            parameters[i] = arguments[i];
+        } else {
+            parameters[i] = AllocateVariable(c, types[i]);
+            bool isCopied = !(qualifiers[i] & VM_QUALIFIER_OUT) || (qualifiers[i] & VM_QUALIFIER_IN);
+            StoreValue(c, &parameters[i], isCopied ? arguments[i] : ConstantValue(c, types[i], 0.0f));
+        }
+        DeclareVariable(c, names[i], &parameters[i]);
+    }
+
+    if (function->hasEarlyReturn) {
+        frame->alive = AllocateRegisters(c, 1);
+        Emit(c, outerMask == VM_NO_MASK ? VM_OP_MASK_ALL : VM_OP_MOVE, frame->alive, outerMask == VM_NO_MASK ? 0 : outerMask, 0, 0);
+        c->mask = frame->alive;
+    }
+    c->position = function->bodyToken;
+    ParseBlock(c);
+
+    c->mask = outerMask;
+    c->maskDepth = outerDepth;
+    c->variableCount = frame->firstVariable;
+    c->frameCount--;
+    c->position = callPosition;
+    for (int i = 0; i < argumentCount; i++) {
+        if (qualifiers[i] & VM_QUALIFIER_OUT) StoreValue(c, &arguments[i], parameters[i]);
+    }
+    return result;
+}
+
+// --- Déclarations globales ---
+
+static int GetSamplerSlot(VmCompiler* c, const char* name) {
+    CpuShader* shader = c->shader;
+    for (int i = 0; i < shader->samplerCount; i++) {
+        if (strcmp(shader->samplerNames[i], name) == 0) return i;
+    }
+    if (shader->samplerCount >= VM_MAX_SAMPLERS) CompileError(c, "trop de samplers");
+    if (strlen(name) >= MAX_PASS_NAME) CompileError(c, "nom de sampler trop long");
+    memcpy(shader->samplerNames[shader->samplerCount], name, strlen(name) + 1);
+    return shader->samplerCount++;
+}
+
+static void DeclareGlobal(VmCompiler* c, unsigned int qualifiers, VmType type, const char* name) {
+    CpuShader* shader = c->shader;
+    VmValue value = MakeValue(type);
+    value.maskDepth = -1;
+    int count = GetComponentCount(type);
+    if (type == VM_TYPE_VOID || (type == VM_TYPE_SAMPLER && !(qualifiers & VM_QUALIFIER_UNIFORM))) {
+        CompileError(c, "variable de type %s", gVmTypeNames[type]);
+    }
+
+    if (qualifiers & VM_QUALIFIER_UNIFORM) {
+        int uniform = 0;
+        while (uniform < VM_UNIFORM_COUNT && strcmp(gVmUniformNames[uniform], name) != 0) uniform++;
+        if (type == VM_TYPE_SAMPLER) {
+            value.sampler = GetSamplerSlot(c, name);
+        } else if (uniform < VM_UNIFORM_COUNT && GetVectorType(gVmUniformSizes[uniform]) == type) {
+            uint32_t first = AllocateFixedRegisters(c, count, 0, false);
+            for (int i = 0; i < count; i++) value.regs[i] = first + (uint32_t)i;
+            shader->uniformRegisters[uniform] = (int)(first & ~VM_FIXED);
+        } else {
+            // Uniform que le render graph n'envoie pas : sa valeur initiale (0 par défaut, comme en GL)
+            value = AcceptToken(c, "=") ? ConvertValue(c, ParseAssignment(c), type) : ConstantValue(c, type, 0.0f);
+        }
+    } else if (qualifiers & VM_QUALIFIER_IN) {
+        if (strcmp(name, "fragTexCoord") == 0 && type == VM_TYPE_VEC2) {
+            uint32_t first = AllocateFixedRegisters(c, 2, 0, false);
+            value.regs[0] = first;
+            value.regs[1] = first + 1;
+            shader->texCoordRegister = (int)(first & ~VM_FIXED);
+        } else {
+            // Autres sorties du vertex shader de raylib (fragColor : couleur blanche du quad)
+            value = ConstantValue(c, type, 1.0f);
+        }
+    } else if (qualifiers & VM_QUALIFIER_OUT) {
+        if (type != VM_TYPE_VEC4) CompileError(c, "sortie '%s' : vec4 attendu", name);
+        uint32_t first = AllocateFixedRegisters(c, 4, 0, false);
+        for (int i = 0; i < 4; i++) value.regs[i] = first + (uint32_t)i;
+        value.isLValue = true;
+        if (shader->outputRegister < 0) shader->outputRegister = (int)(first & ~VM_FIXED);
+        StoreValue(c, &value, ConstantValue(c, type, 0.0f));
+    } else if (qualifiers & VM_QUALIFIER_CONST) {
+        ExpectToken(c, "=");
+        value = ParseConstValue(c, type);
+    } else {
+        // Variable globale : initialisée au début de chaque groupe de pixels
+        uint32_t first = AllocateFixedRegisters(c, count, 0, false);
+        for (int i = 0; i < count; i++) value.regs[i] = first + (uint32_t)i;
+        value.isLValue = true;
+        uint32_t stackTop = c->stackTop;
+        StoreValue(c, &value, AcceptToken(c, "=") ? ParseAssignment(c) : ConstantValue(c, type, 0.0f));
+        c->stackTop = stackTop;
+    }
+    DeclareVariable(c, name, &value);
+}
+
+static void ParseGlobal(VmCompiler* c) {
+    if (AcceptToken(c, ";")) return;
+    if (AcceptToken(c, "precision")) {
+        while (!AcceptToken(c, ";")) {
+            if (PeekToken(c)->kind == VM_TOKEN_END) CompileError(c, "';' manquant");
+            c->position++;
+        }
+        return;
+    }
+    if (IsToken(c, "struct")) CompileError(c, "struct non supporté");
+    unsigned int qualifiers = ParseQualifiers(c);
+    if (qualifiers && PeekToken(c)->kind == VM_TOKEN_IDENTIFIER && strcmp(c->tokens[c->position + 1].text, "{") == 0) {
+        CompileError(c, "blocs d'interface non supportés");
+    }
+    VmType type = ParseType(c);
+    const char* name = ExpectIdentifier(c);
+    if (IsToken(c, "(")) {
+        if (qualifiers) CompileError(c, "qualificatif invalide pour la fonction '%s'", name);
+        DefineFunction(c, type, name);
+        return;
+    }
+    for (;;) {
+        if (IsToken(c, "[")) CompileError(c, "tableaux non supportés");
+        DeclareGlobal(c, qualifiers, type, name);
+        if (!AcceptToken(c, ",")) break;
+        name = ExpectIdentifier(c);
+    }
+    ExpectToken(c, ";");
+}
+
+// Fonction pour placer la zone fixe en tête du fichier de registres, la pile après
+static uint32_t RelocateRegister(const VmCompiler* c, uint32_t reg) {
+    return (reg & VM_FIXED) ? reg & ~VM_FIXED : (uint32_t)c->fixedCount + reg;
+}
+
+static void CompileProgram(VmCompiler* c) {
+    while (PeekToken(c)->kind != VM_TOKEN_END) {
+        ParseGlobal(c);
+        c->globalCount = c->variableCount;
+    }
+    const VmFunction* mainFunction = FindFunction(c, "main", NULL, 0);
+    if (mainFunction == NULL || mainFunction->returnType != VM_TYPE_VOID) CompileError(c, "fonction void main() manquante");
+    CallFunction(c, mainFunction, NULL, 0);
+    if (c->shader->outputRegister < 0) CompileError(c, "aucune sortie out vec4");
+
+    for (int i = 0; i < c->codeCount; i++) {
+        VmInstruction* instruction = &c->code[i];
+        unsigned int operands = GetVmOperands(instruction->op);
+        if (operands & VM_USES_DST) instruction->dst = RelocateRegister(c, instruction->dst);
+        if (operands & VM_USES_A) instruction->a = RelocateRegister(c, instruction->a);
+        if (operands & VM_USES_B) instruction->b = RelocateRegister(c, instruction->b);
+        if (operands & VM_USES_C) instruction->c = RelocateRegister(c, instruction->c);
+    }
+}
+
+CpuShader* CompileCpuShader(const char* source, char* error, size_t errorSize) {
+    VmLexer lexer;
+    memset(&lexer, 0, sizeof(lexer));
+    lexer.error = error;
+    lexer.errorSize = errorSize;
+    if (!TokenizeShader(&lexer, source)) {
+        free(lexer.tokens);
+        return NULL;
+    }
+
+    CpuShader* shader = calloc(1, sizeof(CpuShader));
+    VmCompiler* c = calloc(1, sizeof(VmCompiler));
+    if (c) {
+        c->fixedValues = malloc(VM_MAX_REGISTERS * sizeof(uint32_t));
+        c->isFixedConstant = malloc(VM_MAX_REGISTERS * sizeof(bool));
+    }
+    if (shader == NULL || c == NULL || c->fixedValues == NULL || c->isFixedConstant == NULL) {
+        snprintf(error, errorSize, "mémoire insuffisante");
+        if (c) {
+            free(c->fixedValues);
+            free(c->isFixedConstant);
+        }
+        free(c);
+        free(shader);
+        free(lexer.tokens);
+        return NULL;
+    }
+    for (int i = 0; i < VM_UNIFORM_COUNT; i++) shader->uniformRegisters[i] = -1;
+    shader->texCoordRegister = -1;
+    shader->outputRegister = -1;
+    c->tokens = lexer.tokens;
+    c->mask = VM_NO_MASK;
+    c->shader = shader;
+    c->error = error;
+    c->errorSize = errorSize;
+
+    if (setjmp(c->failure) == 0) {
+        CompileProgram(c);
+        shader->code = c->code;
+        shader->codeCount = c->codeCount;
+        shader->fixedValues = c->fixedValues;
+        shader->fixedCount = c->fixedCount;
+        shader->registerCount = c->fixedCount + (int)c->stackMax;
+    } else {
+        free(c->code);
+        free(c->fixedValues);
+        free(shader);
+        shader = NULL;
+    }
+    free(c->isFixedConstant);
+    free(c);
+    free(lexer.tokens);
+    return shader;
+}
+
+void UnloadCpuShader(CpuShader* shader) {
+    if (shader == NULL) return;
+    free(shader->code);
+    free(shader->fixedValues);
+    free(shader);
+}
+
+bool CpuShaderUsesUniform(const CpuShader* shader, const char* name) {
+    for (int i = 0; i < VM_UNIFORM_COUNT; i++) {
+        if (strcmp(gVmUniformNames[i], name) == 0) return shader->uniformRegisters[i] >= 0;
+    }
+    for (int i = 0; i < shader->samplerCount; i++) {
+        if (strcmp(shader->samplerNames[i], name) == 0) return true;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// Exécution : VM_LANES pixels par instruction
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    const unsigned char* pixels;  // RGBA8, NULL = noir transparent
+    int width;
+    int height;
+    bool isBilinear;
+} VmSampler;
+
+typedef enum {
+    VM_JOB_OK,
+    VM_JOB_OUT_OF_MEMORY,
+    VM_JOB_LOOP_LIMIT
+} VmJobStatus;
+
+typedef struct {
+    const CpuShader* shader;
+    VmSampler samplers[VM_MAX_SAMPLERS];
+    float uniforms[VM_UNIFORM_COUNT][2];
+    unsigned char* output;
+    int width;                    // Taille de la cible (et des coordonnées de texture)
+    int height;
+    int left;                     // Zone exécutée [left, right) x [top, bottom)
+    int top;
+    int right;
+    int bottom;
+    CpuSimdLevel simd;
+    atomic_int status;
+} VmJob;
+
+static float gVmByteToFloat[256];
+
+static void InitVmByteTable(void) {
+    if (gVmByteToFloat[255] == 1.0f) return;
+    for (int i = 0; i < 256; i++) gVmByteToFloat[i] = (float)i / 255.0f;
+}
+
+// Fonction pour lire un sampler (GL_REPEAT, au plus proche ou bilinéaire) pour chaque pixel.
+// Les coordonnées sont calculées dans une boucle vectorisable, les texels lus ensuite.
+static inline __attribute__((always_inline)) void SampleVmTexture(const VmSampler* sampler, const float* u, const float* v, float* rgba) {
+    if (sampler->pixels == NULL) {
+        memset(rgba, 0, 4 * VM_LANES * sizeof(float));
+        return;
+    }
+    int width = sampler->width;
+    int height = sampler->height;
+    int x0[VM_LANES];
+    int y0[VM_LANES];
+    float tx[VM_LANES];
+    float ty[VM_LANES];
+    for (int i = 0; i < VM_LANES; i++) {
+        // Coordonnée bornée : les valeurs énormes ou NaN des pixels inactifs restent lisibles
+        float x = u[i] > -1e7f ? u[i] : -1e7f;
+        float y = v[i] > -1e7f ? v[i] : -1e7f;
+        x = x < 1e7f ? x : 1e7f;
+        y = y < 1e7f ? y : 1e7f;
+        float fx = (x - floorf(x)) * width;
+        float fy = (y - floorf(y)) * height;
+        if (sampler->isBilinear) {
+            fx -= 0.5f;
+            fy -= 0.5f;
+        }
+        float cx = floorf(fx);
+        float cy = floorf(fy);
+        tx[i] = fx - cx;
+        ty[i] = fy - cy;
+        x0[i] = (int)cx;
+        y0[i] = (int)cy;
+    }
+
+    const unsigned char* pixels = sampler->pixels;
+    if (!sampler->isBilinear) {
+        for (int i = 0; i < VM_LANES; i++) {
+            int px = x0[i] < width ? x0[i] : width - 1;
+            int py = y0[i] < height ? y0[i] : height - 1;
+            const unsigned char* texel = pixels + ((size_t)py * width + px) * 4;
+            for (int k = 0; k < 4; k++) rgba[k * VM_LANES + i] = gVmByteToFloat[texel[k]];
+        }
+        return;
+    }
+    for (int i = 0; i < VM_LANES; i++) {
+        // Voisins bouclés : x0 va de -1 à width - 1
+        int ix0 = x0[i] < 0 ? width - 1 : (x0[i] < width ? x0[i] : width - 1);
+        int iy0 = y0[i] < 0 ? height - 1 : (y0[i] < height ? y0[i] : height - 1);
+        int ix1 = ix0 + 1 < width ? ix0 + 1 : 0;
+        int iy1 = iy0 + 1 < height ? iy0 + 1 : 0;
+        const unsigned char* row0 = pixels + (size_t)iy0 * width * 4;
+        const unsigned char* row1 = pixels + (size_t)iy1 * width * 4;
+        for (int k = 0; k < 4; k++) {
+            float c00 = gVmByteToFloat[row0[ix0 * 4 + k]];
+            float c10 = gVmByteToFloat[row0[ix1 * 4 + k]];
+            float c01 = gVmByteToFloat[row1[ix0 * 4 + k]];
+            float c11 = gVmByteToFloat[row1[ix1 * 4 + k]];
+            float top = c00 + (c10 - c00) * tx[i];
+            float bottom = c01 + (c11 - c01) * tx[i];
+            rgba[k * VM_LANES + i] = top + (bottom - top) * ty[i];
+        }
+    }
+}
+
+// Les opérations vectorielles passent par des macros : des fonctions prenant des
+// vecteurs de 256 bits changeraient d'ABI selon la cible (avx2 ou non)
+#define VM_SELECT(mask, a, b) ((VmVector)(((VmMaskVector)(a) & (mask)) | ((VmMaskVector)(b) & ~(mask))))
+#define VM_FOR_VECTORS for (int v = 0; v < VM_VECTORS; v++)
+#define VM_FOR_LANES for (int i = 0; i < VM_LANES; i++)
+
+// Fonction pour exécuter le programme sur un groupe de pixels (false si une boucle ne
+// se termine pas). Inlinée dans une version par jeu d'instructions.
+static inline __attribute__((always_inline)) bool RunVmProgram(const CpuShader* shader, float* registers, const VmSampler* samplers) {
+    const VmInstruction* code = shader->code;
+    int jumpCount = 0;
+    const VmVector one = { 1, 1, 1, 1, 1, 1, 1, 1 };
+    const VmVector zero = { 0 };
+    const VmMaskVector allBits = { -1, -1, -1, -1, -1, -1, -1, -1 };
+    const VmMaskVector oneBits = (VmMaskVector)one;
+    const VmMaskVector absBits = allBits & ~(VmMaskVector)(-zero);   // Tout sauf le bit de signe
+    for (int pc = 0; pc < shader->codeCount; pc++) {
+        const VmInstruction* in = &code[pc];
+        VmVector* d = (VmVector*)(registers + (size_t)in->dst * VM_LANES);
+        const VmVector* a = (const VmVector*)(registers + (size_t)in->a * VM_LANES);
+        const VmVector* b = (const VmVector*)(registers + (size_t)in->b * VM_LANES);
+        VmMaskVector* dm = (VmMaskVector*)d;
+        const VmMaskVector* am = (const VmMaskVector*)a;
+        const VmMaskVector* bm = (const VmMaskVector*)b;
+        float* df = (float*)d;
+        const float* af = (const float*)a;
+        const float* bf = (const float*)b;
+        switch (in->op) {
+            case VM_OP_MOVE: VM_FOR_VECTORS d[v] = a[v]; break;
+            case VM_OP_SELECT: {
+                const VmVector* c = (const VmVector*)(registers + (size_t)in->c * VM_LANES);
+                VM_FOR_VECTORS d[v] = VM_SELECT(am[v], b[v], c[v]);
+                break;
+            }
+            case VM_OP_ADD: VM_FOR_VECTORS d[v] = a[v] + b[v]; break;
+            case VM_OP_SUB: VM_FOR_VECTORS d[v] = a[v] - b[v]; break;
+            case VM_OP_MUL: VM_FOR_VECTORS d[v] = a[v] * b[v]; break;
+            case VM_OP_DIV: VM_FOR_VECTORS d[v] = a[v] / b[v]; break;
+            case VM_OP_MIN: VM_FOR_VECTORS d[v] = VM_SELECT(b[v] < a[v], b[v], a[v]); break;
+            case VM_OP_MAX: VM_FOR_VECTORS d[v] = VM_SELECT(a[v] < b[v], b[v], a[v]); break;
+            case VM_OP_STEP: VM_FOR_VECTORS d[v] = VM_SELECT(b[v] < a[v], zero, one); break;
+            case VM_OP_NEG: VM_FOR_VECTORS d[v] = -a[v]; break;
+            case VM_OP_ABS: VM_FOR_VECTORS d[v] = (VmVector)(am[v] & absBits); break;
+            case VM_OP_SIGN:
+                VM_FOR_VECTORS d[v] = VM_SELECT(zero < a[v], one, VM_SELECT(a[v] < zero, -one, zero));
+                break;
+            case VM_OP_LT: VM_FOR_VECTORS dm[v] = a[v] < b[v]; break;
+            case VM_OP_LE: VM_FOR_VECTORS dm[v] = a[v] <= b[v]; break;
+            case VM_OP_EQ: VM_FOR_VECTORS dm[v] = a[v] == b[v]; break;
+            case VM_OP_NE: VM_FOR_VECTORS dm[v] = a[v] != b[v]; break;
+            case VM_OP_AND: VM_FOR_VECTORS dm[v] = am[v] & bm[v]; break;
+            case VM_OP_OR: VM_FOR_VECTORS dm[v] = am[v] | bm[v]; break;
+            case VM_OP_XOR: VM_FOR_VECTORS dm[v] = am[v] ^ bm[v]; break;
+            case VM_OP_ANDNOT: VM_FOR_VECTORS dm[v] = am[v] & ~bm[v]; break;
+            case VM_OP_NOT: VM_FOR_VECTORS dm[v] = ~am[v]; break;
+            case VM_OP_MASK_ALL: VM_FOR_VECTORS dm[v] = allBits; break;
+            case VM_OP_MASK_TO_FLOAT: VM_FOR_VECTORS dm[v] = am[v] & oneBits; break;
+            case VM_OP_FLOAT_TO_MASK: VM_FOR_VECTORS dm[v] = a[v] != zero; break;
+            // Fonctions de libm, pixel par pixel (mêmes résultats que le repliement des constantes)
+            case VM_OP_MOD: VM_FOR_LANES df[i] = af[i] - bf[i] * floorf(af[i] / bf[i]); break;
+            case VM_OP_POW: VM_FOR_LANES df[i] = powf(af[i], bf[i]); break;
+            case VM_OP_ATAN2: VM_FOR_LANES df[i] = atan2f(af[i], bf[i]); break;
+            case VM_OP_FLOOR: VM_FOR_LANES df[i] = floorf(af[i]); break;
+            case VM_OP_CEIL: VM_FOR_LANES df[i] = ceilf(af[i]); break;
+            case VM_OP_FRACT: VM_FOR_LANES df[i] = af[i] - floorf(af[i]); break;
+            case VM_OP_TRUNC: VM_FOR_LANES df[i] = truncf(af[i]); break;
+            case VM_OP_ROUND: VM_FOR_LANES df[i] = roundf(af[i]); break;
+            case VM_OP_SQRT: VM_FOR_LANES df[i] = sqrtf(af[i]); break;
+            case VM_OP_RSQRT: VM_FOR_LANES df[i] = 1.0f / sqrtf(af[i]); break;
+            case VM_OP_EXP: VM_FOR_LANES df[i] = expf(af[i]); break;
+            case VM_OP_EXP2: VM_FOR_LANES df[i] = exp2f(af[i]); break;
+            case VM_OP_LOG: VM_FOR_LANES df[i] = logf(af[i]); break;
+            case VM_OP_LOG2: VM_FOR_LANES df[i] = log2f(af[i]); break;
+            case VM_OP_SIN: VM_FOR_LANES df[i] = sinf(af[i]); break;
+            case VM_OP_COS: VM_FOR_LANES df[i] = cosf(af[i]); break;
+            case VM_OP_TAN: VM_FOR_LANES df[i] = tanf(af[i]); break;
+            case VM_OP_ASIN: VM_FOR_LANES df[i] = asinf(af[i]); break;
+            case VM_OP_ACOS: VM_FOR_LANES df[i] = acosf(af[i]); break;
+            case VM_OP_ATAN: VM_FOR_LANES df[i] = atanf(af[i]); break;
+            case VM_OP_TEXTURE: SampleVmTexture(&samplers[in->c], af, bf, df); break;
+            case VM_OP_JUMP:
+                // Saut en arrière : un tour de boucle de plus
+                if ((int)in->c <= pc && ++jumpCount > VM_MAX_LOOP_JUMPS) return false;
+                pc = (int)in->c - 1;
+                break;
+            case VM_OP_JUMP_IF_NONE: {
+                VmMaskVector any = am[0];
+                for (int v = 1; v < VM_VECTORS; v++) any |= am[v];
+                bool isNone = true;
+                for (int k = 0; k < VM_VECTOR_FLOATS; k++) isNone &= any[k] == 0;
+                if (isNone) pc = (int)in->c - 1;
+                break;
+            }
+            default: break;
+        }
+    }
+    return true;
+}
+
+static bool RunVmProgramDefault(const CpuShader* shader, float* registers, const VmSampler* samplers) {
+    return RunVmProgram(shader, registers, samplers);
+}
+
+#if defined(CPU_SHADER_X86)
+__attribute__((target("avx2")))
+static bool RunVmProgramAvx2(const CpuShader* shader, float* registers, const VmSampler* samplers) {
+    return RunVmProgram(shader, registers, samplers);
+}
+#endif
+
+static void FillVmRegister(float* registers, int reg, uint32_t bits) {
+    uint32_t* lanes = (uint32_t*)(registers + (size_t)reg * VM_LANES);
+    for (int i = 0; i < VM_LANES; i++) lanes[i] = bits;
+}
+
+static unsigned char VmFloatToByte(float value) {
+    if (!(value > 0.0f)) return 0;   // NaN compris
+    if (value >= 1.0f) return 255;
+    return (unsigned char)(value * 255.0f + 0.5f);
+}
+
+// Fonction pour exécuter le shader sur les lignes [rowStart, rowEnd) de la zone
+static void RunVmRows(void* context, int rowStart, int rowEnd) {
+    VmJob* job = context;
+    const CpuShader* shader = job->shader;
+    void* allocation = malloc((size_t)shader->registerCount * VM_LANES * sizeof(float) + 63);
+    if (allocation == NULL) {
+        atomic_store(&job->status, VM_JOB_OUT_OF_MEMORY);
+        return;
+    }
+    float* registers = (float*)(((uintptr_t)allocation + 63) & ~(uintptr_t)63);
+    for (int i = 0; i < shader->fixedCount; i++) FillVmRegister(registers, i, shader->fixedValues[i]);
+    for (int u = 0; u < VM_UNIFORM_COUNT; u++) {
+        if (shader->uniformRegisters[u] < 0) continue;
+        for (int k = 0; k < gVmUniformSizes[u]; k++) {
+            FillVmRegister(registers, shader->uniformRegisters[u] + k, FloatBits(job->uniforms[u][k]));
+        }
+    }
+
+    int regionWidth = job->right - job->left;
+    int first = rowStart * regionWidth;
+    int last = rowEnd * regionWidth;
+    int pixelX[VM_LANES];
+    int pixelY[VM_LANES];
+    const float* output = registers + (size_t)shader->outputRegister * VM_LANES;
+    for (int base = first; base < last; base += VM_LANES) {
+        // Pixels de la zone à la suite ; les voies en trop répètent le dernier pixel
+        int lanes = last - base < VM_LANES ? last - base : VM_LANES;
+        for (int i = 0; i < VM_LANES; i++) {
+            int index = base + (i < lanes ? i : lanes - 1);
+            pixelX[i] = job->left + index % regionWidth;
+            pixelY[i] = job->top + index / regionWidth;
+        }
+        if (shader->texCoordRegister >= 0) {
+            float* u = registers + (size_t)shader->texCoordRegister * VM_LANES;
+            float* v = u + VM_LANES;
+            for (int i = 0; i < VM_LANES; i++) {
+                u[i] = (pixelX[i] + 0.5f) / job->width;
+                v[i] = (pixelY[i] + 0.5f) / job->height;
+            }
+        }
+
+        bool isFinished;
+        #if defined(CPU_SHADER_X86)
+        if (job->simd >= CPU_SIMD_AVX2) isFinished = RunVmProgramAvx2(shader, registers, job->samplers);
+        else isFinished = RunVmProgramDefault(shader, registers, job->samplers);
+        #else
+        isFinished = RunVmProgramDefault(shader, registers, job->samplers);
+        #endif
+        if (!isFinished) {
+            atomic_store(&job->status, VM_JOB_LOOP_LIMIT);
+            break;
+        }
+
+        for (int i = 0; i < lanes; i++) {
+            unsigned char* pixel = job->output + ((size_t)pixelY[i] * job->width + pixelX[i]) * 4;
+            for (int k = 0; k < 4; k++) pixel[k] = VmFloatToByte(output[k * VM_LANES + i]);
+        }
+    }
+    free(allocation);
+}
+
+// ---------------------------------------------------------------------------
+// Graphe de passes
+// ---------------------------------------------------------------------------
+
+bool LoadCpuShaderGraph(const char* path, CpuShaderGraph* graph, char* error, size_t errorSize) {
+    memset(graph, 0, sizeof(*graph));
+    char* source = PreprocessShaderFile(path, NULL, error, errorSize);
+    if (source == NULL) return false;
+    bool success = ParseRenderGraph(source, &graph->desc, error, errorSize);
+    if (graph->desc.qualityLevels < 1) graph->desc.qualityLevels = 1;
+
+    for (int i = 0; success && i < graph->desc.passCount; i++) {
+        const RenderPassDesc* pass = &graph->desc.passes[i];
+        graph->inputPass[i] = -1;
+        for (int j = 0; j < i && strcmp(pass->input, "source") != 0; j++) {
+            if (strcmp(graph->desc.passes[j].name, pass->input) == 0) graph->inputPass[i] = j;
+        }
+        // Programme générique du niveau de qualité complète
+        int programIndex = (graph->desc.qualityLevels - 1) * graph->desc.passCount + i;
+        char* passSource = BuildRenderPassSource(source, &graph->desc, programIndex, NULL);
+        if (passSource == NULL) {
+            snprintf(error, errorSize, "mémoire insuffisante");
+            success = false;
+            break;
+        }
+        char passError[512];
+        graph->programs[i] = CompileCpuShader(passSource, passError, sizeof(passError));
+        free(passSource);
+        if (graph->programs[i] == NULL) {
+            if (graph->desc.passCount > 1) snprintf(error, errorSize, "Passe %s: %s", pass->name, passError);
+            else snprintf(error, errorSize, "%s", passError);
+            success = false;
+        }
+    }
+    free(source);
+    if (!success) UnloadCpuShaderGraph(graph);
+    return success;
+}
+
+void UnloadCpuShaderGraph(CpuShaderGraph* graph) {
+    for (int i = 0; i < MAX_RENDER_PASSES; i++) UnloadCpuShader(graph->programs[i]);
+    memset(graph, 0, sizeof(*graph));
+}
+
+static VmSampler MakeVmSampler(Image image, bool isBilinear) {
+    return (VmSampler){ image.data, image.width, image.height, isBilinear };
+}
+
+bool RenderCpuShaderGraph(const CpuShaderGraph* graph, Image source, Image* output, const EffectParams* params) {
+    int passCount = graph->desc.passCount;
+    if (passCount < 1 || graph->programs[passCount - 1] == NULL || source.data == NULL || output->data == NULL ||
+        source.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 || output->format != source.format ||
+        output->width != source.width || output->height != source.height) {
+        return false;
+    }
+    InitVmByteTable();
+
+    // Sorties des passes intermédiaires (RGBA8 comme les cibles du GPU), à leur échelle
+    Image targets[MAX_RENDER_PASSES];
+    memset(targets, 0, sizeof(targets));
+    bool success = true;
+    for (int i = 0; i < passCount && success; i++) {
+        const CpuShader* shader = graph->programs[i];
+        bool isFinal = i == passCount - 1;
+        Image target = *output;
+        if (!isFinal) {
+            float scale = graph->desc.passes[i].scale;
+            target.width = (int)(source.width * scale + 0.5f);
+            target.height = (int)(source.height * scale + 0.5f);
+            if (target.width < 1) target.width = 1;
+            if (target.height < 1) target.height = 1;
+            target.data = malloc((size_t)target.width * target.height * 4);
+            if (target.data == NULL) {
+                LOG_ERRORF("Out of memory for CPU shader pass '%s'", graph->desc.passes[i].name);
+                success = false;
+                break;
+            }
+            targets[i] = target;
+        }
+        Image input = graph->inputPass[i] < 0 ? source : targets[graph->inputPass[i]];
+        bool isInputBilinear = graph->inputPass[i] >= 0;
+
+        VmJob job;
+        memset(&job, 0, sizeof(job));
+        job.shader = shader;
+        job.output = target.data;
+        job.width = target.width;
+        job.height = target.height;
+        job.right = target.width;
+        job.bottom = target.height;
+        job.simd = GetCpuFilterSimd();
+        atomic_init(&job.status, VM_JOB_OK);
+
+        // Samplers liés par nom, comme dans RunRenderPasses ; un sampler sans texture lit
+        // l'unité 0 (texture0)
+        for (int s = 0; s < shader->samplerCount; s++) {
+            const char* name = shader->samplerNames[s];
+            job.samplers[s] = MakeVmSampler(input, isInputBilinear);
+            if (strcmp(name, "sourceTexture") == 0) job.samplers[s] = MakeVmSampler(source, false);
+            for (int j = 0; j < i; j++) {
+                if (strcmp(name, graph->desc.passes[j].name) == 0) job.samplers[s] = MakeVmSampler(targets[j], true);
+            }
+        }
+        job.uniforms[VM_UNIFORM_TIME][0] = params->time;
+        job.uniforms[VM_UNIFORM_MOUSE_POS][0] = params->mousePos.x;
+        job.uniforms[VM_UNIFORM_MOUSE_POS][1] = params->mousePos.y;
+        job.uniforms[VM_UNIFORM_RADIUS][0] = params->radius;
+        job.uniforms[VM_UNIFORM_POWER][0] = params->power;
+        job.uniforms[VM_UNIFORM_RESOLUTION][0] = (float)source.width;
+        job.uniforms[VM_UNIFORM_RESOLUTION][1] = (float)source.height;
+        job.uniforms[VM_UNIFORM_PASS_RESOLUTION][0] = (float)target.width;
+        job.uniforms[VM_UNIFORM_PASS_RESOLUTION][1] = (float)target.height;
+        job.uniforms[VM_UNIFORM_INPUT_RESOLUTION][0] = (float)input.width;
+        job.uniforms[VM_UNIFORM_INPUT_RESOLUTION][1] = (float)input.height;
+
+        // Effet borné : image d'origine partout, shader seulement sur les pixels dont le
+        // centre est dans le carré autour du curseur (comme la rastérisation du quad)
+        if (isFinal && graph->desc.boundRadiusScale > 0.0f) {
+            memcpy(output->data, source.data, (size_t)source.width * source.height * 4);
+            float extent = params->radius * graph->desc.boundRadiusScale + 1.0f;
+            float left = fmaxf(params->mousePos.x - extent, 0.0f);
+            float top = fmaxf(params->mousePos.y - extent, 0.0f);
+            float right = fminf(params->mousePos.x + extent, (float)source.width);
+            float bottom = fminf(params->mousePos.y + extent, (float)source.height);
+            if (right <= left || bottom <= top) break;
+            job.left = (int)ceilf(left - 0.5f);
+            job.top = (int)ceilf(top - 0.5f);
+            job.right = (int)ceilf(right - 0.5f);
+            job.bottom = (int)ceilf(bottom - 0.5f);
+            if (job.right <= job.left || job.bottom <= job.top) break;
+        }
+
+        RunCpuRowTasks(job.bottom - job.top, VM_BAND_ROWS, RunVmRows, &job);
+        int status = atomic_load(&job.status);
+        if (status == VM_JOB_OUT_OF_MEMORY) {
+            LOG_ERRORF("Out of memory for CPU shader pass '%s'", graph->desc.passes[i].name);
+            success = false;
+        } else if (status == VM_JOB_LOOP_LIMIT) {
+            LOG_ERRORF("CPU shader pass '%s' exceeded %d loop iterations", graph->desc.passes[i].name, VM_MAX_LOOP_JUMPS);
+            success = false;
+        }
+    }
+    for (int i = 0; i < MAX_RENDER_PASSES; i++) free(targets[i].data);
+    return success;
+}
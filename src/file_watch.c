@@ -0,0 +1,564 @@
+#include "file_watch.h"
+#include "logger.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h> // Pour parcourir les répertoires
+#include <sys/stat.h> // Pour stat()
+#include <unistd.h>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN // Exclure les en-têtes inutiles de Windows
+#include <windows.h> // Pour FindFirstChangeNotification
+#elif defined(__linux__)
+#include <sys/inotify.h>
+#include <poll.h>
+#define FILE_WATCH_HAS_INOTIFY 1
+#endif
+
+#define FILE_WATCH_DEBOUNCE_SECONDS 0.010 // Regroupe les écritures multiples d'une sauvegarde
+#define FILE_WATCH_POLL_INTERVAL_MS 250   // Période de scrutation du mode de secours
+
+typedef enum {
+    WATCH_BACKEND_POLLING,
+    WATCH_BACKEND_INOTIFY,
+    WATCH_BACKEND_WIN32
+} FileWatchBackend;
+
+// Entrée de l'instantané d'un dossier (mode scrutation / Windows)
+typedef struct {
+    char name[FILE_WATCH_MAX_PATH];
+    long long modTime;       // En nanosecondes quand le système le permet
+    long long size;
+    bool isDirectory;
+    bool seen;
+} SnapshotEntry;
+
+// Structure pour un dossier surveillé
+typedef struct {
+    char path[FILE_WATCH_MAX_PATH];
+    int wd;                  // Descripteur inotify
+    #ifdef _WIN32
+    HANDLE changeHandle;
+    #endif
+    SnapshotEntry* entries;
+    int entryCount;
+    int entryCapacity;
+} WatchedDirectory;
+
+// Événement en attente de la fin du délai anti-rebond
+typedef struct {
+    FileWatchEvent event;
+    double lastTime;
+} PendingEvent;
+
+// Structure globale de surveillance des fichiers
+typedef struct {
+    FileWatchBackend backend;
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    atomic_bool running;
+    atomic_int pendingCount;
+    WatchedDirectory* directories;
+    int directoryCount;
+    int directoryCapacity;
+    PendingEvent* pending;
+    int pendingCapacity;
+    int inotifyFd;
+    int wakePipe[2];
+    #ifdef _WIN32
+    HANDLE wakeEvent;
+    #endif
+    bool isInitialized;
+} FileWatch;
+
+static FileWatch gFileWatch = {0};
+
+static double GetMonotonicSeconds(void) {
+    #ifdef _WIN32
+    return GetTickCount64() / 1000.0;
+    #else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+    #endif
+}
+
+// Normalise un chemin de dossier ("./shaders/" -> "shaders", "" -> ".")
+static void NormalizeDirectoryPath(const char* input, char* output, size_t size) {
+    while (input[0] == '.' && input[1] == '/') input += 2;
+    snprintf(output, size, "%s", input[0] ? input : ".");
+    size_t len = strlen(output);
+    while (len > 1 && (output[len - 1] == '/' || output[len - 1] == '\\')) output[--len] = '\0';
+}
+
+// Construit "dossier/nom", retourne false si le chemin est trop long
+static bool JoinWatchPath(const char* directory, const char* name, char* output, size_t size) {
+    int length;
+    if (strcmp(directory, ".") == 0) {
+        length = snprintf(output, size, "%s", name);
+    } else {
+        length = snprintf(output, size, "%s/%s", directory, name);
+    }
+    return length >= 0 && (size_t)length < size;
+}
+
+// Ajoute ou fusionne un événement en attente (appelé avec le mutex verrouillé)
+static void PushPendingEvent(const char* path, FileWatchEventType type, bool isDirectory) {
+    double now = GetMonotonicSeconds();
+    int count = atomic_load(&gFileWatch.pendingCount);
+
+    for (int i = 0; i < count; i++) {
+        PendingEvent* pending = &gFileWatch.pending[i];
+        if (strcmp(pending->event.path, path) != 0) continue;
+
+        // Supprimé puis recréé (sauvegarde par renommage) : simple modification
+        if (pending->event.type == FILE_WATCH_DELETED && type != FILE_WATCH_DELETED) {
+            pending->event.type = FILE_WATCH_MODIFIED;
+        } else if (!(pending->event.type == FILE_WATCH_CREATED && type == FILE_WATCH_MODIFIED)) {
+            pending->event.type = type;
+        }
+        pending->lastTime = now;
+        return;
+    }
+
+    if (count >= gFileWatch.pendingCapacity) {
+        int newCapacity = gFileWatch.pendingCapacity > 0 ? gFileWatch.pendingCapacity * 2 : 32;
+        PendingEvent* newPending = (PendingEvent*)realloc(gFileWatch.pending, newCapacity * sizeof(PendingEvent));
+        if (newPending == NULL) return;
+        gFileWatch.pending = newPending;
+        gFileWatch.pendingCapacity = newCapacity;
+    }
+
+    PendingEvent* pending = &gFileWatch.pending[count];
+    snprintf(pending->event.path, sizeof(pending->event.path), "%s", path);
+    pending->event.type = type;
+    pending->event.isDirectory = isDirectory;
+    pending->lastTime = now;
+    atomic_store(&gFileWatch.pendingCount, count + 1);
+}
+
+// Date de modification la plus précise disponible (la seconde ne suffit pas
+// pour distinguer deux sauvegardes rapprochées)
+static long long GetFileModTime(const char* path, const struct stat* attrib) {
+    #if defined(_WIN32)
+    // st_mtime n'a que la seconde sous Windows : ftLastWriteTime est au 100 ns
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (GetFileAttributesExA(path, GetFileExInfoStandard, &data)) {
+        ULARGE_INTEGER writeTime;
+        writeTime.LowPart = data.ftLastWriteTime.dwLowDateTime;
+        writeTime.HighPart = data.ftLastWriteTime.dwHighDateTime;
+        return (long long)writeTime.QuadPart * 100LL;
+    }
+    return (long long)attrib->st_mtime * 1000000000LL;
+    #elif defined(__linux__)
+    (void)path;
+    return (long long)attrib->st_mtim.tv_sec * 1000000000LL + attrib->st_mtim.tv_nsec;
+    #elif defined(__APPLE__)
+    (void)path;
+    return (long long)attrib->st_mtimespec.tv_sec * 1000000000LL + attrib->st_mtimespec.tv_nsec;
+    #else
+    (void)path;
+    return (long long)attrib->st_mtime * 1000000000LL;
+    #endif
+}
+
+// Fonction pour comparer un dossier à son dernier instantané (mode scrutation / Windows)
+static void ScanDirectorySnapshot(WatchedDirectory* directory, bool emitEvents) {
+    for (int i = 0; i < directory->entryCount; i++) directory->entries[i].seen = false;
+
+    DIR* dir = opendir(directory->path);
+    if (dir) {
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != NULL) {
+            if (entry->d_name[0] == '.') continue;
+
+            char fullPath[FILE_WATCH_MAX_PATH];
+            if (!JoinWatchPath(directory->path, entry->d_name, fullPath, sizeof(fullPath))) continue;
+            struct stat attrib;
+            if (stat(fullPath, &attrib) != 0) continue;
+            bool isDirectory = S_ISDIR(attrib.st_mode);
+            long long modTime = GetFileModTime(fullPath, &attrib);
+
+            SnapshotEntry* known = NULL;
+            for (int i = 0; i < directory->entryCount; i++) {
+                if (strcmp(directory->entries[i].name, entry->d_name) == 0) {
+                    known = &directory->entries[i];
+                    break;
+                }
+            }
+
+            if (known == NULL) {
+                if (directory->entryCount >= directory->entryCapacity) {
+                    int newCapacity = directory->entryCapacity > 0 ? directory->entryCapacity * 2 : 32;
+                    SnapshotEntry* newEntries = (SnapshotEntry*)realloc(directory->entries, newCapacity * sizeof(SnapshotEntry));
+                    if (newEntries == NULL) continue;
+                    directory->entries = newEntries;
+                    directory->entryCapacity = newCapacity;
+                }
+                known = &directory->entries[directory->entryCount++];
+                snprintf(known->name, sizeof(known->name), "%s", entry->d_name);
+                known->modTime = modTime;
+                known->size = (long long)attrib.st_size;
+                known->isDirectory = isDirectory;
+                if (emitEvents) PushPendingEvent(fullPath, FILE_WATCH_CREATED, isDirectory);
+            } else if (known->modTime != modTime || known->size != (long long)attrib.st_size) {
+                known->modTime = modTime;
+                known->size = (long long)attrib.st_size;
+                if (emitEvents && !isDirectory) PushPendingEvent(fullPath, FILE_WATCH_MODIFIED, false);
+            }
+            known->seen = true;
+        }
+        closedir(dir);
+    }
+
+    // Les entrées non revues ont été supprimées
+    for (int i = directory->entryCount - 1; i >= 0; i--) {
+        if (directory->entries[i].seen) continue;
+        if (emitEvents) {
+            char fullPath[FILE_WATCH_MAX_PATH];
+            if (JoinWatchPath(directory->path, directory->entries[i].name, fullPath, sizeof(fullPath)))
+                PushPendingEvent(fullPath, FILE_WATCH_DELETED, directory->entries[i].isDirectory);
+        }
+        directory->entries[i] = directory->entries[--directory->entryCount];
+    }
+}
+
+#ifdef FILE_WATCH_HAS_INOTIFY
+// Thread inotify : bloqué dans poll() tant qu'il n'y a pas d'activité
+static void* InotifyThread(void* arg) {
+    (void)arg;
+    char buffer[16384] __attribute__((aligned(__alignof__(struct inotify_event))));
+    struct pollfd fds[2] = {
+        { gFileWatch.inotifyFd, POLLIN, 0 },
+        { gFileWatch.wakePipe[0], POLLIN, 0 }
+    };
+
+    while (atomic_load(&gFileWatch.running)) {
+        if (poll(fds, 2, -1) <= 0) continue;
+        if (fds[1].revents & POLLIN) break;
+        if (!(fds[0].revents & POLLIN)) continue;
+
+        ssize_t length = read(gFileWatch.inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) continue;
+
+        pthread_mutex_lock(&gFileWatch.mutex);
+        for (char* p = buffer; p < buffer + length; ) {
+            struct inotify_event* event = (struct inotify_event*)p;
+            p += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                LOG_WARNINGF("inotify queue overflow, some file changes were lost");
+                continue;
+            }
+            if (event->len == 0 || event->name[0] == '.') continue;
+
+            const char* directoryPath = NULL;
+            for (int i = 0; i < gFileWatch.directoryCount; i++) {
+                if (gFileWatch.directories[i].wd == event->wd) {
+                    directoryPath = gFileWatch.directories[i].path;
+                    break;
+                }
+            }
+            if (directoryPath == NULL) continue;
+
+            char fullPath[FILE_WATCH_MAX_PATH];
+            if (!JoinWatchPath(directoryPath, event->name, fullPath, sizeof(fullPath))) continue;
+            bool isDirectory = (event->mask & IN_ISDIR) != 0;
+
+            if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                PushPendingEvent(fullPath, FILE_WATCH_DELETED, isDirectory);
+            } else if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                PushPendingEvent(fullPath, FILE_WATCH_CREATED, isDirectory);
+            } else if (event->mask & IN_CLOSE_WRITE) {
+                PushPendingEvent(fullPath, FILE_WATCH_MODIFIED, false);
+            }
+        }
+        pthread_mutex_unlock(&gFileWatch.mutex);
+    }
+    return NULL;
+}
+#endif
+
+#ifdef _WIN32
+// Thread Windows : attend les notifications de changement des dossiers
+static void* Win32WatchThread(void* arg) {
+    (void)arg;
+    while (atomic_load(&gFileWatch.running)) {
+        HANDLE handles[MAXIMUM_WAIT_OBJECTS];
+        int directoryIndex[MAXIMUM_WAIT_OBJECTS];
+        int handleCount = 0;
+        handles[handleCount++] = gFileWatch.wakeEvent;
+
+        pthread_mutex_lock(&gFileWatch.mutex);
+        bool tooManyDirectories = false;
+        for (int i = 0; i < gFileWatch.directoryCount; i++) {
+            if (gFileWatch.directories[i].changeHandle == INVALID_HANDLE_VALUE) continue;
+            if (handleCount >= MAXIMUM_WAIT_OBJECTS) {
+                tooManyDirectories = true;
+                break;
+            }
+            directoryIndex[handleCount] = i;
+            handles[handleCount++] = gFileWatch.directories[i].changeHandle;
+        }
+        pthread_mutex_unlock(&gFileWatch.mutex);
+
+        // Au-delà de 63 dossiers, compléter par une scrutation périodique
+        DWORD timeout = tooManyDirectories ? FILE_WATCH_POLL_INTERVAL_MS : INFINITE;
+        DWORD result = WaitForMultipleObjects(handleCount, handles, FALSE, timeout);
+        if (!atomic_load(&gFileWatch.running)) break;
+
+        pthread_mutex_lock(&gFileWatch.mutex);
+        if (result == WAIT_TIMEOUT) {
+            for (int i = 0; i < gFileWatch.directoryCount; i++) {
+                ScanDirectorySnapshot(&gFileWatch.directories[i], true);
+            }
+        } else if (result > WAIT_OBJECT_0 && result < WAIT_OBJECT_0 + (DWORD)handleCount) {
+            int handleIndex = (int)(result - WAIT_OBJECT_0);
+            int index = directoryIndex[handleIndex];
+            // Le dossier a pu être retiré pendant l'attente
+            if (index < gFileWatch.directoryCount && gFileWatch.directories[index].changeHandle == handles[handleIndex]) {
+                WatchedDirectory* directory = &gFileWatch.directories[index];
+                ScanDirectorySnapshot(directory, true);
+                FindNextChangeNotification(directory->changeHandle);
+            }
+        }
+        pthread_mutex_unlock(&gFileWatch.mutex);
+    }
+    return NULL;
+}
+#endif
+
+// Thread de secours : scrutation périodique des dossiers
+static void* PollingWatchThread(void* arg) {
+    (void)arg;
+    while (atomic_load(&gFileWatch.running)) {
+        pthread_mutex_lock(&gFileWatch.mutex);
+        for (int i = 0; i < gFileWatch.directoryCount; i++) {
+            ScanDirectorySnapshot(&gFileWatch.directories[i], true);
+        }
+        pthread_mutex_unlock(&gFileWatch.mutex);
+
+        // Dormir par petites tranches pour pouvoir s'arrêter rapidement
+        for (int slept = 0; slept < FILE_WATCH_POLL_INTERVAL_MS && atomic_load(&gFileWatch.running); slept += 50) {
+            #ifdef _WIN32
+            Sleep(50);
+            #else
+            usleep(50 * 1000);
+            #endif
+        }
+    }
+    return NULL;
+}
+
+// Fonction pour démarrer la surveillance des fichiers
+bool InitFileWatch(void) {
+    if (gFileWatch.isInitialized) return true;
+
+    memset(&gFileWatch, 0, sizeof(gFileWatch));
+    pthread_mutex_init(&gFileWatch.mutex, NULL);
+    gFileWatch.inotifyFd = -1;
+    gFileWatch.backend = WATCH_BACKEND_POLLING;
+    void* (*threadFunction)(void*) = PollingWatchThread;
+
+    #ifdef FILE_WATCH_HAS_INOTIFY
+    if (getenv("SHADERLAB_WATCH_POLLING") == NULL) {
+        gFileWatch.inotifyFd = inotify_init1(IN_CLOEXEC);
+        if (gFileWatch.inotifyFd >= 0 && pipe(gFileWatch.wakePipe) == 0) {
+            gFileWatch.backend = WATCH_BACKEND_INOTIFY;
+            threadFunction = InotifyThread;
+        } else {
+            LOG_WARNINGF("inotify unavailable, falling back to polling");
+            if (gFileWatch.inotifyFd >= 0) close(gFileWatch.inotifyFd);
+            gFileWatch.inotifyFd = -1;
+        }
+    }
+    #elif defined(_WIN32)
+    if (getenv("SHADERLAB_WATCH_POLLING") == NULL) {
+        gFileWatch.wakeEvent = CreateEventA(NULL, FALSE, FALSE, NULL);
+        if (gFileWatch.wakeEvent != NULL) {
+            gFileWatch.backend = WATCH_BACKEND_WIN32;
+            threadFunction = Win32WatchThread;
+        }
+    }
+    #endif
+
+    atomic_store(&gFileWatch.running, true);
+    if (pthread_create(&gFileWatch.thread, NULL, threadFunction, NULL) != 0) {
+        LOG_ERRORF("Failed to start file watch thread");
+        atomic_store(&gFileWatch.running, false);
+        return false;
+    }
+
+    gFileWatch.isInitialized = true;
+    LOG_INFOF("File watch initialized (%s)", GetFileWatchBackendName());
+    return true;
+}
+
+// Fonction pour arrêter la surveillance des fichiers
+void CloseFileWatch(void) {
+    if (!gFileWatch.isInitialized) return;
+
+    atomic_store(&gFileWatch.running, false);
+    #ifdef FILE_WATCH_HAS_INOTIFY
+    if (gFileWatch.backend == WATCH_BACKEND_INOTIFY) {
+        char wake = 1;
+        if (write(gFileWatch.wakePipe[1], &wake, 1) < 0) LOG_WARNINGF("failed to wake file watch thread");
+    }
+    #endif
+    #ifdef _WIN32
+    if (gFileWatch.backend == WATCH_BACKEND_WIN32) SetEvent(gFileWatch.wakeEvent);
+    #endif
+    pthread_join(gFileWatch.thread, NULL);
+
+    for (int i = 0; i < gFileWatch.directoryCount; i++) {
+        #ifdef _WIN32
+        if (gFileWatch.directories[i].changeHandle != INVALID_HANDLE_VALUE) {
+            FindCloseChangeNotification(gFileWatch.directories[i].changeHandle);
+        }
+        #endif
+        free(gFileWatch.directories[i].entries);
+    }
+    #ifdef FILE_WATCH_HAS_INOTIFY
+    if (gFileWatch.backend == WATCH_BACKEND_INOTIFY) {
+        close(gFileWatch.inotifyFd);
+        close(gFileWatch.wakePipe[0]);
+        close(gFileWatch.wakePipe[1]);
+    }
+    #endif
+    #ifdef _WIN32
+    if (gFileWatch.wakeEvent != NULL) CloseHandle(gFileWatch.wakeEvent);
+    #endif
+    free(gFileWatch.directories);
+    free(gFileWatch.pending);
+    pthread_mutex_destroy(&gFileWatch.mutex);
+    memset(&gFileWatch, 0, sizeof(gFileWatch));
+}
+
+// Fonction pour surveiller un dossier
+bool FileWatchAddDirectory(const char* directory) {
+    if (!gFileWatch.isInitialized) return false;
+
+    char path[FILE_WATCH_MAX_PATH];
+    NormalizeDirectoryPath(directory, path, sizeof(path));
+
+    pthread_mutex_lock(&gFileWatch.mutex);
+    for (int i = 0; i < gFileWatch.directoryCount; i++) {
+        if (strcmp(gFileWatch.directories[i].path, path) == 0) {
+            pthread_mutex_unlock(&gFileWatch.mutex);
+            return true;
+        }
+    }
+
+    if (gFileWatch.directoryCount >= gFileWatch.directoryCapacity) {
+        int newCapacity = gFileWatch.directoryCapacity > 0 ? gFileWatch.directoryCapacity * 2 : 8;
+        WatchedDirectory* newDirectories = (WatchedDirectory*)realloc(gFileWatch.directories, newCapacity * sizeof(WatchedDirectory));
+        if (newDirectories == NULL) {
+            pthread_mutex_unlock(&gFileWatch.mutex);
+            return false;
+        }
+        gFileWatch.directories = newDirectories;
+        gFileWatch.directoryCapacity = newCapacity;
+    }
+
+    WatchedDirectory* watched = &gFileWatch.directories[gFileWatch.directoryCount];
+    memset(watched, 0, sizeof(*watched));
+    snprintf(watched->path, sizeof(watched->path), "%s", path);
+    watched->wd = -1;
+    bool success = true;
+
+    #ifdef FILE_WATCH_HAS_INOTIFY
+    if (gFileWatch.backend == WATCH_BACKEND_INOTIFY) {
+        // Surveiller le dossier plutôt que les fichiers : les sauvegardes par renommage
+        // remplacent l'inode du fichier
+        watched->wd = inotify_add_watch(gFileWatch.inotifyFd, path,
+                                        IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO);
+        success = watched->wd >= 0;
+    }
+    #endif
+    #ifdef _WIN32
+    watched->changeHandle = INVALID_HANDLE_VALUE;
+    if (gFileWatch.backend == WATCH_BACKEND_WIN32) {
+        watched->changeHandle = FindFirstChangeNotificationA(path, FALSE,
+            FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME);
+        success = watched->changeHandle != INVALID_HANDLE_VALUE;
+    }
+    #endif
+
+    if (success && gFileWatch.backend != WATCH_BACKEND_INOTIFY) {
+        // Instantané initial, sans événement
+        ScanDirectorySnapshot(watched, false);
+    }
+    if (success) gFileWatch.directoryCount++;
+    pthread_mutex_unlock(&gFileWatch.mutex);
+
+    #ifdef _WIN32
+    if (success && gFileWatch.backend == WATCH_BACKEND_WIN32) SetEvent(gFileWatch.wakeEvent);
+    #endif
+
+    if (!success) LOG_WARNINGF("cannot watch directory '%s'", path);
+    return success;
+}
+
+// Fonction pour arrêter de surveiller un dossier
+void FileWatchRemoveDirectory(const char* directory) {
+    if (!gFileWatch.isInitialized) return;
+
+    char path[FILE_WATCH_MAX_PATH];
+    NormalizeDirectoryPath(directory, path, sizeof(path));
+
+    pthread_mutex_lock(&gFileWatch.mutex);
+    for (int i = 0; i < gFileWatch.directoryCount; i++) {
+        WatchedDirectory* watched = &gFileWatch.directories[i];
+        if (strcmp(watched->path, path) != 0) continue;
+
+        #ifdef FILE_WATCH_HAS_INOTIFY
+        if (watched->wd >= 0) inotify_rm_watch(gFileWatch.inotifyFd, watched->wd);
+        #endif
+        #ifdef _WIN32
+        if (watched->changeHandle != INVALID_HANDLE_VALUE) FindCloseChangeNotification(watched->changeHandle);
+        #endif
+        free(watched->entries);
+        gFileWatch.directories[i] = gFileWatch.directories[--gFileWatch.directoryCount];
+        break;
+    }
+    pthread_mutex_unlock(&gFileWatch.mutex);
+
+    #ifdef _WIN32
+    if (gFileWatch.backend == WATCH_BACKEND_WIN32) SetEvent(gFileWatch.wakeEvent);
+    #endif
+}
+
+// Fonction pour récupérer les événements dont le délai anti-rebond est écoulé
+int PollFileWatch(FileWatchEvent* events, int maxEvents) {
+    // Chemin rapide sans verrou ni appel système quand rien ne s'est passé
+    if (!gFileWatch.isInitialized || atomic_load(&gFileWatch.pendingCount) == 0) return 0;
+
+    double now = GetMonotonicSeconds();
+    int eventCount = 0;
+
+    pthread_mutex_lock(&gFileWatch.mutex);
+    int count = atomic_load(&gFileWatch.pendingCount);
+    for (int i = 0; i < count && eventCount < maxEvents; ) {
+        if (now - gFileWatch.pending[i].lastTime >= FILE_WATCH_DEBOUNCE_SECONDS) {
+            events[eventCount++] = gFileWatch.pending[i].event;
+            gFileWatch.pending[i] = gFileWatch.pending[--count];
+        } else {
+            i++;
+        }
+    }
+    atomic_store(&gFileWatch.pendingCount, count);
+    pthread_mutex_unlock(&gFileWatch.mutex);
+
+    return eventCount;
+}
+
+const char* GetFileWatchBackendName(void) {
+    switch (gFileWatch.backend) {
+        case WATCH_BACKEND_INOTIFY: return "inotify";
+        case WATCH_BACKEND_WIN32: return "win32 change notifications";
+        default: return "polling";
+    }
+}
@@ -0,0 +1,205 @@
+#include "frame_arena.h"
+#include "logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN // Exclure les en-têtes inutiles de Windows
+#include <windows.h> // Pour VirtualAlloc
+#else
+#include <sys/mman.h> // Pour mmap/madvise
+#include <unistd.h>
+#endif
+
+#define HUGE_PAGE_SIZE (2u * 1024u * 1024u)
+
+// Structure globale de l'arène de frames
+typedef struct {
+    unsigned char* base;
+    size_t reservedBytes;
+    size_t frameBytes;   // Taille utile d'une frame
+    size_t slotBytes;    // Taille du slot, alignée sur la page
+    int slotCapacity;
+    bool usesHugePages;
+    bool isEmpty;        // Aucun slot utilisé depuis le dernier reset
+} FrameArena;
+
+static FrameArena gFrameArena = {0};
+
+static size_t GetSystemPageSize(void) {
+    #ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+    #else
+    return (size_t)sysconf(_SC_PAGESIZE);
+    #endif
+}
+
+static size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+#if !defined(_WIN32) && defined(MAP_HUGETLB)
+// Pages hugetlb libres (HugePages_Free dans /proc/meminfo), -1 si illisible
+static long GetFreeHugePages(void) {
+    FILE* file = fopen("/proc/meminfo", "r");
+    if (file == NULL) return -1;
+    long freePages = -1;
+    char line[256];
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (sscanf(line, "HugePages_Free: %ld", &freePages) == 1) break;
+    }
+    fclose(file);
+    return freePages;
+}
+#endif
+
+// Fonction pour réserver l'espace d'adressage sans consommer de mémoire physique
+static bool ReserveArenaMemory(size_t bytes, bool wantHugePages) {
+    #ifdef _WIN32
+    // Les large pages Windows ne peuvent pas être réservées puis engagées à la demande
+    (void)wantHugePages;
+    gFrameArena.base = (unsigned char*)VirtualAlloc(NULL, bytes, MEM_RESERVE, PAGE_READWRITE);
+    gFrameArena.usesHugePages = false;
+    #else
+    void* memory = MAP_FAILED;
+    gFrameArena.usesHugePages = false;
+    #ifdef MAP_HUGETLB
+    if (wantHugePages) {
+        // Sans MAP_NORESERVE : les pages hugetlb sont réservées dès mmap, qui échoue si le
+        // pool est trop petit (avec, mmap réussit et la première écriture lève SIGBUS)
+        long neededPages = (long)(bytes / HUGE_PAGE_SIZE);
+        long freePages = GetFreeHugePages();
+        if (freePages >= 0 && freePages < neededPages) {
+            LOG_WARNINGF("Frame arena: %ld hugetlb pages needed, %ld free, falling back to transparent huge pages",
+                         neededPages, freePages);
+        } else {
+            memory = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (memory != MAP_FAILED) {
+                gFrameArena.usesHugePages = true;
+            } else {
+                LOG_WARNINGF("Frame arena: hugetlb mapping of %ld pages failed, falling back to transparent huge pages",
+                             neededPages);
+            }
+        }
+    }
+    #endif
+    if (memory == MAP_FAILED) {
+        memory = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        #ifdef MADV_HUGEPAGE
+        if (memory != MAP_FAILED && wantHugePages) madvise(memory, bytes, MADV_HUGEPAGE);
+        #endif
+    }
+    gFrameArena.base = memory != MAP_FAILED ? (unsigned char*)memory : NULL;
+    #endif
+    return gFrameArena.base != NULL;
+}
+
+// Fonction pour rendre une plage de l'arène à l'OS
+static void DiscardArenaRange(size_t offset, size_t bytes) {
+    if (gFrameArena.base == NULL || bytes == 0) return;
+    #ifdef _WIN32
+    VirtualFree(gFrameArena.base + offset, bytes, MEM_DECOMMIT);
+    #else
+    madvise(gFrameArena.base + offset, bytes, MADV_DONTNEED);
+    #endif
+}
+
+// Fonction pour initialiser l'arène de frames
+bool InitFrameArena(size_t frameBytes, int maxSlots) {
+    if (gFrameArena.base != NULL && gFrameArena.frameBytes == frameBytes && gFrameArena.slotCapacity >= maxSlots) {
+        ResetFrameArena();
+        return true;
+    }
+    DestroyFrameArena();
+
+    const char* hugeEnv = getenv("SHADERLAB_HUGE_PAGES");
+    bool wantHugePages = hugeEnv != NULL && atoi(hugeEnv) != 0;
+
+    // Chaque slot commence sur une page pour pouvoir être rendu individuellement
+    size_t alignment = wantHugePages ? HUGE_PAGE_SIZE : GetSystemPageSize();
+    size_t slotBytes = AlignUp(frameBytes, alignment);
+    if (maxSlots <= 0 || slotBytes > SIZE_MAX / (size_t)maxSlots) return false;
+
+    size_t reservedBytes = slotBytes * (size_t)maxSlots;
+    if (!ReserveArenaMemory(reservedBytes, wantHugePages)) {
+        LOG_ERRORF("Failed to reserve frame arena (%d slots of %zu bytes)", maxSlots, slotBytes);
+        return false;
+    }
+
+    gFrameArena.reservedBytes = reservedBytes;
+    gFrameArena.frameBytes = frameBytes;
+    gFrameArena.slotBytes = slotBytes;
+    gFrameArena.slotCapacity = maxSlots;
+    gFrameArena.isEmpty = true;
+    LOG_INFOF("Frame arena initialized: %d slots of %.2f MB (%.1f GB reserved%s)", maxSlots,
+              slotBytes / (1024.0 * 1024.0), reservedBytes / (1024.0 * 1024.0 * 1024.0),
+              gFrameArena.usesHugePages ? ", huge pages" : "");
+    return true;
+}
+
+// Fonction pour libérer l'arène
+void DestroyFrameArena(void) {
+    if (gFrameArena.base == NULL) return;
+    #ifdef _WIN32
+    VirtualFree(gFrameArena.base, 0, MEM_RELEASE);
+    #else
+    munmap(gFrameArena.base, gFrameArena.reservedBytes);
+    #endif
+    memset(&gFrameArena, 0, sizeof(gFrameArena));
+}
+
+// Fonction pour rendre toute la mémoire des frames en une fois
+void ResetFrameArena(void) {
+    DiscardArenaRange(0, gFrameArena.reservedBytes);
+    gFrameArena.isEmpty = true;
+}
+
+bool IsFrameArenaReady(void) {
+    return gFrameArena.base != NULL;
+}
+
+bool IsFrameArenaEmpty(void) {
+    return gFrameArena.isEmpty;
+}
+
+size_t GetFrameArenaSlotBytes(void) {
+    return gFrameArena.slotBytes;
+}
+
+size_t GetFrameArenaFrameBytes(void) {
+    return gFrameArena.frameBytes;
+}
+
+int GetFrameArenaSlotCapacity(void) {
+    return gFrameArena.slotCapacity;
+}
+
+void* GetFrameArenaSlot(int index) {
+    if (gFrameArena.base == NULL || index < 0 || index >= gFrameArena.slotCapacity) return NULL;
+    unsigned char* slot = gFrameArena.base + (size_t)index * gFrameArena.slotBytes;
+    #ifdef _WIN32
+    // Engager les pages du slot (sans effet si elles le sont déjà)
+    if (VirtualAlloc(slot, gFrameArena.slotBytes, MEM_COMMIT, PAGE_READWRITE) == NULL) return NULL;
+    #endif
+    gFrameArena.isEmpty = false;
+    return slot;
+}
+
+void DiscardFrameArenaSlot(int index) {
+    if (index < 0 || index >= gFrameArena.slotCapacity) return;
+    DiscardArenaRange((size_t)index * gFrameArena.slotBytes, gFrameArena.slotBytes);
+}
+
+bool IsFrameArenaPointer(const void* pointer) {
+    const unsigned char* p = (const unsigned char*)pointer;
+    return gFrameArena.base != NULL && p >= gFrameArena.base && p < gFrameArena.base + gFrameArena.reservedBytes;
+}
+
+int GetFrameArenaSlotIndex(const void* pointer) {
+    if (!IsFrameArenaPointer(pointer)) return -1;
+    return (int)(((const unsigned char*)pointer - gFrameArena.base) / gFrameArena.slotBytes);
+}
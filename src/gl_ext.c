@@ -0,0 +1,143 @@
+#include "gl_ext.h"
+#include "logger.h"
+#include <stdio.h>
+#include <string.h>
+
+// Fonctions GLFW liées statiquement avec raylib (pas d'en-tête GLFW dans le projet)
+typedef void (*GLFWglproc)(void);
+extern GLFWglproc glfwGetProcAddress(const char* procname);
+extern int glfwExtensionSupported(const char* extension);
+
+GLExtFunctions gGL = {0};
+
+// Structure globale de l'état du chargeur
+typedef struct {
+    bool isReady;
+    bool hasParallelShaderCompile;
+    bool hasProgramBinary;
+    bool hasTimerQuery;
+    bool hasAsyncReadback;
+} GLExtState;
+
+static GLExtState gGLExtState = {0};
+
+// Fonction pour charger un pointeur de fonction (la conversion passe par memcpy
+// pour rester valide en C standard)
+static bool LoadGLProc(void* target, size_t targetSize, const char* name, bool required) {
+    GLFWglproc proc = glfwGetProcAddress(name);
+    if (proc == NULL) {
+        if (required) LOG_ERRORF("OpenGL function '%s' not available", name);
+        return !required;
+    }
+    memcpy(target, &proc, targetSize);
+    return true;
+}
+
+#define LOAD_GL(field, name) LoadGLProc(&gGL.field, sizeof(gGL.field), name, true)
+#define LOAD_GL_OPTIONAL(field, name) LoadGLProc(&gGL.field, sizeof(gGL.field), name, false)
+
+// Fonction pour charger les fonctions OpenGL utilisées directement
+bool InitGLExtensions(void) {
+    if (gGLExtState.isReady) return true;
+
+    bool success = true;
+    success &= LOAD_GL(GetString, "glGetString");
+    success &= LOAD_GL(GetIntegerv, "glGetIntegerv");
+    success &= LOAD_GL(CreateShader, "glCreateShader");
+    success &= LOAD_GL(ShaderSource, "glShaderSource");
+    success &= LOAD_GL(CompileShader, "glCompileShader");
+    success &= LOAD_GL(GetShaderiv, "glGetShaderiv");
+    success &= LOAD_GL(GetShaderInfoLog, "glGetShaderInfoLog");
+    success &= LOAD_GL(DeleteShader, "glDeleteShader");
+    success &= LOAD_GL(CreateProgram, "glCreateProgram");
+    success &= LOAD_GL(AttachShader, "glAttachShader");
+    success &= LOAD_GL(DetachShader, "glDetachShader");
+    success &= LOAD_GL(BindAttribLocation, "glBindAttribLocation");
+    success &= LOAD_GL(LinkProgram, "glLinkProgram");
+    success &= LOAD_GL(GetProgramiv, "glGetProgramiv");
+    success &= LOAD_GL(GetProgramInfoLog, "glGetProgramInfoLog");
+    success &= LOAD_GL(DeleteProgram, "glDeleteProgram");
+    success &= LOAD_GL(GetActiveUniform, "glGetActiveUniform");
+    success &= LOAD_GL(ReadPixels, "glReadPixels");
+    success &= LOAD_GL(BindFramebuffer, "glBindFramebuffer");
+    if (!success) return false;
+
+    gGLExtState.hasParallelShaderCompile = glfwExtensionSupported("GL_KHR_parallel_shader_compile") ||
+                                           glfwExtensionSupported("GL_ARB_parallel_shader_compile");
+    if (gGLExtState.hasParallelShaderCompile) {
+        LOAD_GL_OPTIONAL(MaxShaderCompilerThreadsKHR, "glMaxShaderCompilerThreadsKHR");
+        if (gGL.MaxShaderCompilerThreadsKHR == NULL) {
+            LOAD_GL_OPTIONAL(MaxShaderCompilerThreadsKHR, "glMaxShaderCompilerThreadsARB");
+        }
+        // Laisser le pilote choisir le nombre de threads de compilation
+        if (gGL.MaxShaderCompilerThreadsKHR) gGL.MaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+    }
+
+    // Binaires de programmes : inutilisables si le pilote n'expose aucun format
+    LOAD_GL_OPTIONAL(GetProgramBinary, "glGetProgramBinary");
+    LOAD_GL_OPTIONAL(ProgramBinary, "glProgramBinary");
+    LOAD_GL_OPTIONAL(ProgramParameteri, "glProgramParameteri");
+    if (gGL.GetProgramBinary && gGL.ProgramBinary && gGL.ProgramParameteri) {
+        GLint formatCount = 0;
+        gGL.GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        gGLExtState.hasProgramBinary = formatCount > 0;
+    }
+
+    // Requêtes de temps GPU (cœur en 3.3, sinon extension)
+    LOAD_GL_OPTIONAL(GenQueries, "glGenQueries");
+    LOAD_GL_OPTIONAL(DeleteQueries, "glDeleteQueries");
+    LOAD_GL_OPTIONAL(BeginQuery, "glBeginQuery");
+    LOAD_GL_OPTIONAL(EndQuery, "glEndQuery");
+    LOAD_GL_OPTIONAL(GetQueryObjectiv, "glGetQueryObjectiv");
+    LOAD_GL_OPTIONAL(GetQueryObjectui64v, "glGetQueryObjectui64v");
+    if (gGL.GenQueries && gGL.DeleteQueries && gGL.BeginQuery && gGL.EndQuery &&
+        gGL.GetQueryObjectiv && gGL.GetQueryObjectui64v) {
+        GLint major = 0;
+        GLint minor = 0;
+        gGL.GetIntegerv(GL_MAJOR_VERSION, &major);
+        gGL.GetIntegerv(GL_MINOR_VERSION, &minor);
+        gGLExtState.hasTimerQuery = major > 3 || (major == 3 && minor >= 3) ||
+                                    glfwExtensionSupported("GL_ARB_timer_query");
+    }
+
+    // Lecture asynchrone des pixels (PBO en 2.1, MapBufferRange en 3.0, fences en 3.2)
+    LOAD_GL_OPTIONAL(GenBuffers, "glGenBuffers");
+    LOAD_GL_OPTIONAL(DeleteBuffers, "glDeleteBuffers");
+    LOAD_GL_OPTIONAL(BindBuffer, "glBindBuffer");
+    LOAD_GL_OPTIONAL(BufferData, "glBufferData");
+    LOAD_GL_OPTIONAL(MapBufferRange, "glMapBufferRange");
+    LOAD_GL_OPTIONAL(UnmapBuffer, "glUnmapBuffer");
+    LOAD_GL_OPTIONAL(FenceSync, "glFenceSync");
+    LOAD_GL_OPTIONAL(ClientWaitSync, "glClientWaitSync");
+    LOAD_GL_OPTIONAL(DeleteSync, "glDeleteSync");
+    gGLExtState.hasAsyncReadback = gGL.GenBuffers && gGL.DeleteBuffers && gGL.BindBuffer && gGL.BufferData &&
+                                   gGL.MapBufferRange && gGL.UnmapBuffer && gGL.FenceSync && gGL.ClientWaitSync &&
+                                   gGL.DeleteSync;
+
+    gGLExtState.isReady = true;
+    LOG_INFOF("OpenGL extensions loaded (%s, parallel shader compile: %s, program binary: %s, timer query: %s, async readback: %s)",
+              (const char*)gGL.GetString(GL_RENDERER), gGLExtState.hasParallelShaderCompile ? "yes" : "no",
+              gGLExtState.hasProgramBinary ? "yes" : "no", gGLExtState.hasTimerQuery ? "yes" : "no",
+              gGLExtState.hasAsyncReadback ? "yes" : "no");
+    return true;
+}
+
+bool IsGLExtensionsReady(void) {
+    return gGLExtState.isReady;
+}
+
+bool HasParallelShaderCompile(void) {
+    return gGLExtState.hasParallelShaderCompile;
+}
+
+bool HasProgramBinary(void) {
+    return gGLExtState.hasProgramBinary;
+}
+
+bool HasTimerQuery(void) {
+    return gGLExtState.hasTimerQuery;
+}
+
+bool HasAsyncReadback(void) {
+    return gGLExtState.hasAsyncReadback;
+}
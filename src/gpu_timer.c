@@ -0,0 +1,76 @@
+#include "gpu_timer.h"
+#include <string.h>
+
+bool AreGpuTimersAvailable(void) {
+    return IsGLExtensionsReady() && HasTimerQuery();
+}
+
+// Fonction pour démarrer une mesure (ignorée si la requête suivante est encore en vol)
+void BeginGpuTimer(GpuTimer* timer) {
+    timer->isRunning = false;
+    if (!AreGpuTimersAvailable()) return;
+
+    // Requêtes créées au premier usage
+    if (timer->queries[0] == 0) gGL.GenQueries(GPU_TIMER_QUERIES, timer->queries);
+
+    // Le GPU a plus de GPU_TIMER_QUERIES frames de retard : sauter cette mesure
+    // plutôt que d'attendre ou de perdre le résultat en cours
+    if (timer->isPending[timer->nextQuery]) return;
+
+    gGL.BeginQuery(GL_TIME_ELAPSED, timer->queries[timer->nextQuery]);
+    timer->isRunning = true;
+}
+
+void EndGpuTimer(GpuTimer* timer) {
+    if (!timer->isRunning) return;
+    gGL.EndQuery(GL_TIME_ELAPSED);
+    timer->isPending[timer->nextQuery] = true;
+    timer->nextQuery = (timer->nextQuery + 1) % GPU_TIMER_QUERIES;
+    timer->isRunning = false;
+}
+
+// Fonction pour lire les résultats déjà disponibles, dans l'ordre d'émission
+void CollectGpuTimer(GpuTimer* timer) {
+    if (!AreGpuTimersAvailable() || timer->queries[0] == 0) return;
+
+    for (int i = 0; i < GPU_TIMER_QUERIES; i++) {
+        int index = (timer->nextQuery + i) % GPU_TIMER_QUERIES; // La plus ancienne d'abord
+        if (!timer->isPending[index]) continue;
+
+        GLint available = 0;
+        gGL.GetQueryObjectiv(timer->queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) break; // Les suivantes ne sont pas prêtes non plus
+
+        GLuint64 elapsed = 0;
+        gGL.GetQueryObjectui64v(timer->queries[index], GL_QUERY_RESULT, &elapsed);
+        timer->isPending[index] = false;
+
+        timer->history[timer->historyHead] = (float)((double)elapsed / 1000000.0);
+        timer->historyHead = (timer->historyHead + 1) % GPU_TIMER_HISTORY;
+        if (timer->historyCount < GPU_TIMER_HISTORY) timer->historyCount++;
+    }
+}
+
+float GetGpuTimerAverage(const GpuTimer* timer) {
+    if (timer->historyCount == 0) return -1.0f;
+    // Moyenne sur la dernière seconde environ
+    int count = timer->historyCount < 60 ? timer->historyCount : 60;
+    float sum = 0.0f;
+    for (int i = 1; i <= count; i++) {
+        sum += timer->history[(timer->historyHead - i + GPU_TIMER_HISTORY) % GPU_TIMER_HISTORY];
+    }
+    return sum / count;
+}
+
+// Fonction pour oublier les mesures (changement de shader) en gardant les requêtes
+void ResetGpuTimer(GpuTimer* timer) {
+    // Les résultats en vol sont abandonnés : les requêtes seront réutilisées
+    memset(timer->isPending, 0, sizeof(timer->isPending));
+    timer->historyCount = 0;
+    timer->historyHead = 0;
+}
+
+void FreeGpuTimer(GpuTimer* timer) {
+    if (timer->queries[0] != 0 && IsGLExtensionsReady()) gGL.DeleteQueries(GPU_TIMER_QUERIES, timer->queries);
+    memset(timer, 0, sizeof(*timer));
+}
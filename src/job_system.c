@@ -0,0 +1,479 @@
+#include "job_system.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifndef _WIN32
+#include <unistd.h> // Pour sysconf
+#endif
+
+#define JOB_DEQUE_SIZE 1024      // Puissance de 2 ; une deque pleine déborde dans la file commune
+#define JOB_DEQUE_MASK (JOB_DEQUE_SIZE - 1)
+#define JOB_NONE 0               // Slot 0 jamais utilisé : JOB_HANDLE_NULL est toujours terminée
+
+// Deque de Chase-Lev : le thread propriétaire empile et dépile en bas sans verrou,
+// les voleurs prennent en haut par compare-and-swap
+typedef struct {
+    atomic_long top;
+    atomic_long bottom;
+    atomic_int items[JOB_DEQUE_SIZE];
+} JobDeque;
+
+// File FIFO protégée par gJobs.mutex
+typedef struct {
+    int items[JOB_MAX_JOBS];
+    int head;
+    int count;
+} JobQueue;
+
+typedef struct {
+    JobFunction function;
+    void* context;
+    atomic_uint generation;               // Incrémentée à la fin de la tâche
+    atomic_int waitCount;                 // Dépendances non terminées (+1 pendant ScheduleJob)
+    int continuations[JOB_MAX_DEPENDENCIES]; // Tâches qui attendent celle-ci (gJobs.graphMutex)
+    int continuationCount;
+    bool isMainThread;
+} Job;
+
+typedef struct {
+    atomic_bool isStarted;
+    int threadCount;                      // 0 = un par cœur
+    int workerCount;                      // Deques : une par thread créé, aucune pour l'appelant
+    int startedCount;                     // Threads effectivement démarrés
+    pthread_t threads[JOB_MAX_THREADS];
+    JobDeque deques[JOB_MAX_THREADS];
+
+    Job jobs[JOB_MAX_JOBS];
+    int freeJobs[JOB_MAX_JOBS];
+    int freeCount;
+    bool isPoolReady;
+
+    JobQueue shared;                      // Tâches créées hors des threads du système
+    JobQueue mainThread;
+    atomic_int sharedCount;
+    atomic_int queuedCount;               // Tâches prêtes dans les deques et la file commune
+    int sleepingCount;
+    bool isQuitting;
+
+    pthread_mutex_t mutex;                // Files, sommeil, arrêt
+    pthread_cond_t wake;                  // Tâche prête ou terminée
+    pthread_mutex_t graphMutex;           // Dépendances et fin des tâches
+    pthread_mutex_t poolMutex;            // Slots libres
+    pthread_mutex_t startMutex;
+} JobSystem;
+
+static JobSystem gJobs = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+    .graphMutex = PTHREAD_MUTEX_INITIALIZER,
+    .poolMutex = PTHREAD_MUTEX_INITIALIZER,
+    .startMutex = PTHREAD_MUTEX_INITIALIZER,
+};
+
+// Deque du thread (-1 hors des threads du système)
+static _Thread_local int gWorkerIndex = -1;
+static _Thread_local bool gIsMainThread = false;
+
+// Découpage d'un ParallelForTiles : chaque participant prend la tuile suivante
+typedef struct {
+    JobTileFunction function;
+    void* context;
+    int width;
+    int height;
+    int tileWidth;
+    int tileHeight;
+    int columns;
+    int tileCount;
+    atomic_int nextTile;
+} TileRange;
+
+static double GetJobTime(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+//------------------------------------------------------------------------------------
+// Deques et files
+//------------------------------------------------------------------------------------
+
+static bool PushDeque(JobDeque* deque, int job) {
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    if (bottom - top >= JOB_DEQUE_SIZE) return false;
+    atomic_store_explicit(&deque->items[bottom & JOB_DEQUE_MASK], job, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    return true;
+}
+
+// Propriétaire uniquement : la dernière tâche empilée (la plus chaude en cache)
+static int PopDeque(JobDeque* deque) {
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    if (top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return JOB_NONE;
+    }
+    int job = atomic_load_explicit(&deque->items[bottom & JOB_DEQUE_MASK], memory_order_relaxed);
+    if (top == bottom) {
+        // Dernière tâche : un voleur peut la prendre en même temps
+        if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                     memory_order_seq_cst, memory_order_relaxed)) {
+            job = JOB_NONE;
+        }
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    }
+    return job;
+}
+
+// Autres threads : la plus ancienne tâche
+static int StealDeque(JobDeque* deque) {
+    long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if (top >= bottom) return JOB_NONE;
+    int job = atomic_load_explicit(&deque->items[top & JOB_DEQUE_MASK], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                 memory_order_seq_cst, memory_order_relaxed)) {
+        return JOB_NONE;
+    }
+    return job;
+}
+
+static void PushQueue(JobQueue* queue, int job) {
+    queue->items[(queue->head + queue->count) % JOB_MAX_JOBS] = job;
+    queue->count++;
+}
+
+static int PopQueue(JobQueue* queue) {
+    if (queue->count == 0) return JOB_NONE;
+    int job = queue->items[queue->head];
+    queue->head = (queue->head + 1) % JOB_MAX_JOBS;
+    queue->count--;
+    return job;
+}
+
+// Réveille les threads endormis (tâche prête ou terminée)
+static void WakeJobThreads(void) {
+    pthread_mutex_lock(&gJobs.mutex);
+    if (gJobs.sleepingCount > 0) pthread_cond_broadcast(&gJobs.wake);
+    pthread_mutex_unlock(&gJobs.mutex);
+}
+
+//------------------------------------------------------------------------------------
+// Tâches
+//------------------------------------------------------------------------------------
+
+static void EnqueueReadyJob(int index) {
+    if (gJobs.jobs[index].isMainThread) {
+        pthread_mutex_lock(&gJobs.mutex);
+        PushQueue(&gJobs.mainThread, index);
+        pthread_mutex_unlock(&gJobs.mutex);
+        WakeJobThreads();
+        return;
+    }
+
+    // Compté avant d'être visible : un voleur ne peut pas faire passer le compte sous zéro
+    atomic_fetch_add(&gJobs.queuedCount, 1);
+    if (gWorkerIndex < 0 || !PushDeque(&gJobs.deques[gWorkerIndex], index)) {
+        pthread_mutex_lock(&gJobs.mutex);
+        PushQueue(&gJobs.shared, index);
+        atomic_fetch_add(&gJobs.sharedCount, 1);
+        pthread_mutex_unlock(&gJobs.mutex);
+    }
+    WakeJobThreads();
+}
+
+// Tâche prête : la sienne d'abord, puis la file commune, puis chez les autres
+static int FindJob(void) {
+    int job = gWorkerIndex >= 0 ? PopDeque(&gJobs.deques[gWorkerIndex]) : JOB_NONE;
+    if (job == JOB_NONE && atomic_load(&gJobs.sharedCount) > 0) {
+        pthread_mutex_lock(&gJobs.mutex);
+        job = PopQueue(&gJobs.shared);
+        if (job != JOB_NONE) atomic_fetch_sub(&gJobs.sharedCount, 1);
+        pthread_mutex_unlock(&gJobs.mutex);
+    }
+    int workerCount = gJobs.workerCount;
+    for (int i = 1; job == JOB_NONE && i <= workerCount; i++) {
+        int victim = (gWorkerIndex + i + workerCount) % workerCount;
+        if (victim != gWorkerIndex) job = StealDeque(&gJobs.deques[victim]);
+    }
+    if (job != JOB_NONE) atomic_fetch_sub(&gJobs.queuedCount, 1);
+    return job;
+}
+
+static void InitJobPool(void) {
+    pthread_mutex_lock(&gJobs.poolMutex);
+    if (!gJobs.isPoolReady) {
+        // Générations à 1 : les handles à 0 (JOB_HANDLE_NULL) sont terminés
+        for (int i = 0; i < JOB_MAX_JOBS; i++) atomic_store(&gJobs.jobs[i].generation, 1);
+        gJobs.freeCount = 0;
+        for (int i = JOB_MAX_JOBS - 1; i > JOB_NONE; i--) gJobs.freeJobs[gJobs.freeCount++] = i;
+        gJobs.isPoolReady = true;
+    }
+    pthread_mutex_unlock(&gJobs.poolMutex);
+}
+
+static void RunJob(int index);
+
+// Slot libre ; sans slot, aide à terminer les tâches en vol
+static int AllocateJob(void) {
+    while (true) {
+        pthread_mutex_lock(&gJobs.poolMutex);
+        int index = gJobs.freeCount > 0 ? gJobs.freeJobs[--gJobs.freeCount] : JOB_NONE;
+        pthread_mutex_unlock(&gJobs.poolMutex);
+        if (index != JOB_NONE) return index;
+
+        int job = FindJob();
+        if (job != JOB_NONE) RunJob(job);
+        else sched_yield();
+    }
+}
+
+static void FinishJob(int index) {
+    Job* job = &gJobs.jobs[index];
+    int continuations[JOB_MAX_DEPENDENCIES];
+    pthread_mutex_lock(&gJobs.graphMutex);
+    int count = job->continuationCount;
+    memcpy(continuations, job->continuations, count * sizeof(int));
+    job->continuationCount = 0;
+    atomic_fetch_add(&job->generation, 1);
+    pthread_mutex_unlock(&gJobs.graphMutex);
+
+    pthread_mutex_lock(&gJobs.poolMutex);
+    gJobs.freeJobs[gJobs.freeCount++] = index;
+    pthread_mutex_unlock(&gJobs.poolMutex);
+
+    for (int i = 0; i < count; i++) {
+        if (atomic_fetch_sub(&gJobs.jobs[continuations[i]].waitCount, 1) == 1) EnqueueReadyJob(continuations[i]);
+    }
+    // Réveille aussi ceux qui attendent cette tâche
+    WakeJobThreads();
+}
+
+static void RunJob(int index) {
+    Job* job = &gJobs.jobs[index];
+    job->function(job->context);
+    FinishJob(index);
+}
+
+static bool RunMainThreadJob(void) {
+    pthread_mutex_lock(&gJobs.mutex);
+    int job = PopQueue(&gJobs.mainThread);
+    pthread_mutex_unlock(&gJobs.mutex);
+    if (job == JOB_NONE) return false;
+    RunJob(job);
+    return true;
+}
+
+//------------------------------------------------------------------------------------
+// Threads
+//------------------------------------------------------------------------------------
+
+static void* RunJobWorker(void* arg) {
+    gWorkerIndex = (int)(intptr_t)arg;
+    while (true) {
+        int job = FindJob();
+        if (job != JOB_NONE) {
+            RunJob(job);
+            continue;
+        }
+        pthread_mutex_lock(&gJobs.mutex);
+        while (atomic_load(&gJobs.queuedCount) == 0 && !gJobs.isQuitting) {
+            gJobs.sleepingCount++;
+            pthread_cond_wait(&gJobs.wake, &gJobs.mutex);
+            gJobs.sleepingCount--;
+        }
+        // À l'arrêt, les tâches déjà prêtes sont terminées d'abord
+        bool isFinished = gJobs.isQuitting && atomic_load(&gJobs.queuedCount) == 0;
+        pthread_mutex_unlock(&gJobs.mutex);
+        if (isFinished) break;
+    }
+    gWorkerIndex = -1;
+    return NULL;
+}
+
+static void StartJobWorkers(void) {
+    if (atomic_load(&gJobs.isStarted)) return;
+    pthread_mutex_lock(&gJobs.startMutex);
+    if (!atomic_load(&gJobs.isStarted)) {
+        InitJobPool();
+        gJobs.isQuitting = false;
+        int count = GetJobThreadCount() - 1;
+        for (int i = 0; i < count; i++) {
+            atomic_store(&gJobs.deques[i].top, 0);
+            atomic_store(&gJobs.deques[i].bottom, 0);
+        }
+        // Deques des threads qui n'ont pas pu démarrer : toujours vides
+        gJobs.workerCount = count;
+        gJobs.startedCount = 0;
+        for (int i = 0; i < count; i++) {
+            if (pthread_create(&gJobs.threads[i], NULL, RunJobWorker, (void*)(intptr_t)i) != 0) break;
+            gJobs.startedCount++;
+        }
+        atomic_store(&gJobs.isStarted, true);
+    }
+    pthread_mutex_unlock(&gJobs.startMutex);
+}
+
+void InitJobSystem(void) {
+    gIsMainThread = true;
+    StartJobWorkers();
+}
+
+void CloseJobSystem(void) {
+    pthread_mutex_lock(&gJobs.startMutex);
+    if (atomic_load(&gJobs.isStarted)) {
+        pthread_mutex_lock(&gJobs.mutex);
+        gJobs.isQuitting = true;
+        pthread_cond_broadcast(&gJobs.wake);
+        pthread_mutex_unlock(&gJobs.mutex);
+        for (int i = 0; i < gJobs.startedCount; i++) pthread_join(gJobs.threads[i], NULL);
+        gJobs.workerCount = 0;
+        gJobs.startedCount = 0;
+        atomic_store(&gJobs.isStarted, false);
+    }
+    pthread_mutex_unlock(&gJobs.startMutex);
+}
+
+void SetJobThreadCount(int count) {
+    if (count < 0) count = 0;
+    int previous = GetJobThreadCount();
+    gJobs.threadCount = count < JOB_MAX_THREADS ? count : JOB_MAX_THREADS;
+    // Threads recréés au prochain usage
+    if (GetJobThreadCount() != previous) CloseJobSystem();
+}
+
+int GetJobThreadCount(void) {
+    if (gJobs.threadCount > 0) return gJobs.threadCount;
+
+    long count = 1;
+    #ifdef _WIN32
+    const char* processors = getenv("NUMBER_OF_PROCESSORS");
+    if (processors) count = strtol(processors, NULL, 10);
+    #else
+    count = sysconf(_SC_NPROCESSORS_ONLN);
+    #endif
+    if (count < 1) count = 1;
+    return count < JOB_MAX_THREADS ? (int)count : JOB_MAX_THREADS;
+}
+
+//------------------------------------------------------------------------------------
+// API
+//------------------------------------------------------------------------------------
+
+static JobHandle ScheduleJobOn(JobFunction function, void* context, const JobHandle* dependencies, int dependencyCount,
+                               bool isMainThread) {
+    StartJobWorkers();
+    int index = AllocateJob();
+    Job* job = &gJobs.jobs[index];
+    job->function = function;
+    job->context = context;
+    job->isMainThread = isMainThread;
+    atomic_store(&job->waitCount, 1);
+    JobHandle handle = { (unsigned int)index, atomic_load(&job->generation) };
+
+    for (int i = 0; i < dependencyCount; i++) {
+        JobHandle dependency = dependencies[i];
+        bool isFull = false;
+        pthread_mutex_lock(&gJobs.graphMutex);
+        if (!IsJobDone(dependency)) {
+            Job* parent = &gJobs.jobs[dependency.index];
+            if (parent->continuationCount < JOB_MAX_DEPENDENCIES) {
+                parent->continuations[parent->continuationCount++] = index;
+                atomic_fetch_add(&job->waitCount, 1);
+            } else {
+                isFull = true;
+            }
+        }
+        pthread_mutex_unlock(&gJobs.graphMutex);
+        if (isFull) WaitForJob(dependency);
+    }
+
+    if (atomic_fetch_sub(&job->waitCount, 1) == 1) EnqueueReadyJob(index);
+    return handle;
+}
+
+JobHandle ScheduleJob(JobFunction function, void* context, const JobHandle* dependencies, int dependencyCount) {
+    return ScheduleJobOn(function, context, dependencies, dependencyCount, false);
+}
+
+JobHandle ScheduleMainThreadJob(JobFunction function, void* context, const JobHandle* dependencies, int dependencyCount) {
+    return ScheduleJobOn(function, context, dependencies, dependencyCount, true);
+}
+
+bool IsJobDone(JobHandle job) {
+    if (job.index == JOB_NONE || job.index >= JOB_MAX_JOBS) return true;
+    return atomic_load(&gJobs.jobs[job.index].generation) != job.generation;
+}
+
+void WaitForJob(JobHandle job) {
+    while (!IsJobDone(job)) {
+        if (gIsMainThread && RunMainThreadJob()) continue;
+        int other = FindJob();
+        if (other != JOB_NONE) {
+            RunJob(other);
+            continue;
+        }
+        // Rien à faire : dormir jusqu'à la fin d'une tâche ou une nouvelle tâche prête
+        pthread_mutex_lock(&gJobs.mutex);
+        while (!IsJobDone(job) && atomic_load(&gJobs.queuedCount) == 0 &&
+               !(gIsMainThread && gJobs.mainThread.count > 0)) {
+            gJobs.sleepingCount++;
+            pthread_cond_wait(&gJobs.wake, &gJobs.mutex);
+            gJobs.sleepingCount--;
+        }
+        pthread_mutex_unlock(&gJobs.mutex);
+    }
+}
+
+static void RunTiles(void* context) {
+    TileRange* range = (TileRange*)context;
+    int tile;
+    while ((tile = atomic_fetch_add(&range->nextTile, 1)) < range->tileCount) {
+        JobTile rect;
+        rect.x = (tile % range->columns) * range->tileWidth;
+        rect.y = (tile / range->columns) * range->tileHeight;
+        rect.width = range->width - rect.x < range->tileWidth ? range->width - rect.x : range->tileWidth;
+        rect.height = range->height - rect.y < range->tileHeight ? range->height - rect.y : range->tileHeight;
+        range->function(range->context, rect);
+    }
+}
+
+// Un participant par thread au plus : chacun prend des tuiles jusqu'à épuisement, les
+// participants lancés trop tard n'en trouvent plus et se terminent aussitôt
+void ParallelForTiles(int width, int height, int tileWidth, int tileHeight, JobTileFunction function, void* context) {
+    if (width <= 0 || height <= 0) return;
+    if (tileWidth < 1 || tileWidth > width) tileWidth = width;
+    if (tileHeight < 1 || tileHeight > height) tileHeight = height;
+
+    TileRange range = { .function = function, .context = context, .width = width, .height = height,
+                        .tileWidth = tileWidth, .tileHeight = tileHeight };
+    range.columns = (width + tileWidth - 1) / tileWidth;
+    range.tileCount = range.columns * ((height + tileHeight - 1) / tileHeight);
+    atomic_init(&range.nextTile, 0);
+
+    int helperCount = GetJobThreadCount() - 1;
+    if (helperCount > range.tileCount - 1) helperCount = range.tileCount - 1;
+    JobHandle helpers[JOB_MAX_THREADS];
+    for (int i = 0; i < helperCount; i++) helpers[i] = ScheduleJob(RunTiles, &range, NULL, 0);
+    RunTiles(&range);
+    for (int i = 0; i < helperCount; i++) WaitForJob(helpers[i]);
+}
+
+int RunMainThreadJobs(double budgetSeconds) {
+    double start = GetJobTime();
+    int count = 0;
+    do {
+        if (!RunMainThreadJob()) break;
+        count++;
+    } while (GetJobTime() - start < budgetSeconds);
+    return count;
+}
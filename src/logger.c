@@ -0,0 +1,300 @@
+#include "logger.h"
+#include "memory_budget.h"
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_RING_MASK (LOG_RING_SIZE - 1)
+#define LOG_FLUSH_INTERVAL_MS 20 // Le thread d'écriture se réveille au moins à cette fréquence
+#define LOG_BATCH_SIZE 16384     // Lignes accumulées avant un fwrite
+#define LOG_REPEAT_MAX_COUNT 1000 // Un message répété est écrit au plus toutes les N occurrences...
+#define LOG_REPEAT_MAX_MS 1000    // ...ou au plus tard après ce délai
+
+// Slot du tampon circulaire (file bornée de Vyukov). sequence == position : slot libre
+// pour l'écrivain qui réserve cette position ; sequence == position + 1 : message prêt
+// pour le thread d'écriture.
+typedef struct {
+    atomic_size_t sequence;
+    int severity;
+    int length;
+    char text[LOG_MAX_MESSAGE_LENGTH];
+} LogCell;
+
+typedef struct {
+    LogCell cells[LOG_RING_SIZE];
+    atomic_size_t writePosition;          // Prochaine position réservée par un écrivain
+    atomic_size_t readPosition;           // Prochaine position lue par le thread d'écriture
+    atomic_int droppedCount;              // Messages perdus (tampon plein) depuis le dernier lot
+    atomic_bool isRunning;
+
+    // Réservé au thread d'écriture
+    FILE* logFile;
+    char batch[LOG_BATCH_SIZE];
+    int batchLength;
+    char lastMessage[LOG_MAX_MESSAGE_LENGTH]; // Message en cours de regroupement
+    int lastLength;                       // -1 : aucun message
+    int lastSeverity;
+    int repeatCount;                      // Occurrences pas encore écrites
+    double repeatStartTime;               // Première occurrence pas encore écrite
+
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t wake;                  // Tampon à moitié plein ou arrêt
+    bool isQuitting;
+} Logger;
+
+static Logger gLogger = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+};
+
+static double GetLogTime(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static const char* GetSeverityPrefix(int severity) {
+    switch (severity) {
+        case LOG_SEVERITY_WARNING: return "WARNING: ";
+        case LOG_SEVERITY_ERROR: return "ERROR: ";
+        default: return "";
+    }
+}
+
+static void FlushLogBatch(void) {
+    if (gLogger.batchLength == 0) return;
+    fwrite(gLogger.batch, 1, gLogger.batchLength, gLogger.logFile);
+    fflush(gLogger.logFile);
+    gLogger.batchLength = 0;
+}
+
+static void AppendLogLine(const char* format, ...) {
+    // Une ligne tient toujours dans un lot vide (message tronqué + préfixe + compteur)
+    if (gLogger.batchLength > LOG_BATCH_SIZE - LOG_MAX_MESSAGE_LENGTH - 64) FlushLogBatch();
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(gLogger.batch + gLogger.batchLength, LOG_BATCH_SIZE - gLogger.batchLength, format, args);
+    va_end(args);
+    if (length > 0) {
+        gLogger.batchLength += length;
+        if (gLogger.batchLength > LOG_BATCH_SIZE - 1) gLogger.batchLength = LOG_BATCH_SIZE - 1;
+    }
+}
+
+// Écrit le message en cours de regroupement ("message xN" s'il a été répété)
+static void FlushRepeatedMessage(void) {
+    if (gLogger.repeatCount == 0) return;
+    const char* prefix = GetSeverityPrefix(gLogger.lastSeverity);
+    if (gLogger.repeatCount > 1) {
+        AppendLogLine("%s%s x%d\n", prefix, gLogger.lastMessage, gLogger.repeatCount);
+    } else {
+        AppendLogLine("%s%s\n", prefix, gLogger.lastMessage);
+    }
+    gLogger.repeatCount = 0;
+}
+
+static void ProcessLogMessage(int severity, const char* text, int length) {
+    // Un message répété après une écriture partielle continue le même groupe, sans nouvel écho
+    if (severity == gLogger.lastSeverity && length == gLogger.lastLength &&
+        memcmp(text, gLogger.lastMessage, length) == 0) {
+        if (gLogger.repeatCount == 0) gLogger.repeatStartTime = GetLogTime();
+        gLogger.repeatCount++;
+        if (gLogger.repeatCount >= LOG_REPEAT_MAX_COUNT) FlushRepeatedMessage();
+        return;
+    }
+    FlushRepeatedMessage();
+    memcpy(gLogger.lastMessage, text, length);
+    gLogger.lastMessage[length] = '\0';
+    gLogger.lastLength = length;
+    gLogger.lastSeverity = severity;
+    gLogger.repeatCount = 1;
+    gLogger.repeatStartTime = GetLogTime();
+    // Les avertissements et erreurs restent visibles en console (première occurrence)
+    if (severity >= LOG_SEVERITY_WARNING) printf("%s%s\n", GetSeverityPrefix(severity), gLogger.lastMessage);
+}
+
+static bool HasPendingLogMessage(void) {
+    size_t position = atomic_load_explicit(&gLogger.readPosition, memory_order_relaxed);
+    LogCell* cell = &gLogger.cells[position & LOG_RING_MASK];
+    return atomic_load_explicit(&cell->sequence, memory_order_acquire) == position + 1;
+}
+
+// Vide le tampon circulaire dans le lot courant puis l'écrit
+static void DrainLogRing(void) {
+    size_t position = atomic_load_explicit(&gLogger.readPosition, memory_order_relaxed);
+    int count = 0;
+    for (;;) {
+        LogCell* cell = &gLogger.cells[position & LOG_RING_MASK];
+        if (atomic_load_explicit(&cell->sequence, memory_order_acquire) != position + 1) break;
+        ProcessLogMessage(cell->severity, cell->text, cell->length);
+        // Libère le slot pour le tour suivant du tampon
+        atomic_store_explicit(&cell->sequence, position + LOG_RING_SIZE, memory_order_release);
+        position++;
+        atomic_store_explicit(&gLogger.readPosition, position, memory_order_relaxed);
+        count++;
+    }
+
+    // Un message répété sans fin (ou le dernier reçu) ne reste pas en attente indéfiniment
+    if (gLogger.repeatCount > 0 && (GetLogTime() - gLogger.repeatStartTime) * 1000.0 >= LOG_REPEAT_MAX_MS) {
+        FlushRepeatedMessage();
+    }
+    int dropped = atomic_exchange_explicit(&gLogger.droppedCount, 0, memory_order_relaxed);
+    if (dropped > 0) {
+        FlushRepeatedMessage();
+        AppendLogLine("LOG %d messages dropped (log buffer full)\n", dropped);
+    }
+    FlushLogBatch();
+}
+
+static void* LogWriterThread(void* arg) {
+    (void)arg;
+    bool isQuitting = false;
+    while (!isQuitting) {
+        pthread_mutex_lock(&gLogger.mutex);
+        if (!gLogger.isQuitting && !HasPendingLogMessage()) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += LOG_FLUSH_INTERVAL_MS * 1000000L;
+            if (deadline.tv_nsec >= 1000000000L) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000L;
+            }
+            pthread_cond_timedwait(&gLogger.wake, &gLogger.mutex, &deadline);
+        }
+        isQuitting = gLogger.isQuitting;
+        pthread_mutex_unlock(&gLogger.mutex);
+        DrainLogRing();
+    }
+    return NULL;
+}
+
+void InitLogger(void) {
+    #if LOG_MIN_SEVERITY >= LOG_SEVERITY_NONE
+    return;
+    #endif
+    if (atomic_load(&gLogger.isRunning)) return;
+    gLogger.logFile = fopen("debug.log", "w");
+    if (!gLogger.logFile) {
+        printf("WARNING: Failed to open debug.log, logging disabled\n");
+        return;
+    }
+    MemoryBudgetReserve(MEM_SUBSYS_LOGS, MEM_POOL_RAM, sizeof(gLogger));
+    fprintf(gLogger.logFile, "=== LOG START ===\n");
+    fflush(gLogger.logFile);
+
+    for (size_t i = 0; i < LOG_RING_SIZE; i++) atomic_init(&gLogger.cells[i].sequence, i);
+    atomic_store(&gLogger.writePosition, 0);
+    atomic_store(&gLogger.readPosition, 0);
+    atomic_store(&gLogger.droppedCount, 0);
+    gLogger.batchLength = 0;
+    gLogger.lastLength = -1;
+    gLogger.repeatCount = 0;
+    gLogger.isQuitting = false;
+    if (pthread_create(&gLogger.thread, NULL, LogWriterThread, NULL) != 0) {
+        printf("ERROR: Failed to start log writer thread\n");
+        fclose(gLogger.logFile);
+        gLogger.logFile = NULL;
+        MemoryBudgetRelease(MEM_SUBSYS_LOGS, MEM_POOL_RAM, sizeof(gLogger));
+        return;
+    }
+    atomic_store(&gLogger.isRunning, true);
+}
+
+void CloseLogger(void) {
+    if (!atomic_load(&gLogger.isRunning)) return;
+    atomic_store(&gLogger.isRunning, false);
+
+    pthread_mutex_lock(&gLogger.mutex);
+    gLogger.isQuitting = true;
+    pthread_cond_signal(&gLogger.wake);
+    pthread_mutex_unlock(&gLogger.mutex);
+    pthread_join(gLogger.thread, NULL);
+
+    FlushRepeatedMessage();
+    AppendLogLine("=== LOG END ===\n");
+    FlushLogBatch();
+    fclose(gLogger.logFile);
+    gLogger.logFile = NULL;
+    MemoryBudgetRelease(MEM_SUBSYS_LOGS, MEM_POOL_RAM, sizeof(gLogger));
+}
+
+// Réserve un slot ; NULL si le tampon est plein
+static LogCell* AcquireLogCell(size_t* position) {
+    size_t current = atomic_load_explicit(&gLogger.writePosition, memory_order_relaxed);
+    for (;;) {
+        LogCell* cell = &gLogger.cells[current & LOG_RING_MASK];
+        size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)current;
+        if (difference == 0) {
+            if (atomic_compare_exchange_weak_explicit(&gLogger.writePosition, &current, current + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                *position = current;
+                return cell;
+            }
+        } else if (difference < 0) {
+            // Slot pas encore lu depuis le tour précédent : tampon plein
+            atomic_fetch_add_explicit(&gLogger.droppedCount, 1, memory_order_relaxed);
+            return NULL;
+        } else {
+            current = atomic_load_explicit(&gLogger.writePosition, memory_order_relaxed);
+        }
+    }
+}
+
+static void PublishLogCell(LogCell* cell, size_t position) {
+    atomic_store_explicit(&cell->sequence, position + 1, memory_order_release);
+    // Réveil anticipé lors d'une rafale ; sinon le thread d'écriture passe à son rythme
+    if (position - atomic_load_explicit(&gLogger.readPosition, memory_order_relaxed) == LOG_RING_SIZE / 2) {
+        pthread_cond_signal(&gLogger.wake);
+    }
+}
+
+void LogMessage(const char* message) {
+    #if LOG_MIN_SEVERITY > LOG_SEVERITY_INFO
+    (void)message;
+    return;
+    #endif
+    // Journal pas démarré (modes ligne de commande) ou déjà fermé : directement sur stdout
+    if (!atomic_load_explicit(&gLogger.isRunning, memory_order_relaxed)) {
+        printf("%s\n", message);
+        return;
+    }
+    size_t position;
+    LogCell* cell = AcquireLogCell(&position);
+    if (cell == NULL) return;
+    size_t length = strlen(message);
+    if (length > LOG_MAX_MESSAGE_LENGTH - 1) length = LOG_MAX_MESSAGE_LENGTH - 1;
+    memcpy(cell->text, message, length);
+    cell->severity = LOG_SEVERITY_INFO;
+    cell->length = (int)length;
+    PublishLogCell(cell, position);
+}
+
+void LogWrite(int severity, const char* format, ...) {
+    if (severity < LOG_MIN_SEVERITY) return;
+    va_list args;
+    if (!atomic_load_explicit(&gLogger.isRunning, memory_order_relaxed)) {
+        va_start(args, format);
+        printf("%s", GetSeverityPrefix(severity));
+        vprintf(format, args);
+        printf("\n");
+        va_end(args);
+        return;
+    }
+    size_t position;
+    LogCell* cell = AcquireLogCell(&position);
+    if (cell == NULL) return;
+    va_start(args, format);
+    int length = vsnprintf(cell->text, sizeof(cell->text), format, args);
+    va_end(args);
+    if (length < 0) length = 0;
+    if (length > LOG_MAX_MESSAGE_LENGTH - 1) length = LOG_MAX_MESSAGE_LENGTH - 1;
+    cell->severity = severity;
+    cell->length = length;
+    PublishLogCell(cell, position);
+}
@@ -1,4 +1,19 @@
 #include "raylib.h"
+#include "memory_budget.h"
+#include "texture_pool.h"
+#include "frame_arena.h"
+#include "file_watch.h"
+#include "shader_reload.h"
+#include "shader_preprocess.h"
+#include "render_graph.h"
+#include "shader_registry.h"
+#include "gpu_timer.h"
+#include "quality_lod.h"
+#include "batch_render.h"
+#include "shader_suite.h"
+#include "video_export.h"
+#include "job_system.h"
+#include "logger.h"
 #include <sys/stat.h> // Pour stat()
 #include <stdio.h>
 #include <string.h>
@@ -17,104 +32,27 @@
 #endif
 #define UNUSED (void)
 
-#define ENABLE_LOGGING 1 // Activer temporairement le logging pour déboguer
-
-// Structure pour le logging avec gestion des patterns
-#define MAX_LOG_BUFFER 64
-#define MAX_MESSAGE_LENGTH 256
-
-typedef struct {
-    char messages[MAX_LOG_BUFFER][MAX_MESSAGE_LENGTH];
-    int messageCount;
-    int writeIndex;
-    FILE* logFile;
-    char lastMessage[MAX_MESSAGE_LENGTH];
-    int consecutiveCount;
-} LogManager;
-
-static LogManager gLogManager = {0};
-
-void InitLogger(void) {
-    #if !ENABLE_LOGGING
-    return;
-    #endif
-    gLogManager.logFile = fopen("debug.log", "w");
-    if (gLogManager.logFile) {
-        fprintf(gLogManager.logFile, "=== LOG START ===\n");
-        fflush(gLogManager.logFile);
-    }
-    gLogManager.messageCount = 0;
-    gLogManager.writeIndex = 0;
-    gLogManager.consecutiveCount = 0;
-    gLogManager.lastMessage[0] = '\0';
-}
-
-void FlushConsecutiveMessages(void) {
-    if (gLogManager.consecutiveCount > 1) {
-        fprintf(gLogManager.logFile, "%s x%d\n", gLogManager.lastMessage, gLogManager.consecutiveCount);
-        fflush(gLogManager.logFile);
-    } else if (gLogManager.consecutiveCount == 1) {
-        fprintf(gLogManager.logFile, "%s\n", gLogManager.lastMessage);
-        fflush(gLogManager.logFile);
-    }
-    gLogManager.consecutiveCount = 0;
-}
-
-void LogMessage(const char* message) {
-    #if !ENABLE_LOGGING
-    return;
-    #endif
-    if (!gLogManager.logFile) return;
-    
-    // Si c'est le même message que le précédent, juste incrémenter le compteur
-    if (gLogManager.consecutiveCount > 0 && strcmp(gLogManager.lastMessage, message) == 0) {
-        gLogManager.consecutiveCount++;
-        return;
-    }
-    
-    // Flush les messages consécutifs précédents
-    FlushConsecutiveMessages();
-    
-    // Commencer un nouveau message
-    strcpy(gLogManager.lastMessage, message);
-    gLogManager.consecutiveCount = 1;
-    
-    // Ajouter au buffer circulaire pour détection de patterns plus complexes
-    strcpy(gLogManager.messages[gLogManager.writeIndex], message);
-    gLogManager.writeIndex = (gLogManager.writeIndex + 1) % MAX_LOG_BUFFER;
-    if (gLogManager.messageCount < MAX_LOG_BUFFER) {
-        gLogManager.messageCount++;
-    }
-}
-
-void CloseLogger(void) {
-    if (gLogManager.logFile) {
-        FlushConsecutiveMessages();
-        fprintf(gLogManager.logFile, "=== LOG END ===\n");
-        fclose(gLogManager.logFile);
-    }
-}
+#define MAX_SEQUENCE_FRAMES 15000 // Nombre maximum de frames d'une séquence vidéo
 
 // Structure pour gérer les erreurs de shader
 typedef struct {
     bool hasError;
     char errorMessage[512];
     bool isDefaultShader;
+    bool reloadFailed; // Dernier rechargement en échec, l'ancien programme est conservé
 } ShaderState;
 
-// Structure pour gérer les shaders disponibles
-#define MAX_SHADERS 32
-#define MAX_SHADER_NAME 64
+// État de la liste déroulante des shaders (la liste elle-même est tenue par shader_registry)
 typedef struct {
-    char names[MAX_SHADERS][MAX_SHADER_NAME];
-    char paths[MAX_SHADERS][320];
-    int count;
-    int selectedIndex;
     bool dropdownActive;
+    int firstVisible; // Premier élément affiché (défilement à la molette)
 } ShaderManager;
 
 static ShaderManager gShaderManager = {0};
 
+#define SHADER_DROPDOWN_ITEM_HEIGHT 20
+#define SHADER_DROPDOWN_VISIBLE_ITEMS 10 // Hauteur de la liste (200) / hauteur d'un élément
+
 // Shader par défaut simple qui ne fait rien
 const char* defaultFragmentShader = 
 "#version 460\n"
@@ -125,142 +63,96 @@ const char* defaultFragmentShader =
 "    fragColor = texture(texture0, fragTexCoord);\n"
 "}\n";
 
-// Fonction pour charger un shader de manière sécurisée
-Shader LoadShaderSafe(const char* vsFileName, const char* fsFileName, ShaderState* state) {
-    Shader shader = {0};
-    
+// Fonction pour charger un shader (toutes ses passes) de manière sécurisée
+void LoadShaderSafe(const char* fsFileName, RenderGraph* graph, ShaderState* state) {
     // Réinitialiser l'état
     state->hasError = false;
     state->errorMessage[0] = '\0';
     state->isDefaultShader = false;
+    state->reloadFailed = false;
     
-    // Essayer de charger le shader
-    shader = LoadShader(vsFileName, fsFileName);
+    // Essayer de charger le shader (après développement des #include),
+    // depuis le cache de binaires si ce source a déjà été compilé
+    char loadError[256] = {0};
+    bool loaded = LoadRenderGraphWithCache(fsFileName, graph, loadError, sizeof(loadError));
+    if (!loaded && loadError[0] != '\0') LOG_ERRORF("%s", loadError);
     
     // Vérifier si le shader est valide
-    if (shader.id == 0) {
+    if (!loaded) {
         // Échec du chargement, utiliser le shader par défaut
-        printf("ERROR: Failed to load shader '%s'\n", fsFileName);
+        LOG_ERRORF("Failed to load shader '%s'", fsFileName);
         LogMessage("LOG Shader loading failed");
         
         // Charger le shader par défaut
-        shader = LoadShaderFromMemory(NULL, defaultFragmentShader);
+        Shader shader = LoadShaderFromMemory(NULL, defaultFragmentShader);
         
         if (shader.id == 0) {
             // Même le shader par défaut a échoué
             state->hasError = true;
             snprintf(state->errorMessage, sizeof(state->errorMessage), 
                     "ERREUR CRITIQUE: Impossible de charger le shader par défaut");
-            printf("CRITICAL ERROR: Cannot load default shader\n");
+            LOG_ERRORF("Cannot load default shader");
         } else {
+            SetRenderGraphShader(graph, shader);
             state->isDefaultShader = true;
             snprintf(state->errorMessage, sizeof(state->errorMessage), 
                     "ERREUR SHADER: Utilisation du shader par défaut. Vérifiez '%s'", fsFileName);
-            printf("Using default shader due to error in '%s'\n", fsFileName);
+            LOG_INFOF("Using default shader due to error in '%s'", fsFileName);
         }
     } else {
-        printf("Shader loaded successfully: %s\n", fsFileName);
+        LOG_INFOF("Shader loaded successfully: %s", fsFileName);
         LogMessage("LOG Shader loaded successfully");
     }
-    
-    return shader;
 }
 
-// Fonction pour découvrir les shaders disponibles
-void DiscoverShaders(void) {
-    printf("=== DISCOVERING SHADERS ===\n");
-    
-    gShaderManager.count = 0;
-    gShaderManager.selectedIndex = 0;
-    gShaderManager.dropdownActive = false;
-    
-    // Chercher dans le dossier racine
-    DIR* dir = opendir(".");
-    if (dir) {
-        struct dirent* entry;
-        while ((entry = readdir(dir)) != NULL && gShaderManager.count < MAX_SHADERS) {
-            if (strstr(entry->d_name, ".glsl") && entry->d_name[0] != '.') {
-                // Extraire le nom sans extension
-                char nameWithoutExt[MAX_SHADER_NAME];
-                int copyLen = snprintf(nameWithoutExt, sizeof(nameWithoutExt), "%s", entry->d_name);
-                if (copyLen >= MAX_SHADER_NAME) {
-                    printf("Warning: shader name too long, truncated: %s\n", entry->d_name);
-                    continue; // Ignorer ce shader si le nom est trop long
-                }
-                
-                char* dotPos = strrchr(nameWithoutExt, '.');
-                if (dotPos) *dotPos = '\0';
-                
-                // Ajouter au manager
-                snprintf(gShaderManager.names[gShaderManager.count], MAX_SHADER_NAME, "%s", nameWithoutExt);
-                snprintf(gShaderManager.paths[gShaderManager.count], 320, "%s", entry->d_name);
-                
-                printf("Found shader: %s -> %s\n", nameWithoutExt, entry->d_name);
-                gShaderManager.count++;
-            }
-        }
-        closedir(dir);
-    }
-    
-    // Chercher dans un dossier "shaders" s'il existe
-    DIR* shaderDir = opendir("shaders");
-    if (shaderDir) {
-        struct dirent* entry;
-        while ((entry = readdir(shaderDir)) != NULL && gShaderManager.count < MAX_SHADERS) {
-            if (strstr(entry->d_name, ".glsl") && entry->d_name[0] != '.') {
-                // Extraire le nom sans extension
-                char nameWithoutExt[MAX_SHADER_NAME];
-                int copyLen = snprintf(nameWithoutExt, sizeof(nameWithoutExt), "%s", entry->d_name);
-                if (copyLen >= MAX_SHADER_NAME) {
-                    printf("Warning: shader name too long, truncated: %s\n", entry->d_name);
-                    continue; // Ignorer ce shader si le nom est trop long
-                }
-                
-                char* dotPos = strrchr(nameWithoutExt, '.');
-                if (dotPos) *dotPos = '\0';
-                
-                // Ajouter au manager avec le chemin du dossier
-                snprintf(gShaderManager.names[gShaderManager.count], MAX_SHADER_NAME, "%s", nameWithoutExt);
-                
-                // Construire le chemin avec vérification de la longueur
-                int pathLen = snprintf(gShaderManager.paths[gShaderManager.count], 256, "shaders/%s", entry->d_name);
-                if (pathLen >= 256) {
-                    printf("Warning: shader path too long, truncated: %s\n", entry->d_name);
-                    continue; // Ignorer ce shader si le chemin est trop long
-                }
-                
-                printf("Found shader: %s -> %s\n", nameWithoutExt, gShaderManager.paths[gShaderManager.count]);
-                gShaderManager.count++;
-            }
-        }
-        closedir(shaderDir);
-    }
-    
-    printf("Total shaders found: %d\n", gShaderManager.count);
-    
-    // Si aucun shader trouvé, ajouter un shader par défaut
-    if (gShaderManager.count == 0) {
-        snprintf(gShaderManager.names[0], MAX_SHADER_NAME, "Default");
-        snprintf(gShaderManager.paths[0], 256, "effect.glsl");
-        gShaderManager.count = 1;
-        printf("No shaders found, using default\n");
+// Fonction pour surveiller les dossiers des fichiers inclus par un shader
+void WatchShaderDependencies(const char* shaderPath) {
+    char dependencies[MAX_SHADER_DEPENDENCIES][SHADER_PREPROCESS_MAX_PATH];
+    int count = GetShaderDependencies(shaderPath, dependencies, MAX_SHADER_DEPENDENCIES);
+    for (int i = 0; i < count; i++) {
+        char* slash = strrchr(dependencies[i], '/');
+        if (slash) *slash = '\0';
+        FileWatchAddDirectory(slash ? dependencies[i] : ".");
     }
 }
 
-// Fonction pour obtenir le chemin du shader sélectionné
-const char* GetSelectedShaderPath(void) {
-    if (gShaderManager.selectedIndex >= 0 && gShaderManager.selectedIndex < gShaderManager.count) {
-        return gShaderManager.paths[gShaderManager.selectedIndex];
+// Fonction pour mettre en file de précompilation tous les shaders sauf l'actif
+void QueueShaderPrecompiles(void) {
+    for (int i = 0; i < GetShaderCount(); i++) {
+        if (i == GetSelectedShaderIndex()) continue;
+        if (!QueueShaderPrecompile(GetShaderEntry(i)->path)) break; // Cache plein
     }
-    return "effect.glsl"; // Fallback
 }
-time_t My_GetFileModTime(const char *path)
-{
-    struct stat attrib;
-    if (stat(path, &attrib) == 0)
-        return attrib.st_mtime;
-    else
-        return 0;
+
+// Fonction pour faire défiler la liste déroulante (sélection visible si possible)
+void ScrollShaderDropdown(int firstVisible, int visibleCount) {
+    int maxFirst = GetShaderCount() - visibleCount;
+    if (firstVisible > maxFirst) firstVisible = maxFirst;
+    if (firstVisible < 0) firstVisible = 0;
+    gShaderManager.firstVisible = firstVisible;
+}
+
+// Fonction pour dessiner le graphe des temps GPU du shader actif
+void DrawGpuTimeGraph(const RenderGraph* graph, Rectangle bounds) {
+    DrawRectangleRec(bounds, RAYWHITE);
+    DrawRectangleLinesEx(bounds, 1, DARKGRAY);
+
+    float samples[GPU_TIMER_HISTORY];
+    int count = GetRenderGraphGpuHistory(graph, samples, GPU_TIMER_HISTORY);
+    if (count < 2) return;
+
+    // Échelle : au moins 1 ms, sinon le plus grand échantillon affiché
+    float maxSample = 1.0f;
+    for (int i = 0; i < count; i++) maxSample = fmaxf(maxSample, samples[i]);
+
+    float step = (bounds.width - 2) / (GPU_TIMER_HISTORY - 1);
+    float startX = bounds.x + bounds.width - 1 - step * (count - 1);
+    for (int i = 1; i < count; i++) {
+        Vector2 from = { startX + step * (i - 1), bounds.y + bounds.height - 1 - (bounds.height - 2) * samples[i - 1] / maxSample };
+        Vector2 to = { startX + step * i, bounds.y + bounds.height - 1 - (bounds.height - 2) * samples[i] / maxSample };
+        DrawLineV(from, to, DARKGREEN);
+    }
+    DrawText(TextFormat("%.1f", maxSample), bounds.x + 2, bounds.y + 1, 8, GRAY);
 }
 
 // Structure pour le traitement vidéo synchrone
@@ -276,9 +168,9 @@ typedef struct {
 
 static VideoProcessor gVideoProcessor = {0};
 
-// Structure pour gérer un buffer de textures
+// Structure pour gérer un buffer de textures (chaque entrée possède une référence)
 typedef struct {
-    Texture2D* textures;
+    TextureHandle* handles;
     int count;
     int capacity;
     bool isAllocated;
@@ -291,12 +183,14 @@ void InitTextureBuffer(TextureBuffer* buffer, int capacity);
 void FreeTextureBuffer(TextureBuffer* buffer);
 bool LoadTextureToBuffer(TextureBuffer* buffer, const Image* image, int index);
 Texture2D* GetTextureFromBuffer(TextureBuffer* buffer, int index);
+TextureHandle GetTextureHandleFromBuffer(TextureBuffer* buffer, int index);
+void UnloadSequenceFrame(Image* frame);
 
 // Fonction pour initialiser le processeur vidéo
 void InitVideoProcessor(void) {
     memset(&gVideoProcessor, 0, sizeof(VideoProcessor));
     snprintf(gVideoProcessor.outputDir, sizeof(gVideoProcessor.outputDir), "./temp_frames/");
-    printf("Video processor initialized (synchronous mode)\n");
+    LOG_INFOF("Video processor initialized (synchronous mode)");
 }
 
 // Fonction pour nettoyer le répertoire temporaire
@@ -318,7 +212,7 @@ void CleanupTempFrames(void) {
 
 // Fonction synchrone pour traiter la vidéo avec FFmpeg
 bool ProcessVideoSynchronous(const char* videoPath) {
-    printf("=== PROCESSING VIDEO SYNCHRONOUSLY ===\n");
+    LOG_INFOF("=== PROCESSING VIDEO SYNCHRONOUSLY ===");
     
     // Copier le chemin de la vidéo
     strcpy(gVideoProcessor.inputPath, videoPath);
@@ -328,7 +222,7 @@ bool ProcessVideoSynchronous(const char* videoPath) {
     gVideoProcessor.fps = 0.0f;
     
     // Créer le répertoire temporaire
-    printf("Creating temp directory...\n");
+    LOG_INFOF("Creating temp directory...");
     #ifdef _WIN32
     int mkdirResult = system("if not exist temp_frames mkdir temp_frames");
     #else
@@ -336,7 +230,7 @@ bool ProcessVideoSynchronous(const char* videoPath) {
     #endif
     
     if (mkdirResult != 0) {
-        printf("ERROR: Failed to create temp directory\n");
+        LOG_ERRORF("Failed to create temp directory");
         gVideoProcessor.hasError = true;
         strcpy(gVideoProcessor.errorMessage, "Impossible de créer le répertoire temporaire");
         return false;
@@ -346,7 +240,7 @@ bool ProcessVideoSynchronous(const char* videoPath) {
     char ffmpegCmd[1024];
     char ffprobeCmd[1024];
     
-    printf("Getting video info with ffprobe...\n");
+    LOG_INFOF("Getting video info with ffprobe...");
     // D'abord, obtenir les informations sur la vidéo (FPS, durée, etc.)
     snprintf(ffprobeCmd, sizeof(ffprobeCmd), "ffprobe -v quiet -select_streams v:0 -show_entries stream=r_frame_rate -of csv=p=0 \"%s\" > temp_fps.txt", 
             videoPath);
@@ -368,32 +262,32 @@ bool ProcessVideoSynchronous(const char* videoPath) {
                 } else {
                     gVideoProcessor.fps = atof(fpsString);
                 }
-                printf("Detected FPS: %.2f\n", gVideoProcessor.fps);
+                LOG_INFOF("Detected FPS: %.2f", gVideoProcessor.fps);
             }
             fclose(fpsFile);
         }
         remove("temp_fps.txt");
     } else {
-        printf("WARNING: Failed to get video FPS, using default\n");
+        LOG_WARNINGF("Failed to get video FPS, using default");
     }
     
     // Si on n'a pas pu obtenir le FPS, utiliser une valeur par défaut
     if (gVideoProcessor.fps <= 0) {
         gVideoProcessor.fps = 30.0f;
-        printf("Using default FPS: %.2f\n", gVideoProcessor.fps);
+        LOG_INFOF("Using default FPS: %.2f", gVideoProcessor.fps);
     }
     
     // Extraire les frames avec FFmpeg
-    printf("Starting FFmpeg frame extraction...\n");
+    LOG_INFOF("Starting FFmpeg frame extraction...");
     snprintf(ffmpegCmd, sizeof(ffmpegCmd), "ffmpeg -i \"%s\" \"%sframe_%%06d.png\" -y", 
             videoPath, gVideoProcessor.outputDir);
     
-    printf("Executing FFmpeg command: %s\n", ffmpegCmd);
+    LOG_INFOF("Executing FFmpeg command: %s", ffmpegCmd);
     result = system(ffmpegCmd);
-    printf("FFmpeg command result: %d\n", result);
+    LOG_INFOF("FFmpeg command result: %d", result);
     
     if (result != 0) {
-        printf("ERROR: FFmpeg failed with error code: %d\n", result);
+        LOG_ERRORF("FFmpeg failed with error code: %d", result);
         gVideoProcessor.hasError = true;
         snprintf(gVideoProcessor.errorMessage, sizeof(gVideoProcessor.errorMessage), 
                 "Erreur FFmpeg (code: %d)", result);
@@ -401,7 +295,7 @@ bool ProcessVideoSynchronous(const char* videoPath) {
     }
     
     // Attendre que FFmpeg termine et compter les frames une seule fois
-    printf("FFmpeg extraction successful, waiting for completion...\n");
+    LOG_INFOF("FFmpeg extraction successful, waiting for completion...");
     
     #ifdef _WIN32
     Sleep(2000); // Attendre 2 secondes pour que FFmpeg termine
@@ -433,30 +327,30 @@ bool ProcessVideoSynchronous(const char* videoPath) {
         closedir(dir);
     }
     
-    printf("Frame extraction completed: %d frames found\n", finalFrameCount);
+    LOG_INFOF("Frame extraction completed: %d frames found", finalFrameCount);
     
     // Finaliser le traitement
     gVideoProcessor.frameCount = finalFrameCount;
-    printf("=== FINAL FRAME COUNT: %d ===\n", finalFrameCount);
+    LOG_INFOF("=== FINAL FRAME COUNT: %d ===", finalFrameCount);
     
     if (finalFrameCount > 0) {
         gVideoProcessor.isCompleted = true;
         gVideoProcessor.hasError = false;
-        printf("*** VIDEO PROCESSING COMPLETED SUCCESSFULLY ***\n");
-        printf("*** %d frames extracted at %.2f FPS ***\n", finalFrameCount, gVideoProcessor.fps);
+        LOG_INFOF("*** VIDEO PROCESSING COMPLETED SUCCESSFULLY ***");
+        LOG_INFOF("*** %d frames extracted at %.2f FPS ***", finalFrameCount, gVideoProcessor.fps);
         return true;
     } else {
         gVideoProcessor.hasError = true;
         strcpy(gVideoProcessor.errorMessage, "Aucune frame extraite");
-        printf("ERROR: No frames extracted\n");
+        LOG_ERRORF("No frames extracted");
         return false;
     }
 }
 
 // Fonction pour démarrer le traitement vidéo synchrone
 bool StartVideoProcessing(const char* videoPath) {
-    printf("=== STARTING VIDEO PROCESSING (SYNCHRONOUS) ===\n");
-    printf("Video file: %s\n", videoPath);
+    LOG_INFOF("=== STARTING VIDEO PROCESSING (SYNCHRONOUS) ===");
+    LOG_INFOF("Video file: %s", videoPath);
     
     // Nettoyer les frames précédentes
     CleanupTempFrames();
@@ -499,21 +393,74 @@ bool LoadSpecificFrame(int frameIndex, Image* frameImage) {
         return false;
     }
     
-    *frameImage = LoadImage(framePath);
-    return frameImage->data != NULL;
+    Image decoded = LoadImage(framePath);
+    if (decoded.data == NULL) return false;
+    
+    // Refuser la frame si le budget RAM est épuisé (après éviction)
+    size_t frameBytes = GetPixelDataSize(decoded.width, decoded.height, decoded.format);
+    if (!MemoryBudgetReserve(MEM_SUBSYS_FRAMES, MEM_POOL_RAM, frameBytes)) {
+        UnloadImage(decoded);
+        return false;
+    }
+    
+    // Ranger la frame dans son slot de l'arène : le buffer décodé (toujours de même taille)
+    // est libéré aussitôt, le tas ne se fragmente pas. L'arène est dimensionnée au clip
+    // (les huge pages hugetlb sont réservées en entier dès la création) ; une frame au-delà
+    // reste dans son buffer décodé.
+    int slotCount = gVideoProcessor.frameCount > 0 ? gVideoProcessor.frameCount : MAX_SEQUENCE_FRAMES;
+    if (!IsFrameArenaReady() || (IsFrameArenaEmpty() && (GetFrameArenaFrameBytes() != frameBytes ||
+                                                         GetFrameArenaSlotCapacity() < slotCount))) {
+        InitFrameArena(frameBytes, slotCount);
+    }
+    void* slot = GetFrameArenaFrameBytes() == frameBytes ? GetFrameArenaSlot(frameIndex) : NULL;
+    if (slot != NULL) {
+        memcpy(slot, decoded.data, frameBytes);
+        UnloadImage(decoded);
+        decoded.data = slot;
+    }
+    
+    *frameImage = decoded;
+    return true;
+}
+
+// Fonction pour décharger une frame en mettant à jour le budget mémoire
+void UnloadSequenceFrame(Image* frame) {
+    if (frame->data == NULL) return;
+    MemoryBudgetRelease(MEM_SUBSYS_FRAMES, MEM_POOL_RAM, GetPixelDataSize(frame->width, frame->height, frame->format));
+    if (IsFrameArenaPointer(frame->data)) {
+        DiscardFrameArenaSlot(GetFrameArenaSlotIndex(frame->data));
+    } else {
+        UnloadImage(*frame);
+    }
+    frame->data = NULL;
+}
+
+// Fonction pour libérer toute une séquence de frames (l'arène est vidée en une fois)
+void FreeFrameSequence(Image** sequence, int frameCount) {
+    if (*sequence == NULL) return;
+    for (int i = 0; i < frameCount; i++) {
+        Image* frame = &(*sequence)[i];
+        if (frame->data == NULL) continue;
+        MemoryBudgetRelease(MEM_SUBSYS_FRAMES, MEM_POOL_RAM, GetPixelDataSize(frame->width, frame->height, frame->format));
+        if (!IsFrameArenaPointer(frame->data)) UnloadImage(*frame);
+        frame->data = NULL;
+    }
+    ResetFrameArena();
+    free(*sequence);
+    *sequence = NULL;
 }
 
 // Fonction pour charger les frames extraites (version synchrone)
 bool LoadExtractedFrames(Image** sequence, TextureBuffer* textureBuffer, int* frameCount, float* fps) {
     LogMessage("LOG LoadExtractedFrames called");
-    printf("=== LOADING EXTRACTED FRAMES ===\n");
+    LOG_INFOF("=== LOADING EXTRACTED FRAMES ===");
     
-    printf("LoadExtractedFrames: checking state - completed=%d, hasError=%d, frameCount=%d\n", 
+    LOG_DEBUGF("LoadExtractedFrames: checking state - completed=%d, hasError=%d, frameCount=%d", 
            gVideoProcessor.isCompleted, gVideoProcessor.hasError, gVideoProcessor.frameCount);
     
     // Vérifier que le traitement est terminé
     if (gVideoProcessor.hasError) {
-        printf("LoadExtractedFrames failed: hasError=%d, error='%s'\n", 
+        LOG_WARNINGF("LoadExtractedFrames failed: hasError=%d, error='%s'", 
                gVideoProcessor.hasError, gVideoProcessor.errorMessage);
         LogMessage("LOG LoadExtractedFrames failed - has error");
         return false;
@@ -524,7 +471,7 @@ bool LoadExtractedFrames(Image** sequence, TextureBuffer* textureBuffer, int* fr
     
     // Compter les frames actuellement disponibles
     int availableFrames = 0;
-    for (int i = 0; i < 15000; i++) {
+    for (int i = 0; i < MAX_SEQUENCE_FRAMES; i++) {
         if (IsFrameAvailable(i)) {
             availableFrames = i + 1;
         } else {
@@ -532,7 +479,7 @@ bool LoadExtractedFrames(Image** sequence, TextureBuffer* textureBuffer, int* fr
         }
     }
     
-    printf("Found %d available frames (expected: %d)\n", availableFrames, totalExpectedFrames);
+    LOG_INFOF("Found %d available frames (expected: %d)", availableFrames, totalExpectedFrames);
     LogMessage("LOG Counted available frames");
     
     if (availableFrames <= 0) {
@@ -541,14 +488,14 @@ bool LoadExtractedFrames(Image** sequence, TextureBuffer* textureBuffer, int* fr
     }
     
     // Allouer la mémoire pour les frames
-    *sequence = (Image*)calloc(15000, sizeof(Image));
+    *sequence = (Image*)calloc(MAX_SEQUENCE_FRAMES, sizeof(Image));
     if (*sequence == NULL) {
         LogMessage("LOG Failed to allocate memory for frames");
         return false;
     }
     
     // Initialiser le buffer de textures
-    InitTextureBuffer(textureBuffer, 15000);
+    InitTextureBuffer(textureBuffer, MAX_SEQUENCE_FRAMES);
     
     LogMessage("LOG Memory allocated for frames and texture buffer");
     
@@ -563,33 +510,33 @@ bool LoadExtractedFrames(Image** sequence, TextureBuffer* textureBuffer, int* fr
                 loadedFrames++;
                 if (loadedFrames == 1) {
                     LogMessage("LOG First frame loaded successfully");
-                    printf("*** FIRST FRAME LOADED - READY FOR DISPLAY ***\n");
+                    LOG_INFOF("*** FIRST FRAME LOADED - READY FOR DISPLAY ***");
                 }
                 // Afficher le progrès tous les 50 frames
                 if (loadedFrames % 50 == 0) {
-                    printf("Progress: %d/%d frames loaded (%.1f%%)\n", 
+                    LOG_DEBUGF("Progress: %d/%d frames loaded (%.1f%%)", 
                            loadedFrames, availableFrames, 
                            (float)loadedFrames / availableFrames * 100.0f);
                 }
             } else {
-                printf("Failed to load texture for frame %d\n", i);
+                LOG_WARNINGF("Failed to load texture for frame %d", i);
                 failedTextures++;
-                UnloadImage((*sequence)[i]);
+                UnloadSequenceFrame(&(*sequence)[i]);
                 
                 if (failedTextures > 10) {
-                    printf("Too many texture failures (%d), stopping load\n", failedTextures);
+                    LOG_WARNINGF("Too many texture failures (%d), stopping load", failedTextures);
                     break;
                 }
             }
         } else {
-            printf("Failed to load frame %d\n", i);
+            LOG_WARNINGF("Failed to load frame %d", i);
             LogMessage("LOG Failed to load specific frame");
             break;
         }
     }
     
     *frameCount = loadedFrames;
-    printf("Total frames loaded: %d/%d (%.1f%%) - Texture failures: %d\n", 
+    LOG_INFOF("Total frames loaded: %d/%d (%.1f%%) - Texture failures: %d", 
            loadedFrames, availableFrames, 
            (float)loadedFrames / availableFrames * 100.0f, failedTextures);
     LogMessage("LOG Frame loading completed");
@@ -622,8 +569,8 @@ int CheckAndLoadNewFrames(Image** sequence, TextureBuffer* textureBuffer, int cu
                     newMaxFrames = i + 1;
                     newFramesLoaded++;
                 } else {
-                    printf("Failed to load texture for new frame %d\n", i + 1);
-                    UnloadImage((*sequence)[i]); // Décharger l'image si la texture a échoué
+                    LOG_WARNINGF("Failed to load texture for new frame %d", i + 1);
+                    UnloadSequenceFrame(&(*sequence)[i]); // Décharger l'image si la texture a échoué
                     break;
                 }
             } else {
@@ -635,7 +582,7 @@ int CheckAndLoadNewFrames(Image** sequence, TextureBuffer* textureBuffer, int cu
     }
     
     if (newFramesLoaded > 0) {
-        printf("Loaded %d new frames: total now %d\n", newFramesLoaded, newMaxFrames);
+        LOG_INFOF("Loaded %d new frames: total now %d", newFramesLoaded, newMaxFrames);
     }
     
     return newMaxFrames;
@@ -654,86 +601,147 @@ void GetVideoProcessingStatus(bool* isProcessing, bool* isCompleted, bool* hasEr
 
 // Fonction pour nettoyer le processeur vidéo (version synchrone)
 void CleanupVideoProcessor(void) {
-    printf("Cleaning up video processor...\n");
+    LOG_INFOF("Cleaning up video processor...");
     
     CleanupTempFrames();
-    printf("Video processor cleanup completed\n");
+    LOG_INFOF("Video processor cleanup completed");
+}
+
+// Fonction pour changer la texture affichée : le slot garde sa propre référence
+// et la vue n'est qu'une copie non propriétaire (jamais déchargée directement)
+void SetDisplayTexture(TextureHandle* displayHandle, Texture2D* displayView, TextureHandle newHandle) {
+    TextureHandle retained = RetainTexture(newHandle);
+    ReleaseTexture(displayHandle);
+    *displayHandle = retained;
+    
+    Texture2D* texture = ResolveTexture(retained);
+    *displayView = texture != NULL ? *texture : (Texture2D){0};
+}
+
+// Fonction pour afficher une frame de la séquence en partageant la texture du buffer
+bool SelectSequenceFrame(Image* sequence, TextureBuffer* textureBuffer, int index,
+                         TextureHandle* displayHandle, Texture2D* displayView) {
+    TextureHandle handle = GetTextureHandleFromBuffer(textureBuffer, index);
+    if (!IsTextureHandleValid(handle)) {
+        // Texture absente : la (re)charger dans le buffer depuis l'image CPU
+        if (sequence == NULL || sequence[index].data == NULL ||
+            !LoadTextureToBuffer(textureBuffer, &sequence[index], index)) {
+            return false;
+        }
+        handle = GetTextureHandleFromBuffer(textureBuffer, index);
+    }
+    SetDisplayTexture(displayHandle, displayView, handle);
+    return true;
+}
+
+// Fonction pour savoir si une frame de la séquence peut être affichée
+// (image en RAM ou texture déjà sur le GPU)
+bool IsSequenceFrameReady(const Image* sequence, TextureBuffer* textureBuffer, int index) {
+    if (sequence == NULL || index < 0) return false;
+    return sequence[index].data != NULL || GetTextureFromBuffer(textureBuffer, index) != NULL;
+}
+
+// Contexte pour l'éviction des frames sous pression mémoire
+typedef struct {
+    Image** sequence;
+    TextureBuffer* textureBuffer;
+    int* currentFrame;
+} FrameEvictionContext;
+
+// Évicteur RAM : libère la copie CPU des frames déjà présentes sur le GPU
+size_t EvictResidentFrames(MemPool pool, size_t bytesNeeded, void* userData) {
+    FrameEvictionContext* context = (FrameEvictionContext*)userData;
+    if (pool != MEM_POOL_RAM || *context->sequence == NULL) return 0;
+    
+    size_t freed = 0;
+    for (int i = 0; i < context->textureBuffer->count && freed < bytesNeeded; i++) {
+        if (i == *context->currentFrame) continue;
+        Image* frame = &(*context->sequence)[i];
+        if (frame->data != NULL && GetTextureFromBuffer(context->textureBuffer, i) != NULL) {
+            freed += GetPixelDataSize(frame->width, frame->height, frame->format);
+            UnloadSequenceFrame(frame);
+        }
+    }
+    return freed;
 }
 
 // Fonction pour initialiser le buffer de textures
 void InitTextureBuffer(TextureBuffer* buffer, int capacity) {
-    buffer->textures = (Texture2D*)calloc(capacity, sizeof(Texture2D));
+    buffer->handles = (TextureHandle*)calloc(capacity, sizeof(TextureHandle));
     buffer->count = 0;
     buffer->capacity = capacity;
     buffer->isAllocated = true;
-    printf("Texture buffer initialized with capacity: %d\n", capacity);
+    LOG_INFOF("Texture buffer initialized with capacity: %d", capacity);
 }
 
 // Fonction pour libérer le buffer de textures
 void FreeTextureBuffer(TextureBuffer* buffer) {
-    if (buffer->isAllocated && buffer->textures) {
+    if (buffer->isAllocated && buffer->handles) {
+        // Les textures encore référencées ailleurs (affichage, caches) restent vivantes
         for (int i = 0; i < buffer->count; i++) {
-            if (buffer->textures[i].id > 0) {
-                UnloadTexture(buffer->textures[i]);
-            }
+            ReleaseTexture(&buffer->handles[i]);
         }
-        free(buffer->textures);
-        buffer->textures = NULL;
+        free(buffer->handles);
+        buffer->handles = NULL;
         buffer->count = 0;
         buffer->capacity = 0;
         buffer->isAllocated = false;
-        printf("Texture buffer freed\n");
+        LOG_INFOF("Texture buffer freed");
     }
 }
 
 // Fonction pour charger une texture dans le buffer
 bool LoadTextureToBuffer(TextureBuffer* buffer, const Image* image, int index) {
-    if (!buffer->isAllocated || !buffer->textures || index >= buffer->capacity) {
-        printf("ERROR: Invalid texture buffer or index\n");
+    if (!buffer->isAllocated || !buffer->handles || index >= buffer->capacity) {
+        LOG_ERRORF("Invalid texture buffer or index");
         return false;
     }
     
-    // Si il y a déjà une texture à cet index, la décharger
-    if (index < buffer->count && buffer->textures[index].id > 0) {
-        UnloadTexture(buffer->textures[index]);
+    // Si il y a déjà une texture à cet index, libérer la référence du buffer
+    if (index < buffer->count) {
+        ReleaseTexture(&buffer->handles[index]);
     }
     
-    // Charger la nouvelle texture
-    buffer->textures[index] = LoadTextureFromImage(*image);
+    // Charger la nouvelle texture (refusée si le budget VRAM est épuisé)
+    buffer->handles[index] = AcquireTextureFromImage(*image);
+    Texture2D* texture = ResolveTexture(buffer->handles[index]);
+    if (texture == NULL) {
+        return false;
+    }
     
     // Mettre à jour le count si nécessaire
     if (index >= buffer->count) {
         buffer->count = index + 1;
     }
     
-    printf("Texture loaded to buffer at index %d (ID: %d)\n", index, buffer->textures[index].id);
-    return buffer->textures[index].id > 0;
+    LOG_DEBUGF("Texture loaded to buffer at index %d (ID: %d)", index, texture->id);
+    return true;
+}
+
+// Fonction pour obtenir le handle d'une texture du buffer
+TextureHandle GetTextureHandleFromBuffer(TextureBuffer* buffer, int index) {
+    if (!buffer->isAllocated || !buffer->handles || index >= buffer->count || index < 0) {
+        return TEXTURE_HANDLE_NULL;
+    }
+    return buffer->handles[index];
 }
 
 // Fonction pour obtenir une texture du buffer
 Texture2D* GetTextureFromBuffer(TextureBuffer* buffer, int index) {
-    if (!buffer->isAllocated || !buffer->textures || index >= buffer->count || index < 0) {
-        return NULL;
-    }
-    
-    if (buffer->textures[index].id > 0) {
-        return &buffer->textures[index];
-    }
-    
-    return NULL;
+    return ResolveTexture(GetTextureHandleFromBuffer(buffer, index));
 }
 
 // Fonction pour forcer le chargement de toutes les frames disponibles
 void LoadAllAvailableFrames(Image** sequence, TextureBuffer* textureBuffer, int* totalFrames) {
     if (!sequence || !*sequence || !textureBuffer) return;
     
-    printf("=== LOADING ALL AVAILABLE FRAMES ===\n");
+    LOG_INFOF("=== LOADING ALL AVAILABLE FRAMES ===");
     
     int currentMax = *totalFrames;
     int maxAvailable = 0;
     
     // Compter toutes les frames disponibles
-    for (int i = 0; i < 15000; i++) {
+    for (int i = 0; i < MAX_SEQUENCE_FRAMES; i++) {
         if (IsFrameAvailable(i)) {
             maxAvailable = i + 1;
         } else {
@@ -741,10 +749,10 @@ void LoadAllAvailableFrames(Image** sequence, TextureBuffer* textureBuffer, int*
         }
     }
     
-    printf("Found %d total available frames, currently loaded: %d\n", maxAvailable, currentMax);
+    LOG_INFOF("Found %d total available frames, currently loaded: %d", maxAvailable, currentMax);
     
     if (maxAvailable <= currentMax) {
-        printf("All frames already loaded\n");
+        LOG_INFOF("All frames already loaded");
         return;
     }
     
@@ -757,34 +765,51 @@ void LoadAllAvailableFrames(Image** sequence, TextureBuffer* textureBuffer, int*
             if (LoadTextureToBuffer(textureBuffer, &(*sequence)[i], i)) {
                 loadedFrames++;
                 if (loadedFrames % 100 == 0) {
-                    printf("Batch loading progress: %d/%d frames\n", 
+                    LOG_DEBUGF("Batch loading progress: %d/%d frames", 
                            currentMax + loadedFrames, maxAvailable);
                 }
             } else {
                 failedFrames++;
-                UnloadImage((*sequence)[i]);
+                UnloadSequenceFrame(&(*sequence)[i]);
                 if (failedFrames > 20) {
-                    printf("Too many texture failures, stopping batch load\n");
+                    LOG_WARNINGF("Too many texture failures, stopping batch load");
                     break;
                 }
             }
         } else {
             failedFrames++;
             if (failedFrames > 20) {
-                printf("Too many load failures, stopping batch load\n");
+                LOG_WARNINGF("Too many load failures, stopping batch load");
                 break;
             }
         }
     }
     
     *totalFrames = currentMax + loadedFrames;
-    printf("Batch load completed: %d new frames loaded (total: %d)\n", 
+    LOG_INFOF("Batch load completed: %d new frames loaded (total: %d)", 
            loadedFrames, *totalFrames);
 }
 
 
-int main(void)
+int main(int argc, char** argv)
 {
+    InitMemoryBudget();
+    InitJobSystem();
+
+    // Options en ligne de commande : traitement ou suite de tests sans fenêtre
+    if (IsBatchCommandLine(argc, argv)) {
+        #ifdef _WIN32
+        // Lié avec -mwindows : reprendre la console qui a lancé le programme
+        if (AttachConsole(ATTACH_PARENT_PROCESS)) {
+            freopen("CONOUT$", "w", stdout);
+            freopen("CONOUT$", "w", stderr);
+        }
+        #endif
+        int status = IsShaderSuiteCommandLine(argc, argv) ? RunShaderSuite(argc, argv) : RunBatchRender(argc, argv);
+        CloseJobSystem();
+        return status;
+    }
+
     InitLogger();
     LogMessage("LOG Program Start");
     
@@ -796,20 +821,35 @@ int main(void)
     const int screenHeight = 720;
     InitWindow(screenWidth, screenHeight, "Drag & Drop + Shader Zone");
     LogMessage("LOG Window Initialized");
+    InitTexturePool();
+    InitShaderReload();
 
-    // Découvrir les shaders disponibles
-    DiscoverShaders();
+    // Découvrir les shaders disponibles et surveiller leurs dossiers
+    // (les sauvegardes par renommage sont aussi détectées)
+    InitFileWatch();
+    InitShaderRegistry();
     LogMessage("LOG Shaders discovered");
 
     const char *shaderPath = GetSelectedShaderPath();
     ShaderState shaderState = {0};
-    Shader shader = LoadShaderSafe(0, shaderPath, &shaderState);
+    // Passes de l'effet (une seule sauf #pragma pass), uniforms résolus une fois par programme
+    RenderGraph effectGraph = {0};
+    // Niveau de qualité choisi pendant l'interaction (#pragma quality)
+    QualityController qualityController = {0};
+    EffectParams lastEffectParams = {0};
+    float effectIdleTime = 0.0f;
+    LoadShaderSafe(shaderPath, &effectGraph, &shaderState);
     LogMessage("LOG Shader loaded with error checking");
 
-    time_t lastModTime = My_GetFileModTime(shaderPath);
-    LogMessage("LOG File mod time retrieved");
+    WatchShaderDependencies(shaderPath);
+    LogMessage("LOG Shader file watch started");
 
-    Texture2D originalImageTex = {0}; // Image originale non modifiée
+    // Les autres shaders seront compilés pendant les frames libres
+    QueueShaderPrecompiles();
+
+    TextureHandle originalImageHandle = TEXTURE_HANDLE_NULL; // Référence sur la texture affichée
+    TextureHandle shadedImageHandle = TEXTURE_HANDLE_NULL; // Image du résultat de shader en cache
+    Texture2D originalImageTex = {0}; // Vue non propriétaire de l'image originale non modifiée
     LogMessage("LOG Image textures initialized");
     
     // Variables pour la gestion de l'image redimensionnée
@@ -828,6 +868,10 @@ int main(void)
     TextureBuffer videoTextureBuffer = {0}; // Buffer pour les textures vidéo
     char loadedFilePath[512] = {0};
     
+    // Sous pression RAM, libérer les copies CPU des frames déjà sur le GPU
+    FrameEvictionContext frameEvictionContext = { &frameSequence, &videoTextureBuffer, &currentFrame };
+    RegisterMemoryEvictor(MEM_SUBSYS_FRAMES, EvictResidentFrames, &frameEvictionContext);
+    
     // Variables pour le traitement vidéo (simplifiées pour le mode synchrone)
     // char videoErrorMessage[256] = {0}; // Removed - unused variable
     
@@ -859,9 +903,6 @@ int main(void)
     while (!WindowShouldClose())
     {
         
-        // Vérifier modification toutes les 60 frames
-        static int frameCounter = 0;
-        
         // Gestion drag & drop
         if (IsFileDropped())
         {
@@ -884,20 +925,16 @@ int main(void)
                     LogMessage("LOG Image file detected");
                     
                     // Nettoyer les données précédentes
-                    if (originalImageTex.id > 0) UnloadTexture(originalImageTex);
-                    if (frameSequence != NULL) {
-                        for (int i = 0; i < totalFrames; i++) {
-                            UnloadImage(frameSequence[i]);
-                        }
-                        free(frameSequence);
-                        frameSequence = NULL;
-                    }
+                    SetDisplayTexture(&originalImageHandle, &originalImageTex, TEXTURE_HANDLE_NULL);
+                    FreeFrameSequence(&frameSequence, totalFrames);
                     // Nettoyer le buffer de textures vidéo
                     FreeTextureBuffer(&videoTextureBuffer);
                     
                     // Charger la nouvelle image
                     Image img = LoadImage(files.paths[0]);
-                    originalImageTex = LoadTextureFromImage(img);
+                    TextureHandle imageHandle = AcquireTextureFromImage(img);
+                    SetDisplayTexture(&originalImageHandle, &originalImageTex, imageHandle);
+                    ReleaseTexture(&imageHandle);
                     UnloadImage(img);
                     
                     // Réinitialiser les variables de séquence
@@ -910,7 +947,6 @@ int main(void)
                     
                     strcpy(loadedFilePath, files.paths[0]);
                     
-                    frameCounter = -1;
                     LogMessage("LOG Image loaded and texture updated");
                     
                     // Calculer les dimensions pour adapter l'image à la fenêtre
@@ -949,14 +985,8 @@ int main(void)
                     LogMessage("LOG Video file detected");
                     
                     // Nettoyer les données précédentes
-                    if (originalImageTex.id > 0) UnloadTexture(originalImageTex);
-                    if (frameSequence != NULL) {
-                        for (int i = 0; i < totalFrames; i++) {
-                            UnloadImage(frameSequence[i]);
-                        }
-                        free(frameSequence);
-                        frameSequence = NULL;
-                    }
+                    SetDisplayTexture(&originalImageHandle, &originalImageTex, TEXTURE_HANDLE_NULL);
+                    FreeFrameSequence(&frameSequence, totalFrames);
                     // Nettoyer le buffer de textures vidéo
                     FreeTextureBuffer(&videoTextureBuffer);
                     
@@ -967,7 +997,7 @@ int main(void)
                         // En mode synchrone, charger immédiatement les frames
                         if (LoadExtractedFrames(&frameSequence, &videoTextureBuffer, &totalFrames, &frameRate)) {
                             LogMessage("LOG Video frames loaded successfully");
-                            printf("*** VIDEO FRAMES LOADED: %d frames at %.2f FPS ***\n", totalFrames, frameRate);
+                            LOG_INFOF("*** VIDEO FRAMES LOADED: %d frames at %.2f FPS ***", totalFrames, frameRate);
                             
                             isSequence = true;
                             currentFrame = 0;
@@ -976,12 +1006,7 @@ int main(void)
                             
                             // Charger la première frame
                             if (frameSequence != NULL && totalFrames > 0) {
-                                Texture2D* firstTexture = GetTextureFromBuffer(&videoTextureBuffer, 0);
-                                if (firstTexture != NULL) {
-                                    originalImageTex = *firstTexture;
-                                } else {
-                                    originalImageTex = LoadTextureFromImage(frameSequence[0]);
-                                }
+                                SelectSequenceFrame(frameSequence, &videoTextureBuffer, 0, &originalImageHandle, &originalImageTex);
                                 
                                 // Calculer les dimensions pour adapter l'image à la fenêtre
                                 float availableWidth = screenWidth - 200;
@@ -1007,16 +1032,16 @@ int main(void)
                                 sourceRect.width = originalImageTex.width;
                                 sourceRect.height = originalImageTex.height;
                                 
-                                printf("*** VIDEO READY FOR PLAYBACK ***\n");
+                                LOG_INFOF("*** VIDEO READY FOR PLAYBACK ***");
                                 LogMessage("LOG Video ready for playback");
                             }
                         } else {
                             LogMessage("LOG Failed to load video frames");
-                            printf("ERROR: Failed to load video frames\n");
+                            LOG_ERRORF("Failed to load video frames");
                         }
                     } else {
                         LogMessage("LOG Failed to start video processing");
-                        printf("ERROR: Failed to process video\n");
+                        LOG_ERRORF("Failed to process video");
                     }
                 }
                 else
@@ -1027,21 +1052,67 @@ int main(void)
             UnloadDroppedFiles(files);
         }
         
-        frameCounter++;
-        if (frameCounter >= 60)
+        // Recharger le shader dès qu'il est sauvegardé (aucun coût sans événement)
+        FileWatchEvent watchEvents[32];
+        int watchEventCount = PollFileWatch(watchEvents, 32);
+        bool shaderSourceChanged = false;
+        for (int i = 0; i < watchEventCount; i++)
         {
-            frameCounter = 0;
-            const char* currentShaderPath = GetSelectedShaderPath();
-            time_t modTime = My_GetFileModTime(currentShaderPath);
-            if (modTime != lastModTime)
-            {
-                lastModTime = modTime;
-                UnloadShader(shader);
-                shader = LoadShaderSafe(0, currentShaderPath, &shaderState);
-                LogMessage("LOG Shader reloaded due to file modification");
-                TraceLog(LOG_INFO, "Shader reloaded due to file modification.");
+            // Shader ajouté ou supprimé : mise à jour de la liste (la sélection suit son chemin)
+            if (UpdateShaderRegistry(&watchEvents[i])) {
+                ScrollShaderDropdown(gShaderManager.firstVisible, SHADER_DROPDOWN_VISIBLE_ITEMS);
             }
+
+            // Le fichier sera relu par le préprocesseur au prochain chargement,
+            // et les shaders précompilés qui l'utilisent seront recompilés
+            InvalidateShaderSourceFile(watchEvents[i].path);
+            InvalidatePrecompiledShaders(watchEvents[i].path);
+            
+            // Une suppression seule garde le shader actuel (le fichier va être recréé)
+            if (watchEvents[i].type == FILE_WATCH_DELETED) continue;
+            
+            // Nouveau shader : le compiler d'avance lui aussi
+            int eventIndex = FindShaderEntry(watchEvents[i].path);
+            if (eventIndex >= 0 && eventIndex != GetSelectedShaderIndex()) QueueShaderPrecompile(watchEvents[i].path);
+            
+            // Le shader actif ou l'un de ses fichiers inclus a changé
+            if (ShaderDependsOn(GetSelectedShaderPath(), watchEvents[i].path)) shaderSourceChanged = true;
+        }
+        if (shaderSourceChanged)
+        {
+            // L'ancien programme reste actif jusqu'à ce que le nouveau soit prêt
+            RequestShaderReload(GetSelectedShaderPath());
+            LogMessage("LOG Shader reload requested due to file modification");
+        }
+        
+        // Remplacer le shader seulement quand la compilation a réussi
+        ShaderReloadResult reloadResult = UpdateShaderReload(&effectGraph, shaderState.errorMessage, sizeof(shaderState.errorMessage));
+        if (reloadResult != SHADER_RELOAD_NONE) {
+            // Les inclusions ont pu changer : surveiller leurs dossiers
+            WatchShaderDependencies(GetSelectedShaderPath());
         }
+        if (reloadResult == SHADER_RELOAD_SWAPPED) {
+            ResetQualityController(&qualityController, GetRenderGraphQualityLevels(&effectGraph));
+            shaderState.hasError = false;
+            shaderState.isDefaultShader = false;
+            shaderState.reloadFailed = false;
+            shaderState.errorMessage[0] = '\0';
+            LogMessage("LOG Shader reloaded");
+            TraceLog(LOG_INFO, "Shader reloaded.");
+        } else if (reloadResult == SHADER_RELOAD_FAILED) {
+            shaderState.reloadFailed = true;
+            LogMessage("LOG Shader reload failed - previous shader kept");
+        }
+        
+        // Précompiler les autres shaders dans un budget de 2 ms par frame
+        const char* precompiledPath = UpdateShaderPrecompile(0.002);
+        if (precompiledPath != NULL) WatchShaderDependencies(precompiledPath);
+        // Variante spécialisée demandée pour les paramètres actuels (#pragma specialize)
+        UpdateShaderVariants(&effectGraph);
+        // Export vidéo en cours : 8 ms de rendu par frame, décodage et encodage en parallèle
+        UpdateVideoExport(&effectGraph, 0.008);
+        // Tâches CPU terminées qui doivent finir sur le thread GL (uploads...)
+        RunMainThreadJobs(0.002);
 
         // Gestion du verrouillage de la souris avec la touche espace
         bool spacePressed = IsKeyPressed(KEY_SPACE);
@@ -1074,19 +1145,12 @@ int main(void)
                 int nextFrame = currentFrame + 1;
                 
                 // Vérifier si la frame suivante est disponible
-                if (nextFrame < totalFrames && frameSequence[nextFrame].data != NULL) {
+                if (nextFrame < totalFrames && IsSequenceFrameReady(frameSequence, &videoTextureBuffer, nextFrame)) {
                     currentFrame = nextFrame;
                     
                     // Mettre à jour la texture avec la frame actuelle depuis le buffer
-                    Texture2D* nextTexture = GetTextureFromBuffer(&videoTextureBuffer, currentFrame);
-                    if (nextTexture != NULL) {
-                        originalImageTex = *nextTexture;
+                    if (SelectSequenceFrame(frameSequence, &videoTextureBuffer, currentFrame, &originalImageHandle, &originalImageTex)) {
                         LogMessage("LOG Frame updated from texture buffer");
-                    } else {
-                        // Fallback: créer la texture normalement
-                        UnloadTexture(originalImageTex);
-                        originalImageTex = LoadTextureFromImage(frameSequence[currentFrame]);
-                        LogMessage("LOG Frame updated (fallback - texture creation)");
                     }
                     
                     // Mettre à jour le slider
@@ -1096,27 +1160,19 @@ int main(void)
                     if (nextFrame >= totalFrames) {
                         // Fin de séquence, recommencer au début
                         currentFrame = 0;
-                        if (frameSequence != NULL && frameSequence[0].data != NULL) {
-                            Texture2D* firstTexture = GetTextureFromBuffer(&videoTextureBuffer, 0);
-                            if (firstTexture != NULL) {
-                                originalImageTex = *firstTexture;
-                            } else {
-                                UnloadTexture(originalImageTex);
-                                originalImageTex = LoadTextureFromImage(frameSequence[currentFrame]);
-                            }
-                        }
+                        SelectSequenceFrame(frameSequence, &videoTextureBuffer, 0, &originalImageHandle, &originalImageTex);
                         sliderValue = 0.0f;
                     } else {
                         // Frame suivante pas encore chargée, arrêter la lecture
                         isPlaying = false;
-                        printf("Playback paused: frame %d not ready\n", nextFrame);
+                        LOG_DEBUGF("Playback paused: frame %d not ready", nextFrame);
                         LogMessage("LOG Playback paused - next frame not ready");
                         
                         // Essayer de charger la frame manquante
                         if (LoadSpecificFrame(nextFrame, &frameSequence[nextFrame])) {
                             // Charger la texture dans le buffer
                             if (LoadTextureToBuffer(&videoTextureBuffer, &frameSequence[nextFrame], nextFrame)) {
-                                printf("Late frame %d loaded, resuming playback\n", nextFrame);
+                                LOG_DEBUGF("Late frame %d loaded, resuming playback", nextFrame);
                                 isPlaying = true;
                             }
                         }
@@ -1193,8 +1249,9 @@ int main(void)
             
             // Texte du shader sélectionné
             const char* selectedShaderName = "Default";
-            if (gShaderManager.selectedIndex >= 0 && gShaderManager.selectedIndex < gShaderManager.count) {
-                selectedShaderName = gShaderManager.names[gShaderManager.selectedIndex];
+            const ShaderEntry* selectedEntry = GetShaderEntry(GetSelectedShaderIndex());
+            if (selectedEntry != NULL) {
+                selectedShaderName = selectedEntry->name;
             }
             DrawText(selectedShaderName, shaderDropdown.x + 5, shaderDropdown.y + 5, 12, BLACK);
             DrawText("v", shaderDropdown.x + shaderDropdown.width - 15, shaderDropdown.y + 5, 12, BLACK);
@@ -1208,26 +1265,48 @@ int main(void)
             DrawRectangleLinesEx(shaderReloadButton, 2, BLACK);
             DrawText("Reload Shaders", shaderReloadButton.x + 5, shaderReloadButton.y + 5, 10, BLACK);
             
+            // Temps GPU du shader actif (requêtes de temps lues quelques frames plus tard)
+            float shaderGpuTime = GetRenderGraphGpuTime(&effectGraph);
+            if (!AreGpuTimersAvailable()) {
+                DrawText("GPU: n/a", shaderReloadButton.x + shaderReloadButton.width + 5, shaderReloadButton.y + 7, 10, DARKGRAY);
+            } else if (shaderGpuTime < 0.0f) {
+                DrawText("GPU: --", shaderReloadButton.x + shaderReloadButton.width + 5, shaderReloadButton.y + 7, 10, DARKGRAY);
+            } else {
+                DrawText(TextFormat("GPU: %.2f ms", shaderGpuTime), shaderReloadButton.x + shaderReloadButton.width + 5,
+                         shaderReloadButton.y + 7, 10, shaderGpuTime > 8.0f ? RED : DARKGREEN);
+            }
+            if (AreGpuTimersAvailable()) DrawGpuTimeGraph(&effectGraph, (Rectangle){10, 108, 180, 24});
+            
             // Liste déroulante des shaders si active
             if (gShaderManager.dropdownActive) {
-                float itemHeight = 20;
-                float maxHeight = fminf(gShaderManager.count * itemHeight, shaderDropdownList.height);
+                float itemHeight = SHADER_DROPDOWN_ITEM_HEIGHT;
+                int shaderCount = GetShaderCount();
+                float maxHeight = fminf(shaderCount * itemHeight, shaderDropdownList.height);
                 Rectangle listRect = {shaderDropdownList.x, shaderDropdownList.y, shaderDropdownList.width, maxHeight};
                 
                 DrawRectangleRec(listRect, LIGHTGRAY);
                 DrawRectangleLinesEx(listRect, 2, BLACK);
                 
-                for (int i = 0; i < gShaderManager.count; i++) {
-                    Rectangle itemRect = {listRect.x, listRect.y + i * itemHeight, listRect.width, itemHeight};
+                // Seuls les éléments visibles sont dessinés (la liste peut en contenir des milliers)
+                int lastVisible = (int)fminf(shaderCount, gShaderManager.firstVisible + SHADER_DROPDOWN_VISIBLE_ITEMS);
+                for (int i = gShaderManager.firstVisible; i < lastVisible; i++) {
+                    Rectangle itemRect = {listRect.x, listRect.y + (i - gShaderManager.firstVisible) * itemHeight, listRect.width, itemHeight};
                     
-                    Color itemColor = (i == gShaderManager.selectedIndex) ? BLUE : LIGHTGRAY;
+                    Color itemColor = (i == GetSelectedShaderIndex()) ? BLUE : LIGHTGRAY;
                     if (CheckCollisionPointRec(mousePos, itemRect)) {
                         itemColor = ColorBrightness(itemColor, 0.2f);
                     }
                     
                     DrawRectangleRec(itemRect, itemColor);
                     DrawRectangleLinesEx(itemRect, 1, DARKGRAY);
-                    DrawText(gShaderManager.names[i], itemRect.x + 5, itemRect.y + 2, 12, BLACK);
+                    DrawText(GetShaderEntry(i)->name, itemRect.x + 5, itemRect.y + 2, 12, BLACK);
+                }
+                
+                // Barre de défilement
+                if (shaderCount > SHADER_DROPDOWN_VISIBLE_ITEMS) {
+                    float thumbHeight = fmaxf(10.0f, listRect.height * SHADER_DROPDOWN_VISIBLE_ITEMS / shaderCount);
+                    float thumbY = listRect.y + (listRect.height - thumbHeight) * gShaderManager.firstVisible / (shaderCount - SHADER_DROPDOWN_VISIBLE_ITEMS);
+                    DrawRectangle(listRect.x + listRect.width - 6, thumbY, 4, thumbHeight, DARKGRAY);
                 }
             }
             textHeight += 100;
@@ -1249,11 +1328,45 @@ int main(void)
                 DrawText("ERREUR SHADER:", 10, textHeight+=25, 12, RED);
                 DrawText("CRITIQUE - Arrêt", 10, textHeight+=15, 10, RED);
                 DrawText(shaderState.errorMessage, 10, textHeight+=15, 8, RED);
+            } else if (shaderState.reloadFailed) {
+                DrawText("ÉCHEC RECHARGEMENT:", 10, textHeight+=25, 12, ORANGE);
+                DrawText("Ancien shader conservé", 10, textHeight+=15, 10, ORANGE);
+                DrawText(shaderState.errorMessage, 10, textHeight+=15, 8, ORANGE);
             } else if (shaderState.isDefaultShader) {
                 DrawText("SHADER PAR DÉFAUT:", 10, textHeight+=25, 12, ORANGE);
                 DrawText("Corrigez effect.fs", 10, textHeight+=15, 10, ORANGE);
                 DrawText("et sauvegardez", 10, textHeight+=15, 10, ORANGE);
             }
+            if (IsShaderReloadPending()) {
+                DrawText("Compilation du shader...", 10, textHeight+=15, 10, DARKBLUE);
+            } else if (GetPendingPrecompileCount() > 0) {
+                DrawText(TextFormat("Précompilation: %d/%d", GetPrecompiledShaderCount(),
+                                    GetPrecompiledShaderCount() + GetPendingPrecompileCount()), 10, textHeight+=15, 10, GRAY);
+            }
+            
+            // Niveau de qualité du shader (#pragma quality), réduit automatiquement si besoin
+            int shownQualityLevels = GetRenderGraphQualityLevels(&effectGraph);
+            if (shownQualityLevels > 1) {
+                int shownQuality = GetRenderGraphQuality(&effectGraph);
+                bool isReduced = shownQuality < shownQualityLevels - 1;
+                DrawText(TextFormat("Qualité: %d/%d%s", shownQuality + 1, shownQualityLevels, isReduced ? " (réduite)" : ""),
+                         10, textHeight+=15, 10, isReduced ? ORANGE : DARKGRAY);
+            }
+            if (effectGraph.desc.specializedParams != 0) {
+                DrawText(TextFormat("Variantes: %d%s", GetRenderGraphVariantCount(&effectGraph),
+                                    IsRenderGraphSpecialized(&effectGraph) ? " (active)" : ""), 10, textHeight+=15, 10, DARKGRAY);
+            }
+            
+            // Temps GPU de chaque passe d'un shader multi-passes
+            if (effectGraph.desc.passCount > 1 && GetRenderGraphGpuTime(&effectGraph) >= 0.0f) {
+                DrawText("Passes (GPU):", 10, textHeight+=25, 12, BLACK);
+                for (int i = 0; i < effectGraph.desc.passCount; i++) {
+                    float passTime = GetRenderPassGpuTime(&effectGraph, i);
+                    DrawText(passTime >= 0.0f ? TextFormat("%s: %.2f ms", effectGraph.desc.passes[i].name, passTime)
+                                              : TextFormat("%s: --", effectGraph.desc.passes[i].name),
+                             10, textHeight+=15, 10, DARKGRAY);
+                }
+            }
             
             // Affichage du statut de traitement vidéo (simplifié)
             if (gVideoProcessor.hasError) {
@@ -1274,6 +1387,26 @@ int main(void)
                 
                 // Afficher le statut de chargement (simplifié)
                 DrawText("Chargement terminé", 10, textHeight+=15, 10, GREEN);
+
+                VideoExportStatus exportStatus;
+                GetVideoExportStatus(&exportStatus);
+                if (exportStatus.state == VIDEO_EXPORT_RUNNING) {
+                    DrawText(exportStatus.frameCount > 0 ? TextFormat("Export: %d/%d (%.1f fps)", exportStatus.encodedFrames,
+                                                                      exportStatus.frameCount, exportStatus.framesPerSecond)
+                                                         : TextFormat("Export: %d (%.1f fps)", exportStatus.encodedFrames,
+                                                                      exportStatus.framesPerSecond),
+                             10, textHeight+=15, 10, DARKBLUE);
+                    DrawText("E: Annuler l'export", 10, textHeight+=15, 10, DARKGRAY);
+                } else if (exportStatus.state == VIDEO_EXPORT_DONE) {
+                    DrawText(TextFormat("Exporté: %d frames (%.1f fps)", exportStatus.encodedFrames, exportStatus.framesPerSecond),
+                             10, textHeight+=15, 10, GREEN);
+                    DrawText(GetFileName(exportStatus.outputPath), 10, textHeight+=15, 8, GREEN);
+                } else if (exportStatus.state == VIDEO_EXPORT_FAILED || exportStatus.state == VIDEO_EXPORT_CANCELLED) {
+                    DrawText(TextFormat("Export arrêté: %s", exportStatus.errorMessage), 10, textHeight+=15, 8,
+                             exportStatus.state == VIDEO_EXPORT_FAILED ? RED : ORANGE);
+                } else {
+                    DrawText("E: Exporter la vidéo", 10, textHeight+=15, 10, DARKGRAY);
+                }
             }
             
             if (originalImageTex.id > 0) {
@@ -1357,6 +1490,9 @@ int main(void)
                 DrawText("Load All", loadAllButton.x + 5, loadAllButton.y + 8, 14, BLACK);
             }
             
+            // Utilisation mémoire en direct en bas du panel
+            DrawMemoryBudgetPanel(10, screenHeight - 50);
+            
             // Modifier rayon
             if (IsKeyDown(KEY_UP)) {
                 radius += 1.0f;
@@ -1382,11 +1518,11 @@ int main(void)
                     // Vérifier si on peut lire la frame suivante
                     if (!isPlaying) {
                         int nextFrame = (currentFrame + 1) % totalFrames;
-                        if (frameSequence[nextFrame].data != NULL) {
+                        if (IsSequenceFrameReady(frameSequence, &videoTextureBuffer, nextFrame)) {
                             isPlaying = true;
                             LogMessage("LOG Playback started (keyboard)");
                         } else {
-                            printf("Cannot start playback: next frame not ready\n");
+                            LOG_INFOF("Cannot start playback: next frame not ready");
                         }
                     } else {
                         isPlaying = false;
@@ -1395,34 +1531,37 @@ int main(void)
                 }
                 if (IsKeyPressed(KEY_LEFT)) {
                     int prevFrame = (currentFrame - 1 + totalFrames) % totalFrames;
-                    if (frameSequence != NULL && frameSequence[prevFrame].data != NULL) {
+                    if (IsSequenceFrameReady(frameSequence, &videoTextureBuffer, prevFrame)) {
                         currentFrame = prevFrame;
-                        Texture2D* prevTexture = GetTextureFromBuffer(&videoTextureBuffer, currentFrame);
-                        if (prevTexture != NULL) {
-                            originalImageTex = *prevTexture;
-                        } else {
-                            UnloadTexture(originalImageTex);
-                            originalImageTex = LoadTextureFromImage(frameSequence[currentFrame]);
-                        }
+                        SelectSequenceFrame(frameSequence, &videoTextureBuffer, currentFrame, &originalImageHandle, &originalImageTex);
                         sliderValue = totalFrames > 1 ? (float)currentFrame / (float)(totalFrames - 1) : 0.0f;
                         LogMessage("LOG Previous frame (keyboard)");
                     }
                 }
+                // E : exporter la vidéo avec l'effet (ou annuler l'export en cours)
+                if (IsKeyPressed(KEY_E)) {
+                    if (IsVideoExportRunning()) {
+                        CancelVideoExport();
+                    } else {
+                        char exportPath[600];
+                        snprintf(exportPath, sizeof(exportPath), "%s/%s_shaded.mp4", GetDirectoryPath(loadedFilePath),
+                                 GetFileNameWithoutExt(loadedFilePath));
+                        // Paramètres de l'affichage, temps compté depuis la première frame
+                        EffectParams exportParams = { 0.0f, mouseLocked ? lockedMouseInImage : lastEffectParams.mousePos, radius, power };
+                        if (StartVideoExport(loadedFilePath, exportPath, &exportParams, totalFrames)) {
+                            LogMessage("LOG Video export started");
+                        }
+                    }
+                }
                 if (IsKeyPressed(KEY_RIGHT)) {
                     int nextFrame = (currentFrame + 1) % totalFrames;
-                    if (frameSequence != NULL && frameSequence[nextFrame].data != NULL) {
+                    if (IsSequenceFrameReady(frameSequence, &videoTextureBuffer, nextFrame)) {
                         currentFrame = nextFrame;
-                        Texture2D* nextTexture = GetTextureFromBuffer(&videoTextureBuffer, currentFrame);
-                        if (nextTexture != NULL) {
-                            originalImageTex = *nextTexture;
-                        } else {
-                            UnloadTexture(originalImageTex);
-                            originalImageTex = LoadTextureFromImage(frameSequence[currentFrame]);
-                        }
+                        SelectSequenceFrame(frameSequence, &videoTextureBuffer, currentFrame, &originalImageHandle, &originalImageTex);
                         sliderValue = totalFrames > 1 ? (float)currentFrame / (float)(totalFrames - 1) : 0.0f;
                         LogMessage("LOG Next frame (keyboard)");
                     } else {
-                        printf("Next frame not available yet\n");
+                        LOG_INFOF("Next frame not available yet");
                     }
                 }
             }
@@ -1435,11 +1574,11 @@ int main(void)
                 if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mousePos, playPauseButton)) {
                     if (!isPlaying) {
                         int nextFrame = (currentFrame + 1) % totalFrames;
-                        if (frameSequence[nextFrame].data != NULL) {
+                        if (IsSequenceFrameReady(frameSequence, &videoTextureBuffer, nextFrame)) {
                             isPlaying = true;
                             LogMessage("LOG Playback started (button)");
                         } else {
-                            printf("Cannot start playback: next frame not ready\n");
+                            LOG_INFOF("Cannot start playback: next frame not ready");
                         }
                     } else {
                         isPlaying = false;
@@ -1450,15 +1589,9 @@ int main(void)
                 // Clic sur le bouton Previous
                 if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mousePos, prevButton)) {
                     int prevFrame = (currentFrame - 1 + totalFrames) % totalFrames;
-                    if (frameSequence != NULL && frameSequence[prevFrame].data != NULL) {
+                    if (IsSequenceFrameReady(frameSequence, &videoTextureBuffer, prevFrame)) {
                         currentFrame = prevFrame;
-                        Texture2D* prevTexture = GetTextureFromBuffer(&videoTextureBuffer, currentFrame);
-                        if (prevTexture != NULL) {
-                            originalImageTex = *prevTexture;
-                        } else {
-                            UnloadTexture(originalImageTex);
-                            originalImageTex = LoadTextureFromImage(frameSequence[currentFrame]);
-                        }
+                        SelectSequenceFrame(frameSequence, &videoTextureBuffer, currentFrame, &originalImageHandle, &originalImageTex);
                         sliderValue = totalFrames > 1 ? (float)currentFrame / (float)(totalFrames - 1) : 0.0f;
                         LogMessage("LOG Previous frame (button)");
                     }
@@ -1467,48 +1600,51 @@ int main(void)
                 // Clic sur le bouton Next
                 if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mousePos, nextButton)) {
                     int nextFrame = (currentFrame + 1) % totalFrames;
-                    if (frameSequence != NULL && frameSequence[nextFrame].data != NULL) {
+                    if (IsSequenceFrameReady(frameSequence, &videoTextureBuffer, nextFrame)) {
                         currentFrame = nextFrame;
-                        Texture2D* nextTexture = GetTextureFromBuffer(&videoTextureBuffer, currentFrame);
-                        if (nextTexture != NULL) {
-                            originalImageTex = *nextTexture;
-                        } else {
-                            UnloadTexture(originalImageTex);
-                            originalImageTex = LoadTextureFromImage(frameSequence[currentFrame]);
-                        }
+                        SelectSequenceFrame(frameSequence, &videoTextureBuffer, currentFrame, &originalImageHandle, &originalImageTex);
                         sliderValue = totalFrames > 1 ? (float)currentFrame / (float)(totalFrames - 1) : 0.0f;
                         LogMessage("LOG Next frame (button)");
                     } else {
-                        printf("Next frame not available yet\n");
+                        LOG_INFOF("Next frame not available yet");
                     }
                 }
                 
                 // Clic sur le bouton Reload
                 if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mousePos, reloadButton)) {
-                    printf("Reloading video...\n");
+                    LOG_INFOF("Reloading video...");
                     currentFrame = 0;
                     totalFrames = 0;
                     isPlaying = false;
                     
-                    // Libérer les textures existantes
+                    // Libérer les frames et textures existantes
+                    FreeFrameSequence(&frameSequence, videoTextureBuffer.count);
                     FreeTextureBuffer(&videoTextureBuffer);
                     
-                    // Réinitialiser et recharger
-                    InitTextureBuffer(&videoTextureBuffer, 15000);
+                    // Recharger (LoadExtractedFrames réinitialise le buffer)
                     LoadExtractedFrames(&frameSequence, &videoTextureBuffer, &totalFrames, &frameRate);
+                    SelectSequenceFrame(frameSequence, &videoTextureBuffer, 0, &originalImageHandle, &originalImageTex);
                     
-                    printf("Video reloaded successfully with %d frames\n", totalFrames);
+                    LOG_INFOF("Video reloaded successfully with %d frames", totalFrames);
                     LogMessage("LOG Video reloaded");
                 }
                 
                 // Clic sur le bouton Load All
                 if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mousePos, loadAllButton)) {
-                    printf("Force loading all available frames...\n");
+                    LOG_INFOF("Force loading all available frames...");
                     LoadAllAvailableFrames(&frameSequence, &videoTextureBuffer, &totalFrames);
                     LogMessage("LOG All frames loaded");
                 }
             }
 
+            // Défilement de la liste déroulante à la molette
+            if (gShaderManager.dropdownActive && CheckCollisionPointRec(GetMousePosition(), shaderDropdownList)) {
+                float wheel = GetMouseWheelMove();
+                if (wheel != 0.0f) {
+                    ScrollShaderDropdown(gShaderManager.firstVisible - (int)(wheel * 3.0f), SHADER_DROPDOWN_VISIBLE_ITEMS);
+                }
+            }
+
             // Gestion des clics sur le dropdown des shaders
             if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
                 Vector2 mousePos = GetMousePosition();
@@ -1516,40 +1652,60 @@ int main(void)
                 // Clic sur le dropdown principal
                 if (CheckCollisionPointRec(mousePos, shaderDropdown)) {
                     gShaderManager.dropdownActive = !gShaderManager.dropdownActive;
+                    if (gShaderManager.dropdownActive) {
+                        // Ouvrir la liste sur le shader sélectionné
+                        ScrollShaderDropdown(GetSelectedShaderIndex() - SHADER_DROPDOWN_VISIBLE_ITEMS / 2, SHADER_DROPDOWN_VISIBLE_ITEMS);
+                    }
                     LogMessage("LOG Shader dropdown toggled");
                 }
                 // Clic sur le bouton reload des shaders
                 else if (CheckCollisionPointRec(mousePos, shaderReloadButton)) {
-                    printf("Reloading shader list...\n");
-                    DiscoverShaders();
+                    LOG_INFOF("Reloading shader list...");
+                    RescanShaderRegistry(); // La sélection est conservée
+                    ScrollShaderDropdown(gShaderManager.firstVisible, SHADER_DROPDOWN_VISIBLE_ITEMS);
+                    ClearShaderPreprocessCache(); // Tout relire depuis le disque
+                    ClearPrecompiledShaders();
                     
-                    // Recharger le shader actuel
+                    // Recharger le shader actuel (en arrière-plan)
                     const char* currentShaderPath = GetSelectedShaderPath();
-                    UnloadShader(shader);
-                    shader = LoadShaderSafe(0, currentShaderPath, &shaderState);
-                    lastModTime = My_GetFileModTime(currentShaderPath);
+                    RequestShaderReload(currentShaderPath);
+                    QueueShaderPrecompiles();
                     
-                    printf("Shader list reloaded, found %d shaders\n", gShaderManager.count);
+                    LOG_INFOF("Shader list reloaded, found %d shaders", GetShaderCount());
                     LogMessage("LOG Shader list reloaded");
                 }
                 // Clic sur un item de la liste déroulante
                 else if (gShaderManager.dropdownActive && CheckCollisionPointRec(mousePos, shaderDropdownList)) {
-                    float itemHeight = 20;
-                    int clickedIndex = (int)((mousePos.y - shaderDropdownList.y) / itemHeight);
+                    float itemHeight = SHADER_DROPDOWN_ITEM_HEIGHT;
+                    int clickedIndex = gShaderManager.firstVisible + (int)((mousePos.y - shaderDropdownList.y) / itemHeight);
                     
-                    if (clickedIndex >= 0 && clickedIndex < gShaderManager.count) {
-                        gShaderManager.selectedIndex = clickedIndex;
+                    if (clickedIndex >= 0 && clickedIndex < GetShaderCount()) {
+                        // Le shader actuel n'est gardé compilé que s'il correspond à son fichier
+                        char previousShaderPath[SHADER_PREPROCESS_MAX_PATH];
+                        snprintf(previousShaderPath, sizeof(previousShaderPath), "%s", GetSelectedShaderPath());
+                        bool keepPrevious = !shaderState.hasError && !shaderState.isDefaultShader && !shaderState.reloadFailed;
+                        
+                        SelectShader(clickedIndex);
                         gShaderManager.dropdownActive = false;
                         
                         // Charger le nouveau shader
                         const char* newShaderPath = GetSelectedShaderPath();
-                        printf("Switching to shader: %s\n", newShaderPath);
+                        LOG_INFOF("Switching to shader: %s", newShaderPath);
                         
-                        UnloadShader(shader);
-                        shader = LoadShaderSafe(0, newShaderPath, &shaderState);
-                        lastModTime = My_GetFileModTime(newShaderPath);
-                        
-                        LogMessage("LOG Shader switched");
+                        if (SwapPrecompiledShader(newShaderPath, &effectGraph, keepPrevious ? previousShaderPath : NULL)) {
+                            // Déjà compilé : remplacé immédiatement
+                            WatchShaderDependencies(newShaderPath);
+                            ResetQualityController(&qualityController, GetRenderGraphQualityLevels(&effectGraph));
+                            shaderState.hasError = false;
+                            shaderState.isDefaultShader = false;
+                            shaderState.reloadFailed = false;
+                            shaderState.errorMessage[0] = '\0';
+                            LogMessage("LOG Shader switched to precompiled program");
+                        } else {
+                            // Le shader précédent reste affiché pendant la compilation
+                            RequestShaderReload(newShaderPath);
+                            LogMessage("LOG Shader switch requested");
+                        }
                     }
                 }
                 // Clic ailleurs ferme la liste déroulante
@@ -1565,7 +1721,7 @@ int main(void)
                 LogMessage("LOG Drawing imagef");
                 
                 // Vérifier si on peut appliquer le shader
-                if (applyShader && !shaderState.hasError && shader.id > 0)
+                if (applyShader && !shaderState.hasError && IsRenderGraphReady(&effectGraph))
                 {
                     // Convertir les coordonnées de la souris vers les coordonnées de l'image
                     Vector2 mouseInImage;
@@ -1587,30 +1743,49 @@ int main(void)
                     static int timeDebugCounter = 0;
                     timeDebugCounter++;
                     if (timeDebugCounter % 120 == 0) {
-                        printf("Shader time: %.2f seconds\n", timeSeconds);
+                        LOG_DEBUGF("Shader time: %.2f seconds", timeSeconds);
+                    }
+                    
+                    // Appliquer les passes du shader lors de l'affichage (la dernière dessine l'image)
+                    EffectParams effectParams = { timeSeconds, mouseInImage, radius, power };
+                    // Un id de texture peut être réutilisé par le pool : comparer les handles
+                    if (originalImageHandle.index != shadedImageHandle.index ||
+                        originalImageHandle.generation != shadedImageHandle.generation) {
+                        InvalidateRenderGraphResult(&effectGraph);
+                        shadedImageHandle = originalImageHandle;
                     }
                     
-                    // Appliquer le shader directement lors de l'affichage
-                    BeginShaderMode(shader);
-                        // Envoyer toutes les variables uniform au shader
-                        int timeLocation = GetShaderLocation(shader, "time");
-                        if (timeLocation != -1) {
-                            SetShaderValue(shader, timeLocation, &timeSeconds, SHADER_UNIFORM_FLOAT);
+                    // Qualité réduite si besoin tant que l'utilisateur agit ou que la séquence
+                    // avance, complète dès que tout est figé (même si le shader anime time).
+                    // Pendant un export, le graphe reste en qualité complète.
+                    int qualityLevels = GetRenderGraphQualityLevels(&effectGraph);
+                    if (qualityLevels > 1 && !IsVideoExportRunning()) {
+                        bool effectChanging = (isSequence && isPlaying) ||
+                                              memcmp(&effectParams.mousePos, &lastEffectParams.mousePos, sizeof(Vector2)) != 0 ||
+                                              effectParams.radius != lastEffectParams.radius || effectParams.power != lastEffectParams.power;
+                        effectIdleTime = effectChanging ? 0.0f : effectIdleTime + GetFrameTime();
+                        if (effectIdleTime >= 0.3f) {
+                            SetRenderGraphQuality(&effectGraph, qualityLevels - 1);
                         } else {
-                            if (timeDebugCounter % 300 == 0) { // Toutes les 5 secondes
-                                printf("WARNING: Shader uniform 'time' not found\n");
-                            }
+                            SetRenderGraphQuality(&effectGraph, UpdateQualityController(&qualityController, qualityLevels, GetFrameTime(),
+                                                                                        GetRenderGraphGpuTime(&effectGraph), 1000.0f / 60.0f));
                         }
-                        SetShaderValue(shader, GetShaderLocation(shader, "mousePos"), 
-                                     (float[2]){mouseInImage.x, mouseInImage.y}, SHADER_UNIFORM_VEC2);
-                        SetShaderValue(shader, GetShaderLocation(shader, "radius"), &radius, SHADER_UNIFORM_FLOAT);
-                        SetShaderValue(shader, GetShaderLocation(shader, "power"), &power, SHADER_UNIFORM_FLOAT);
-                        SetShaderValue(shader, GetShaderLocation(shader, "resolution"), 
-                                     (float[2]){(float)originalImageTex.width, (float)originalImageTex.height}, SHADER_UNIFORM_VEC2);
-
+                    }
+                    lastEffectParams = effectParams;
+                    
+                    // Paramètres inchangés depuis une demi-seconde : compiler une variante où ils
+                    // sont constants (le programme générique sert en attendant)
+                    RenderGraphVariantKey variantKey;
+                    if (!shaderState.reloadFailed && !shaderState.isDefaultShader &&
+                        GetRenderGraphVariantRequest(&effectGraph, &effectParams, 0.5, &variantKey)) {
+                        RequestShaderVariant(GetSelectedShaderPath(), &variantKey);
+                    }
+                    if (DrawRenderGraph(&effectGraph, originalImageTex, sourceRect, imageRect, &effectParams)) {
+                        LogMessage("LOG Shader applied to image");
+                    } else {
+                        // Cibles intermédiaires indisponibles : image sans effet
                         DrawTexturePro(originalImageTex, sourceRect, imageRect, (Vector2){0, 0}, 0.0f, WHITE);
-                    EndShaderMode();
-                    LogMessage("LOG Shader applied to image");
+                    }
                 }
                 else
                 {
@@ -1646,25 +1821,31 @@ int main(void)
     }
 
     LogMessage("LOG Program ending - cleaning up");
+
+    // Arrêter un export en cours (ressources GL libérées avant CloseWindow)
+    CloseVideoExport();
+    CloseJobSystem();
     
     // Nettoyer le processeur vidéo
     CleanupVideoProcessor();
     LogMessage("LOG Video processor cleaned up");
     
-    if (originalImageTex.id > 0) UnloadTexture(originalImageTex);
+    SetDisplayTexture(&originalImageHandle, &originalImageTex, TEXTURE_HANDLE_NULL);
     
     // Nettoyer les séquences d'images
-    if (frameSequence != NULL) {
-        for (int i = 0; i < totalFrames; i++) {
-            UnloadImage(frameSequence[i]);
-        }
-        free(frameSequence);
-    }
+    FreeFrameSequence(&frameSequence, totalFrames);
+    DestroyFrameArena();
+    UnregisterMemoryEvictor(MEM_SUBSYS_FRAMES, EvictResidentFrames);
     
     // Nettoyer le buffer de textures
     FreeTextureBuffer(&videoTextureBuffer);
+    CloseTexturePool();
     
-    UnloadShader(shader);
+    CloseShaderRegistry();
+    CloseFileWatch();
+    CloseShaderReload();
+    UnloadRenderGraph(&effectGraph);
+    ClearShaderPreprocessCache();
     CloseWindow();
     LogMessage("LOG Program ended");
 
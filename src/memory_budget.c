@@ -0,0 +1,240 @@
+#include "raylib.h"
+#include "memory_budget.h"
+#include "logger.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define DEFAULT_RAM_BUDGET_MB 4096
+#define DEFAULT_VRAM_BUDGET_MB 2048
+#define MB (1024.0f*1024.0f)
+#define MAX_EVICTORS_PER_SUBSYS 8
+#define MESSAGE_INTERVAL (1.0 / 60.0) // Au plus un message d'éviction/refus par sous-système et par frame
+
+// Limite des messages d'un sous-système (les réservations refusées sont retentées à chaque frame)
+typedef struct {
+    double lastTime;
+    int skippedCount;     // Messages sautés depuis le dernier écrit
+} MemMessageThrottle;
+
+// Structure pour un évicteur enregistré par un sous-système
+typedef struct {
+    MemEvictCallback callback;
+    void* userData;
+} MemEvictor;
+
+// Structure globale du budget mémoire
+typedef struct {
+    atomic_size_t used[MEM_POOL_COUNT];
+    atomic_size_t peak[MEM_POOL_COUNT];
+    atomic_size_t subsystemUsed[MEM_SUBSYS_COUNT][MEM_POOL_COUNT];
+    size_t cap[MEM_POOL_COUNT];
+    MemEvictor evictors[MEM_SUBSYS_COUNT][MAX_EVICTORS_PER_SUBSYS];
+    int evictorCount[MEM_SUBSYS_COUNT];
+    bool isEvicting;
+    atomic_int refusedCount;
+    MemMessageThrottle evictMessages[MEM_SUBSYS_COUNT];
+    MemMessageThrottle refuseMessages[MEM_SUBSYS_COUNT];
+} MemoryBudget;
+
+static MemoryBudget gMemoryBudget = {0};
+
+// Ordre d'éviction : les caches d'abord, les frames ensuite, les textures en dernier
+static const MemSubsystem gEvictionOrder[] = { MEM_SUBSYS_CACHES, MEM_SUBSYS_FRAMES, MEM_SUBSYS_TEXTURES };
+
+static const char* gSubsystemNames[MEM_SUBSYS_COUNT] = { "Frames", "Textures", "Caches", "Logs" };
+
+static double GetBudgetTime(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Retourne false si le message doit être sauté ; sinon écrit dans suffix le nombre de
+// messages sautés depuis le dernier (vide s'il n'y en a pas, pour que le journal regroupe
+// les refus identiques)
+static bool TakeMessageSlot(MemMessageThrottle* throttle, char* suffix, size_t suffixSize) {
+    double now = GetBudgetTime();
+    if (throttle->lastTime > 0.0 && now - throttle->lastTime < MESSAGE_INTERVAL) {
+        throttle->skippedCount++;
+        return false;
+    }
+    throttle->lastTime = now;
+    if (throttle->skippedCount > 0) {
+        snprintf(suffix, suffixSize, ", %d more not logged", throttle->skippedCount);
+    } else {
+        suffix[0] = '\0';
+    }
+    throttle->skippedCount = 0;
+    return true;
+}
+
+static size_t ReadBudgetFromEnv(const char* name, size_t defaultMb) {
+    const char* value = getenv(name);
+    if (value != NULL) {
+        long mb = atol(value);
+        if (mb > 0) return (size_t)mb * 1024 * 1024;
+        LOG_WARNINGF("invalid %s='%s', using default", name, value);
+    }
+    return defaultMb * 1024 * 1024;
+}
+
+// Fonction pour initialiser le budget mémoire
+void InitMemoryBudget(void) {
+    for (int p = 0; p < MEM_POOL_COUNT; p++) {
+        atomic_store(&gMemoryBudget.used[p], 0);
+        atomic_store(&gMemoryBudget.peak[p], 0);
+        for (int s = 0; s < MEM_SUBSYS_COUNT; s++) {
+            atomic_store(&gMemoryBudget.subsystemUsed[s][p], 0);
+        }
+    }
+    gMemoryBudget.cap[MEM_POOL_RAM] = ReadBudgetFromEnv("SHADERLAB_RAM_BUDGET_MB", DEFAULT_RAM_BUDGET_MB);
+    gMemoryBudget.cap[MEM_POOL_VRAM] = ReadBudgetFromEnv("SHADERLAB_VRAM_BUDGET_MB", DEFAULT_VRAM_BUDGET_MB);
+    gMemoryBudget.isEvicting = false;
+    atomic_store(&gMemoryBudget.refusedCount, 0);
+    LOG_INFOF("Memory budget initialized: RAM %.0f MB, VRAM %.0f MB",
+              gMemoryBudget.cap[MEM_POOL_RAM] / MB, gMemoryBudget.cap[MEM_POOL_VRAM] / MB);
+}
+
+void SetMemoryBudgetCap(MemPool pool, size_t bytes) {
+    gMemoryBudget.cap[pool] = bytes;
+}
+
+void RegisterMemoryEvictor(MemSubsystem subsys, MemEvictCallback callback, void* userData) {
+    if (gMemoryBudget.evictorCount[subsys] >= MAX_EVICTORS_PER_SUBSYS) {
+        LOG_WARNINGF("too many evictors for %s", gSubsystemNames[subsys]);
+        return;
+    }
+    MemEvictor* evictor = &gMemoryBudget.evictors[subsys][gMemoryBudget.evictorCount[subsys]++];
+    evictor->callback = callback;
+    evictor->userData = userData;
+}
+
+void UnregisterMemoryEvictor(MemSubsystem subsys, MemEvictCallback callback) {
+    for (int i = 0; i < gMemoryBudget.evictorCount[subsys]; i++) {
+        if (gMemoryBudget.evictors[subsys][i].callback == callback) {
+            gMemoryBudget.evictors[subsys][i] = gMemoryBudget.evictors[subsys][--gMemoryBudget.evictorCount[subsys]];
+            return;
+        }
+    }
+}
+
+// Tente d'ajouter des octets au pool sans dépasser le plafond
+static bool TryCommit(MemSubsystem subsys, MemPool pool, size_t bytes) {
+    size_t current = atomic_load(&gMemoryBudget.used[pool]);
+    do {
+        if (current + bytes > gMemoryBudget.cap[pool]) return false;
+    } while (!atomic_compare_exchange_weak(&gMemoryBudget.used[pool], &current, current + bytes));
+
+    atomic_fetch_add(&gMemoryBudget.subsystemUsed[subsys][pool], bytes);
+
+    size_t newUsed = current + bytes;
+    size_t peak = atomic_load(&gMemoryBudget.peak[pool]);
+    while (newUsed > peak && !atomic_compare_exchange_weak(&gMemoryBudget.peak[pool], &peak, newUsed)) {}
+    return true;
+}
+
+bool MemoryBudgetTryReserve(MemSubsystem subsys, MemPool pool, size_t bytes) {
+    if (TryCommit(subsys, pool, bytes)) return true;
+    atomic_fetch_add(&gMemoryBudget.refusedCount, 1);
+    return false;
+}
+
+// Réservation facultative (cache, réutilisation) : l'appelant a une autre solution,
+// un échec n'est pas compté comme un refus
+bool MemoryBudgetTryReserveOptional(MemSubsystem subsys, MemPool pool, size_t bytes) {
+    return TryCommit(subsys, pool, bytes);
+}
+
+// Fonction pour réserver de la mémoire avec éviction sous pression
+bool MemoryBudgetReserve(MemSubsystem subsys, MemPool pool, size_t bytes) {
+    if (TryCommit(subsys, pool, bytes)) return true;
+
+    // Un évicteur qui alloue ne doit pas redéclencher d'éviction
+    if (!gMemoryBudget.isEvicting) {
+        gMemoryBudget.isEvicting = true;
+        int orderCount = (int)(sizeof(gEvictionOrder) / sizeof(gEvictionOrder[0]));
+        size_t needed = 1;
+        for (int i = 0; i < orderCount && needed > 0; i++) {
+            MemSubsystem victim = gEvictionOrder[i];
+            for (int e = 0; e < gMemoryBudget.evictorCount[victim]; e++) {
+                MemEvictor* evictor = &gMemoryBudget.evictors[victim][e];
+
+                size_t used = atomic_load(&gMemoryBudget.used[pool]);
+                needed = used + bytes > gMemoryBudget.cap[pool] ? used + bytes - gMemoryBudget.cap[pool] : 0;
+                if (needed == 0) break;
+
+                size_t freed = evictor->callback(pool, needed, evictor->userData);
+                char suffix[48];
+                if (freed > 0 && TakeMessageSlot(&gMemoryBudget.evictMessages[victim], suffix, sizeof(suffix))) {
+                    LOG_INFOF("Memory budget: %s evicted %.1f MB from %s%s", gSubsystemNames[victim], freed / MB,
+                              pool == MEM_POOL_RAM ? "RAM" : "VRAM", suffix);
+                }
+            }
+        }
+        gMemoryBudget.isEvicting = false;
+
+        if (TryCommit(subsys, pool, bytes)) return true;
+    }
+
+    atomic_fetch_add(&gMemoryBudget.refusedCount, 1);
+    char suffix[48];
+    if (TakeMessageSlot(&gMemoryBudget.refuseMessages[subsys], suffix, sizeof(suffix))) {
+        LOG_WARNINGF("Memory budget: refused %.1f MB for %s (%s %.0f/%.0f MB%s)", bytes / MB, gSubsystemNames[subsys],
+                     pool == MEM_POOL_RAM ? "RAM" : "VRAM", atomic_load(&gMemoryBudget.used[pool]) / MB,
+                     gMemoryBudget.cap[pool] / MB, suffix);
+    }
+    return false;
+}
+
+void MemoryBudgetRelease(MemSubsystem subsys, MemPool pool, size_t bytes) {
+    atomic_fetch_sub(&gMemoryBudget.used[pool], bytes);
+    atomic_fetch_sub(&gMemoryBudget.subsystemUsed[subsys][pool], bytes);
+}
+
+size_t GetMemoryBudgetUsed(MemPool pool) {
+    return atomic_load(&gMemoryBudget.used[pool]);
+}
+
+size_t GetMemoryBudgetPeak(MemPool pool) {
+    return atomic_load(&gMemoryBudget.peak[pool]);
+}
+
+size_t GetMemoryBudgetCap(MemPool pool) {
+    return gMemoryBudget.cap[pool];
+}
+
+size_t GetSubsystemMemoryUsed(MemSubsystem subsys, MemPool pool) {
+    return atomic_load(&gMemoryBudget.subsystemUsed[subsys][pool]);
+}
+
+const char* GetMemSubsystemName(MemSubsystem subsys) {
+    return gSubsystemNames[subsys];
+}
+
+// Fonction pour afficher l'utilisation mémoire dans le panneau
+void DrawMemoryBudgetPanel(int x, int y) {
+    for (int p = 0; p < MEM_POOL_COUNT; p++) {
+        size_t used = GetMemoryBudgetUsed(p);
+        size_t cap = GetMemoryBudgetCap(p);
+        Color color = used * 10 > cap * 9 ? RED : (used * 4 > cap * 3 ? ORANGE : BLACK);
+        DrawText(TextFormat("%s: %.0f/%.0f Mo", p == MEM_POOL_RAM ? "RAM" : "VRAM", used / MB, cap / MB),
+                 x, y, 10, color);
+        y += 12;
+    }
+    DrawText(TextFormat("Frames %.0f  Tex %.0f Mo",
+                        (GetSubsystemMemoryUsed(MEM_SUBSYS_FRAMES, MEM_POOL_RAM) +
+                         GetSubsystemMemoryUsed(MEM_SUBSYS_FRAMES, MEM_POOL_VRAM)) / MB,
+                        (GetSubsystemMemoryUsed(MEM_SUBSYS_TEXTURES, MEM_POOL_RAM) +
+                         GetSubsystemMemoryUsed(MEM_SUBSYS_TEXTURES, MEM_POOL_VRAM)) / MB), x, y, 10, DARKGRAY);
+    y += 12;
+    DrawText(TextFormat("Caches %.1f  Logs %.2f Mo",
+                        (GetSubsystemMemoryUsed(MEM_SUBSYS_CACHES, MEM_POOL_RAM) +
+                         GetSubsystemMemoryUsed(MEM_SUBSYS_CACHES, MEM_POOL_VRAM)) / MB,
+                        GetSubsystemMemoryUsed(MEM_SUBSYS_LOGS, MEM_POOL_RAM) / MB), x, y, 10, DARKGRAY);
+    int refused = atomic_load(&gMemoryBudget.refusedCount);
+    if (refused > 0) {
+        DrawText(TextFormat("Refus: %d", refused), x + 140, y, 10, RED);
+    }
+}
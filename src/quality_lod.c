@@ -0,0 +1,71 @@
+#include "quality_lod.h"
+#include <string.h>
+
+void ResetQualityController(QualityController* controller, int levelCount) {
+    memset(controller, 0, sizeof(*controller));
+    controller->levelCount = levelCount > 0 ? levelCount : 1;
+    controller->quality = controller->levelCount - 1;
+    controller->upgradeDelay = QUALITY_UPGRADE_DELAY;
+    controller->sinceUpgrade = QUALITY_UPGRADE_DELAY_MAX;
+}
+
+static void ChangeQuality(QualityController* controller, int quality) {
+    controller->quality = quality;
+    controller->overTime = 0.0f;
+    controller->underTime = 0.0f;
+    controller->cooldown = QUALITY_COOLDOWN;
+    // Les frames mesurées au niveau précédent ne comptent plus
+    controller->frameTime = 0.0f;
+}
+
+// Fonction pour faire évoluer le niveau d'une frame
+int UpdateQualityController(QualityController* controller, int levelCount, float frameSeconds,
+                            float gpuMilliseconds, float frameBudgetMilliseconds) {
+    if (controller->levelCount != levelCount || controller->upgradeDelay == 0.0f) {
+        ResetQualityController(controller, levelCount);
+    }
+    if (controller->levelCount <= 1) return controller->quality;
+
+    controller->frameTime = controller->frameTime == 0.0f ? frameSeconds
+                          : controller->frameTime * 0.9f + frameSeconds * 0.1f;
+    controller->sinceUpgrade += frameSeconds;
+    if (controller->cooldown > 0.0f) {
+        controller->cooldown -= frameSeconds;
+        return controller->quality;
+    }
+
+    // Trop lent : frames manquées, ou shader au-delà de sa part du budget.
+    // Avec la synchronisation verticale, le temps de frame ne descend pas sous le
+    // budget : sans mesure GPU, la marge est supposée dès que les frames sont tenues.
+    float gpuBudget = frameBudgetMilliseconds * QUALITY_GPU_SHARE;
+    bool isOver = controller->frameTime * 1000.0f > frameBudgetMilliseconds * 1.15f ||
+                  (gpuMilliseconds >= 0.0f && gpuMilliseconds > gpuBudget);
+    bool hasHeadroom = !isOver && (gpuMilliseconds < 0.0f || gpuMilliseconds < gpuBudget * QUALITY_HEADROOM);
+
+    if (isOver) {
+        controller->overTime += frameSeconds;
+        controller->underTime = 0.0f;
+        if (controller->overTime >= QUALITY_DOWNGRADE_DELAY && controller->quality > 0) {
+            // Retour au niveau d'où l'on vient : attendre plus longtemps avant de réessayer
+            if (controller->sinceUpgrade < QUALITY_UPGRADE_DELAY * 2.0f) {
+                controller->upgradeDelay *= 2.0f;
+                if (controller->upgradeDelay > QUALITY_UPGRADE_DELAY_MAX) controller->upgradeDelay = QUALITY_UPGRADE_DELAY_MAX;
+            }
+            ChangeQuality(controller, controller->quality - 1);
+        }
+    } else if (hasHeadroom) {
+        controller->underTime += frameSeconds;
+        controller->overTime = 0.0f;
+        if (controller->underTime >= controller->upgradeDelay && controller->quality < controller->levelCount - 1) {
+            ChangeQuality(controller, controller->quality + 1);
+            controller->sinceUpgrade = 0.0f;
+        }
+    } else {
+        controller->overTime = 0.0f;
+        controller->underTime = 0.0f;
+    }
+
+    // Un niveau tenu longtemps : les remontées redeviennent rapides
+    if (controller->sinceUpgrade > QUALITY_UPGRADE_DELAY_MAX) controller->upgradeDelay = QUALITY_UPGRADE_DELAY;
+    return controller->quality;
+}
@@ -0,0 +1,750 @@
+#include "render_graph.h"
+#include "memory_budget.h"
+#include "logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+
+#define MAX_PRAGMA_LINE 256
+
+// Noms des paramètres spécialisables, dans l'ordre de RenderParam
+static const char* renderParamNames[RENDER_PARAM_COUNT] = { "radius", "power" };
+
+// Fonction pour trouver une passe par son nom parmi les premières passes
+static int FindPassIndex(const RenderGraphDesc* desc, const char* name, int before) {
+    for (int i = 0; i < before; i++) {
+        if (strcmp(desc->passes[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+static bool IsValidPassName(const char* name) {
+    if (name[0] == '\0' || isdigit((unsigned char)name[0])) return false;
+    for (const char* c = name; *c; c++) {
+        if (!isalnum((unsigned char)*c) && *c != '_') return false;
+    }
+    return true;
+}
+
+// Fonction pour lire une directive "#pragma pass nom clé=valeur..."
+static bool ParsePassPragma(const char* arguments, RenderGraphDesc* desc, int lineNumber, char* error, size_t errorSize) {
+    if (desc->passCount >= MAX_RENDER_PASSES) {
+        snprintf(error, errorSize, "Ligne %d: trop de passes (%d max)", lineNumber, MAX_RENDER_PASSES);
+        return false;
+    }
+
+    RenderPassDesc* pass = &desc->passes[desc->passCount];
+    memset(pass, 0, sizeof(*pass));
+    pass->scale = 1.0f;
+    // Par défaut, une passe lit la précédente (l'image pour la première)
+    snprintf(pass->input, sizeof(pass->input), "%s", desc->passCount > 0 ? desc->passes[desc->passCount - 1].name : "source");
+
+    char line[MAX_PRAGMA_LINE];
+    snprintf(line, sizeof(line), "%s", arguments);
+    int tokenIndex = 0;
+    char* cursor = line;
+    while (*cursor) {
+        while (*cursor == ' ' || *cursor == '\t') cursor++;
+        if (*cursor == '\0') break;
+        char* token = cursor;
+        while (*cursor && *cursor != ' ' && *cursor != '\t') cursor++;
+        if (*cursor) *cursor++ = '\0';
+
+        if (tokenIndex++ == 0) {
+            if (!IsValidPassName(token) || strlen(token) >= MAX_PASS_NAME || strcmp(token, "source") == 0) {
+                snprintf(error, errorSize, "Ligne %d: nom de passe invalide '%s'", lineNumber, token);
+                return false;
+            }
+            if (FindPassIndex(desc, token, desc->passCount) >= 0) {
+                snprintf(error, errorSize, "Ligne %d: passe '%s' déjà déclarée", lineNumber, token);
+                return false;
+            }
+            snprintf(pass->name, sizeof(pass->name), "%s", token);
+            continue;
+        }
+
+        char* value = strchr(token, '=');
+        if (value == NULL) {
+            snprintf(error, errorSize, "Ligne %d: option '%s' sans valeur", lineNumber, token);
+            return false;
+        }
+        *value++ = '\0';
+        if (strcmp(token, "scale") == 0) {
+            pass->scale = strtof(value, NULL);
+            if (!(pass->scale > 0.0f && pass->scale <= 4.0f)) {
+                snprintf(error, errorSize, "Ligne %d: scale doit être entre 0 et 4", lineNumber);
+                return false;
+            }
+        } else if (strcmp(token, "input") == 0) {
+            if (strcmp(value, "source") != 0 && FindPassIndex(desc, value, desc->passCount) < 0) {
+                snprintf(error, errorSize, "Ligne %d: entrée '%s' inconnue (passe précédente ou source)", lineNumber, value);
+                return false;
+            }
+            snprintf(pass->input, sizeof(pass->input), "%s", value);
+        } else {
+            snprintf(error, errorSize, "Ligne %d: option de passe inconnue '%s'", lineNumber, token);
+            return false;
+        }
+    }
+
+    if (pass->name[0] == '\0') {
+        snprintf(error, errorSize, "Ligne %d: #pragma pass sans nom", lineNumber);
+        return false;
+    }
+    desc->passCount++;
+    return true;
+}
+
+// Fonction pour lire une directive "#pragma specialize param..."
+static bool ParseSpecializePragma(const char* arguments, size_t length, RenderGraphDesc* desc, int lineNumber, char* error, size_t errorSize) {
+    char line[MAX_PRAGMA_LINE];
+    if (length >= sizeof(line)) length = sizeof(line) - 1;
+    memcpy(line, arguments, length);
+    line[length] = '\0';
+
+    char* cursor = line;
+    while (*cursor) {
+        while (*cursor == ' ' || *cursor == '\t' || *cursor == '\r') cursor++;
+        if (*cursor == '\0') break;
+        char* token = cursor;
+        while (*cursor && *cursor != ' ' && *cursor != '\t' && *cursor != '\r') cursor++;
+        if (*cursor) *cursor++ = '\0';
+
+        int param = -1;
+        for (int i = 0; i < RENDER_PARAM_COUNT; i++) {
+            if (strcmp(token, renderParamNames[i]) == 0) param = i;
+        }
+        if (param < 0) {
+            snprintf(error, errorSize, "Ligne %d: paramètre '%s' non spécialisable (radius, power)", lineNumber, token);
+            return false;
+        }
+        desc->specializedParams |= 1u << param;
+    }
+    return true;
+}
+
+// Fonction pour lire la description du graphe dans le source
+bool ParseRenderGraph(const char* source, RenderGraphDesc* desc, char* error, size_t errorSize) {
+    memset(desc, 0, sizeof(*desc));
+    if (errorSize > 0) error[0] = '\0';
+
+    const char* line = source;
+    int lineNumber = 1;
+    while (*line) {
+        size_t lineLength = strcspn(line, "\n");
+        const char* directive = line;
+        while (*directive == ' ' || *directive == '\t') directive++;
+        if (strncmp(directive, "#pragma", 7) == 0) {
+            const char* argument = directive + 7;
+            while (*argument == ' ' || *argument == '\t') argument++;
+            if (strncmp(argument, "pass", 4) == 0 && (argument[4] == ' ' || argument[4] == '\t')) {
+                char arguments[MAX_PRAGMA_LINE];
+                size_t length = lineLength - (size_t)(argument + 4 - line);
+                if (length >= sizeof(arguments)) length = sizeof(arguments) - 1;
+                memcpy(arguments, argument + 4, length);
+                arguments[length] = '\0';
+                char* carriageReturn = strchr(arguments, '\r');
+                if (carriageReturn) *carriageReturn = '\0';
+                if (!ParsePassPragma(arguments, desc, lineNumber, error, errorSize)) return false;
+            } else if (strncmp(argument, "bounded_by_radius", 17) == 0 &&
+                       (argument[17] == ' ' || argument[17] == '\t' || argument[17] == '\r' || argument[17] == '\n' || argument[17] == '\0')) {
+                char* end = NULL;
+                float scale = strtof(argument + 17, &end);
+                if (end == argument + 17) scale = 1.0f; // Sans facteur : exactement radius
+                if (!(scale > 0.0f)) {
+                    snprintf(error, errorSize, "Ligne %d: facteur de bounded_by_radius invalide", lineNumber);
+                    return false;
+                }
+                desc->boundRadiusScale = scale;
+            } else if (strncmp(argument, "specialize", 10) == 0 && (argument[10] == ' ' || argument[10] == '\t')) {
+                if (!ParseSpecializePragma(argument + 10, lineLength - (size_t)(argument + 10 - line), desc, lineNumber, error, errorSize)) return false;
+            } else if (strncmp(argument, "quality", 7) == 0 && (argument[7] == ' ' || argument[7] == '\t')) {
+                char* end = NULL;
+                long levels = strtol(argument + 7, &end, 10);
+                if (end == argument + 7 || levels < 1 || levels > MAX_QUALITY_LEVELS) {
+                    snprintf(error, errorSize, "Ligne %d: nombre de niveaux de qualité invalide (1 à %d)", lineNumber, MAX_QUALITY_LEVELS);
+                    return false;
+                }
+                desc->qualityLevels = (int)levels;
+            }
+        }
+        line += lineLength;
+        if (*line == '\n') line++;
+        lineNumber++;
+    }
+
+    // Sans déclaration : une seule passe vers l'écran
+    if (desc->passCount == 0) {
+        desc->passCount = 1;
+        snprintf(desc->passes[0].name, MAX_PASS_NAME, "main");
+        snprintf(desc->passes[0].input, MAX_PASS_NAME, "source");
+        desc->passes[0].scale = 1.0f;
+    }
+    if (desc->qualityLevels == 0) desc->qualityLevels = 1;
+    return true;
+}
+
+int GetRenderGraphProgramCount(const RenderGraphDesc* desc) {
+    return desc->passCount * (desc->qualityLevels > 0 ? desc->qualityLevels : 1);
+}
+
+// Fonction pour écrire un flottant en littéral GLSL sans perte ("8" devient "8.0")
+static void FormatGlslFloat(float value, char* output, size_t size) {
+    snprintf(output, size, "%.9g", value);
+    if (strpbrk(output, ".eEn") == NULL) snprintf(output + strlen(output), size - strlen(output), ".0");
+}
+
+// Fonction pour construire le source d'un programme (defines insérés après #version)
+char* BuildRenderPassSource(const char* source, const RenderGraphDesc* desc, int programIndex,
+                            const RenderGraphVariantKey* variant) {
+    int passIndex = programIndex % desc->passCount;
+    int qualityLevels = desc->qualityLevels > 0 ? desc->qualityLevels : 1;
+    char defines[512];
+    char upperName[MAX_PASS_NAME];
+    const char* name = desc->passes[passIndex].name;
+    size_t nameLength = strlen(name);
+    for (size_t i = 0; i <= nameLength; i++) upperName[i] = (char)toupper((unsigned char)name[i]);
+
+    // #version doit rester la première directive
+    const char* insertAt = source;
+    const char* version = strstr(source, "#version");
+    int nextLine = 1;
+    if (version) {
+        const char* end = strchr(version, '\n');
+        insertAt = end ? end + 1 : version + strlen(version);
+        for (const char* c = source; c < insertAt; c++) {
+            if (*c == '\n') nextLine++;
+        }
+    }
+    char scale[32];
+    FormatGlslFloat(desc->passes[passIndex].scale, scale, sizeof(scale));
+    int definesLength = snprintf(defines, sizeof(defines),
+                                 "%s#define PASS_%s 1\n#define PASS_INDEX %d\n#define PASS_SCALE %s\n#define QUALITY %d\n#define QUALITY_LEVELS %d\n",
+                                 (insertAt > source && insertAt[-1] != '\n') ? "\n" : "", upperName, passIndex, scale,
+                                 programIndex / desc->passCount, qualityLevels);
+    for (int i = 0; variant != NULL && i < RENDER_PARAM_COUNT; i++) {
+        if (!(desc->specializedParams & (1u << i))) continue;
+        char upperParam[16];
+        char value[32];
+        size_t paramLength = strlen(renderParamNames[i]);
+        for (size_t j = 0; j <= paramLength; j++) upperParam[j] = (char)toupper((unsigned char)renderParamNames[i][j]);
+        FormatGlslFloat(variant->values[i], value, sizeof(value));
+        definesLength += snprintf(defines + definesLength, sizeof(defines) - (size_t)definesLength,
+                                  "#define SPECIALIZE_%s %s\n", upperParam, value);
+    }
+    definesLength += snprintf(defines + definesLength, sizeof(defines) - (size_t)definesLength, "#line %d 0\n", nextLine);
+
+    size_t prefixLength = (size_t)(insertAt - source);
+    size_t totalLength = strlen(source) + (size_t)definesLength;
+    char* result = (char*)malloc(totalLength + 1);
+    if (result == NULL) return NULL;
+    memcpy(result, source, prefixLength);
+    memcpy(result + prefixLength, defines, (size_t)definesLength);
+    strcpy(result + prefixLength + definesLength, insertAt);
+    return result;
+}
+
+// Fonction pour libérer les cibles intermédiaires
+static void ReleaseRenderTargets(RenderGraph* graph) {
+    for (int i = 0; i < graph->targetCount; i++) {
+        if (graph->targets[i].id > 0) UnloadRenderTexture(graph->targets[i]);
+        graph->targets[i] = (RenderTexture2D){0};
+    }
+    if (graph->reservedBytes > 0) MemoryBudgetRelease(MEM_SUBSYS_CACHES, MEM_POOL_VRAM, graph->reservedBytes);
+    graph->reservedBytes = 0;
+    graph->sourceWidth = 0;
+    graph->sourceHeight = 0;
+}
+
+static void GetSlotSize(const RenderGraph* graph, int slot, int width, int height, int* slotWidth, int* slotHeight) {
+    *slotWidth = (int)(width * graph->slotScale[slot] + 0.5f);
+    *slotHeight = (int)(height * graph->slotScale[slot] + 0.5f);
+    if (*slotWidth < 1) *slotWidth = 1;
+    if (*slotHeight < 1) *slotHeight = 1;
+}
+
+// Fonction pour (re)créer les cibles intermédiaires pour une taille d'image
+static bool EnsureRenderTargets(RenderGraph* graph, int width, int height) {
+    if (graph->targetCount == 0) return true;
+    if (graph->sourceWidth == width && graph->sourceHeight == height && graph->targets[0].id > 0) return true;
+    ReleaseRenderTargets(graph);
+
+    size_t totalBytes = 0;
+    for (int i = 0; i < graph->targetCount; i++) {
+        int slotWidth, slotHeight;
+        GetSlotSize(graph, i, width, height, &slotWidth, &slotHeight);
+        totalBytes += (size_t)slotWidth * slotHeight * 4;
+    }
+    if (!MemoryBudgetReserve(MEM_SUBSYS_CACHES, MEM_POOL_VRAM, totalBytes)) {
+        LOG_WARNINGF("Render graph: VRAM budget refused %zu bytes of render targets", totalBytes);
+        return false;
+    }
+    graph->reservedBytes = totalBytes;
+
+    for (int i = 0; i < graph->targetCount; i++) {
+        int slotWidth, slotHeight;
+        GetSlotSize(graph, i, width, height, &slotWidth, &slotHeight);
+        graph->targets[i] = LoadRenderTexture(slotWidth, slotHeight);
+        if (graph->targets[i].id == 0) {
+            ReleaseRenderTargets(graph);
+            return false;
+        }
+        SetTextureFilter(graph->targets[i].texture, TEXTURE_FILTER_BILINEAR);
+    }
+    graph->sourceWidth = width;
+    graph->sourceHeight = height;
+    return true;
+}
+
+// Fonction pour libérer la cible du résultat en cache
+static void ReleaseResultTarget(RenderGraph* graph) {
+    if (graph->result.id > 0) UnloadRenderTexture(graph->result);
+    if (graph->resultBytes > 0) MemoryBudgetRelease(MEM_SUBSYS_CACHES, MEM_POOL_VRAM, graph->resultBytes);
+    graph->result = (RenderTexture2D){0};
+    graph->resultBytes = 0;
+    graph->hasResult = false;
+}
+
+static bool EnsureResultTarget(RenderGraph* graph, int width, int height) {
+    if (graph->result.id > 0 && graph->result.texture.width == width && graph->result.texture.height == height) return true;
+    ReleaseResultTarget(graph);
+
+    size_t bytes = (size_t)width * height * 4;
+    if (!MemoryBudgetReserve(MEM_SUBSYS_CACHES, MEM_POOL_VRAM, bytes)) return false;
+    graph->result = LoadRenderTexture(width, height);
+    if (graph->result.id == 0) {
+        MemoryBudgetRelease(MEM_SUBSYS_CACHES, MEM_POOL_VRAM, bytes);
+        return false;
+    }
+    graph->resultBytes = bytes;
+    return true;
+}
+
+// Fonction pour attribuer les cibles : une cible est réutilisée (ping-pong) dès que
+// plus aucune passe suivante ne lit la passe qui l'occupait
+static void AssignRenderTargetSlots(RenderGraph* graph) {
+    int passCount = graph->desc.passCount;
+    int lastUse[MAX_RENDER_PASSES];
+    for (int j = 0; j < passCount; j++) lastUse[j] = -1;
+    for (int i = 0; i < passCount; i++) {
+        if (graph->inputPass[i] >= 0) lastUse[graph->inputPass[i]] = i;
+        // Les cibles sont communes à tous les niveaux de qualité
+        for (int quality = 0; quality < graph->desc.qualityLevels; quality++) {
+            const PassUniforms* uniforms = &graph->passUniforms[quality * passCount + i];
+            for (int j = 0; j < i; j++) {
+                if (uniforms->passSamplerLocations[j] != -1) lastUse[j] = i;
+            }
+        }
+    }
+
+    int slotOwner[MAX_RENDER_PASSES];
+    graph->targetCount = 0;
+    for (int i = 0; i < passCount; i++) {
+        graph->targetSlot[i] = -1;
+        if (i == passCount - 1) break; // La dernière passe dessine à l'écran
+
+        float scale = graph->desc.passes[i].scale;
+        for (int slot = 0; slot < graph->targetCount; slot++) {
+            if (graph->slotScale[slot] == scale && lastUse[slotOwner[slot]] < i) {
+                graph->targetSlot[i] = slot;
+                break;
+            }
+        }
+        if (graph->targetSlot[i] < 0) {
+            graph->targetSlot[i] = graph->targetCount;
+            graph->slotScale[graph->targetCount++] = scale;
+        }
+        slotOwner[graph->targetSlot[i]] = i;
+    }
+}
+
+// Fonction pour résoudre les uniforms d'un programme de la passe
+static void ResolvePassUniforms(const RenderGraph* graph, int passIndex, Shader shader, ShaderUniformTable* table, PassUniforms* uniforms) {
+    BuildShaderUniformTable(table, shader);
+    uniforms->time = FindShaderUniform(table, "time");
+    uniforms->mousePos = FindShaderUniform(table, "mousePos");
+    uniforms->radius = FindShaderUniform(table, "radius");
+    uniforms->power = FindShaderUniform(table, "power");
+    uniforms->resolution = FindShaderUniform(table, "resolution");
+    uniforms->passResolution = FindShaderUniform(table, "passResolution");
+    uniforms->inputResolution = FindShaderUniform(table, "inputResolution");
+
+    // Les samplers sont liés à chaque exécution (unités de texture du batch raylib)
+    uniforms->sourceSamplerLocation = GetShaderLocation(shader, "sourceTexture");
+    for (int j = 0; j < MAX_RENDER_PASSES; j++) {
+        uniforms->passSamplerLocations[j] = j < passIndex ? GetShaderLocation(shader, graph->desc.passes[j].name) : -1;
+    }
+}
+
+// Fonction pour remplacer les programmes du graphe
+void SetRenderGraphPrograms(RenderGraph* graph, const RenderGraphDesc* desc, const Shader* shaders) {
+    UnloadRenderGraph(graph);
+    graph->desc = *desc;
+    if (graph->desc.qualityLevels < 1) graph->desc.qualityLevels = 1;
+    for (int i = 0; i < desc->passCount; i++) {
+        graph->inputPass[i] = strcmp(desc->passes[i].input, "source") == 0 ? -1 : FindPassIndex(desc, desc->passes[i].input, i);
+    }
+    for (int i = 0; i < GetRenderGraphProgramCount(&graph->desc); i++) {
+        graph->shaders[i] = shaders[i];
+        ResolvePassUniforms(graph, i % desc->passCount, shaders[i], &graph->uniforms[i], &graph->passUniforms[i]);
+    }
+    AssignRenderTargetSlots(graph);
+    graph->isTimeDependent = RenderGraphUsesUniform(graph, "time");
+    // Une fois par chargement : un shader statique n'a pas besoin de time
+    if (!graph->isTimeDependent) LOG_DEBUGF("Render graph: shader does not use uniform 'time'");
+    graph->quality = graph->desc.qualityLevels - 1;
+    if (graph->desc.qualityLevels > 1) {
+        LOG_INFOF("Render graph: %d passes, %d quality levels, %d intermediate targets", desc->passCount,
+                  graph->desc.qualityLevels, graph->targetCount);
+    } else if (desc->passCount > 1) {
+        LOG_INFOF("Render graph: %d passes, %d intermediate targets", desc->passCount, graph->targetCount);
+    }
+}
+
+void SetRenderGraphShader(RenderGraph* graph, Shader shader) {
+    RenderGraphDesc desc = {0};
+    desc.passCount = 1;
+    snprintf(desc.passes[0].name, MAX_PASS_NAME, "main");
+    snprintf(desc.passes[0].input, MAX_PASS_NAME, "source");
+    desc.passes[0].scale = 1.0f;
+    desc.qualityLevels = 1;
+    SetRenderGraphPrograms(graph, &desc, &shader);
+}
+
+static void UnloadRenderGraphVariant(RenderGraph* graph, RenderGraphVariant* variant) {
+    for (int i = 0; i < graph->desc.passCount; i++) {
+        FreeShaderUniformTable(&variant->uniforms[i]);
+        if (variant->shaders[i].id > 0) UnloadShader(variant->shaders[i]);
+    }
+    memset(variant, 0, sizeof(*variant));
+}
+
+// Fonction pour décharger les programmes et les cibles du graphe
+void UnloadRenderGraph(RenderGraph* graph) {
+    ReleaseRenderTargets(graph);
+    ReleaseResultTarget(graph);
+    for (int i = 0; i < graph->variantCount; i++) UnloadRenderGraphVariant(graph, &graph->variants[i]);
+    for (int i = 0; i < MAX_RENDER_PASSES; i++) FreeGpuTimer(&graph->passTimers[i]);
+    for (int i = 0; i < GetRenderGraphProgramCount(&graph->desc); i++) {
+        FreeShaderUniformTable(&graph->uniforms[i]);
+        if (graph->shaders[i].id > 0) UnloadShader(graph->shaders[i]);
+    }
+    memset(graph, 0, sizeof(*graph));
+}
+
+// Fonction pour libérer la mémoire vidéo d'un graphe mis de côté (programmes conservés)
+void ReleaseRenderGraphTargets(RenderGraph* graph) {
+    ReleaseRenderTargets(graph);
+    ReleaseResultTarget(graph);
+    for (int i = 0; i < MAX_RENDER_PASSES; i++) ResetGpuTimer(&graph->passTimers[i]);
+}
+
+bool IsRenderGraphReady(const RenderGraph* graph) {
+    int programCount = GetRenderGraphProgramCount(&graph->desc);
+    return programCount > 0 && graph->shaders[programCount - 1].id > 0;
+}
+
+bool RenderGraphUsesUniform(const RenderGraph* graph, const char* name) {
+    for (int i = 0; i < GetRenderGraphProgramCount(&graph->desc); i++) {
+        if (FindShaderUniform(&graph->uniforms[i], name) >= 0) return true;
+    }
+    return false;
+}
+
+// Fonction pour calculer la zone de l'image modifiée par un effet borné (false si vide)
+static bool GetEffectBounds(const RenderGraph* graph, Rectangle sourceRect, const EffectParams* params, Rectangle* bounds) {
+    // Un pixel de marge pour le filtrage bilinéaire au bord du carré
+    float extent = params->radius * graph->desc.boundRadiusScale + 1.0f;
+    float left = fmaxf(params->mousePos.x - extent, sourceRect.x);
+    float top = fmaxf(params->mousePos.y - extent, sourceRect.y);
+    float right = fminf(params->mousePos.x + extent, sourceRect.x + sourceRect.width);
+    float bottom = fminf(params->mousePos.y + extent, sourceRect.y + sourceRect.height);
+    if (right <= left || bottom <= top) return false;
+    *bounds = (Rectangle){ left, top, right - left, bottom - top };
+    return true;
+}
+
+// Fonction pour construire la clé de variante des paramètres actuels
+static void GetVariantKey(const RenderGraph* graph, const EffectParams* params, RenderGraphVariantKey* key) {
+    memset(key, 0, sizeof(*key));
+    const float values[RENDER_PARAM_COUNT] = { params->radius, params->power };
+    for (int i = 0; i < RENDER_PARAM_COUNT; i++) {
+        if (graph->desc.specializedParams & (1u << i)) key->values[i] = values[i];
+    }
+    key->quality = graph->quality;
+}
+
+static int FindVariant(const RenderGraph* graph, const RenderGraphVariantKey* key) {
+    for (int i = 0; i < graph->variantCount; i++) {
+        if (memcmp(&graph->variants[i].key, key, sizeof(*key)) == 0) return i;
+    }
+    return -1;
+}
+
+// Fonction pour trouver la variante compilée pour les paramètres actuels (NULL sinon)
+static RenderGraphVariant* GetActiveVariant(RenderGraph* graph, const EffectParams* params) {
+    if (graph->desc.specializedParams == 0) return NULL;
+    RenderGraphVariantKey key;
+    GetVariantKey(graph, params, &key);
+    int index = FindVariant(graph, &key);
+    if (index < 0 || graph->variants[index].isFailed) return NULL;
+    graph->variants[index].lastUse = ++graph->variantUseCounter;
+    return &graph->variants[index];
+}
+
+// Fonction pour exécuter les passes, la dernière dans destRect (à l'écran si finalTarget est NULL)
+static void RunRenderPasses(RenderGraph* graph, Texture2D source, Rectangle sourceRect, Rectangle destRect,
+                            const EffectParams* params, RenderTexture2D* finalTarget) {
+    float resolution[2] = { (float)source.width, (float)source.height };
+    int passCount = graph->desc.passCount;
+    // Programmes spécialisés si la variante est prête, génériques sinon
+    RenderGraphVariant* variant = GetActiveVariant(graph, params);
+    graph->isSpecialized = variant != NULL;
+    for (int i = 0; i < passCount; i++) {
+        int program = graph->quality * passCount + i;
+        bool isIntermediate = graph->targetSlot[i] >= 0;
+        RenderTexture2D* target = isIntermediate ? &graph->targets[graph->targetSlot[i]] : finalTarget;
+        Texture2D input = graph->inputPass[i] < 0 ? source : graph->targets[graph->targetSlot[graph->inputPass[i]]].texture;
+        Shader shader = variant ? variant->shaders[i] : graph->shaders[program];
+        PassUniforms* uniforms = variant ? &variant->passUniforms[i] : &graph->passUniforms[program];
+        ShaderUniformTable* table = variant ? &variant->uniforms[i] : &graph->uniforms[program];
+
+        // Rectangle source exprimé dans la texture d'entrée (qui peut être réduite)
+        float inputScaleX = (float)input.width / source.width;
+        float inputScaleY = (float)input.height / source.height;
+        Rectangle inputRect = { sourceRect.x * inputScaleX, sourceRect.y * inputScaleY,
+                                sourceRect.width * inputScaleX, sourceRect.height * inputScaleY };
+        Rectangle outputRect = destRect;
+        float passResolution[2] = { resolution[0], resolution[1] };
+
+        if (isIntermediate) {
+            passResolution[0] = (float)target->texture.width;
+            passResolution[1] = (float)target->texture.height;
+            // Entrée entière, retournée : les cibles gardent l'orientation de l'image
+            inputRect = (Rectangle){ 0, 0, (float)input.width, -(float)input.height };
+            outputRect = (Rectangle){ 0, 0, passResolution[0], passResolution[1] };
+        }
+        if (target) {
+            BeginTextureMode(*target);
+            ClearBackground(BLANK);
+            // Écrire la couleur telle quelle (alpha compris) dans la cible
+            BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+        }
+
+        // Effet borné : image non modifiée partout, shader seulement autour du curseur
+        bool drawEffect = true;
+        if (!isIntermediate && graph->desc.boundRadiusScale > 0.0f) {
+            DrawTexturePro(source, sourceRect, destRect, (Vector2){0, 0}, 0.0f, WHITE);
+            Rectangle bounds;
+            drawEffect = GetEffectBounds(graph, sourceRect, params, &bounds);
+            if (drawEffect) {
+                float destScaleX = destRect.width / sourceRect.width;
+                float destScaleY = destRect.height / sourceRect.height;
+                inputRect = (Rectangle){ inputRect.x + (bounds.x - sourceRect.x) * inputScaleX,
+                                         inputRect.y + (bounds.y - sourceRect.y) * inputScaleY,
+                                         bounds.width * inputScaleX, bounds.height * inputScaleY };
+                outputRect = (Rectangle){ destRect.x + (bounds.x - sourceRect.x) * destScaleX,
+                                          destRect.y + (bounds.y - sourceRect.y) * destScaleY,
+                                          bounds.width * destScaleX, bounds.height * destScaleY };
+            }
+        }
+
+        // Résultats des frames précédentes, lus sans attendre le GPU
+        CollectGpuTimer(&graph->passTimers[i]);
+
+        if (drawEffect) {
+            BeginShaderMode(shader);
+                // Mesure après le changement de programme (qui envoie le batch précédent)
+                BeginGpuTimer(&graph->passTimers[i]);
+                SetShaderUniform(table, uniforms->time, &params->time);
+                SetShaderUniform(table, uniforms->mousePos, (float[2]){ params->mousePos.x, params->mousePos.y });
+                SetShaderUniform(table, uniforms->radius, &params->radius);
+                SetShaderUniform(table, uniforms->power, &params->power);
+                SetShaderUniform(table, uniforms->resolution, resolution);
+                SetShaderUniform(table, uniforms->passResolution, passResolution);
+                SetShaderUniform(table, uniforms->inputResolution, (float[2]){ (float)input.width, (float)input.height });
+
+                if (uniforms->sourceSamplerLocation != -1) SetShaderValueTexture(shader, uniforms->sourceSamplerLocation, source);
+                for (int j = 0; j < i; j++) {
+                    if (uniforms->passSamplerLocations[j] != -1 && graph->targetSlot[j] >= 0) {
+                        SetShaderValueTexture(shader, uniforms->passSamplerLocations[j], graph->targets[graph->targetSlot[j]].texture);
+                    }
+                }
+
+                DrawTexturePro(input, inputRect, outputRect, (Vector2){0, 0}, 0.0f, WHITE);
+            EndShaderMode(); // Envoie le draw de la passe
+            EndGpuTimer(&graph->passTimers[i]);
+        }
+
+        if (target) {
+            EndBlendMode();
+            EndTextureMode();
+        }
+    }
+}
+
+// Fonction pour dessiner le résultat en cache, en ne ré-exécutant les passes que si
+// une entrée a changé. Retourne false si la cible du résultat n'a pas pu être créée.
+static bool DrawCachedResult(RenderGraph* graph, Texture2D source, Rectangle sourceRect, Rectangle destRect, const EffectParams* params) {
+    int width = (int)(destRect.width + 0.5f);
+    int height = (int)(destRect.height + 0.5f);
+    if (width < 1 || height < 1) return false;
+
+    RenderGraphResultKey key;
+    memset(&key, 0, sizeof(key));
+    key.sourceId = source.id;
+    key.sourceRect = sourceRect;
+    key.width = width;
+    key.height = height;
+    key.mousePos = params->mousePos;
+    key.radius = params->radius;
+    key.power = params->power;
+
+    if (!graph->hasResult || memcmp(&key, &graph->resultKey, sizeof(key)) != 0) {
+        if (!EnsureResultTarget(graph, width, height)) return false;
+        RunRenderPasses(graph, source, sourceRect, (Rectangle){ 0, 0, (float)width, (float)height }, params, &graph->result);
+        graph->resultKey = key;
+        graph->hasResult = true;
+    }
+
+    Texture2D result = graph->result.texture;
+    DrawTexturePro(result, (Rectangle){ 0, 0, (float)result.width, -(float)result.height }, destRect, (Vector2){0, 0}, 0.0f, WHITE);
+    return true;
+}
+
+// Fonction pour exécuter le graphe
+bool DrawRenderGraph(RenderGraph* graph, Texture2D source, Rectangle sourceRect, Rectangle destRect, const EffectParams* params) {
+    if (!IsRenderGraphReady(graph) || source.id == 0) return false;
+    if (!EnsureRenderTargets(graph, source.width, source.height)) return false;
+
+    // Effet indépendant du temps : le résultat précédent reste valable tant que les entrées sont identiques
+    if (!graph->isTimeDependent && DrawCachedResult(graph, source, sourceRect, destRect, params)) return true;
+
+    RunRenderPasses(graph, source, sourceRect, destRect, params, NULL);
+    return true;
+}
+
+// Fonction pour exécuter le graphe hors écran (export, mode sans fenêtre)
+bool RenderGraphToTexture(RenderGraph* graph, Texture2D source, RenderTexture2D* target, const EffectParams* params) {
+    if (!IsRenderGraphReady(graph) || source.id == 0 || target->id == 0) return false;
+    if (!EnsureRenderTargets(graph, source.width, source.height)) return false;
+
+    Rectangle sourceRect = { 0, 0, (float)source.width, (float)source.height };
+    Rectangle destRect = { 0, 0, (float)target->texture.width, (float)target->texture.height };
+    RunRenderPasses(graph, source, sourceRect, destRect, params, target);
+    return true;
+}
+
+void InvalidateRenderGraphResult(RenderGraph* graph) {
+    graph->hasResult = false;
+}
+
+// Fonction pour changer de niveau de qualité (les programmes sont déjà compilés)
+void SetRenderGraphQuality(RenderGraph* graph, int quality) {
+    if (quality > graph->desc.qualityLevels - 1) quality = graph->desc.qualityLevels - 1;
+    if (quality < 0) quality = 0;
+    if (quality == graph->quality) return;
+
+    graph->quality = quality;
+    graph->hasResult = false;
+    // Les mesures de l'ancien niveau ne disent rien du nouveau
+    for (int i = 0; i < MAX_RENDER_PASSES; i++) ResetGpuTimer(&graph->passTimers[i]);
+}
+
+// Fonction pour détecter des paramètres stables sans variante
+bool GetRenderGraphVariantRequest(RenderGraph* graph, const EffectParams* params, double delaySeconds, RenderGraphVariantKey* key) {
+    if (graph->desc.specializedParams == 0 || !IsRenderGraphReady(graph)) return false;
+
+    GetVariantKey(graph, params, key);
+    double now = GetTime();
+    if (memcmp(key, &graph->stableKey, sizeof(*key)) != 0) {
+        graph->stableKey = *key;
+        graph->stableSince = now;
+        return false;
+    }
+    if (now - graph->stableSince < delaySeconds) return false;
+    if (FindVariant(graph, key) >= 0) return false;
+    if (graph->hasVariantRequest && memcmp(key, &graph->variantRequest, sizeof(*key)) == 0) return false;
+
+    graph->variantRequest = *key;
+    graph->hasVariantRequest = true;
+    return true;
+}
+
+// Fonction pour ajouter une variante (remplace la moins récemment utilisée si plein)
+void AddRenderGraphVariant(RenderGraph* graph, const RenderGraphVariantKey* key, const Shader* shaders) {
+    if (graph->hasVariantRequest && memcmp(key, &graph->variantRequest, sizeof(*key)) == 0) graph->hasVariantRequest = false;
+
+    int index = FindVariant(graph, key);
+    if (index < 0 && graph->variantCount < MAX_GRAPH_VARIANTS) index = graph->variantCount++;
+    if (index < 0) {
+        index = 0;
+        for (int i = 1; i < graph->variantCount; i++) {
+            if (graph->variants[i].lastUse < graph->variants[index].lastUse) index = i;
+        }
+    }
+    RenderGraphVariant* variant = &graph->variants[index];
+    UnloadRenderGraphVariant(graph, variant);
+    variant->key = *key;
+    variant->lastUse = ++graph->variantUseCounter;
+    variant->isFailed = shaders == NULL;
+    for (int i = 0; shaders != NULL && i < graph->desc.passCount; i++) {
+        variant->shaders[i] = shaders[i];
+        ResolvePassUniforms(graph, i, shaders[i], &variant->uniforms[i], &variant->passUniforms[i]);
+    }
+}
+
+int GetRenderGraphVariantCount(const RenderGraph* graph) {
+    int count = 0;
+    for (int i = 0; i < graph->variantCount; i++) {
+        if (!graph->variants[i].isFailed) count++;
+    }
+    return count;
+}
+
+bool IsRenderGraphSpecialized(const RenderGraph* graph) {
+    return graph->isSpecialized;
+}
+
+int GetRenderGraphQuality(const RenderGraph* graph) {
+    return graph->quality;
+}
+
+int GetRenderGraphQualityLevels(const RenderGraph* graph) {
+    return graph->desc.qualityLevels > 0 ? graph->desc.qualityLevels : 1;
+}
+
+float GetRenderPassGpuTime(const RenderGraph* graph, int passIndex) {
+    if (passIndex < 0 || passIndex >= graph->desc.passCount) return -1.0f;
+    return GetGpuTimerAverage(&graph->passTimers[passIndex]);
+}
+
+float GetRenderGraphGpuTime(const RenderGraph* graph) {
+    float total = -1.0f;
+    for (int i = 0; i < graph->desc.passCount; i++) {
+        float passTime = GetGpuTimerAverage(&graph->passTimers[i]);
+        if (passTime >= 0.0f) total = (total < 0.0f ? 0.0f : total) + passTime;
+    }
+    return total;
+}
+
+// Fonction pour additionner les historiques des passes (échantillons alignés depuis le plus récent)
+int GetRenderGraphGpuHistory(const RenderGraph* graph, float* samples, int maxSamples) {
+    int count = maxSamples < GPU_TIMER_HISTORY ? maxSamples : GPU_TIMER_HISTORY;
+    for (int i = 0; i < graph->desc.passCount; i++) {
+        if (graph->passTimers[i].historyCount < count) count = graph->passTimers[i].historyCount;
+    }
+    if (graph->desc.passCount == 0) count = 0;
+
+    for (int k = 0; k < count; k++) {
+        float sum = 0.0f;
+        for (int i = 0; i < graph->desc.passCount; i++) {
+            const GpuTimer* timer = &graph->passTimers[i];
+            sum += timer->history[(timer->historyHead - count + k + GPU_TIMER_HISTORY) % GPU_TIMER_HISTORY];
+        }
+        samples[k] = sum;
+    }
+    return count;
+}
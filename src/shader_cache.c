@@ -0,0 +1,169 @@
+#include "shader_cache.h"
+#include "shader_preprocess.h"
+#include "logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h> // Pour _mkdir
+#endif
+
+#define SHADER_CACHE_MAGIC "SLPROGB1"
+#define SHADER_CACHE_MAX_BINARY (64 * 1024 * 1024)
+
+// En-tête des fichiers de binaires
+typedef struct {
+    char magic[8];
+    unsigned long long key;
+    unsigned int format;
+    unsigned int length;
+} ShaderBinaryHeader;
+
+// Structure globale du cache de binaires
+typedef struct {
+    bool isEnabled;
+    unsigned long long driverHash;   // Hash de vendor/renderer/version
+} ShaderBinaryCache;
+
+static ShaderBinaryCache gShaderBinaryCache = {0};
+
+static void GetShaderBinaryPath(unsigned long long key, char* path, size_t size) {
+    snprintf(path, size, SHADER_CACHE_DIRECTORY "/%016llx.bin", key);
+}
+
+// Fonction pour initialiser le cache de binaires
+bool InitShaderBinaryCache(void) {
+    gShaderBinaryCache.isEnabled = false;
+
+    const char* disableEnv = getenv("SHADERLAB_NO_SHADER_CACHE");
+    if (disableEnv != NULL && atoi(disableEnv) != 0) {
+        LOG_INFOF("Shader binary cache disabled by SHADERLAB_NO_SHADER_CACHE");
+        return false;
+    }
+    if (!IsGLExtensionsReady() || !HasProgramBinary()) {
+        LOG_INFOF("Shader binary cache unavailable (no program binary support)");
+        return false;
+    }
+
+    // Identité du pilote : un binaire n'est valable que pour le pilote qui l'a produit
+    char identity[1024];
+    snprintf(identity, sizeof(identity), "%s\n%s\n%s",
+             (const char*)gGL.GetString(GL_VENDOR), (const char*)gGL.GetString(GL_RENDERER),
+             (const char*)gGL.GetString(GL_VERSION));
+    gShaderBinaryCache.driverHash = HashShaderSource(identity, strlen(identity));
+
+    #ifdef _WIN32
+    _mkdir(SHADER_CACHE_DIRECTORY);
+    #else
+    mkdir(SHADER_CACHE_DIRECTORY, 0755);
+    #endif
+
+    gShaderBinaryCache.isEnabled = true;
+    LOG_INFOF("Shader binary cache enabled (" SHADER_CACHE_DIRECTORY "/)");
+    return true;
+}
+
+bool IsShaderBinaryCacheEnabled(void) {
+    return gShaderBinaryCache.isEnabled;
+}
+
+unsigned long long GetShaderBinaryKey(unsigned long long fragmentHash, unsigned long long vertexHash) {
+    unsigned long long parts[3] = { fragmentHash, vertexHash, gShaderBinaryCache.driverHash };
+    return HashShaderSource(parts, sizeof(parts));
+}
+
+// Fonction pour lire un binaire depuis le disque
+void* LoadShaderBinary(unsigned long long key, GLenum* format, GLsizei* length) {
+    if (!gShaderBinaryCache.isEnabled) return NULL;
+
+    char path[128];
+    GetShaderBinaryPath(key, path, sizeof(path));
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) return NULL;
+
+    void* data = NULL;
+    ShaderBinaryHeader header;
+    if (fread(&header, sizeof(header), 1, file) == 1 &&
+        memcmp(header.magic, SHADER_CACHE_MAGIC, sizeof(header.magic)) == 0 &&
+        header.key == key && header.length > 0 && header.length <= SHADER_CACHE_MAX_BINARY) {
+        data = malloc(header.length);
+        if (data && fread(data, 1, header.length, file) != header.length) {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(file);
+
+    if (data) {
+        *format = header.format;
+        *length = (GLsizei)header.length;
+    }
+    return data;
+}
+
+// Fonction pour créer un programme depuis un binaire du cache
+GLuint CreateProgramFromBinary(unsigned long long key, GLenum format, const void* data, GLsizei length) {
+    if (!gShaderBinaryCache.isEnabled) return 0;
+
+    GLuint program = gGL.CreateProgram();
+    gGL.ProgramBinary(program, format, data, length);
+    GLint linked = 0;
+    gGL.GetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked) return program;
+
+    // Binaire refusé (mise à jour du pilote...) : le supprimer, l'appelant recompile
+    gGL.DeleteProgram(program);
+    char path[128];
+    GetShaderBinaryPath(key, path, sizeof(path));
+    remove(path);
+    LOG_INFOF("Shader binary %016llx rejected by driver, recompiling from source", key);
+    return 0;
+}
+
+void PrepareProgramForBinary(GLuint program) {
+    if (gShaderBinaryCache.isEnabled) gGL.ProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, 1);
+}
+
+// Fonction pour enregistrer le binaire d'un programme
+bool SaveShaderBinary(GLuint program, unsigned long long key) {
+    if (!gShaderBinaryCache.isEnabled) return false;
+
+    GLint binaryLength = 0;
+    gGL.GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    if (binaryLength <= 0 || binaryLength > SHADER_CACHE_MAX_BINARY) return false;
+
+    void* data = malloc((size_t)binaryLength);
+    if (data == NULL) return false;
+    GLenum format = 0;
+    GLsizei written = 0;
+    gGL.GetProgramBinary(program, binaryLength, &written, &format, data);
+
+    ShaderBinaryHeader header = {0};
+    memcpy(header.magic, SHADER_CACHE_MAGIC, sizeof(header.magic));
+    header.key = key;
+    header.format = format;
+    header.length = (unsigned int)written;
+
+    // Écrire dans un fichier temporaire puis renommer : jamais de binaire tronqué
+    char path[128];
+    char tempPath[136];
+    GetShaderBinaryPath(key, path, sizeof(path));
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", path);
+
+    bool success = false;
+    FILE* file = fopen(tempPath, "wb");
+    if (file) {
+        success = written > 0 &&
+                  fwrite(&header, sizeof(header), 1, file) == 1 &&
+                  fwrite(data, 1, (size_t)written, file) == (size_t)written;
+        success = (fclose(file) == 0) && success;
+        if (success) {
+            remove(path); // rename n'écrase pas sous Windows
+            success = rename(tempPath, path) == 0;
+        }
+        if (!success) remove(tempPath);
+    }
+    free(data);
+    return success;
+}
@@ -0,0 +1,426 @@
+#include "shader_preprocess.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#define MAX_INCLUDE_DEPTH 16
+
+// Fichier source lu depuis le disque
+typedef struct {
+    char path[SHADER_PREPROCESS_MAX_PATH];
+    char* content;
+    size_t length;
+    unsigned long long hash;
+    bool isLoaded;       // Faux tant que le fichier n'a pas été (re)lu
+} SourceFile;
+
+// Shader racine développé, avec les fichiers dont il dépend
+typedef struct {
+    char path[SHADER_PREPROCESS_MAX_PATH];
+    int dependencies[MAX_SHADER_DEPENDENCIES];                  // Indices dans files (racine en premier)
+    unsigned long long dependencyHashes[MAX_SHADER_DEPENDENCIES];
+    int dependencyCount;
+    char* output;                                               // NULL si le dernier prétraitement a échoué
+    size_t outputLength;
+    unsigned long long outputHash;
+} PreprocessedShader;
+
+// Structure globale du préprocesseur
+typedef struct {
+    pthread_mutex_t mutex;
+    SourceFile* files;
+    int fileCount;
+    int fileCapacity;
+    PreprocessedShader* shaders;
+    int shaderCount;
+    int shaderCapacity;
+} ShaderPreprocessor;
+
+static ShaderPreprocessor gPreprocessor = { .mutex = PTHREAD_MUTEX_INITIALIZER };
+
+// Contexte d'un développement en cours
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+    int included[MAX_SHADER_DEPENDENCIES];   // Fichiers déjà inclus (numéro de source = position)
+    int includedCount;
+    int stack[MAX_INCLUDE_DEPTH];            // Pile d'inclusion pour détecter les cycles
+    int depth;
+    char* error;
+    size_t errorSize;
+} ExpandContext;
+
+unsigned long long HashShaderSource(const void* data, size_t length) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    unsigned long long hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Normalise un chemin ("./shaders/lib/../a.glsl" -> "shaders/a.glsl")
+static void NormalizeShaderPath(const char* input, char* output, size_t size) {
+    size_t segmentStarts[64];
+    int segmentCount = 0;
+    size_t base = (input[0] == '/' && size > 1) ? 1 : 0; // Garder la racine des chemins absolus
+    size_t written = base;
+    output[0] = '/';
+    output[written] = '\0';
+
+    const char* cursor = input;
+    while (*cursor) {
+        size_t length = strcspn(cursor, "/\\");
+        bool isParent = length == 2 && cursor[0] == '.' && cursor[1] == '.';
+        if (isParent && segmentCount > 0 && strcmp(output + segmentStarts[segmentCount - 1], "..") != 0) {
+            // Retirer le dernier segment et son séparateur
+            size_t start = segmentStarts[--segmentCount];
+            written = start > base ? start - 1 : base;
+            output[written] = '\0';
+        } else if (length > 0 && !(length == 1 && cursor[0] == '.') && segmentCount < 64) {
+            size_t separator = written > base ? 1 : 0;
+            if (written + separator + length >= size) break;
+            if (separator) output[written++] = '/';
+            segmentStarts[segmentCount++] = written;
+            memcpy(output + written, cursor, length);
+            written += length;
+            output[written] = '\0';
+        }
+        cursor += length;
+        if (*cursor) cursor++;
+    }
+}
+
+// Fonction pour trouver (ou ajouter) un fichier dans le cache
+static int GetSourceFileIndex(const char* path, bool create) {
+    for (int i = 0; i < gPreprocessor.fileCount; i++) {
+        if (strcmp(gPreprocessor.files[i].path, path) == 0) return i;
+    }
+    if (!create) return -1;
+
+    if (gPreprocessor.fileCount >= gPreprocessor.fileCapacity) {
+        int newCapacity = gPreprocessor.fileCapacity > 0 ? gPreprocessor.fileCapacity * 2 : 16;
+        SourceFile* newFiles = (SourceFile*)realloc(gPreprocessor.files, newCapacity * sizeof(SourceFile));
+        if (newFiles == NULL) return -1;
+        gPreprocessor.files = newFiles;
+        gPreprocessor.fileCapacity = newCapacity;
+    }
+    SourceFile* file = &gPreprocessor.files[gPreprocessor.fileCount];
+    memset(file, 0, sizeof(*file));
+    snprintf(file->path, sizeof(file->path), "%s", path);
+    return gPreprocessor.fileCount++;
+}
+
+// Fonction pour lire un fichier s'il n'est pas déjà en cache
+static bool LoadSourceFile(int index) {
+    SourceFile* file = &gPreprocessor.files[index];
+    if (file->isLoaded) return true;
+
+    FILE* handle = fopen(file->path, "rb");
+    if (handle == NULL) return false;
+
+    char* content = NULL;
+    size_t length = 0;
+    if (fseek(handle, 0, SEEK_END) == 0) {
+        long size = ftell(handle);
+        if (size >= 0 && fseek(handle, 0, SEEK_SET) == 0) {
+            content = (char*)malloc((size_t)size + 1);
+            if (content) length = fread(content, 1, (size_t)size, handle);
+        }
+    }
+    fclose(handle);
+    if (content == NULL) return false;
+    content[length] = '\0';
+
+    // Certains pilotes refusent le BOM UTF-8 ajouté par les éditeurs Windows
+    if (length >= 3 && (unsigned char)content[0] == 0xEF && (unsigned char)content[1] == 0xBB && (unsigned char)content[2] == 0xBF) {
+        memmove(content, content + 3, length - 2);
+        length -= 3;
+    }
+
+    free(file->content);
+    file->content = content;
+    file->length = length;
+    file->hash = HashShaderSource(content, length);
+    file->isLoaded = true;
+    return true;
+}
+
+static bool AppendOutput(ExpandContext* context, const char* text, size_t length) {
+    if (context->length + length + 1 > context->capacity) {
+        size_t newCapacity = context->capacity > 0 ? context->capacity * 2 : 4096;
+        while (newCapacity < context->length + length + 1) newCapacity *= 2;
+        char* newData = (char*)realloc(context->data, newCapacity);
+        if (newData == NULL) return false;
+        context->data = newData;
+        context->capacity = newCapacity;
+    }
+    memcpy(context->data + context->length, text, length);
+    context->length += length;
+    context->data[context->length] = '\0';
+    return true;
+}
+
+// Fonction pour résoudre le chemin d'un #include (relatif au fichier, puis à shaders/).
+// Si le fichier est introuvable, missingIndex reçoit le premier candidat.
+static int ResolveIncludeFile(const char* includerPath, const char* name, int* missingIndex) {
+    char candidate[SHADER_PREPROCESS_MAX_PATH * 2];
+    char normalized[SHADER_PREPROCESS_MAX_PATH];
+
+    const char* slash = strrchr(includerPath, '/');
+    if (slash) {
+        snprintf(candidate, sizeof(candidate), "%.*s/%s", (int)(slash - includerPath), includerPath, name);
+    } else {
+        snprintf(candidate, sizeof(candidate), "%s", name);
+    }
+    NormalizeShaderPath(candidate, normalized, sizeof(normalized));
+    int index = GetSourceFileIndex(normalized, true);
+    if (index >= 0 && LoadSourceFile(index)) return index;
+
+    snprintf(candidate, sizeof(candidate), "shaders/%s", name);
+    NormalizeShaderPath(candidate, normalized, sizeof(normalized));
+    int fallback = GetSourceFileIndex(normalized, true);
+    if (fallback >= 0 && LoadSourceFile(fallback)) return fallback;
+
+    *missingIndex = index;
+    return -1;
+}
+
+// Fonction pour développer un fichier et ses inclusions dans la sortie
+static bool ExpandSourceFile(ExpandContext* context, int fileIndex, int sourceNumber) {
+    if (context->depth >= MAX_INCLUDE_DEPTH) {
+        snprintf(context->error, context->errorSize, "Inclusions trop profondes: %s", gPreprocessor.files[fileIndex].path);
+        return false;
+    }
+    context->stack[context->depth++] = fileIndex;
+
+    // Le contenu est alloué séparément : il reste valide si la table des fichiers grandit
+    const char* line = gPreprocessor.files[fileIndex].content;
+    int lineNumber = 1;
+    while (*line) {
+        size_t lineLength = strcspn(line, "\n");
+        const char* next = line + lineLength + (line[lineLength] == '\n' ? 1 : 0);
+
+        const char* directive = line;
+        while (*directive == ' ' || *directive == '\t') directive++;
+        if (strncmp(directive, "#include", 8) == 0 && (directive[8] == ' ' || directive[8] == '\t' || directive[8] == '"' || directive[8] == '<')) {
+            const char* start = directive + 8;
+            while (*start == ' ' || *start == '\t') start++;
+            char closing = *start == '<' ? '>' : '"';
+            const char* end = (*start == '"' || *start == '<') ? strchr(start + 1, closing) : NULL;
+            if (end == NULL || end > line + lineLength) {
+                snprintf(context->error, context->errorSize, "%s:%d: #include invalide", gPreprocessor.files[fileIndex].path, lineNumber);
+                return false;
+            }
+
+            char name[SHADER_PREPROCESS_MAX_PATH];
+            snprintf(name, sizeof(name), "%.*s", (int)(end - start - 1), start + 1);
+            char includerPath[SHADER_PREPROCESS_MAX_PATH];
+            snprintf(includerPath, sizeof(includerPath), "%s", gPreprocessor.files[fileIndex].path);
+            int missingIndex = -1;
+            int includeIndex = ResolveIncludeFile(includerPath, name, &missingIndex);
+            if (includeIndex < 0) {
+                // Garder le fichier manquant comme dépendance : sa création relancera le shader
+                if (missingIndex >= 0 && context->includedCount < MAX_SHADER_DEPENDENCIES) {
+                    context->included[context->includedCount++] = missingIndex;
+                }
+                snprintf(context->error, context->errorSize, "%s:%d: fichier inclus introuvable: %s", includerPath, lineNumber, name);
+                return false;
+            }
+
+            for (int i = 0; i < context->depth; i++) {
+                if (context->stack[i] == includeIndex) {
+                    snprintf(context->error, context->errorSize, "%s:%d: inclusion circulaire de %s", includerPath, lineNumber, name);
+                    return false;
+                }
+            }
+
+            // Chaque fichier n'est inclus qu'une fois par shader
+            bool alreadyIncluded = false;
+            for (int i = 0; i < context->includedCount; i++) {
+                if (context->included[i] == includeIndex) alreadyIncluded = true;
+            }
+            if (!alreadyIncluded) {
+                if (context->includedCount >= MAX_SHADER_DEPENDENCIES) {
+                    snprintf(context->error, context->errorSize, "Trop de fichiers inclus (%d max)", MAX_SHADER_DEPENDENCIES);
+                    return false;
+                }
+                int includeNumber = context->includedCount;
+                context->included[context->includedCount++] = includeIndex;
+
+                // #line garde les numéros de ligne des erreurs justes (numéro de source = ordre d'inclusion)
+                char lineDirective[64];
+                int length = snprintf(lineDirective, sizeof(lineDirective), "#line 1 %d\n", includeNumber);
+                if (!AppendOutput(context, lineDirective, length)) return false;
+                if (!ExpandSourceFile(context, includeIndex, includeNumber)) return false;
+                bool endsWithNewline = context->length > 0 && context->data[context->length - 1] == '\n';
+                length = snprintf(lineDirective, sizeof(lineDirective), "%s#line %d %d\n", endsWithNewline ? "" : "\n", lineNumber + 1, sourceNumber);
+                if (!AppendOutput(context, lineDirective, length)) return false;
+            } else {
+                if (!AppendOutput(context, "\n", 1)) return false;
+            }
+        } else {
+            if (!AppendOutput(context, line, next - line)) return false;
+        }
+
+        line = next;
+        lineNumber++;
+    }
+
+    context->depth--;
+    return true;
+}
+
+static PreprocessedShader* GetPreprocessedShader(const char* path, bool create) {
+    for (int i = 0; i < gPreprocessor.shaderCount; i++) {
+        if (strcmp(gPreprocessor.shaders[i].path, path) == 0) return &gPreprocessor.shaders[i];
+    }
+    if (!create) return NULL;
+
+    if (gPreprocessor.shaderCount >= gPreprocessor.shaderCapacity) {
+        int newCapacity = gPreprocessor.shaderCapacity > 0 ? gPreprocessor.shaderCapacity * 2 : 8;
+        PreprocessedShader* newShaders = (PreprocessedShader*)realloc(gPreprocessor.shaders, newCapacity * sizeof(PreprocessedShader));
+        if (newShaders == NULL) return NULL;
+        gPreprocessor.shaders = newShaders;
+        gPreprocessor.shaderCapacity = newCapacity;
+    }
+    PreprocessedShader* shader = &gPreprocessor.shaders[gPreprocessor.shaderCount++];
+    memset(shader, 0, sizeof(*shader));
+    snprintf(shader->path, sizeof(shader->path), "%s", path);
+    return shader;
+}
+
+// Vrai si aucun fichier utilisé par le shader n'a changé depuis son développement
+static bool IsPreprocessedShaderCurrent(const PreprocessedShader* shader) {
+    if (shader->output == NULL) return false;
+    for (int i = 0; i < shader->dependencyCount; i++) {
+        int index = shader->dependencies[i];
+        if (!LoadSourceFile(index) || gPreprocessor.files[index].hash != shader->dependencyHashes[i]) return false;
+    }
+    return true;
+}
+
+static char* CopySource(const char* source, size_t length) {
+    char* copy = (char*)malloc(length + 1);
+    if (copy) memcpy(copy, source, length + 1);
+    return copy;
+}
+
+// Fonction pour développer un shader (depuis le cache si rien n'a changé)
+char* PreprocessShaderFile(const char* path, unsigned long long* sourceHash, char* error, size_t errorSize) {
+    char rootPath[SHADER_PREPROCESS_MAX_PATH];
+    NormalizeShaderPath(path, rootPath, sizeof(rootPath));
+    if (errorSize > 0) error[0] = '\0';
+
+    pthread_mutex_lock(&gPreprocessor.mutex);
+    PreprocessedShader* shader = GetPreprocessedShader(rootPath, true);
+    if (shader == NULL) {
+        pthread_mutex_unlock(&gPreprocessor.mutex);
+        snprintf(error, errorSize, "Mémoire insuffisante");
+        return NULL;
+    }
+
+    if (IsPreprocessedShaderCurrent(shader)) {
+        char* result = CopySource(shader->output, shader->outputLength);
+        if (sourceHash) *sourceHash = shader->outputHash;
+        pthread_mutex_unlock(&gPreprocessor.mutex);
+        return result;
+    }
+
+    ExpandContext context = {0};
+    context.error = error;
+    context.errorSize = errorSize;
+    bool success = false;
+
+    int rootIndex = GetSourceFileIndex(rootPath, true);
+    if (rootIndex >= 0) {
+        context.included[context.includedCount++] = rootIndex;
+        if (!LoadSourceFile(rootIndex)) {
+            snprintf(error, errorSize, "Lecture impossible: %s", rootPath);
+        } else {
+            success = ExpandSourceFile(&context, rootIndex, 0);
+        }
+    }
+
+    // Les dépendances sont gardées même en cas d'échec : corriger un fichier inclus relance le shader
+    shader->dependencyCount = context.includedCount;
+    for (int i = 0; i < context.includedCount; i++) {
+        shader->dependencies[i] = context.included[i];
+        shader->dependencyHashes[i] = gPreprocessor.files[context.included[i]].hash;
+    }
+    free(shader->output);
+    shader->output = NULL;
+    shader->outputLength = 0;
+
+    char* result = NULL;
+    if (success && context.data) {
+        shader->output = context.data;
+        shader->outputLength = context.length;
+        shader->outputHash = HashShaderSource(context.data, context.length);
+        result = CopySource(context.data, context.length);
+        if (sourceHash) *sourceHash = shader->outputHash;
+    } else {
+        free(context.data);
+    }
+    pthread_mutex_unlock(&gPreprocessor.mutex);
+    return result;
+}
+
+// Fonction pour marquer un fichier comme modifié
+void InvalidateShaderSourceFile(const char* path) {
+    char normalized[SHADER_PREPROCESS_MAX_PATH];
+    NormalizeShaderPath(path, normalized, sizeof(normalized));
+
+    pthread_mutex_lock(&gPreprocessor.mutex);
+    int index = GetSourceFileIndex(normalized, false);
+    if (index >= 0) gPreprocessor.files[index].isLoaded = false;
+    pthread_mutex_unlock(&gPreprocessor.mutex);
+}
+
+bool ShaderDependsOn(const char* rootPath, const char* filePath) {
+    char root[SHADER_PREPROCESS_MAX_PATH];
+    char file[SHADER_PREPROCESS_MAX_PATH];
+    NormalizeShaderPath(rootPath, root, sizeof(root));
+    NormalizeShaderPath(filePath, file, sizeof(file));
+    if (strcmp(root, file) == 0) return true;
+
+    bool dependsOn = false;
+    pthread_mutex_lock(&gPreprocessor.mutex);
+    PreprocessedShader* shader = GetPreprocessedShader(root, false);
+    for (int i = 0; shader && i < shader->dependencyCount && !dependsOn; i++) {
+        dependsOn = strcmp(gPreprocessor.files[shader->dependencies[i]].path, file) == 0;
+    }
+    pthread_mutex_unlock(&gPreprocessor.mutex);
+    return dependsOn;
+}
+
+int GetShaderDependencies(const char* rootPath, char paths[][SHADER_PREPROCESS_MAX_PATH], int maxPaths) {
+    char root[SHADER_PREPROCESS_MAX_PATH];
+    NormalizeShaderPath(rootPath, root, sizeof(root));
+
+    int count = 0;
+    pthread_mutex_lock(&gPreprocessor.mutex);
+    PreprocessedShader* shader = GetPreprocessedShader(root, false);
+    for (int i = 0; shader && i < shader->dependencyCount && count < maxPaths; i++) {
+        snprintf(paths[count++], SHADER_PREPROCESS_MAX_PATH, "%s", gPreprocessor.files[shader->dependencies[i]].path);
+    }
+    pthread_mutex_unlock(&gPreprocessor.mutex);
+    return count;
+}
+
+// Fonction pour vider tous les caches du préprocesseur
+void ClearShaderPreprocessCache(void) {
+    pthread_mutex_lock(&gPreprocessor.mutex);
+    for (int i = 0; i < gPreprocessor.fileCount; i++) free(gPreprocessor.files[i].content);
+    for (int i = 0; i < gPreprocessor.shaderCount; i++) free(gPreprocessor.shaders[i].output);
+    free(gPreprocessor.files);
+    free(gPreprocessor.shaders);
+    gPreprocessor.files = NULL;
+    gPreprocessor.shaders = NULL;
+    gPreprocessor.fileCount = gPreprocessor.fileCapacity = 0;
+    gPreprocessor.shaderCount = gPreprocessor.shaderCapacity = 0;
+    pthread_mutex_unlock(&gPreprocessor.mutex);
+}
@@ -0,0 +1,346 @@
+#include "shader_registry.h"
+#include "logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#define SHADER_REGISTRY_ROOT "shaders"
+#define SHADER_REGISTRY_MAX_DEPTH 16          // Protection contre les boucles de liens
+#define SHADER_REGISTRY_DEFAULT_PATH "effect.glsl"
+
+// Structure globale de la liste des shaders
+typedef struct {
+    ShaderEntry* entries;                     // Triées par chemin
+    int count;
+    int capacity;
+    char** directories;                       // Dossiers parcourus (et surveillés)
+    int directoryCount;
+    int directoryCapacity;
+    char selectedPath[FILE_WATCH_MAX_PATH];
+    int selectedIndex;
+} ShaderRegistry;
+
+static ShaderRegistry gShaderRegistry = {0};
+
+static char* CopyString(const char* text) {
+    size_t length = strlen(text);
+    char* copy = (char*)malloc(length + 1);
+    if (copy) memcpy(copy, text, length + 1);
+    return copy;
+}
+
+static bool HasShaderExtension(const char* path) {
+    size_t length = strlen(path);
+    return length > 5 && strcmp(path + length - 5, ".glsl") == 0;
+}
+
+// Les dossiers lib/ ne contiennent que des fichiers inclus, pas des effets
+static bool IsSkippedDirectoryName(const char* name, size_t length) {
+    return length == 0 || name[0] == '.' || (length == 3 && strncmp(name, "lib", 3) == 0);
+}
+
+// Fonction pour savoir si un dossier fait partie de l'arborescence parcourue
+static bool IsRegistryDirectory(const char* directory, size_t length) {
+    size_t rootLength = strlen(SHADER_REGISTRY_ROOT);
+    if (length < rootLength || strncmp(directory, SHADER_REGISTRY_ROOT, rootLength) != 0) return false;
+    if (length == rootLength) return true;
+    if (directory[rootLength] != '/') return false;
+
+    const char* component = directory + rootLength + 1;
+    const char* end = directory + length;
+    while (component < end) {
+        const char* slash = memchr(component, '/', (size_t)(end - component));
+        size_t componentLength = slash ? (size_t)(slash - component) : (size_t)(end - component);
+        if (IsSkippedDirectoryName(component, componentLength)) return false;
+        component += componentLength + 1;
+    }
+    return true;
+}
+
+// Un shader est listé s'il est dans le dossier courant ou sous shaders/ (hors lib/)
+static bool IsRegistryFile(const char* path) {
+    const char* slash = strrchr(path, '/');
+    const char* name = slash ? slash + 1 : path;
+    if (name[0] == '.' || !HasShaderExtension(path)) return false;
+    return slash == NULL || IsRegistryDirectory(path, (size_t)(slash - path));
+}
+
+// Position d'insertion d'un chemin dans la liste triée
+static int LowerBound(const char* path) {
+    int low = 0;
+    int high = gShaderRegistry.count;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (strcmp(gShaderRegistry.entries[middle].path, path) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+int FindShaderEntry(const char* path) {
+    int index = LowerBound(path);
+    if (index < gShaderRegistry.count && strcmp(gShaderRegistry.entries[index].path, path) == 0) return index;
+    return -1;
+}
+
+static void RefreshSelectedIndex(void) {
+    gShaderRegistry.selectedIndex = FindShaderEntry(gShaderRegistry.selectedPath);
+}
+
+// Fonction pour créer une entrée (nom affiché : chemin sous shaders/ sans extension)
+static bool CreateEntry(ShaderEntry* entry, const char* path) {
+    const char* name = path;
+    size_t rootLength = strlen(SHADER_REGISTRY_ROOT);
+    if (strncmp(path, SHADER_REGISTRY_ROOT, rootLength) == 0 && path[rootLength] == '/') name = path + rootLength + 1;
+
+    entry->path = CopyString(path);
+    entry->name = CopyString(name);
+    if (entry->path == NULL || entry->name == NULL) {
+        free(entry->path);
+        free(entry->name);
+        return false;
+    }
+    entry->name[strlen(entry->name) - 5] = '\0'; // Retirer ".glsl"
+    return true;
+}
+
+static bool ReserveEntries(int needed) {
+    if (needed <= gShaderRegistry.capacity) return true;
+    int newCapacity = gShaderRegistry.capacity > 0 ? gShaderRegistry.capacity * 2 : 64;
+    while (newCapacity < needed) newCapacity *= 2;
+    ShaderEntry* newEntries = (ShaderEntry*)realloc(gShaderRegistry.entries, newCapacity * sizeof(ShaderEntry));
+    if (newEntries == NULL) return false;
+    gShaderRegistry.entries = newEntries;
+    gShaderRegistry.capacity = newCapacity;
+    return true;
+}
+
+// Ajout en fin de liste pendant un parcours (triée ensuite en une fois)
+static void AppendEntry(const char* path) {
+    if (!ReserveEntries(gShaderRegistry.count + 1)) return;
+    if (CreateEntry(&gShaderRegistry.entries[gShaderRegistry.count], path)) gShaderRegistry.count++;
+}
+
+static bool InsertEntry(const char* path) {
+    int index = LowerBound(path);
+    if (index < gShaderRegistry.count && strcmp(gShaderRegistry.entries[index].path, path) == 0) return false;
+    if (!ReserveEntries(gShaderRegistry.count + 1)) return false;
+
+    ShaderEntry entry;
+    if (!CreateEntry(&entry, path)) return false;
+    memmove(&gShaderRegistry.entries[index + 1], &gShaderRegistry.entries[index],
+            (size_t)(gShaderRegistry.count - index) * sizeof(ShaderEntry));
+    gShaderRegistry.entries[index] = entry;
+    gShaderRegistry.count++;
+    return true;
+}
+
+static void RemoveEntryAt(int index) {
+    free(gShaderRegistry.entries[index].path);
+    free(gShaderRegistry.entries[index].name);
+    memmove(&gShaderRegistry.entries[index], &gShaderRegistry.entries[index + 1],
+            (size_t)(gShaderRegistry.count - index - 1) * sizeof(ShaderEntry));
+    gShaderRegistry.count--;
+}
+
+static int CompareEntries(const void* a, const void* b) {
+    return strcmp(((const ShaderEntry*)a)->path, ((const ShaderEntry*)b)->path);
+}
+
+// Fonction pour trier la liste après un parcours et retirer les doublons
+static void SortEntries(void) {
+    qsort(gShaderRegistry.entries, (size_t)gShaderRegistry.count, sizeof(ShaderEntry), CompareEntries);
+    int write = 0;
+    for (int read = 0; read < gShaderRegistry.count; read++) {
+        if (write > 0 && strcmp(gShaderRegistry.entries[write - 1].path, gShaderRegistry.entries[read].path) == 0) {
+            free(gShaderRegistry.entries[read].path);
+            free(gShaderRegistry.entries[read].name);
+            continue;
+        }
+        gShaderRegistry.entries[write++] = gShaderRegistry.entries[read];
+    }
+    gShaderRegistry.count = write;
+}
+
+// Fonction pour surveiller un dossier parcouru (une seule fois)
+static void AddWatchedDirectory(const char* directory) {
+    for (int i = 0; i < gShaderRegistry.directoryCount; i++) {
+        if (strcmp(gShaderRegistry.directories[i], directory) == 0) return;
+    }
+    if (gShaderRegistry.directoryCount >= gShaderRegistry.directoryCapacity) {
+        int newCapacity = gShaderRegistry.directoryCapacity > 0 ? gShaderRegistry.directoryCapacity * 2 : 16;
+        char** newDirectories = (char**)realloc(gShaderRegistry.directories, newCapacity * sizeof(char*));
+        if (newDirectories == NULL) return;
+        gShaderRegistry.directories = newDirectories;
+        gShaderRegistry.directoryCapacity = newCapacity;
+    }
+    char* copy = CopyString(directory);
+    if (copy == NULL) return;
+    gShaderRegistry.directories[gShaderRegistry.directoryCount++] = copy;
+    FileWatchAddDirectory(directory);
+}
+
+// Fonction pour parcourir un dossier (et ses sous-dossiers si recursive)
+static void ScanDirectory(const char* directory, bool recursive, int depth) {
+    DIR* dir = opendir(directory);
+    if (dir == NULL) return;
+    AddWatchedDirectory(directory);
+
+    bool isCurrentDirectory = strcmp(directory, ".") == 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') continue;
+
+        char path[FILE_WATCH_MAX_PATH];
+        int length = isCurrentDirectory ? snprintf(path, sizeof(path), "%s", entry->d_name)
+                                        : snprintf(path, sizeof(path), "%s/%s", directory, entry->d_name);
+        if (length < 0 || (size_t)length >= sizeof(path)) {
+            LOG_WARNINGF("shader path too long, skipped: %s/%s", directory, entry->d_name);
+            continue;
+        }
+
+        if (HasShaderExtension(entry->d_name)) {
+            AppendEntry(path);
+            continue;
+        }
+
+        // Seuls les autres noms sont testés (stat), les .glsl sont la grande majorité
+        if (!recursive || IsSkippedDirectoryName(entry->d_name, strlen(entry->d_name))) continue;
+        struct stat info;
+        if (stat(path, &info) != 0 || !S_ISDIR(info.st_mode)) continue;
+        if (depth >= SHADER_REGISTRY_MAX_DEPTH) {
+            LOG_WARNINGF("shader directory too deep, skipped: %s", path);
+            continue;
+        }
+        ScanDirectory(path, true, depth + 1);
+    }
+    closedir(dir);
+}
+
+static void FreeEntries(void) {
+    for (int i = 0; i < gShaderRegistry.count; i++) {
+        free(gShaderRegistry.entries[i].path);
+        free(gShaderRegistry.entries[i].name);
+    }
+    gShaderRegistry.count = 0;
+}
+
+// Fonction pour parcourir toute l'arborescence des shaders
+void RescanShaderRegistry(void) {
+    double startTime = (double)clock() / CLOCKS_PER_SEC;
+    FreeEntries();
+    ScanDirectory(".", false, 0);
+    ScanDirectory(SHADER_REGISTRY_ROOT, true, 0);
+    SortEntries();
+    RefreshSelectedIndex();
+    LOG_INFOF("Shader registry: %d shaders in %d directories (%.1f ms)", gShaderRegistry.count,
+              gShaderRegistry.directoryCount, ((double)clock() / CLOCKS_PER_SEC - startTime) * 1000.0);
+}
+
+// Fonction pour initialiser la liste (le premier shader est sélectionné)
+void InitShaderRegistry(void) {
+    CloseShaderRegistry();
+    RescanShaderRegistry();
+    if (gShaderRegistry.count > 0) {
+        SelectShader(0);
+    } else {
+        // Aucun shader trouvé : chemin par défaut (erreur affichée au chargement)
+        snprintf(gShaderRegistry.selectedPath, sizeof(gShaderRegistry.selectedPath), "%s", SHADER_REGISTRY_DEFAULT_PATH);
+        gShaderRegistry.selectedIndex = -1;
+        LOG_INFOF("No shaders found, using default");
+    }
+}
+
+void CloseShaderRegistry(void) {
+    FreeEntries();
+    free(gShaderRegistry.entries);
+    for (int i = 0; i < gShaderRegistry.directoryCount; i++) free(gShaderRegistry.directories[i]);
+    free(gShaderRegistry.directories);
+    memset(&gShaderRegistry, 0, sizeof(gShaderRegistry));
+    gShaderRegistry.selectedIndex = -1;
+}
+
+// Fonction pour retirer un dossier supprimé (ses shaders et ses sous-dossiers)
+static bool RemoveRegistryDirectory(const char* directory) {
+    size_t length = strlen(directory);
+    bool changed = false;
+    for (int i = gShaderRegistry.count - 1; i >= 0; i--) {
+        const char* path = gShaderRegistry.entries[i].path;
+        if (strncmp(path, directory, length) == 0 && path[length] == '/') {
+            RemoveEntryAt(i);
+            changed = true;
+        }
+    }
+    for (int i = gShaderRegistry.directoryCount - 1; i >= 0; i--) {
+        const char* watched = gShaderRegistry.directories[i];
+        if (strncmp(watched, directory, length) == 0 && (watched[length] == '\0' || watched[length] == '/')) {
+            FileWatchRemoveDirectory(watched);
+            free(gShaderRegistry.directories[i]);
+            gShaderRegistry.directories[i] = gShaderRegistry.directories[--gShaderRegistry.directoryCount];
+        }
+    }
+    return changed;
+}
+
+// Fonction pour appliquer un événement de fichier à la liste
+bool UpdateShaderRegistry(const FileWatchEvent* event) {
+    bool changed = false;
+    if (event->isDirectory) {
+        if (!IsRegistryDirectory(event->path, strlen(event->path))) return false;
+        if (event->type == FILE_WATCH_DELETED) {
+            changed = RemoveRegistryDirectory(event->path);
+        } else if (event->type == FILE_WATCH_CREATED) {
+            // Nouveau dossier (ou dossier déplacé ici) : parcourir son contenu
+            int depth = 0;
+            for (const char* c = event->path; *c; c++) {
+                if (*c == '/') depth++;
+            }
+            int previousCount = gShaderRegistry.count;
+            ScanDirectory(event->path, true, depth);
+            SortEntries();
+            changed = gShaderRegistry.count != previousCount;
+        }
+    } else if (IsRegistryFile(event->path)) {
+        if (event->type == FILE_WATCH_DELETED) {
+            int index = FindShaderEntry(event->path);
+            if (index >= 0) {
+                RemoveEntryAt(index);
+                changed = true;
+            }
+        } else {
+            changed = InsertEntry(event->path);
+        }
+    }
+
+    if (changed) RefreshSelectedIndex();
+    return changed;
+}
+
+int GetShaderCount(void) {
+    return gShaderRegistry.count;
+}
+
+const ShaderEntry* GetShaderEntry(int index) {
+    if (index < 0 || index >= gShaderRegistry.count) return NULL;
+    return &gShaderRegistry.entries[index];
+}
+
+void SelectShader(int index) {
+    if (index < 0 || index >= gShaderRegistry.count) return;
+    snprintf(gShaderRegistry.selectedPath, sizeof(gShaderRegistry.selectedPath), "%s", gShaderRegistry.entries[index].path);
+    gShaderRegistry.selectedIndex = index;
+}
+
+int GetSelectedShaderIndex(void) {
+    return gShaderRegistry.selectedIndex;
+}
+
+const char* GetSelectedShaderPath(void) {
+    return gShaderRegistry.selectedPath[0] != '\0' ? gShaderRegistry.selectedPath : SHADER_REGISTRY_DEFAULT_PATH;
+}
@@ -0,0 +1,1023 @@
+#include "shader_reload.h"
+#include "gl_ext.h"
+#include "shader_preprocess.h"
+#include "shader_cache.h"
+#include "render_graph.h"
+#include "logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#define SHADER_RELOAD_MAX_PATH 320
+#define MAX_SHADER_LOCATIONS 32 // RL_MAX_SHADER_LOCATIONS de raylib
+#define SHADER_PRECOMPILE_MAX 128 // Graphes gardés compilés (programmes côté pilote)
+
+// Vertex shader équivalent au shader par défaut de raylib (OpenGL 3.3)
+static const char* defaultVertexShader =
+"#version 330\n"
+"in vec3 vertexPosition;\n"
+"in vec2 vertexTexCoord;\n"
+"in vec4 vertexColor;\n"
+"out vec2 fragTexCoord;\n"
+"out vec4 fragColor;\n"
+"uniform mat4 mvp;\n"
+"void main() {\n"
+"    fragTexCoord = vertexTexCoord;\n"
+"    fragColor = vertexColor;\n"
+"    gl_Position = mvp*vec4(vertexPosition, 1.0);\n"
+"}\n";
+
+// Emplacements d'attributs imposés par le batch de raylib
+static const struct { unsigned int location; const char* name; } defaultAttribs[] = {
+    {0, "vertexPosition"}, {1, "vertexTexCoord"}, {2, "vertexNormal"}, {3, "vertexColor"},
+    {4, "vertexTangent"}, {5, "vertexTexCoord2"}, {6, "vertexBoneIds"}, {7, "vertexBoneWeights"}
+};
+
+// Programmes d'un graphe prêts à compiler : une variante par passe et par niveau
+// de qualité (sources développés et binaires du cache)
+typedef struct {
+    RenderGraphDesc desc;
+    unsigned long long sourceHash;                    // Source développé du fichier
+    char* sources[MAX_RENDER_PROGRAMS];
+    unsigned long long keys[MAX_RENDER_PROGRAMS];       // Clés du cache de binaires
+    void* binaries[MAX_RENDER_PROGRAMS];                // Binaires trouvés (NULL sinon)
+    GLenum binaryFormats[MAX_RENDER_PROGRAMS];
+    GLsizei binaryLengths[MAX_RENDER_PROGRAMS];
+} PreparedGraph;
+
+typedef enum {
+    RELOAD_STAGE_IDLE,
+    RELOAD_STAGE_READING,    // Le thread lit et prétraite le source
+    RELOAD_STAGE_COMPILING   // Compilation/édition de liens lancées côté GL
+} ReloadStage;
+
+// Shader compilé d'avance, prêt à remplacer le graphe actif
+typedef struct {
+    char* path;
+    RenderGraph graph;
+} PrecompiledShader;
+
+// Structure globale du rechargement de shader
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t condition;
+    bool running;
+
+    // Demande transmise au thread (protégée par le mutex)
+    char requestPath[SHADER_RELOAD_MAX_PATH];
+    unsigned int requestGeneration;
+    bool hasRequest;
+
+    // Résultat du thread (protégé par le mutex)
+    PreparedGraph ready;
+    bool readySuccess;
+    char readyError[SHADER_RELOAD_MAX_PATH + 64];
+    unsigned int readyGeneration;
+    bool hasResult;
+
+    // File de précompilation (protégée par le mutex), servie quand il n'y a pas de demande
+    char** precompileQueue;
+    int precompileQueueCount;
+    int precompileQueueCapacity;
+    unsigned int precompileGeneration;    // Incrémenté quand des sources changent
+    PreparedGraph precompileReady;
+    bool precompileReadySuccess;
+    char precompileReadyPath[SHADER_RELOAD_MAX_PATH];
+    char precompileReadyError[SHADER_RELOAD_MAX_PATH + 64];
+    bool hasPrecompileResult;
+    char precompileReadingPath[SHADER_RELOAD_MAX_PATH]; // Shader en cours de lecture ("" sinon)
+
+    // Variante spécialisée (protégée par le mutex), une seule à la fois : la dernière
+    // demande remplace la précédente
+    char variantRequestPath[SHADER_RELOAD_MAX_PATH];
+    RenderGraphVariantKey variantRequestKey;
+    unsigned int variantGeneration;
+    bool hasVariantRequest;
+    PreparedGraph variantReady;
+    RenderGraphVariantKey variantReadyKey;
+    bool variantReadySuccess;
+    char variantReadyError[SHADER_RELOAD_MAX_PATH + 64];
+    bool hasVariantResult;
+
+    // État du thread principal
+    ReloadStage stage;
+    unsigned int generation;
+    char currentPath[SHADER_RELOAD_MAX_PATH];
+    GLuint vertexShader;     // Compilé une fois, partagé par tous les programmes
+    unsigned long long vertexHash;
+    PreparedGraph pending;   // Graphe en cours de compilation
+    GLuint fragmentShaders[MAX_RENDER_PROGRAMS];
+    GLuint programs[MAX_RENDER_PROGRAMS];
+    double startTime;
+    bool isInitialized;
+
+    // Précompilation côté thread principal
+    bool isPrecompiling;
+    char precompilePath[SHADER_RELOAD_MAX_PATH];
+    PreparedGraph precompilePending;
+    GLuint precompileFragmentShaders[MAX_RENDER_PROGRAMS];
+    GLuint precompilePrograms[MAX_RENDER_PROGRAMS];
+    PrecompiledShader* precompiled;
+    int precompiledCount;
+    int precompiledCapacity;
+
+    // Compilation de la variante côté thread principal
+    bool isBuildingVariant;
+    RenderGraphVariantKey variantKey;
+    char variantPath[SHADER_RELOAD_MAX_PATH];
+    PreparedGraph variantPending;
+    GLuint variantFragmentShaders[MAX_RENDER_PROGRAMS];
+    GLuint variantPrograms[MAX_RENDER_PROGRAMS];
+} ShaderReloader;
+
+static ShaderReloader gShaderReloader = {0};
+
+static void FreePreparedGraph(PreparedGraph* prepared) {
+    for (int i = 0; i < MAX_RENDER_PROGRAMS; i++) {
+        free(prepared->sources[i]);
+        free(prepared->binaries[i]);
+    }
+    memset(prepared, 0, sizeof(*prepared));
+}
+
+// Fonction pour lire un shader et préparer ses passes (sans appel GL, utilisable
+// depuis le thread de lecture). Pour une variante, seules les passes de son niveau
+// de qualité sont préparées, et desc est réduit à ce niveau.
+static bool PrepareGraph(const char* path, const RenderGraphVariantKey* variant, PreparedGraph* prepared,
+                         char* errorMessage, size_t errorSize) {
+    memset(prepared, 0, sizeof(*prepared));
+
+    // Lecture et développement des #include (seuls les fichiers modifiés sont relus)
+    char* source = PreprocessShaderFile(path, &prepared->sourceHash, errorMessage, errorSize);
+    if (source == NULL) return false;
+
+    bool success = ParseRenderGraph(source, &prepared->desc, errorMessage, errorSize);
+    if (success && variant != NULL && variant->quality >= prepared->desc.qualityLevels) {
+        snprintf(errorMessage, errorSize, "Niveau de qualité %d absent: %s", variant->quality, path);
+        success = false;
+    }
+    int programCount = variant ? prepared->desc.passCount : GetRenderGraphProgramCount(&prepared->desc);
+    int firstProgram = variant ? variant->quality * prepared->desc.passCount : 0;
+    for (int i = 0; success && i < programCount; i++) {
+        prepared->sources[i] = BuildRenderPassSource(source, &prepared->desc, firstProgram + i, variant);
+        if (prepared->sources[i] == NULL) {
+            snprintf(errorMessage, errorSize, "Mémoire insuffisante: %s", path);
+            success = false;
+            break;
+        }
+
+        // Chercher un binaire déjà compilé pour cette passe et ce pilote
+        unsigned long long passHash = HashShaderSource(prepared->sources[i], strlen(prepared->sources[i]));
+        prepared->keys[i] = GetShaderBinaryKey(passHash, gShaderReloader.vertexHash);
+        prepared->binaries[i] = LoadShaderBinary(prepared->keys[i], &prepared->binaryFormats[i], &prepared->binaryLengths[i]);
+    }
+    free(source);
+    if (variant != NULL) prepared->desc.qualityLevels = 1;
+
+    if (!success) FreePreparedGraph(prepared);
+    return success;
+}
+
+static char* CopyString(const char* text) {
+    size_t length = strlen(text);
+    char* copy = (char*)malloc(length + 1);
+    if (copy) memcpy(copy, text, length + 1);
+    return copy;
+}
+
+// Fonction pour ajouter un chemin à la file de précompilation (mutex tenu)
+static bool PushPrecompilePath(const char* path) {
+    for (int i = 0; i < gShaderReloader.precompileQueueCount; i++) {
+        if (strcmp(gShaderReloader.precompileQueue[i], path) == 0) return true;
+    }
+    if (gShaderReloader.precompileQueueCount == gShaderReloader.precompileQueueCapacity) {
+        int capacity = gShaderReloader.precompileQueueCapacity ? gShaderReloader.precompileQueueCapacity * 2 : 16;
+        char** queue = (char**)realloc(gShaderReloader.precompileQueue, capacity * sizeof(char*));
+        if (queue == NULL) return false;
+        gShaderReloader.precompileQueue = queue;
+        gShaderReloader.precompileQueueCapacity = capacity;
+    }
+    char* copy = CopyString(path);
+    if (copy == NULL) return false;
+    gShaderReloader.precompileQueue[gShaderReloader.precompileQueueCount++] = copy;
+    return true;
+}
+
+static void ClearPrecompileQueue(void) {
+    for (int i = 0; i < gShaderReloader.precompileQueueCount; i++) free(gShaderReloader.precompileQueue[i]);
+    gShaderReloader.precompileQueueCount = 0;
+}
+
+// Fonction pour préparer le prochain shader de la file (mutex tenu, relâché pendant la lecture)
+static void PreparePrecompile(void) {
+    char* path = gShaderReloader.precompileQueue[0];
+    gShaderReloader.precompileQueueCount--;
+    memmove(gShaderReloader.precompileQueue, gShaderReloader.precompileQueue + 1,
+            gShaderReloader.precompileQueueCount * sizeof(char*));
+    unsigned int generation = gShaderReloader.precompileGeneration;
+    snprintf(gShaderReloader.precompileReadingPath, sizeof(gShaderReloader.precompileReadingPath), "%s", path);
+    pthread_mutex_unlock(&gShaderReloader.mutex);
+
+    char error[sizeof(gShaderReloader.precompileReadyError)] = {0};
+    PreparedGraph prepared;
+    bool success = PrepareGraph(path, NULL, &prepared, error, sizeof(error));
+
+    pthread_mutex_lock(&gShaderReloader.mutex);
+    gShaderReloader.precompileReadingPath[0] = '\0';
+    if (generation == gShaderReloader.precompileGeneration) {
+        gShaderReloader.precompileReady = prepared;
+        gShaderReloader.precompileReadySuccess = success;
+        snprintf(gShaderReloader.precompileReadyPath, sizeof(gShaderReloader.precompileReadyPath), "%s", path);
+        snprintf(gShaderReloader.precompileReadyError, sizeof(gShaderReloader.precompileReadyError), "%s", error);
+        gShaderReloader.hasPrecompileResult = true;
+    } else {
+        // Un fichier a changé pendant la lecture : relire plus tard
+        FreePreparedGraph(&prepared);
+        PushPrecompilePath(path);
+    }
+    free(path);
+}
+
+// Fonction pour préparer la variante demandée (mutex tenu, relâché pendant la lecture)
+static void PrepareVariant(void) {
+    char path[SHADER_RELOAD_MAX_PATH];
+    snprintf(path, sizeof(path), "%s", gShaderReloader.variantRequestPath);
+    RenderGraphVariantKey key = gShaderReloader.variantRequestKey;
+    unsigned int generation = gShaderReloader.variantGeneration;
+    gShaderReloader.hasVariantRequest = false;
+    pthread_mutex_unlock(&gShaderReloader.mutex);
+
+    char error[sizeof(gShaderReloader.variantReadyError)] = {0};
+    PreparedGraph prepared;
+    bool success = PrepareGraph(path, &key, &prepared, error, sizeof(error));
+
+    pthread_mutex_lock(&gShaderReloader.mutex);
+    if (generation == gShaderReloader.variantGeneration) {
+        gShaderReloader.variantReady = prepared;
+        gShaderReloader.variantReadyKey = key;
+        gShaderReloader.variantReadySuccess = success;
+        snprintf(gShaderReloader.variantReadyError, sizeof(gShaderReloader.variantReadyError), "%s", error);
+        gShaderReloader.hasVariantResult = true;
+    } else {
+        FreePreparedGraph(&prepared);
+    }
+}
+
+static void* ShaderReadThread(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&gShaderReloader.mutex);
+    while (gShaderReloader.running) {
+        if (!gShaderReloader.hasRequest) {
+            // Après les rechargements : la variante demandée, puis la précompilation,
+            // un shader à la fois
+            if (gShaderReloader.hasVariantRequest) {
+                PrepareVariant();
+            } else if (gShaderReloader.precompileQueueCount > 0 && !gShaderReloader.hasPrecompileResult) {
+                PreparePrecompile();
+            } else {
+                pthread_cond_wait(&gShaderReloader.condition, &gShaderReloader.mutex);
+            }
+            continue;
+        }
+
+        char path[SHADER_RELOAD_MAX_PATH];
+        snprintf(path, sizeof(path), "%s", gShaderReloader.requestPath);
+        unsigned int generation = gShaderReloader.requestGeneration;
+        gShaderReloader.hasRequest = false;
+        pthread_mutex_unlock(&gShaderReloader.mutex);
+
+        char error[sizeof(gShaderReloader.readyError)] = {0};
+        PreparedGraph prepared;
+        bool success = PrepareGraph(path, NULL, &prepared, error, sizeof(error));
+
+        pthread_mutex_lock(&gShaderReloader.mutex);
+        // Ignorer le résultat si une demande plus récente est arrivée entre-temps
+        if (generation == gShaderReloader.requestGeneration) {
+            FreePreparedGraph(&gShaderReloader.ready);
+            gShaderReloader.ready = prepared;
+            gShaderReloader.readySuccess = success;
+            snprintf(gShaderReloader.readyError, sizeof(gShaderReloader.readyError), "%s", error);
+            gShaderReloader.readyGeneration = generation;
+            gShaderReloader.hasResult = true;
+        } else {
+            FreePreparedGraph(&prepared);
+        }
+    }
+    pthread_mutex_unlock(&gShaderReloader.mutex);
+    return NULL;
+}
+
+// Fonction pour copier la première ligne utile d'un journal de compilation
+static void CopyInfoLog(const char* log, char* output, size_t size) {
+    if (size == 0) return;
+    while (*log == '\n' || *log == ' ') log++;
+    size_t length = strcspn(log, "\n");
+    if (length >= size) length = size - 1;
+    memcpy(output, log, length);
+    output[length] = '\0';
+}
+
+// Fonction pour abandonner les programmes en cours de compilation
+static void DiscardPendingPrograms(void) {
+    for (int i = 0; i < MAX_RENDER_PROGRAMS; i++) {
+        if (gShaderReloader.programs[i]) gGL.DeleteProgram(gShaderReloader.programs[i]);
+        if (gShaderReloader.fragmentShaders[i]) gGL.DeleteShader(gShaderReloader.fragmentShaders[i]);
+        gShaderReloader.programs[i] = 0;
+        gShaderReloader.fragmentShaders[i] = 0;
+    }
+    FreePreparedGraph(&gShaderReloader.pending);
+}
+
+// Fonction pour abandonner la précompilation en cours
+static void DiscardPrecompilePrograms(void) {
+    for (int i = 0; i < MAX_RENDER_PROGRAMS; i++) {
+        if (gShaderReloader.precompilePrograms[i]) gGL.DeleteProgram(gShaderReloader.precompilePrograms[i]);
+        if (gShaderReloader.precompileFragmentShaders[i]) gGL.DeleteShader(gShaderReloader.precompileFragmentShaders[i]);
+        gShaderReloader.precompilePrograms[i] = 0;
+        gShaderReloader.precompileFragmentShaders[i] = 0;
+    }
+    FreePreparedGraph(&gShaderReloader.precompilePending);
+    gShaderReloader.isPrecompiling = false;
+}
+
+// Fonction pour abandonner la variante en cours de compilation
+static void DiscardVariantPrograms(void) {
+    for (int i = 0; i < MAX_RENDER_PROGRAMS; i++) {
+        if (gShaderReloader.variantPrograms[i]) gGL.DeleteProgram(gShaderReloader.variantPrograms[i]);
+        if (gShaderReloader.variantFragmentShaders[i]) gGL.DeleteShader(gShaderReloader.variantFragmentShaders[i]);
+        gShaderReloader.variantPrograms[i] = 0;
+        gShaderReloader.variantFragmentShaders[i] = 0;
+    }
+    FreePreparedGraph(&gShaderReloader.variantPending);
+    gShaderReloader.isBuildingVariant = false;
+}
+
+// Fonction pour lancer la compilation et l'édition de liens sans attendre le résultat
+static GLuint StartProgramBuild(const char* source, GLuint* fragmentShader) {
+    *fragmentShader = gGL.CreateShader(GL_FRAGMENT_SHADER);
+    gGL.ShaderSource(*fragmentShader, 1, &source, NULL);
+    gGL.CompileShader(*fragmentShader);
+
+    GLuint program = gGL.CreateProgram();
+    gGL.AttachShader(program, gShaderReloader.vertexShader);
+    gGL.AttachShader(program, *fragmentShader);
+    for (size_t i = 0; i < sizeof(defaultAttribs) / sizeof(defaultAttribs[0]); i++) {
+        gGL.BindAttribLocation(program, defaultAttribs[i].location, defaultAttribs[i].name);
+    }
+    PrepareProgramForBinary(program);
+    // Avec parallel_shader_compile, l'édition de liens attend la compilation côté pilote
+    gGL.LinkProgram(program);
+    return program;
+}
+
+// Fonction pour vérifier le résultat de l'édition de liens (bloquant si elle n'est pas terminée).
+// En cas d'échec, le programme et le shader sont supprimés et le journal copié dans errorMessage.
+static bool FinishProgramBuild(GLuint program, GLuint fragmentShader, const char* path, char* errorMessage, size_t errorSize) {
+    GLint linked = 0;
+    gGL.GetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        char log[1024] = {0};
+        GLint compiled = 0;
+        gGL.GetShaderiv(fragmentShader, GL_COMPILE_STATUS, &compiled);
+        if (!compiled) {
+            gGL.GetShaderInfoLog(fragmentShader, sizeof(log), NULL, log);
+        } else {
+            gGL.GetProgramInfoLog(program, sizeof(log), NULL, log);
+        }
+        LOG_ERRORF("Shader compilation failed for '%s': %s", path, log);
+        CopyInfoLog(log, errorMessage, errorSize);
+        gGL.DeleteProgram(program);
+        gGL.DeleteShader(fragmentShader);
+        return false;
+    }
+
+    // Le programme reste valide sans ses shaders
+    gGL.DetachShader(program, gShaderReloader.vertexShader);
+    gGL.DetachShader(program, fragmentShader);
+    gGL.DeleteShader(fragmentShader);
+    return true;
+}
+
+// Fonction pour nommer un programme dans les messages : "fichier [passe]",
+// ou "fichier [passe, qualité n]" pour un shader à plusieurs niveaux
+static void GetProgramLabel(const RenderGraphDesc* desc, int programIndex, const char* path, char* label, size_t size) {
+    const char* passName = desc->passes[programIndex % desc->passCount].name;
+    if (desc->qualityLevels > 1) {
+        snprintf(label, size, "%s [%s, qualité %d]", path, passName, programIndex / desc->passCount);
+    } else {
+        snprintf(label, size, "%s [%s]", path, passName);
+    }
+}
+
+// Fonction pour construire le Shader raylib (emplacements par défaut comme LoadShader)
+static Shader BuildRaylibShader(GLuint program) {
+    Shader shader = {0};
+    shader.id = program;
+    shader.locs = (int*)MemAlloc(MAX_SHADER_LOCATIONS * sizeof(int));
+    for (int i = 0; i < MAX_SHADER_LOCATIONS; i++) shader.locs[i] = -1;
+
+    shader.locs[SHADER_LOC_VERTEX_POSITION] = GetShaderLocationAttrib(shader, "vertexPosition");
+    shader.locs[SHADER_LOC_VERTEX_TEXCOORD01] = GetShaderLocationAttrib(shader, "vertexTexCoord");
+    shader.locs[SHADER_LOC_VERTEX_TEXCOORD02] = GetShaderLocationAttrib(shader, "vertexTexCoord2");
+    shader.locs[SHADER_LOC_VERTEX_NORMAL] = GetShaderLocationAttrib(shader, "vertexNormal");
+    shader.locs[SHADER_LOC_VERTEX_TANGENT] = GetShaderLocationAttrib(shader, "vertexTangent");
+    shader.locs[SHADER_LOC_VERTEX_COLOR] = GetShaderLocationAttrib(shader, "vertexColor");
+    shader.locs[SHADER_LOC_VERTEX_BONEIDS] = GetShaderLocationAttrib(shader, "vertexBoneIds");
+    shader.locs[SHADER_LOC_VERTEX_BONEWEIGHTS] = GetShaderLocationAttrib(shader, "vertexBoneWeights");
+
+    shader.locs[SHADER_LOC_MATRIX_MVP] = GetShaderLocation(shader, "mvp");
+    shader.locs[SHADER_LOC_MATRIX_VIEW] = GetShaderLocation(shader, "matView");
+    shader.locs[SHADER_LOC_MATRIX_PROJECTION] = GetShaderLocation(shader, "matProjection");
+    shader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocation(shader, "matModel");
+    shader.locs[SHADER_LOC_MATRIX_NORMAL] = GetShaderLocation(shader, "matNormal");
+    shader.locs[SHADER_LOC_BONE_MATRICES] = GetShaderLocation(shader, "boneMatrices");
+
+    shader.locs[SHADER_LOC_COLOR_DIFFUSE] = GetShaderLocation(shader, "colDiffuse");
+    shader.locs[SHADER_LOC_MAP_DIFFUSE] = GetShaderLocation(shader, "texture0");
+    shader.locs[SHADER_LOC_MAP_SPECULAR] = GetShaderLocation(shader, "texture1");
+    shader.locs[SHADER_LOC_MAP_NORMAL] = GetShaderLocation(shader, "texture2");
+    return shader;
+}
+
+// Fonction pour lancer la construction de toutes les passes : binaire du cache
+// si le pilote l'accepte, sinon compilation (résultat lu plus tard)
+static void StartGraphBuild(PreparedGraph* prepared, GLuint* programs, GLuint* fragmentShaders) {
+    for (int i = 0; i < GetRenderGraphProgramCount(&prepared->desc); i++) {
+        programs[i] = 0;
+        fragmentShaders[i] = 0;
+        if (prepared->binaries[i]) {
+            programs[i] = CreateProgramFromBinary(prepared->keys[i], prepared->binaryFormats[i],
+                                                  prepared->binaries[i], prepared->binaryLengths[i]);
+            free(prepared->binaries[i]);
+            prepared->binaries[i] = NULL;
+        }
+        if (programs[i] == 0) programs[i] = StartProgramBuild(prepared->sources[i], &fragmentShaders[i]);
+    }
+}
+
+static bool IsGraphBuildComplete(const PreparedGraph* prepared, const GLuint* programs, const GLuint* fragmentShaders) {
+    if (!HasParallelShaderCompile()) return true;
+    for (int i = 0; i < GetRenderGraphProgramCount(&prepared->desc); i++) {
+        if (fragmentShaders[i] == 0) continue; // Chargé depuis le cache
+        GLint completed = 0;
+        gGL.GetProgramiv(programs[i], GL_COMPLETION_STATUS_KHR, &completed);
+        if (!completed) return false;
+    }
+    return true;
+}
+
+// Fonction pour terminer la construction des passes. Tout ou rien : si une passe échoue,
+// tous les programmes sont supprimés. Les programmes compilés sont ajoutés au cache.
+static bool FinishGraphBuild(const PreparedGraph* prepared, GLuint* programs, GLuint* fragmentShaders,
+                             const char* path, Shader* shaders, char* errorMessage, size_t errorSize) {
+    bool success = true;
+    for (int i = 0; i < GetRenderGraphProgramCount(&prepared->desc); i++) {
+        if (fragmentShaders[i] == 0) continue;
+        if (!success) {
+            gGL.DeleteProgram(programs[i]);
+            gGL.DeleteShader(fragmentShaders[i]);
+            programs[i] = 0;
+        } else {
+            char label[SHADER_RELOAD_MAX_PATH + MAX_PASS_NAME + 24];
+            GetProgramLabel(&prepared->desc, i, path, label, sizeof(label));
+            if (FinishProgramBuild(programs[i], fragmentShaders[i], label, errorMessage, errorSize)) {
+                SaveShaderBinary(programs[i], prepared->keys[i]);
+            } else {
+                success = false;
+                programs[i] = 0;
+            }
+        }
+        fragmentShaders[i] = 0;
+    }
+
+    for (int i = 0; i < GetRenderGraphProgramCount(&prepared->desc); i++) {
+        if (success) {
+            shaders[i] = BuildRaylibShader(programs[i]);
+        } else if (programs[i]) {
+            gGL.DeleteProgram(programs[i]);
+        }
+        programs[i] = 0;
+    }
+    return success;
+}
+
+// Fonction pour compiler les passes avec raylib (bloquant, sans les fonctions GL)
+static bool LoadGraphWithRaylib(const PreparedGraph* prepared, const char* path, Shader* shaders, char* errorMessage, size_t errorSize) {
+    for (int i = 0; i < GetRenderGraphProgramCount(&prepared->desc); i++) {
+        shaders[i] = LoadShaderFromMemory(NULL, prepared->sources[i]);
+        if (shaders[i].id == 0) {
+            for (int j = 0; j < i; j++) UnloadShader(shaders[j]);
+            char label[SHADER_RELOAD_MAX_PATH + MAX_PASS_NAME + 24];
+            GetProgramLabel(&prepared->desc, i, path, label, sizeof(label));
+            snprintf(errorMessage, errorSize, "Compilation échouée: %s", label);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Fonction pour démarrer le système de rechargement
+bool InitShaderReload(void) {
+    if (gShaderReloader.isInitialized) return true;
+
+    memset(&gShaderReloader, 0, sizeof(gShaderReloader));
+    pthread_mutex_init(&gShaderReloader.mutex, NULL);
+    pthread_cond_init(&gShaderReloader.condition, NULL);
+
+    // Sans les fonctions GL, le source prêt est compilé par LoadShaderFromMemory (bloquant)
+    if (InitGLExtensions()) {
+        gShaderReloader.vertexShader = gGL.CreateShader(GL_VERTEX_SHADER);
+        gGL.ShaderSource(gShaderReloader.vertexShader, 1, &defaultVertexShader, NULL);
+        gGL.CompileShader(gShaderReloader.vertexShader);
+        gShaderReloader.vertexHash = HashShaderSource(defaultVertexShader, strlen(defaultVertexShader));
+        GLint compiled = 0;
+        gGL.GetShaderiv(gShaderReloader.vertexShader, GL_COMPILE_STATUS, &compiled);
+        if (!compiled) {
+            LOG_ERRORF("Failed to compile reload vertex shader, falling back to blocking reloads");
+            gGL.DeleteShader(gShaderReloader.vertexShader);
+            gShaderReloader.vertexShader = 0;
+        } else {
+            InitShaderBinaryCache();
+        }
+    }
+
+    gShaderReloader.running = true;
+    if (pthread_create(&gShaderReloader.thread, NULL, ShaderReadThread, NULL) != 0) {
+        LOG_ERRORF("Failed to start shader read thread");
+        gShaderReloader.running = false;
+    }
+    gShaderReloader.isInitialized = true;
+    return gShaderReloader.running;
+}
+
+// Fonction pour arrêter le système de rechargement
+void CloseShaderReload(void) {
+    if (!gShaderReloader.isInitialized) return;
+
+    if (gShaderReloader.running) {
+        pthread_mutex_lock(&gShaderReloader.mutex);
+        gShaderReloader.running = false;
+        pthread_cond_signal(&gShaderReloader.condition);
+        pthread_mutex_unlock(&gShaderReloader.mutex);
+        pthread_join(gShaderReloader.thread, NULL);
+    }
+
+    if (gShaderReloader.vertexShader) {
+        DiscardPendingPrograms();
+        DiscardPrecompilePrograms();
+        DiscardVariantPrograms();
+        gGL.DeleteShader(gShaderReloader.vertexShader);
+    }
+    FreePreparedGraph(&gShaderReloader.pending);
+    FreePreparedGraph(&gShaderReloader.ready);
+    FreePreparedGraph(&gShaderReloader.precompilePending);
+    FreePreparedGraph(&gShaderReloader.precompileReady);
+    FreePreparedGraph(&gShaderReloader.variantPending);
+    FreePreparedGraph(&gShaderReloader.variantReady);
+    ClearPrecompileQueue();
+    free(gShaderReloader.precompileQueue);
+    for (int i = 0; i < gShaderReloader.precompiledCount; i++) {
+        UnloadRenderGraph(&gShaderReloader.precompiled[i].graph);
+        free(gShaderReloader.precompiled[i].path);
+    }
+    free(gShaderReloader.precompiled);
+    pthread_cond_destroy(&gShaderReloader.condition);
+    pthread_mutex_destroy(&gShaderReloader.mutex);
+    memset(&gShaderReloader, 0, sizeof(gShaderReloader));
+}
+
+// Fonction pour demander le rechargement d'un fragment shader
+void RequestShaderReload(const char* fsFileName) {
+    if (!gShaderReloader.running) return;
+
+    // Une compilation en cours pour une ancienne demande est abandonnée
+    if (gShaderReloader.stage == RELOAD_STAGE_COMPILING) DiscardPendingPrograms();
+
+    pthread_mutex_lock(&gShaderReloader.mutex);
+    gShaderReloader.generation = ++gShaderReloader.requestGeneration;
+    snprintf(gShaderReloader.requestPath, sizeof(gShaderReloader.requestPath), "%s", fsFileName);
+    gShaderReloader.hasRequest = true;
+    gShaderReloader.hasResult = false;
+    pthread_cond_signal(&gShaderReloader.condition);
+    pthread_mutex_unlock(&gShaderReloader.mutex);
+
+    snprintf(gShaderReloader.currentPath, sizeof(gShaderReloader.currentPath), "%s", fsFileName);
+    gShaderReloader.stage = RELOAD_STAGE_READING;
+    gShaderReloader.startTime = GetTime();
+}
+
+// Fonction pour récupérer les passes préparées par le thread (false si pas encore prêtes)
+static bool TakeReadyGraph(PreparedGraph* prepared, bool* success, char* errorMessage, size_t errorSize) {
+    bool ready = false;
+    pthread_mutex_lock(&gShaderReloader.mutex);
+    if (gShaderReloader.hasResult && gShaderReloader.readyGeneration == gShaderReloader.generation) {
+        *prepared = gShaderReloader.ready;
+        *success = gShaderReloader.readySuccess;
+        snprintf(errorMessage, errorSize, "%s", gShaderReloader.readyError);
+        memset(&gShaderReloader.ready, 0, sizeof(gShaderReloader.ready));
+        gShaderReloader.hasResult = false;
+        ready = true;
+    }
+    pthread_mutex_unlock(&gShaderReloader.mutex);
+    return ready;
+}
+
+// Fonction pour remplacer toutes les passes du graphe actif
+static void SwapGraph(RenderGraph* graph, const PreparedGraph* prepared, const Shader* shaders) {
+    const RenderGraphDesc* desc = &prepared->desc;
+    SetRenderGraphPrograms(graph, desc, shaders);
+    graph->sourceHash = prepared->sourceHash;
+    LOG_INFOF("Shader reloaded: %s (%d pass%s, %.1f ms)", gShaderReloader.currentPath, desc->passCount,
+              desc->passCount > 1 ? "es" : "", (GetTime() - gShaderReloader.startTime) * 1000.0);
+}
+
+// Fonction pour faire avancer le rechargement d'une étape
+ShaderReloadResult UpdateShaderReload(RenderGraph* graph, char* errorMessage, size_t errorSize) {
+    if (gShaderReloader.stage == RELOAD_STAGE_READING) {
+        PreparedGraph* prepared = &gShaderReloader.pending;
+        bool success = false;
+        if (!TakeReadyGraph(prepared, &success, errorMessage, errorSize)) return SHADER_RELOAD_NONE;
+
+        if (!success) {
+            gShaderReloader.stage = RELOAD_STAGE_IDLE;
+            LOG_ERRORF("Shader reload failed: %s", errorMessage);
+            return SHADER_RELOAD_FAILED;
+        }
+
+        Shader shaders[MAX_RENDER_PROGRAMS] = {0};
+        if (gShaderReloader.vertexShader == 0) {
+            // Repli bloquant si les fonctions GL n'ont pas pu être chargées
+            success = LoadGraphWithRaylib(prepared, gShaderReloader.currentPath, shaders, errorMessage, errorSize);
+            gShaderReloader.stage = RELOAD_STAGE_IDLE;
+            if (success) SwapGraph(graph, prepared, shaders);
+            FreePreparedGraph(prepared);
+            return success ? SHADER_RELOAD_SWAPPED : SHADER_RELOAD_FAILED;
+        }
+
+        StartGraphBuild(prepared, gShaderReloader.programs, gShaderReloader.fragmentShaders);
+        gShaderReloader.stage = RELOAD_STAGE_COMPILING;
+        // Shader déjà vu : toutes les passes viennent du cache, remplacement immédiat.
+        // Sinon le résultat de la compilation sera lu à une frame suivante.
+        for (int i = 0; i < GetRenderGraphProgramCount(&prepared->desc); i++) {
+            if (gShaderReloader.fragmentShaders[i] != 0) return SHADER_RELOAD_NONE;
+        }
+    }
+
+    if (gShaderReloader.stage == RELOAD_STAGE_COMPILING) {
+        PreparedGraph* prepared = &gShaderReloader.pending;
+        if (!IsGraphBuildComplete(prepared, gShaderReloader.programs, gShaderReloader.fragmentShaders)) return SHADER_RELOAD_NONE;
+
+        gShaderReloader.stage = RELOAD_STAGE_IDLE;
+        Shader shaders[MAX_RENDER_PROGRAMS] = {0};
+        bool success = FinishGraphBuild(prepared, gShaderReloader.programs, gShaderReloader.fragmentShaders,
+                                        gShaderReloader.currentPath, shaders, errorMessage, errorSize);
+        if (success) {
+            SwapGraph(graph, prepared, shaders);
+        } else {
+            LOG_INFOF("Keeping previous shader");
+        }
+        FreePreparedGraph(prepared);
+        return success ? SHADER_RELOAD_SWAPPED : SHADER_RELOAD_FAILED;
+    }
+
+    return SHADER_RELOAD_NONE;
+}
+
+bool IsShaderReloadPending(void) {
+    return gShaderReloader.stage != RELOAD_STAGE_IDLE;
+}
+
+// Fonction pour charger un graphe immédiatement (démarrage), via le cache de binaires si possible
+bool LoadRenderGraphWithCache(const char* fsFileName, RenderGraph* graph, char* errorMessage, size_t errorSize) {
+    PreparedGraph prepared;
+    if (!PrepareGraph(fsFileName, NULL, &prepared, errorMessage, errorSize)) return false;
+
+    Shader shaders[MAX_RENDER_PROGRAMS] = {0};
+    bool success;
+    if (gShaderReloader.vertexShader == 0) {
+        // Sans les fonctions GL, compilation classique par raylib
+        success = LoadGraphWithRaylib(&prepared, fsFileName, shaders, errorMessage, errorSize);
+    } else {
+        GLuint programs[MAX_RENDER_PROGRAMS] = {0};
+        GLuint fragmentShaders[MAX_RENDER_PROGRAMS] = {0};
+        StartGraphBuild(&prepared, programs, fragmentShaders);
+        success = FinishGraphBuild(&prepared, programs, fragmentShaders, fsFileName, shaders, errorMessage, errorSize);
+    }
+
+    if (success) {
+        SetRenderGraphPrograms(graph, &prepared.desc, shaders);
+        graph->sourceHash = prepared.sourceHash;
+    }
+    FreePreparedGraph(&prepared);
+    return success;
+}
+
+static int FindPrecompiledShader(const char* path) {
+    for (int i = 0; i < gShaderReloader.precompiledCount; i++) {
+        if (strcmp(gShaderReloader.precompiled[i].path, path) == 0) return i;
+    }
+    return -1;
+}
+
+static void RemovePrecompiledShader(int index, bool unload) {
+    PrecompiledShader* entry = &gShaderReloader.precompiled[index];
+    if (unload) UnloadRenderGraph(&entry->graph);
+    free(entry->path);
+    gShaderReloader.precompiledCount--;
+    memmove(entry, entry + 1, (gShaderReloader.precompiledCount - index) * sizeof(PrecompiledShader));
+}
+
+// Fonction pour garder un graphe compilé (le cache en devient propriétaire).
+// Retourne l'entrée, NULL si le cache est plein (le graphe est alors déchargé).
+static PrecompiledShader* AddPrecompiledShader(const char* path, RenderGraph* graph) {
+    int existing = FindPrecompiledShader(path);
+    if (existing >= 0) RemovePrecompiledShader(existing, true);
+
+    if (gShaderReloader.precompiledCount == gShaderReloader.precompiledCapacity) {
+        int capacity = gShaderReloader.precompiledCapacity ? gShaderReloader.precompiledCapacity * 2 : 16;
+        if (capacity > SHADER_PRECOMPILE_MAX) capacity = SHADER_PRECOMPILE_MAX;
+        PrecompiledShader* entries = NULL;
+        if (capacity > gShaderReloader.precompiledCapacity) {
+            entries = (PrecompiledShader*)realloc(gShaderReloader.precompiled, capacity * sizeof(PrecompiledShader));
+        }
+        if (entries == NULL) {
+            UnloadRenderGraph(graph);
+            return NULL;
+        }
+        gShaderReloader.precompiled = entries;
+        gShaderReloader.precompiledCapacity = capacity;
+    }
+
+    char* copy = CopyString(path);
+    if (copy == NULL) {
+        UnloadRenderGraph(graph);
+        return NULL;
+    }
+    PrecompiledShader* entry = &gShaderReloader.precompiled[gShaderReloader.precompiledCount++];
+    entry->path = copy;
+    entry->graph = *graph;
+    memset(graph, 0, sizeof(*graph));
+    return entry;
+}
+
+// Fonction pour ajouter un shader à précompiler (ignoré s'il est déjà prêt ou en file)
+bool QueueShaderPrecompile(const char* fsFileName) {
+    if (!gShaderReloader.running || gShaderReloader.vertexShader == 0) return false;
+    if (FindPrecompiledShader(fsFileName) >= 0) return true;
+    if (gShaderReloader.isPrecompiling && strcmp(gShaderReloader.precompilePath, fsFileName) == 0) return true;
+
+    pthread_mutex_lock(&gShaderReloader.mutex);
+    // Déjà en cours de lecture ou lu : rien à ajouter
+    if (strcmp(gShaderReloader.precompileReadingPath, fsFileName) == 0 ||
+        (gShaderReloader.hasPrecompileResult && strcmp(gShaderReloader.precompileReadyPath, fsFileName) == 0)) {
+        pthread_mutex_unlock(&gShaderReloader.mutex);
+        return true;
+    }
+    bool queued = gShaderReloader.precompiledCount + gShaderReloader.precompileQueueCount < SHADER_PRECOMPILE_MAX &&
+                  PushPrecompilePath(fsFileName);
+    if (queued) pthread_cond_signal(&gShaderReloader.condition);
+    pthread_mutex_unlock(&gShaderReloader.mutex);
+    return queued;
+}
+
+// Fonction pour récupérer le prochain shader préparé par le thread (false si aucun)
+static bool TakePrecompileGraph(PreparedGraph* prepared, bool* success, char* path, size_t pathSize, char* errorMessage, size_t errorSize) {
+    bool ready = false;
+    pthread_mutex_lock(&gShaderReloader.mutex);
+    if (gShaderReloader.hasPrecompileResult) {
+        *prepared = gShaderReloader.precompileReady;
+        *success = gShaderReloader.precompileReadySuccess;
+        snprintf(path, pathSize, "%s", gShaderReloader.precompileReadyPath);
+        snprintf(errorMessage, errorSize, "%s", gShaderReloader.precompileReadyError);
+        memset(&gShaderReloader.precompileReady, 0, sizeof(gShaderReloader.precompileReady));
+        gShaderReloader.hasPrecompileResult = false;
+        pthread_cond_signal(&gShaderReloader.condition); // Le thread peut préparer le suivant
+        ready = true;
+    }
+    pthread_mutex_unlock(&gShaderReloader.mutex);
+    return ready;
+}
+
+// Fonction pour avancer la précompilation pendant une frame sans rechargement.
+// Au plus une construction terminée et une lancée par appel, la seconde seulement
+// s'il reste du budget.
+const char* UpdateShaderPrecompile(double budgetSeconds) {
+    if (!gShaderReloader.running || gShaderReloader.vertexShader == 0) return NULL;
+    if (gShaderReloader.stage != RELOAD_STAGE_IDLE) return NULL; // Le rechargement passe d'abord
+
+    double start = GetTime();
+    const char* completed = NULL;
+    if (gShaderReloader.isPrecompiling) {
+        PreparedGraph* prepared = &gShaderReloader.precompilePending;
+        if (!IsGraphBuildComplete(prepared, gShaderReloader.precompilePrograms, gShaderReloader.precompileFragmentShaders)) return NULL;
+
+        // Sans parallel_shader_compile, l'édition de liens est attendue ici
+        char error[256] = {0};
+        Shader shaders[MAX_RENDER_PROGRAMS] = {0};
+        if (FinishGraphBuild(prepared, gShaderReloader.precompilePrograms, gShaderReloader.precompileFragmentShaders,
+                             gShaderReloader.precompilePath, shaders, error, sizeof(error))) {
+            RenderGraph graph = {0};
+            SetRenderGraphPrograms(&graph, &prepared->desc, shaders);
+            graph.sourceHash = prepared->sourceHash;
+            PrecompiledShader* entry = AddPrecompiledShader(gShaderReloader.precompilePath, &graph);
+            if (entry) completed = entry->path;
+        }
+        FreePreparedGraph(prepared);
+        gShaderReloader.isPrecompiling = false;
+        if (GetTime() - start >= budgetSeconds) return completed;
+    }
+
+    PreparedGraph prepared;
+    bool success = false;
+    char error[sizeof(gShaderReloader.precompileReadyError)] = {0};
+    if (!TakePrecompileGraph(&prepared, &success, gShaderReloader.precompilePath, sizeof(gShaderReloader.precompilePath),
+                             error, sizeof(error))) {
+        return completed;
+    }
+    if (!success) {
+        LOG_INFOF("Shader precompile skipped: %s", error);
+        return completed;
+    }
+
+    gShaderReloader.precompilePending = prepared;
+    StartGraphBuild(&gShaderReloader.precompilePending, gShaderReloader.precompilePrograms, gShaderReloader.precompileFragmentShaders);
+    gShaderReloader.isPrecompiling = true;
+    return completed;
+}
+
+// Fonction pour activer un shader précompilé : simple échange de graphes
+bool SwapPrecompiledShader(const char* fsFileName, RenderGraph* graph, const char* activePath) {
+    int index = FindPrecompiledShader(fsFileName);
+    if (index < 0) return false;
+
+    // Un rechargement en cours (d'un autre shader) n'a plus lieu d'être
+    if (gShaderReloader.stage != RELOAD_STAGE_IDLE) {
+        if (gShaderReloader.stage == RELOAD_STAGE_COMPILING) DiscardPendingPrograms();
+        pthread_mutex_lock(&gShaderReloader.mutex);
+        gShaderReloader.generation = ++gShaderReloader.requestGeneration;
+        gShaderReloader.hasRequest = false;
+        gShaderReloader.hasResult = false;
+        FreePreparedGraph(&gShaderReloader.ready);
+        pthread_mutex_unlock(&gShaderReloader.mutex);
+        gShaderReloader.stage = RELOAD_STAGE_IDLE;
+    }
+
+    RenderGraph previous = *graph;
+    *graph = gShaderReloader.precompiled[index].graph;
+    RemovePrecompiledShader(index, false);
+
+    // L'ancien graphe reste compilé pour revenir en arrière sans attendre
+    if (activePath != NULL && IsRenderGraphReady(&previous)) {
+        ReleaseRenderGraphTargets(&previous);
+        AddPrecompiledShader(activePath, &previous);
+    } else {
+        UnloadRenderGraph(&previous);
+    }
+
+    snprintf(gShaderReloader.currentPath, sizeof(gShaderReloader.currentPath), "%s", fsFileName);
+    LOG_INFOF("Shader switched: %s (precompiled)", fsFileName);
+    return true;
+}
+
+// Fonction pour oublier les shaders précompilés qui utilisent un fichier modifié
+// (à appeler après InvalidateShaderSourceFile). Ils sont remis en file.
+void InvalidatePrecompiledShaders(const char* filePath) {
+    if (!gShaderReloader.running) return;
+
+    char paths[SHADER_PRECOMPILE_MAX + 2][SHADER_RELOAD_MAX_PATH];
+    int pathCount = 0;
+    for (int i = gShaderReloader.precompiledCount - 1; i >= 0; i--) {
+        if (!ShaderDependsOn(gShaderReloader.precompiled[i].path, filePath)) continue;
+        snprintf(paths[pathCount++], SHADER_RELOAD_MAX_PATH, "%s", gShaderReloader.precompiled[i].path);
+        RemovePrecompiledShader(i, true);
+    }
+    if (gShaderReloader.isPrecompiling && ShaderDependsOn(gShaderReloader.precompilePath, filePath)) {
+        snprintf(paths[pathCount++], SHADER_RELOAD_MAX_PATH, "%s", gShaderReloader.precompilePath);
+        DiscardPrecompilePrograms();
+    }
+
+    pthread_mutex_lock(&gShaderReloader.mutex);
+    // Source lu avant la modification : le thread le remettra en file
+    if (gShaderReloader.precompileReadingPath[0] != '\0' &&
+        ShaderDependsOn(gShaderReloader.precompileReadingPath, filePath)) {
+        gShaderReloader.precompileGeneration++;
+    }
+    if (gShaderReloader.hasPrecompileResult && ShaderDependsOn(gShaderReloader.precompileReadyPath, filePath)) {
+        snprintf(paths[pathCount++], SHADER_RELOAD_MAX_PATH, "%s", gShaderReloader.precompileReadyPath);
+        FreePreparedGraph(&gShaderReloader.precompileReady);
+        gShaderReloader.hasPrecompileResult = false;
+    }
+    for (int i = 0; i < pathCount; i++) PushPrecompilePath(paths[i]);
+    if (pathCount > 0) pthread_cond_signal(&gShaderReloader.condition);
+    pthread_mutex_unlock(&gShaderReloader.mutex);
+}
+
+// Fonction pour vider le cache et la file (les shaders sont à remettre en file)
+void ClearPrecompiledShaders(void) {
+    if (!gShaderReloader.running) return;
+
+    if (gShaderReloader.isPrecompiling) DiscardPrecompilePrograms();
+    while (gShaderReloader.precompiledCount > 0) RemovePrecompiledShader(gShaderReloader.precompiledCount - 1, true);
+
+    pthread_mutex_lock(&gShaderReloader.mutex);
+    gShaderReloader.precompileGeneration++;
+    FreePreparedGraph(&gShaderReloader.precompileReady);
+    gShaderReloader.hasPrecompileResult = false;
+    ClearPrecompileQueue();
+    pthread_mutex_unlock(&gShaderReloader.mutex);
+}
+
+int GetPrecompiledShaderCount(void) {
+    return gShaderReloader.precompiledCount;
+}
+
+// Shaders encore en file ou en cours de compilation
+int GetPendingPrecompileCount(void) {
+    if (!gShaderReloader.running) return 0;
+    pthread_mutex_lock(&gShaderReloader.mutex);
+    int count = gShaderReloader.precompileQueueCount + (gShaderReloader.hasPrecompileResult ? 1 : 0);
+    pthread_mutex_unlock(&gShaderReloader.mutex);
+    return count + (gShaderReloader.isPrecompiling ? 1 : 0);
+}
+
+// Fonction pour demander la compilation d'une variante spécialisée du graphe actif
+void RequestShaderVariant(const char* fsFileName, const RenderGraphVariantKey* key) {
+    if (!gShaderReloader.running || gShaderReloader.vertexShader == 0) return;
+
+    // Une seule variante à la fois : la précédente est abandonnée
+    if (gShaderReloader.isBuildingVariant) DiscardVariantPrograms();
+
+    pthread_mutex_lock(&gShaderReloader.mutex);
+    gShaderReloader.variantGeneration++;
+    snprintf(gShaderReloader.variantRequestPath, sizeof(gShaderReloader.variantRequestPath), "%s", fsFileName);
+    gShaderReloader.variantRequestKey = *key;
+    gShaderReloader.hasVariantRequest = true;
+    FreePreparedGraph(&gShaderReloader.variantReady);
+    gShaderReloader.hasVariantResult = false;
+    pthread_cond_signal(&gShaderReloader.condition);
+    pthread_mutex_unlock(&gShaderReloader.mutex);
+
+    snprintf(gShaderReloader.variantPath, sizeof(gShaderReloader.variantPath), "%s", fsFileName);
+}
+
+// Fonction pour récupérer la variante préparée par le thread (false si aucune)
+static bool TakeVariantGraph(PreparedGraph* prepared, RenderGraphVariantKey* key, bool* success, char* errorMessage, size_t errorSize) {
+    bool ready = false;
+    pthread_mutex_lock(&gShaderReloader.mutex);
+    if (gShaderReloader.hasVariantResult) {
+        *prepared = gShaderReloader.variantReady;
+        *key = gShaderReloader.variantReadyKey;
+        *success = gShaderReloader.variantReadySuccess;
+        snprintf(errorMessage, errorSize, "%s", gShaderReloader.variantReadyError);
+        memset(&gShaderReloader.variantReady, 0, sizeof(gShaderReloader.variantReady));
+        gShaderReloader.hasVariantResult = false;
+        ready = true;
+    }
+    pthread_mutex_unlock(&gShaderReloader.mutex);
+    return ready;
+}
+
+// Fonction pour avancer la compilation de la variante et l'ajouter au graphe.
+// Une variante lue dans un autre source que celui du graphe (fichier modifié,
+// shader changé) est abandonnée.
+void UpdateShaderVariants(RenderGraph* graph) {
+    if (!gShaderReloader.running || gShaderReloader.vertexShader == 0) return;
+    if (gShaderReloader.stage != RELOAD_STAGE_IDLE) return; // Le rechargement passe d'abord
+
+    if (gShaderReloader.isBuildingVariant) {
+        PreparedGraph* prepared = &gShaderReloader.variantPending;
+        if (!IsGraphBuildComplete(prepared, gShaderReloader.variantPrograms, gShaderReloader.variantFragmentShaders)) return;
+
+        char error[256] = {0};
+        Shader shaders[MAX_RENDER_PROGRAMS] = {0};
+        bool success = FinishGraphBuild(prepared, gShaderReloader.variantPrograms, gShaderReloader.variantFragmentShaders,
+                                        gShaderReloader.variantPath, shaders, error, sizeof(error));
+        if (prepared->sourceHash == graph->sourceHash) {
+            AddRenderGraphVariant(graph, &gShaderReloader.variantKey, success ? shaders : NULL);
+            if (success) LOG_INFOF("Shader variant ready: %s", gShaderReloader.variantPath);
+        } else {
+            // La demande reste mémorisée : le graphe sera remplacé par le rechargement
+            for (int i = 0; success && i < prepared->desc.passCount; i++) UnloadShader(shaders[i]);
+        }
+        FreePreparedGraph(prepared);
+        gShaderReloader.isBuildingVariant = false;
+        return;
+    }
+
+    PreparedGraph prepared;
+    RenderGraphVariantKey key;
+    bool success = false;
+    char error[sizeof(gShaderReloader.variantReadyError)] = {0};
+    if (!TakeVariantGraph(&prepared, &key, &success, error, sizeof(error))) return;
+    if (!success) {
+        LOG_ERRORF("Shader variant failed: %s", error);
+        AddRenderGraphVariant(graph, &key, NULL); // Ne pas redemander ces valeurs
+        return;
+    }
+    gShaderReloader.variantPending = prepared;
+    gShaderReloader.variantKey = key;
+    StartGraphBuild(&gShaderReloader.variantPending, gShaderReloader.variantPrograms, gShaderReloader.variantFragmentShaders);
+    gShaderReloader.isBuildingVariant = true;
+}
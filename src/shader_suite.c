@@ -0,0 +1,425 @@
+#include "shader_suite.h"
+#include "raylib.h"
+#include "cpu_filter.h"
+#include "cpu_shader.h"
+#include "video_export.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SUITE_MAX_PATH 1024
+#define SUITE_MAX_SHADERS 32
+#define SUITE_MAX_CASES 8
+#define SUITE_MAX_TIMINGS (SUITE_MAX_SHADERS * SUITE_MAX_CASES)
+#define SUITE_MAX_RUNS 64
+#define SUITE_SHADER_DIR "shaders"
+#define SUITE_IMAGE "sample.png"
+#define SUITE_VIDEO "video_mini.mov"
+#define SUITE_VIDEO_FRAMES 3           // Frames de la vidéo gardées comme entrées
+#define SUITE_VIDEO_STEP 15            // Écart entre ces frames
+#define SUITE_RADIUS 80.0f
+#define SUITE_POWER 1.0f
+#define SUITE_TIMING_THREADS 1         // Threads des mesures si golden/vm_timings.txt n'en donne pas
+
+typedef struct {
+    const char* goldenDir;
+    bool isUpdate;
+    int runs;
+    float minPsnr;
+    int maxError;
+    float vmSlowdown;                  // 0 = temps de la VM ignorés
+    int threadCount;                   // Rendus des images (0 = un par cœur)
+} SuiteOptions;
+
+// Entrée fixe : une image et les uniforms du rendu
+typedef struct {
+    char name[64];
+    Image image;
+    EffectParams params;
+} SuiteCase;
+
+// Temps de référence d'un rendu par la VM (golden/vm_timings.txt)
+typedef struct {
+    char shader[128];
+    char caseName[64];
+    double ms;
+} SuiteTiming;
+
+// Les temps n'ont de sens qu'au nombre de threads où ils ont été enregistrés : les mesures
+// sont toujours faites à ce nombre, quel que soit --threads
+typedef struct {
+    SuiteTiming items[SUITE_MAX_TIMINGS];
+    int count;
+    int threadCount;
+} SuiteTimings;
+
+static double GetSuiteTime(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void PrintSuiteUsage(void) {
+    printf("Usage: main.exe --suite [--golden golden] [--update] [--runs 5] [--psnr 40] [--max-error 16]\n"
+           "                [--vm-slowdown 1.25] [--threads n]\n");
+}
+
+// Fonction pour lire les options (false si la ligne de commande est invalide)
+static bool ParseSuiteOptions(int argc, char** argv, SuiteOptions* options) {
+    memset(options, 0, sizeof(*options));
+    options->goldenDir = "golden";
+    options->runs = 5;
+    options->minPsnr = 40.0f;
+    options->maxError = 16;
+    options->vmSlowdown = 1.25f;
+
+    for (int i = 1; i < argc; i++) {
+        const char* name = argv[i];
+        if (strcmp(name, "--suite") == 0) continue;
+        if (strcmp(name, "--update") == 0) {
+            options->isUpdate = true;
+            continue;
+        }
+        if (strcmp(name, "--help") == 0) return false;
+        if (i + 1 >= argc) {
+            printf("ERROR: Missing value for %s\n", name);
+            return false;
+        }
+        const char* value = argv[++i];
+        char* end = NULL;
+
+        if (strcmp(name, "--golden") == 0) options->goldenDir = value;
+        else if (strcmp(name, "--runs") == 0) options->runs = (int)strtol(value, &end, 10);
+        else if (strcmp(name, "--psnr") == 0) options->minPsnr = strtof(value, &end);
+        else if (strcmp(name, "--max-error") == 0) options->maxError = (int)strtol(value, &end, 10);
+        else if (strcmp(name, "--vm-slowdown") == 0) options->vmSlowdown = strtof(value, &end);
+        else if (strcmp(name, "--threads") == 0) options->threadCount = (int)strtol(value, &end, 10);
+        else {
+            printf("ERROR: Unknown option %s\n", name);
+            return false;
+        }
+        if (end != NULL && (end == value || *end != '\0')) {
+            printf("ERROR: Invalid number '%s' for %s\n", value, name);
+            return false;
+        }
+    }
+
+    if (options->runs < 1 || options->runs > SUITE_MAX_RUNS) {
+        printf("ERROR: --runs must be between 1 and %d\n", SUITE_MAX_RUNS);
+        return false;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------------
+// Entrées
+//------------------------------------------------------------------------------------
+
+static void AddSuiteCase(SuiteCase* cases, int* count, const char* name, Image image, Vector2 mousePos, float time) {
+    SuiteCase* item = &cases[(*count)++];
+    snprintf(item->name, sizeof(item->name), "%s", name);
+    item->image = image;
+    item->params = (EffectParams){ .mousePos = mousePos, .radius = SUITE_RADIUS, .power = SUITE_POWER, .time = time };
+}
+
+// Frames 0, SUITE_VIDEO_STEP, 2*SUITE_VIDEO_STEP... (sans ffmpeg : aucune, avec un avertissement)
+static void LoadVideoCases(SuiteCase* cases, int* count) {
+    int width = 0, height = 0;
+    float fps = 30.0f;
+    YuvColorSpace colorSpace = { 0 };
+    FILE* decoder = NULL;
+    if (ProbeVideoFile(SUITE_VIDEO, &width, &height, &fps, &colorSpace)) decoder = OpenVideoDecoder(SUITE_VIDEO, colorSpace);
+    if (decoder == NULL) {
+        printf("WARNING: Cannot decode %s (ffmpeg missing?), video cases skipped\n", SUITE_VIDEO);
+        return;
+    }
+
+    size_t frameBytes = GetYuvFrameSize(width, height);
+    unsigned char* yuvFrame = (unsigned char*)malloc(frameBytes);
+    int kept = 0;
+    for (int frame = 0; yuvFrame != NULL && kept < SUITE_VIDEO_FRAMES; frame++) {
+        if (fread(yuvFrame, 1, frameBytes, decoder) != frameBytes) break;
+        if (frame % SUITE_VIDEO_STEP != 0) continue;
+
+        Image image = GenImageColor(width, height, BLANK);
+        YuvImage yuv = GetPackedYuvImage(yuvFrame, width, height, YUV_LAYOUT_I420);
+        ConvertYuvToRgba(&yuv, colorSpace, (unsigned char*)image.data);
+        char name[64];
+        snprintf(name, sizeof(name), "video_%03d", frame);
+        AddSuiteCase(cases, count, name, image, (Vector2){ width / 2.0f, height / 2.0f }, frame / fps);
+        kept++;
+    }
+    // Lire la fin du flux : fermer le tube plus tôt fait écrire une erreur à ffmpeg
+    while (yuvFrame != NULL && fread(yuvFrame, 1, frameBytes, decoder) == frameBytes) {}
+    free(yuvFrame);
+    pclose(decoder);
+}
+
+static int LoadSuiteCases(SuiteCase* cases) {
+    int count = 0;
+    Image sample = LoadImage(SUITE_IMAGE);
+    if (sample.data != NULL) {
+        ImageFormat(&sample, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        AddSuiteCase(cases, &count, "sample_center", sample, (Vector2){ sample.width / 2.0f, sample.height / 2.0f }, 0.0f);
+        // Cercle à cheval sur le bord : les voisins bouclent (GL_REPEAT)
+        AddSuiteCase(cases, &count, "sample_corner", ImageCopy(sample), (Vector2){ 10.0f, 10.0f }, 1.5f);
+    } else {
+        printf("ERROR: Failed to load %s\n", SUITE_IMAGE);
+    }
+    LoadVideoCases(cases, &count);
+    return count;
+}
+
+//------------------------------------------------------------------------------------
+// Références
+//------------------------------------------------------------------------------------
+
+static void LoadSuiteTimings(const char* path, SuiteTimings* timings) {
+    timings->count = 0;
+    timings->threadCount = SUITE_TIMING_THREADS;
+    FILE* file = fopen(path, "r");
+    if (file == NULL) return;
+    char line[512];
+    while (timings->count < SUITE_MAX_TIMINGS && fgets(line, sizeof(line), file) != NULL) {
+        SuiteTiming* timing = &timings->items[timings->count];
+        if (line[0] == '#') continue;
+        int threadCount = 0;
+        if (sscanf(line, "threads %d", &threadCount) == 1) {
+            if (threadCount > 0) timings->threadCount = threadCount;
+            continue;
+        }
+        if (sscanf(line, "%127s %63s %lf", timing->shader, timing->caseName, &timing->ms) == 3) timings->count++;
+    }
+    fclose(file);
+}
+
+static bool SaveSuiteTimings(const char* path, const SuiteTimings* timings) {
+    FILE* file = fopen(path, "w");
+    if (file == NULL) return false;
+    fprintf(file, "# shader cas ms (médiane du rendu par cpu_shader, pas un temps GPU)\n");
+    fprintf(file, "threads %d\n", timings->threadCount);
+    for (int i = 0; i < timings->count; i++) {
+        fprintf(file, "%s %s %.3f\n", timings->items[i].shader, timings->items[i].caseName, timings->items[i].ms);
+    }
+    fclose(file);
+    return true;
+}
+
+// Temps de référence, -1 sans référence
+static double FindSuiteTiming(const SuiteTimings* timings, const char* shader, const char* caseName) {
+    for (int i = 0; i < timings->count; i++) {
+        if (strcmp(timings->items[i].shader, shader) == 0 && strcmp(timings->items[i].caseName, caseName) == 0) {
+            return timings->items[i].ms;
+        }
+    }
+    return -1.0;
+}
+
+static void SetSuiteTiming(SuiteTimings* timings, const char* shader, const char* caseName, double ms) {
+    for (int i = 0; i < timings->count; i++) {
+        if (strcmp(timings->items[i].shader, shader) == 0 && strcmp(timings->items[i].caseName, caseName) == 0) {
+            timings->items[i].ms = ms;
+            return;
+        }
+    }
+    if (timings->count == SUITE_MAX_TIMINGS) return;
+    SuiteTiming* timing = &timings->items[timings->count++];
+    snprintf(timing->shader, sizeof(timing->shader), "%.127s", shader);
+    snprintf(timing->caseName, sizeof(timing->caseName), "%.63s", caseName);
+    timing->ms = ms;
+}
+
+// PSNR sur les 4 canaux (INFINITY si identiques) et plus grand écart sur un canal
+static void CompareSuiteImages(Image actual, Image golden, double* psnr, int* maxError) {
+    const unsigned char* a = (const unsigned char*)actual.data;
+    const unsigned char* b = (const unsigned char*)golden.data;
+    size_t size = (size_t)actual.width * actual.height * 4;
+    double sum = 0.0;
+    int worst = 0;
+    for (size_t i = 0; i < size; i++) {
+        int diff = abs((int)a[i] - (int)b[i]);
+        sum += (double)diff * diff;
+        if (diff > worst) worst = diff;
+    }
+    double mse = sum / (double)size;
+    *psnr = mse > 0.0 ? 10.0 * log10(255.0 * 255.0 / mse) : INFINITY;
+    *maxError = worst;
+}
+
+static int CompareDoubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static int ComparePaths(const void* a, const void* b) {
+    return strcmp((const char*)a, (const char*)b);
+}
+
+// Médiane de runs rendus au nombre de threads des références, puis retour à threadCount.
+// Faux si un rendu échoue.
+static bool TimeShaderCase(const CpuShaderGraph* graph, const SuiteCase* item, Image* output, const SuiteOptions* options,
+                           int timingThreads, double* ms) {
+    double runs[SUITE_MAX_RUNS];
+    bool isRendered = true;
+    SetCpuFilterThreadCount(timingThreads);
+    for (int r = 0; isRendered && r < options->runs; r++) {
+        double start = GetSuiteTime();
+        isRendered = RenderCpuShaderGraph(graph, item->image, output, &item->params);
+        runs[r] = (GetSuiteTime() - start) * 1000.0;
+    }
+    SetCpuFilterThreadCount(options->threadCount);
+    if (!isRendered) return false;
+    qsort(runs, options->runs, sizeof(double), CompareDoubles);
+    *ms = runs[options->runs / 2];
+    return true;
+}
+
+//------------------------------------------------------------------------------------
+// Suite
+//------------------------------------------------------------------------------------
+
+// Fonction pour tester un shader sur toutes les entrées. Retourne le nombre d'échecs.
+static int RunShaderCases(const char* shaderPath, const SuiteCase* cases, int caseCount, const SuiteOptions* options,
+                          SuiteTimings* timings) {
+    const char* shaderName = GetFileName(shaderPath);
+    char shaderKey[128];
+    const char* dot = strrchr(shaderName, '.');
+    snprintf(shaderKey, sizeof(shaderKey), "%.*s", dot ? (int)(dot - shaderName) : (int)strlen(shaderName), shaderName);
+
+    CpuShaderGraph graph;
+    char error[256] = {0};
+    if (!LoadCpuShaderGraph(shaderPath, &graph, error, sizeof(error))) {
+        printf("FAIL  %-16s compile: %s\n", shaderName, error);
+        return 1;
+    }
+
+    char dir[SUITE_MAX_PATH];
+    snprintf(dir, sizeof(dir), "%s/%s", options->goldenDir, shaderKey);
+    if (options->isUpdate && !DirectoryExists(dir) && MakeDirectory(dir) != 0) {
+        printf("ERROR: Failed to create '%s'\n", dir);
+        UnloadCpuShaderGraph(&graph);
+        return 1;
+    }
+
+    int failures = 0;
+    for (int c = 0; c < caseCount; c++) {
+        const SuiteCase* item = &cases[c];
+        Image output = ImageCopy(item->image);
+        bool isRendered = output.data != NULL && RenderCpuShaderGraph(&graph, item->image, &output, &item->params);
+        bool isTimed = options->isUpdate || options->vmSlowdown > 0.0f;
+        double ms = 0.0;
+        if (isRendered && isTimed) isRendered = TimeShaderCase(&graph, item, &output, options, timings->threadCount, &ms);
+        if (!isRendered) {
+            printf("FAIL  %-16s %-14s render failed\n", shaderName, item->name);
+            failures++;
+            if (output.data != NULL) UnloadImage(output);
+            continue;
+        }
+
+        char goldenPath[SUITE_MAX_PATH * 2], actualPath[SUITE_MAX_PATH * 2];
+        snprintf(goldenPath, sizeof(goldenPath), "%s/%s.png", dir, item->name);
+        snprintf(actualPath, sizeof(actualPath), "%s/%s.actual.png", dir, item->name);
+
+        if (options->isUpdate) {
+            bool isSaved = ExportImage(output, goldenPath);
+            if (isSaved) SetSuiteTiming(timings, shaderKey, item->name, ms);
+            else failures++;
+            printf("%s %-16s %-14s vm %8.2f ms\n", isSaved ? "SAVE " : "FAIL ", shaderName, item->name, ms);
+            UnloadImage(output);
+            continue;
+        }
+
+        Image golden = FileExists(goldenPath) ? LoadImage(goldenPath) : (Image){0};
+        if (golden.data != NULL) ImageFormat(&golden, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        if (golden.data == NULL || golden.width != output.width || golden.height != output.height) {
+            printf("FAIL  %-16s %-14s %s (run with --update)\n", shaderName, item->name,
+                   golden.data == NULL ? "no golden image" : "golden image size differs");
+            ExportImage(output, actualPath);
+            failures++;
+            if (golden.data != NULL) UnloadImage(golden);
+            UnloadImage(output);
+            continue;
+        }
+
+        double psnr = 0.0;
+        int maxError = 0;
+        CompareSuiteImages(output, golden, &psnr, &maxError);
+        bool isImageOk = psnr >= options->minPsnr && maxError <= options->maxError;
+        double reference = FindSuiteTiming(timings, shaderKey, item->name);
+        bool isSlower = options->vmSlowdown > 0.0f && reference > 0.0 && ms > reference * options->vmSlowdown;
+
+        char quality[32], timing[64];
+        if (isinf(psnr)) snprintf(quality, sizeof(quality), "psnr    inf");
+        else snprintf(quality, sizeof(quality), "psnr %6.2f dB", psnr);
+        if (!isTimed) snprintf(timing, sizeof(timing), "vm not timed");
+        else if (reference > 0.0) snprintf(timing, sizeof(timing), "vm %8.2f ms (ref %.2f, %+.0f%%)", ms, reference, (ms / reference - 1.0) * 100.0);
+        else snprintf(timing, sizeof(timing), "vm %8.2f ms (no ref)", ms);
+        printf("%s %-16s %-14s %-13s  max %3d  %s\n", !isImageOk ? "FAIL " : (isSlower ? "ALERT" : "OK   "),
+               shaderName, item->name, quality, maxError, timing);
+
+        if (!isImageOk) ExportImage(output, actualPath);
+        if (!isImageOk || isSlower) failures++;
+        UnloadImage(golden);
+        UnloadImage(output);
+    }
+
+    UnloadCpuShaderGraph(&graph);
+    return failures;
+}
+
+bool IsShaderSuiteCommandLine(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--suite") == 0) return true;
+    }
+    return false;
+}
+
+int RunShaderSuite(int argc, char** argv) {
+    SuiteOptions options;
+    if (!ParseSuiteOptions(argc, argv, &options)) {
+        PrintSuiteUsage();
+        return 1;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+    if (options.threadCount > 0) SetCpuFilterThreadCount(options.threadCount);
+    if (options.isUpdate && !DirectoryExists(options.goldenDir) && MakeDirectory(options.goldenDir) != 0) {
+        printf("ERROR: Failed to create '%s'\n", options.goldenDir);
+        return 1;
+    }
+
+    SuiteCase cases[SUITE_MAX_CASES];
+    int caseCount = LoadSuiteCases(cases);
+    char timingsPath[SUITE_MAX_PATH];
+    snprintf(timingsPath, sizeof(timingsPath), "%s/vm_timings.txt", options.goldenDir);
+    SuiteTimings timings;
+    LoadSuiteTimings(timingsPath, &timings);
+
+    // Shaders triés par nom : même ordre de sortie partout
+    FilePathList files = LoadDirectoryFilesEx(SUITE_SHADER_DIR, ".glsl", false);
+    char shaders[SUITE_MAX_SHADERS][SUITE_MAX_PATH];
+    int shaderCount = 0;
+    for (unsigned int i = 0; i < files.count && shaderCount < SUITE_MAX_SHADERS; i++) {
+        if (IsPathFile(files.paths[i])) snprintf(shaders[shaderCount++], SUITE_MAX_PATH, "%s", files.paths[i]);
+    }
+    UnloadDirectoryFiles(files);
+    qsort(shaders, shaderCount, SUITE_MAX_PATH, ComparePaths);
+
+    printf("Suite: %d shaders x %d inputs, %s (%d threads), %d timed runs each on %d thread%s\n", shaderCount, caseCount,
+           options.isUpdate ? "updating golden images" : "comparing with golden images", GetCpuFilterThreadCount(),
+           options.runs, timings.threadCount, timings.threadCount == 1 ? "" : "s");
+    int failures = caseCount == 0 || shaderCount == 0 ? 1 : 0;
+    double start = GetSuiteTime();
+    for (int i = 0; i < shaderCount; i++) failures += RunShaderCases(shaders[i], cases, caseCount, &options, &timings);
+
+    if (options.isUpdate && !SaveSuiteTimings(timingsPath, &timings)) {
+        printf("ERROR: Failed to write '%s'\n", timingsPath);
+        failures++;
+    }
+    printf("%s: %d failure%s in %.1f s\n", failures == 0 ? "PASSED" : "FAILED", failures, failures == 1 ? "" : "s",
+           GetSuiteTime() - start);
+
+    for (int i = 0; i < caseCount; i++) UnloadImage(cases[i].image);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+#include "shader_uniforms.h"
+#include "gl_ext.h"
+#include "logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Types GLSL retournés par glGetActiveUniform
+#define GL_INT          0x1404
+#define GL_FLOAT        0x1406
+#define GL_FLOAT_VEC2   0x8B50
+#define GL_FLOAT_VEC3   0x8B51
+#define GL_FLOAT_VEC4   0x8B52
+#define GL_INT_VEC2     0x8B53
+#define GL_INT_VEC3     0x8B54
+#define GL_INT_VEC4     0x8B55
+#define GL_BOOL         0x8B56
+#define GL_SAMPLER_2D   0x8B5E
+
+// Fonction pour convertir un type GL en type raylib (et sa taille en octets)
+static int GetUniformTypeFromGL(GLenum glType, int* elementSize) {
+    switch (glType) {
+        case GL_FLOAT:      *elementSize = 1 * sizeof(float); return SHADER_UNIFORM_FLOAT;
+        case GL_FLOAT_VEC2: *elementSize = 2 * sizeof(float); return SHADER_UNIFORM_VEC2;
+        case GL_FLOAT_VEC3: *elementSize = 3 * sizeof(float); return SHADER_UNIFORM_VEC3;
+        case GL_FLOAT_VEC4: *elementSize = 4 * sizeof(float); return SHADER_UNIFORM_VEC4;
+        case GL_INT:
+        case GL_BOOL:       *elementSize = 1 * sizeof(int); return SHADER_UNIFORM_INT;
+        case GL_INT_VEC2:   *elementSize = 2 * sizeof(int); return SHADER_UNIFORM_IVEC2;
+        case GL_INT_VEC3:   *elementSize = 3 * sizeof(int); return SHADER_UNIFORM_IVEC3;
+        case GL_INT_VEC4:   *elementSize = 4 * sizeof(int); return SHADER_UNIFORM_IVEC4;
+        case GL_SAMPLER_2D: *elementSize = 1 * sizeof(int); return SHADER_UNIFORM_SAMPLER2D;
+        default:            *elementSize = 0; return -1;
+    }
+}
+
+// Fonction pour construire la table des uniforms d'un programme
+void BuildShaderUniformTable(ShaderUniformTable* table, Shader shader) {
+    FreeShaderUniformTable(table);
+    table->programId = shader.id;
+    if (shader.id == 0 || !IsGLExtensionsReady()) return;
+
+    GLint activeCount = 0;
+    gGL.GetProgramiv(shader.id, GL_ACTIVE_UNIFORMS, &activeCount);
+    if (activeCount <= 0) return;
+
+    table->uniforms = (ShaderUniform*)calloc(activeCount, sizeof(ShaderUniform));
+    if (table->uniforms == NULL) return;
+
+    int totalValueSize = 0;
+    for (GLint i = 0; i < activeCount; i++) {
+        ShaderUniform* uniform = &table->uniforms[table->count];
+        GLint size = 0;
+        GLenum glType = 0;
+        gGL.GetActiveUniform(shader.id, (GLuint)i, sizeof(uniform->name), NULL, &size, &glType, uniform->name);
+
+        // Les uniforms des blocs n'ont pas d'emplacement
+        uniform->location = GetShaderLocation(shader, uniform->name);
+        if (uniform->location < 0) continue;
+
+        // "tableau[0]" -> "tableau"
+        char* bracket = strchr(uniform->name, '[');
+        if (bracket) *bracket = '\0';
+
+        int elementSize = 0;
+        uniform->type = GetUniformTypeFromGL(glType, &elementSize);
+        uniform->count = size > 0 ? size : 1;
+        uniform->valueSize = elementSize * uniform->count;
+        totalValueSize += uniform->valueSize;
+        table->count++;
+    }
+
+    // Un seul bloc pour toutes les dernières valeurs
+    if (totalValueSize > 0) table->values = (unsigned char*)calloc(totalValueSize, 1);
+    int offset = 0;
+    for (int i = 0; i < table->count; i++) {
+        ShaderUniform* uniform = &table->uniforms[i];
+        uniform->value = (table->values && uniform->valueSize > 0) ? table->values + offset : NULL;
+        offset += uniform->valueSize;
+    }
+
+    LOG_DEBUGF("Shader uniform table built: %d active uniforms", table->count);
+}
+
+// Fonction pour libérer la table des uniforms
+void FreeShaderUniformTable(ShaderUniformTable* table) {
+    free(table->uniforms);
+    free(table->values);
+    memset(table, 0, sizeof(*table));
+}
+
+int FindShaderUniform(const ShaderUniformTable* table, const char* name) {
+    for (int i = 0; i < table->count; i++) {
+        if (strcmp(table->uniforms[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+// Fonction pour envoyer un uniform seulement s'il a changé
+bool SetShaderUniform(ShaderUniformTable* table, int index, const void* value) {
+    if (index < 0 || index >= table->count) return false;
+    ShaderUniform* uniform = &table->uniforms[index];
+    if (uniform->type < 0 || uniform->value == NULL) return false;
+
+    if (uniform->hasValue && memcmp(uniform->value, value, uniform->valueSize) == 0) {
+        table->skippedCount++;
+        return false;
+    }
+
+    memcpy(uniform->value, value, uniform->valueSize);
+    uniform->hasValue = true;
+    table->uploadCount++;
+
+    Shader shader = {0};
+    shader.id = table->programId;
+    SetShaderValueV(shader, uniform->location, value, uniform->type, uniform->count);
+    return true;
+}
+
+void InvalidateShaderUniforms(ShaderUniformTable* table) {
+    for (int i = 0; i < table->count; i++) table->uniforms[i].hasValue = false;
+}
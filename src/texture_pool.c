@@ -0,0 +1,234 @@
+#include "texture_pool.h"
+#include "memory_budget.h"
+#include "logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TEXTURE_POOL_INITIAL_SLOTS 256
+#define MAX_RESERVE_TEXTURES 16
+
+// Slot de la table de handles
+typedef struct {
+    Texture2D texture;
+    int refCount;
+    unsigned int generation;
+    int nextFree;       // Chaînage des slots libres (-1 en fin de liste)
+} TextureSlot;
+
+// Structure globale de la table de textures
+typedef struct {
+    TextureSlot* slots;
+    int slotCount;
+    int capacity;
+    int firstFree;
+    int liveCount;
+    // Textures libérées, gardées pour être réutilisées (comptées dans les caches)
+    Texture2D reserve[MAX_RESERVE_TEXTURES];
+    int reserveCount;
+} TexturePool;
+
+static TexturePool gTexturePool = {0};
+
+static size_t GetTextureBytes(Texture2D texture) {
+    return GetPixelDataSize(texture.width, texture.height, texture.format);
+}
+
+// Décharge la plus ancienne texture de la réserve
+static size_t DropOldestReserveTexture(void) {
+    if (gTexturePool.reserveCount == 0) return 0;
+    Texture2D texture = gTexturePool.reserve[0];
+    for (int i = 1; i < gTexturePool.reserveCount; i++) {
+        gTexturePool.reserve[i - 1] = gTexturePool.reserve[i];
+    }
+    gTexturePool.reserveCount--;
+
+    size_t bytes = GetTextureBytes(texture);
+    MemoryBudgetRelease(MEM_SUBSYS_CACHES, MEM_POOL_VRAM, bytes);
+    UnloadTexture(texture);
+    return bytes;
+}
+
+// Évicteur VRAM : vide la réserve sous pression
+static size_t EvictReserveTextures(MemPool pool, size_t bytesNeeded, void* userData) {
+    (void)userData;
+    if (pool != MEM_POOL_VRAM) return 0;
+    size_t freed = 0;
+    while (freed < bytesNeeded && gTexturePool.reserveCount > 0) {
+        freed += DropOldestReserveTexture();
+    }
+    return freed;
+}
+
+// Fonction pour initialiser la table de textures
+void InitTexturePool(void) {
+    gTexturePool.capacity = TEXTURE_POOL_INITIAL_SLOTS;
+    gTexturePool.slots = (TextureSlot*)calloc(gTexturePool.capacity, sizeof(TextureSlot));
+    // Le slot 0 est réservé pour que TEXTURE_HANDLE_NULL ne soit jamais valide
+    gTexturePool.slotCount = 1;
+    gTexturePool.firstFree = -1;
+    gTexturePool.liveCount = 0;
+    gTexturePool.reserveCount = 0;
+    RegisterMemoryEvictor(MEM_SUBSYS_CACHES, EvictReserveTextures, NULL);
+    LOG_INFOF("Texture pool initialized");
+}
+
+// Fonction pour décharger toutes les textures de la table
+void CloseTexturePool(void) {
+    for (int i = 1; i < gTexturePool.slotCount; i++) {
+        TextureSlot* slot = &gTexturePool.slots[i];
+        if (slot->refCount > 0) {
+            LOG_WARNINGF("texture %u still referenced (%d) at shutdown", slot->texture.id, slot->refCount);
+            MemoryBudgetRelease(MEM_SUBSYS_TEXTURES, MEM_POOL_VRAM, GetTextureBytes(slot->texture));
+            UnloadTexture(slot->texture);
+        }
+    }
+    while (gTexturePool.reserveCount > 0) {
+        DropOldestReserveTexture();
+    }
+    UnregisterMemoryEvictor(MEM_SUBSYS_CACHES, EvictReserveTextures);
+    free(gTexturePool.slots);
+    gTexturePool = (TexturePool){0};
+}
+
+// Cherche dans la réserve une texture de mêmes dimensions et format
+static bool TakeReserveTexture(Image image, Texture2D* texture) {
+    for (int i = gTexturePool.reserveCount - 1; i >= 0; i--) {
+        Texture2D candidate = gTexturePool.reserve[i];
+        if (candidate.width == image.width && candidate.height == image.height &&
+            candidate.format == image.format && candidate.mipmaps == image.mipmaps) {
+            gTexturePool.reserve[i] = gTexturePool.reserve[--gTexturePool.reserveCount];
+            *texture = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+static int AllocateSlot(void) {
+    if (gTexturePool.firstFree >= 0) {
+        int index = gTexturePool.firstFree;
+        gTexturePool.firstFree = gTexturePool.slots[index].nextFree;
+        return index;
+    }
+    if (gTexturePool.slotCount >= gTexturePool.capacity) {
+        int newCapacity = gTexturePool.capacity * 2;
+        TextureSlot* newSlots = (TextureSlot*)realloc(gTexturePool.slots, newCapacity * sizeof(TextureSlot));
+        if (newSlots == NULL) return -1;
+        gTexturePool.slots = newSlots;
+        gTexturePool.capacity = newCapacity;
+    }
+    int index = gTexturePool.slotCount++;
+    gTexturePool.slots[index] = (TextureSlot){0};
+    return index;
+}
+
+// Fonction pour créer une texture référencée depuis une image
+TextureHandle AcquireTextureFromImage(Image image) {
+    if (image.data == NULL || gTexturePool.slots == NULL) return TEXTURE_HANDLE_NULL;
+
+    size_t bytes = GetPixelDataSize(image.width, image.height, image.format);
+    Texture2D texture = {0};
+
+    bool isReused = TakeReserveTexture(image, &texture);
+    if (isReused) {
+        // Réutiliser la texture : elle passe des caches aux textures vivantes
+        MemoryBudgetRelease(MEM_SUBSYS_CACHES, MEM_POOL_VRAM, bytes);
+        if (MemoryBudgetTryReserveOptional(MEM_SUBSYS_TEXTURES, MEM_POOL_VRAM, bytes)) {
+            UpdateTexture(texture, image.data);
+        } else {
+            // Budget des textures plein : libérer la texture et passer par la création,
+            // qui peut évincer d'autres sous-systèmes
+            UnloadTexture(texture);
+            isReused = false;
+        }
+    }
+    if (!isReused) {
+        if (!MemoryBudgetReserve(MEM_SUBSYS_TEXTURES, MEM_POOL_VRAM, bytes)) {
+            return TEXTURE_HANDLE_NULL;
+        }
+        texture = LoadTextureFromImage(image);
+        if (texture.id == 0) {
+            MemoryBudgetRelease(MEM_SUBSYS_TEXTURES, MEM_POOL_VRAM, bytes);
+            return TEXTURE_HANDLE_NULL;
+        }
+    }
+
+    int index = AllocateSlot();
+    if (index < 0) {
+        MemoryBudgetRelease(MEM_SUBSYS_TEXTURES, MEM_POOL_VRAM, bytes);
+        UnloadTexture(texture);
+        return TEXTURE_HANDLE_NULL;
+    }
+
+    TextureSlot* slot = &gTexturePool.slots[index];
+    slot->texture = texture;
+    slot->refCount = 1;
+    slot->nextFree = -1;
+    gTexturePool.liveCount++;
+    return (TextureHandle){ (unsigned int)index, slot->generation };
+}
+
+static TextureSlot* GetLiveSlot(TextureHandle handle) {
+    if (handle.index == 0 || handle.index >= (unsigned int)gTexturePool.slotCount) return NULL;
+    TextureSlot* slot = &gTexturePool.slots[handle.index];
+    if (slot->generation != handle.generation || slot->refCount <= 0) return NULL;
+    return slot;
+}
+
+TextureHandle RetainTexture(TextureHandle handle) {
+    TextureSlot* slot = GetLiveSlot(handle);
+    if (slot == NULL) return TEXTURE_HANDLE_NULL;
+    slot->refCount++;
+    return handle;
+}
+
+// Fonction pour libérer une référence : à zéro, la texture va dans la réserve
+void ReleaseTexture(TextureHandle* handle) {
+    TextureSlot* slot = GetLiveSlot(*handle);
+    *handle = TEXTURE_HANDLE_NULL;
+    if (slot == NULL) return;
+
+    slot->refCount--;
+    if (slot->refCount > 0) return;
+
+    // Le slot est recyclé : les handles existants deviennent périmés
+    Texture2D texture = slot->texture;
+    size_t bytes = GetTextureBytes(texture);
+    slot->texture = (Texture2D){0};
+    slot->generation++;
+    slot->nextFree = gTexturePool.firstFree;
+    gTexturePool.firstFree = (int)(slot - gTexturePool.slots);
+    gTexturePool.liveCount--;
+
+    MemoryBudgetRelease(MEM_SUBSYS_TEXTURES, MEM_POOL_VRAM, bytes);
+    if (gTexturePool.reserveCount >= MAX_RESERVE_TEXTURES) {
+        DropOldestReserveTexture();
+    }
+    if (MemoryBudgetTryReserveOptional(MEM_SUBSYS_CACHES, MEM_POOL_VRAM, bytes)) {
+        gTexturePool.reserve[gTexturePool.reserveCount++] = texture;
+    } else {
+        UnloadTexture(texture);
+    }
+}
+
+bool IsTextureHandleValid(TextureHandle handle) {
+    return GetLiveSlot(handle) != NULL;
+}
+
+Texture2D* ResolveTexture(TextureHandle handle) {
+    TextureSlot* slot = GetLiveSlot(handle);
+    return slot != NULL ? &slot->texture : NULL;
+}
+
+int GetTextureRefCount(TextureHandle handle) {
+    TextureSlot* slot = GetLiveSlot(handle);
+    return slot != NULL ? slot->refCount : 0;
+}
+
+int GetTexturePoolLiveCount(void) {
+    return gTexturePool.liveCount;
+}
+
+int GetTexturePoolReserveCount(void) {
+    return gTexturePool.reserveCount;
+}
@@ -0,0 +1,539 @@
+#include "video_export.h"
+#include "raylib.h"
+#include "gl_ext.h"
+#include "memory_budget.h"
+#include "logger.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define VIDEO_EXPORT_PATH_SIZE 512
+
+// File de frames de taille fixe entre un producteur et un consommateur. Le producteur
+// écrit dans l'emplacement libre puis le valide ; le consommateur lit le plus ancien
+// puis le rend. Une file fermée n'accepte plus de frames et réveille les attentes.
+typedef struct {
+    unsigned char* slots[VIDEO_EXPORT_DECODE_FRAMES > VIDEO_EXPORT_ENCODE_FRAMES ? VIDEO_EXPORT_DECODE_FRAMES : VIDEO_EXPORT_ENCODE_FRAMES];
+    int capacity;
+    int head;
+    int count;
+    bool isClosed;
+    pthread_mutex_t mutex;
+    pthread_cond_t changed;
+} FrameQueue;
+
+// Lecture d'une frame rendue : PBO + fence, ou copie synchrone sans PBO
+typedef struct {
+    GLuint buffer;
+    GLsync fence;
+    unsigned char* pixels;        // Sans PBO
+} Readback;
+
+// Structure globale de l'export en cours
+typedef struct {
+    VideoExportState state;
+    char outputPath[VIDEO_EXPORT_PATH_SIZE];
+    char errorMessage[256];
+    int width;
+    int height;
+    float fps;
+    YuvColorSpace colorSpace;
+    size_t frameBytes;
+    size_t yuvBytes;
+    unsigned char* yuvFrame;      // Frame lue dans le pipe, avant conversion
+    int frameCount;
+    EffectParams params;
+    bool isAsync;                 // Lecture par PBO
+
+    FILE* decoder;
+    FILE* encoder;
+    pthread_t decodeThread;
+    pthread_t encodeThread;
+    bool hasDecodeThread;
+    bool hasEncodeThread;
+    FrameQueue decoded;
+    FrameQueue encoded;
+    atomic_bool isCancelled;
+    atomic_bool isEncoderFailed;
+    atomic_bool isEncoderDone;
+    atomic_int encodedFrames;
+    int encoderStatus;            // Code de sortie de ffmpeg, écrit avant isEncoderDone
+
+    Texture2D sourceTexture;
+    RenderTexture2D target;
+    Readback readbacks[VIDEO_EXPORT_READBACKS];
+    int readbackHead;             // Plus ancienne lecture en vol
+    int readbackCount;
+    int renderedFrames;
+    RenderGraph* graph;           // Passé en qualité complète pendant l'export
+    int displayQuality;           // Niveau de l'affichage, rétabli à la fin
+
+    size_t ramReserved;
+    size_t vramReserved;
+    double startTime;
+    double endTime;
+} VideoExport;
+
+static VideoExport gVideoExport = {0};
+
+static bool InitFrameQueue(FrameQueue* queue, int capacity, size_t frameBytes) {
+    memset(queue, 0, sizeof(*queue));
+    queue->capacity = capacity;
+    pthread_mutex_init(&queue->mutex, NULL);
+    pthread_cond_init(&queue->changed, NULL);
+    for (int i = 0; i < capacity; i++) {
+        queue->slots[i] = (unsigned char*)malloc(frameBytes);
+        if (queue->slots[i] == NULL) return false;
+    }
+    return true;
+}
+
+static void FreeFrameQueue(FrameQueue* queue) {
+    if (queue->capacity == 0) return;
+    for (int i = 0; i < queue->capacity; i++) free(queue->slots[i]);
+    pthread_mutex_destroy(&queue->mutex);
+    pthread_cond_destroy(&queue->changed);
+    memset(queue, 0, sizeof(*queue));
+}
+
+static void CloseFrameQueue(FrameQueue* queue) {
+    if (queue->capacity == 0) return;
+    pthread_mutex_lock(&queue->mutex);
+    queue->isClosed = true;
+    pthread_cond_broadcast(&queue->changed);
+    pthread_mutex_unlock(&queue->mutex);
+}
+
+// Emplacement à remplir, NULL si la file est pleine (sans attente) ou fermée
+static unsigned char* GetFreeFrame(FrameQueue* queue, bool wait) {
+    pthread_mutex_lock(&queue->mutex);
+    while (wait && !queue->isClosed && queue->count == queue->capacity) {
+        pthread_cond_wait(&queue->changed, &queue->mutex);
+    }
+    unsigned char* slot = NULL;
+    if (!queue->isClosed && queue->count < queue->capacity) {
+        slot = queue->slots[(queue->head + queue->count) % queue->capacity];
+    }
+    pthread_mutex_unlock(&queue->mutex);
+    return slot;
+}
+
+static void PushFrame(FrameQueue* queue) {
+    pthread_mutex_lock(&queue->mutex);
+    queue->count++;
+    pthread_cond_broadcast(&queue->changed);
+    pthread_mutex_unlock(&queue->mutex);
+}
+
+// Plus ancienne frame remplie, NULL si la file est vide (sans attente) ou fermée et vide
+static unsigned char* GetFilledFrame(FrameQueue* queue, bool wait, bool* isFinished) {
+    pthread_mutex_lock(&queue->mutex);
+    while (wait && !queue->isClosed && queue->count == 0) {
+        pthread_cond_wait(&queue->changed, &queue->mutex);
+    }
+    unsigned char* slot = queue->count > 0 ? queue->slots[queue->head] : NULL;
+    if (isFinished) *isFinished = queue->isClosed && queue->count == 0;
+    pthread_mutex_unlock(&queue->mutex);
+    return slot;
+}
+
+static void PopFrame(FrameQueue* queue) {
+    pthread_mutex_lock(&queue->mutex);
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->count--;
+    pthread_cond_broadcast(&queue->changed);
+    pthread_mutex_unlock(&queue->mutex);
+}
+
+// Une ligne "clé=valeur" par champ, dans l'ordre choisi par ffprobe
+bool ProbeVideoFile(const char* path, int* width, int* height, float* fps, YuvColorSpace* colorSpace) {
+    char command[VIDEO_EXPORT_PATH_SIZE + 256];
+    snprintf(command, sizeof(command),
+             "ffprobe -v error -select_streams v:0 -show_entries stream=width,height,r_frame_rate,pix_fmt,color_space,color_range "
+             "-of default=noprint_wrappers=1 \"%s\"", path);
+    FILE* probe = popen(command, "r");
+    if (probe == NULL) return false;
+
+    float num = 0.0f, den = 1.0f;
+    char matrix[64] = "", range[64] = "", pixelFormat[64] = "";
+    *width = *height = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), probe) != NULL) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (sscanf(line, "width=%d", width) == 1 || sscanf(line, "height=%d", height) == 1) continue;
+        if (sscanf(line, "r_frame_rate=%f/%f", &num, &den) >= 1) continue;
+        if (sscanf(line, "pix_fmt=%63s", pixelFormat) == 1) continue;
+        if (sscanf(line, "color_space=%63s", matrix) == 1) continue;
+        sscanf(line, "color_range=%63s", range);
+    }
+    pclose(probe);
+
+    *fps = den > 0.0f && num > 0.0f ? num / den : 30.0f;
+    if (strcmp(matrix, "bt709") == 0) colorSpace->matrix = YUV_MATRIX_BT709;
+    else if (strcmp(matrix, "bt470bg") == 0 || strcmp(matrix, "smpte170m") == 0) colorSpace->matrix = YUV_MATRIX_BT601;
+    else colorSpace->matrix = *height >= 720 ? YUV_MATRIX_BT709 : YUV_MATRIX_BT601;
+    bool isFullRange = strcmp(range, "pc") == 0 || strncmp(pixelFormat, "yuvj", 4) == 0;
+    colorSpace->range = isFullRange ? YUV_RANGE_FULL : YUV_RANGE_LIMITED;
+    return *width > 0 && *height > 0;
+}
+
+// La plage est fixée explicitement : sans cela, ffmpeg peut ramener une source yuvj en
+// plage limitée en la convertissant en yuv420p
+FILE* OpenVideoDecoder(const char* path, YuvColorSpace colorSpace) {
+    char command[VIDEO_EXPORT_PATH_SIZE + 256];
+    snprintf(command, sizeof(command), "ffmpeg -v error -i \"%s\" -vf scale=out_range=%s -f rawvideo -pix_fmt yuv420p -",
+             path, colorSpace.range == YUV_RANGE_FULL ? "pc" : "tv");
+    #ifdef _WIN32
+    return popen(command, "rb");
+    #else
+    return popen(command, "r");
+    #endif
+}
+
+FILE* OpenVideoEncoder(const char* path, int width, int height, float fps) {
+    char command[VIDEO_EXPORT_PATH_SIZE + 256];
+    snprintf(command, sizeof(command), "ffmpeg -v error -y -f rawvideo -pix_fmt rgba -s %dx%d -r %.6g -i - -pix_fmt yuv420p \"%s\"",
+             width, height, fps, path);
+    #ifdef _WIN32
+    return popen(command, "wb");
+    #else
+    return popen(command, "w");
+    #endif
+}
+
+static void* DecodeVideoFrames(void* arg) {
+    (void)arg;
+    VideoExport* exp = &gVideoExport;
+    unsigned char* frame;
+    YuvImage image = GetPackedYuvImage(exp->yuvFrame, exp->width, exp->height, YUV_LAYOUT_I420);
+    while (!atomic_load(&exp->isCancelled) && (frame = GetFreeFrame(&exp->decoded, true)) != NULL) {
+        if (fread(exp->yuvFrame, 1, exp->yuvBytes, exp->decoder) != exp->yuvBytes) break;
+        ConvertYuvToRgba(&image, exp->colorSpace, frame);
+        PushFrame(&exp->decoded);
+    }
+    // Fin de la vidéo : les frames déjà décodées restent lisibles
+    CloseFrameQueue(&exp->decoded);
+    return NULL;
+}
+
+static void* EncodeVideoFrames(void* arg) {
+    (void)arg;
+    VideoExport* exp = &gVideoExport;
+    unsigned char* frame;
+    while (!atomic_load(&exp->isCancelled) && (frame = GetFilledFrame(&exp->encoded, true, NULL)) != NULL) {
+        if (fwrite(frame, 1, exp->frameBytes, exp->encoder) != exp->frameBytes) {
+            atomic_store(&exp->isEncoderFailed, true);
+            break;
+        }
+        PopFrame(&exp->encoded);
+        atomic_fetch_add(&exp->encodedFrames, 1);
+    }
+    // Arrêt sur erreur : le thread GL n'obtient plus de place
+    CloseFrameQueue(&exp->encoded);
+    exp->encoderStatus = pclose(exp->encoder);
+    exp->encoder = NULL;
+    atomic_store(&exp->isEncoderDone, true);
+    return NULL;
+}
+
+// Fonction pour libérer les ressources (threads arrêtés au préalable)
+static void ReleaseVideoExport(void) {
+    VideoExport* exp = &gVideoExport;
+    for (int i = 0; i < VIDEO_EXPORT_READBACKS; i++) {
+        Readback* readback = &exp->readbacks[i];
+        if (readback->fence != NULL) gGL.DeleteSync(readback->fence);
+        if (readback->buffer != 0) gGL.DeleteBuffers(1, &readback->buffer);
+        free(readback->pixels);
+        memset(readback, 0, sizeof(*readback));
+    }
+    if (exp->sourceTexture.id != 0) UnloadTexture(exp->sourceTexture);
+    if (exp->target.id != 0) UnloadRenderTexture(exp->target);
+    exp->sourceTexture = (Texture2D){0};
+    exp->target = (RenderTexture2D){0};
+
+    if (exp->decoder != NULL) pclose(exp->decoder);
+    if (exp->encoder != NULL) pclose(exp->encoder);
+    exp->decoder = NULL;
+    exp->encoder = NULL;
+    FreeFrameQueue(&exp->decoded);
+    FreeFrameQueue(&exp->encoded);
+    free(exp->yuvFrame);
+    exp->yuvFrame = NULL;
+
+    MemoryBudgetRelease(MEM_SUBSYS_FRAMES, MEM_POOL_RAM, exp->ramReserved);
+    MemoryBudgetRelease(MEM_SUBSYS_TEXTURES, MEM_POOL_VRAM, exp->vramReserved);
+    exp->ramReserved = 0;
+    exp->vramReserved = 0;
+}
+
+// Fonction pour arrêter les threads et terminer l'export dans l'état donné
+static void FinishVideoExport(VideoExportState state, const char* errorMessage) {
+    VideoExport* exp = &gVideoExport;
+    if (state != VIDEO_EXPORT_DONE) atomic_store(&exp->isCancelled, true);
+    CloseFrameQueue(&exp->decoded);
+    CloseFrameQueue(&exp->encoded);
+    // Le décodeur termine au plus la frame en cours de lecture
+    if (exp->hasDecodeThread) pthread_join(exp->decodeThread, NULL);
+    if (exp->hasEncodeThread) pthread_join(exp->encodeThread, NULL);
+    exp->hasDecodeThread = false;
+    exp->hasEncodeThread = false;
+
+    if (state == VIDEO_EXPORT_DONE && exp->encoderStatus != 0) {
+        state = VIDEO_EXPORT_FAILED;
+        errorMessage = TextFormat("ffmpeg a échoué (code %d)", exp->encoderStatus);
+    }
+    exp->state = state;
+    exp->endTime = GetTime();
+    snprintf(exp->errorMessage, sizeof(exp->errorMessage), "%s", errorMessage ? errorMessage : "");
+    ReleaseVideoExport();
+    if (exp->graph != NULL) SetRenderGraphQuality(exp->graph, exp->displayQuality);
+    exp->graph = NULL;
+
+    int frames = atomic_load(&exp->encodedFrames);
+    double seconds = exp->endTime - exp->startTime;
+    if (state == VIDEO_EXPORT_DONE) {
+        LOG_INFOF("Video export completed: %s, %d frames in %.2f s (%.1f fps)", exp->outputPath, frames, seconds,
+                  seconds > 0.0 ? frames / seconds : 0.0);
+    } else {
+        LogWrite(state == VIDEO_EXPORT_CANCELLED ? LOG_SEVERITY_WARNING : LOG_SEVERITY_ERROR,
+                 "Video export stopped after %d frames%s%s", frames, exp->errorMessage[0] ? ": " : "", exp->errorMessage);
+    }
+}
+
+bool StartVideoExport(const char* videoPath, const char* outputPath, const EffectParams* params, int frameCount) {
+    VideoExport* exp = &gVideoExport;
+    if (exp->state == VIDEO_EXPORT_RUNNING) return false;
+    memset(exp, 0, sizeof(*exp));
+    snprintf(exp->outputPath, sizeof(exp->outputPath), "%s", outputPath);
+    exp->params = *params;
+    exp->frameCount = frameCount;
+    exp->state = VIDEO_EXPORT_FAILED;
+
+    if (!IsGLExtensionsReady() || !ProbeVideoFile(videoPath, &exp->width, &exp->height, &exp->fps, &exp->colorSpace)) {
+        snprintf(exp->errorMessage, sizeof(exp->errorMessage), "Vidéo illisible (ffprobe)");
+        LOG_ERRORF("Cannot export '%s': ffprobe failed", videoPath);
+        return false;
+    }
+    exp->frameBytes = (size_t)exp->width * exp->height * 4;
+    exp->yuvBytes = GetYuvFrameSize(exp->width, exp->height);
+    exp->isAsync = HasAsyncReadback();
+
+    // Files de frames en RAM, texture source + cible + PBO en VRAM
+    size_t ramBytes = exp->frameBytes * (VIDEO_EXPORT_DECODE_FRAMES + VIDEO_EXPORT_ENCODE_FRAMES +
+                                         (exp->isAsync ? 0 : VIDEO_EXPORT_READBACKS)) + exp->yuvBytes;
+    size_t vramBytes = exp->frameBytes * (2 + (exp->isAsync ? VIDEO_EXPORT_READBACKS : 0));
+    if (!MemoryBudgetReserve(MEM_SUBSYS_FRAMES, MEM_POOL_RAM, ramBytes)) {
+        snprintf(exp->errorMessage, sizeof(exp->errorMessage), "Budget RAM dépassé");
+        return false;
+    }
+    exp->ramReserved = ramBytes;
+    if (!MemoryBudgetReserve(MEM_SUBSYS_TEXTURES, MEM_POOL_VRAM, vramBytes)) {
+        snprintf(exp->errorMessage, sizeof(exp->errorMessage), "Budget VRAM dépassé");
+        ReleaseVideoExport();
+        return false;
+    }
+    exp->vramReserved = vramBytes;
+
+    bool isReady = InitFrameQueue(&exp->decoded, VIDEO_EXPORT_DECODE_FRAMES, exp->frameBytes) &&
+                   InitFrameQueue(&exp->encoded, VIDEO_EXPORT_ENCODE_FRAMES, exp->frameBytes) &&
+                   (exp->yuvFrame = (unsigned char*)malloc(exp->yuvBytes)) != NULL;
+    Image blank = { NULL, exp->width, exp->height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    if (isReady) {
+        blank.data = calloc(1, exp->frameBytes);
+        exp->sourceTexture = LoadTextureFromImage(blank);
+        free(blank.data);
+        exp->target = LoadRenderTexture(exp->width, exp->height);
+        isReady = exp->sourceTexture.id != 0 && exp->target.id != 0;
+    }
+    for (int i = 0; isReady && i < VIDEO_EXPORT_READBACKS; i++) {
+        Readback* readback = &exp->readbacks[i];
+        if (exp->isAsync) {
+            gGL.GenBuffers(1, &readback->buffer);
+            gGL.BindBuffer(GL_PIXEL_PACK_BUFFER, readback->buffer);
+            gGL.BufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)exp->frameBytes, NULL, GL_STREAM_READ);
+            isReady = readback->buffer != 0;
+        } else {
+            readback->pixels = (unsigned char*)malloc(exp->frameBytes);
+            isReady = readback->pixels != NULL;
+        }
+    }
+    if (exp->isAsync) gGL.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (isReady) {
+        exp->decoder = OpenVideoDecoder(videoPath, exp->colorSpace);
+        exp->encoder = exp->decoder ? OpenVideoEncoder(outputPath, exp->width, exp->height, exp->fps) : NULL;
+        isReady = exp->encoder != NULL;
+    }
+    if (isReady) {
+        exp->hasDecodeThread = pthread_create(&exp->decodeThread, NULL, DecodeVideoFrames, NULL) == 0;
+        exp->hasEncodeThread = exp->hasDecodeThread &&
+                               pthread_create(&exp->encodeThread, NULL, EncodeVideoFrames, NULL) == 0;
+        isReady = exp->hasEncodeThread;
+    }
+    if (!isReady) {
+        LOG_ERRORF("Failed to start video export to '%s'", outputPath);
+        exp->startTime = GetTime();
+        FinishVideoExport(VIDEO_EXPORT_FAILED, "Démarrage impossible (ffmpeg, mémoire)");
+        return false;
+    }
+
+    exp->state = VIDEO_EXPORT_RUNNING;
+    exp->startTime = GetTime();
+    LOG_INFOF("Video export started: %dx%d at %.2f fps to %s (%s readback)", exp->width, exp->height, exp->fps,
+              outputPath, exp->isAsync ? "async" : "sync");
+    return true;
+}
+
+// Fonction pour lancer la lecture de la cible (dans le PBO si possible)
+static void StartReadback(Readback* readback) {
+    VideoExport* exp = &gVideoExport;
+    gGL.BindFramebuffer(GL_READ_FRAMEBUFFER, exp->target.id);
+    if (exp->isAsync) {
+        gGL.BindBuffer(GL_PIXEL_PACK_BUFFER, readback->buffer);
+        gGL.ReadPixels(0, 0, exp->width, exp->height, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        gGL.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        readback->fence = gGL.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    } else {
+        gGL.ReadPixels(0, 0, exp->width, exp->height, GL_RGBA, GL_UNSIGNED_BYTE, readback->pixels);
+    }
+    gGL.BindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+}
+
+// Vrai quand la lecture est terminée (attente d'au plus timeoutSeconds)
+static bool IsReadbackComplete(Readback* readback, double timeoutSeconds) {
+    if (readback->fence == NULL) return true;
+    GLuint64 timeout = timeoutSeconds > 0.0 ? (GLuint64)(timeoutSeconds * 1e9) : 0;
+    GLenum result = gGL.ClientWaitSync(readback->fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+    return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+}
+
+// Fonction pour copier une lecture terminée vers l'encodeur. Les lignes arrivent de bas
+// en haut (origine GL) et la cible est à l'envers : la copie ligne à ligne les remet droites.
+static bool FinishReadback(Readback* readback, unsigned char* frame) {
+    VideoExport* exp = &gVideoExport;
+    const unsigned char* pixels = readback->pixels;
+    if (exp->isAsync) {
+        gGL.DeleteSync(readback->fence);
+        readback->fence = NULL;
+        gGL.BindBuffer(GL_PIXEL_PACK_BUFFER, readback->buffer);
+        pixels = (const unsigned char*)gGL.MapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)exp->frameBytes, GL_MAP_READ_BIT);
+    }
+    bool isMapped = pixels != NULL;
+    if (isMapped) {
+        size_t rowBytes = (size_t)exp->width * 4;
+        for (int y = 0; y < exp->height; y++) {
+            memcpy(frame + (size_t)y * rowBytes, pixels + (size_t)(exp->height - 1 - y) * rowBytes, rowBytes);
+        }
+    }
+    if (exp->isAsync) {
+        if (isMapped) gGL.UnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        gGL.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+    return isMapped;
+}
+
+void UpdateVideoExport(RenderGraph* graph, double budgetSeconds) {
+    VideoExport* exp = &gVideoExport;
+    if (exp->state != VIDEO_EXPORT_RUNNING) return;
+
+    if (atomic_load(&exp->isEncoderFailed)) {
+        FinishVideoExport(VIDEO_EXPORT_FAILED, "L'encodeur ffmpeg s'est arrêté");
+        return;
+    }
+
+    // Export en qualité complète, le niveau de l'affichage est rétabli à la fin
+    // (changer de niveau à chaque frame remettrait à zéro les mesures GPU et le résultat)
+    if (exp->graph == NULL) {
+        exp->graph = graph;
+        exp->displayQuality = GetRenderGraphQuality(graph);
+        SetRenderGraphQuality(graph, GetRenderGraphQualityLevels(graph) - 1);
+    }
+
+    double start = GetTime();
+    bool isFailed = false;
+    bool isDecodeFinished = false;
+    while (!isFailed) {
+        double remaining = budgetSeconds - (GetTime() - start);
+        if (remaining <= 0.0) break;
+        bool hasProgressed = false;
+
+        // Lectures terminées, dans l'ordre, vers l'encodeur. Toutes en vol : attendre
+        // la plus ancienne dans la limite du budget plutôt que de rendre la main.
+        while (exp->readbackCount > 0) {
+            Readback* readback = &exp->readbacks[exp->readbackHead];
+            double timeout = exp->readbackCount == VIDEO_EXPORT_READBACKS ? remaining : 0.0;
+            if (!IsReadbackComplete(readback, timeout)) break;
+            unsigned char* frame = GetFreeFrame(&exp->encoded, false);
+            if (frame == NULL) break;
+            if (!FinishReadback(readback, frame)) {
+                isFailed = true;
+                break;
+            }
+            PushFrame(&exp->encoded);
+            exp->readbackHead = (exp->readbackHead + 1) % VIDEO_EXPORT_READBACKS;
+            exp->readbackCount--;
+            hasProgressed = true;
+        }
+        if (isFailed) break;
+
+        // Frame décodée suivante : rendu puis lecture asynchrone
+        if (exp->readbackCount < VIDEO_EXPORT_READBACKS) {
+            unsigned char* frame = GetFilledFrame(&exp->decoded, false, &isDecodeFinished);
+            if (frame != NULL) {
+                UpdateTexture(exp->sourceTexture, frame);
+                PopFrame(&exp->decoded);
+                EffectParams params = exp->params;
+                params.time += (float)exp->renderedFrames / exp->fps;
+                if (!RenderGraphToTexture(graph, exp->sourceTexture, &exp->target, &params)) {
+                    isFailed = true;
+                    break;
+                }
+                int index = (exp->readbackHead + exp->readbackCount) % VIDEO_EXPORT_READBACKS;
+                StartReadback(&exp->readbacks[index]);
+                exp->readbackCount++;
+                exp->renderedFrames++;
+                hasProgressed = true;
+            }
+        }
+        if (!hasProgressed) break;
+    }
+    if (isFailed) {
+        FinishVideoExport(VIDEO_EXPORT_FAILED, "Rendu ou lecture GPU impossible");
+        return;
+    }
+    // Vidéo entièrement rendue et lue : l'encodeur termine puis ffmpeg finalise le fichier
+    if (isDecodeFinished && exp->readbackCount == 0) {
+        CloseFrameQueue(&exp->encoded);
+        if (atomic_load(&exp->isEncoderDone)) {
+            if (exp->renderedFrames == 0) FinishVideoExport(VIDEO_EXPORT_FAILED, "Aucune frame décodée");
+            else if (atomic_load(&exp->encodedFrames) != exp->renderedFrames) FinishVideoExport(VIDEO_EXPORT_FAILED, "L'encodeur ffmpeg s'est arrêté");
+            else FinishVideoExport(VIDEO_EXPORT_DONE, NULL);
+        }
+    }
+}
+
+void CancelVideoExport(void) {
+    if (gVideoExport.state != VIDEO_EXPORT_RUNNING) return;
+    FinishVideoExport(VIDEO_EXPORT_CANCELLED, "Annulé");
+}
+
+bool IsVideoExportRunning(void) {
+    return gVideoExport.state == VIDEO_EXPORT_RUNNING;
+}
+
+void GetVideoExportStatus(VideoExportStatus* status) {
+    const VideoExport* exp = &gVideoExport;
+    status->state = exp->state;
+    status->encodedFrames = atomic_load(&gVideoExport.encodedFrames);
+    status->frameCount = exp->frameCount;
+    status->seconds = exp->state == VIDEO_EXPORT_IDLE ? 0.0f
+                    : (float)((exp->state == VIDEO_EXPORT_RUNNING ? GetTime() : exp->endTime) - exp->startTime);
+    status->framesPerSecond = status->seconds > 0.0f ? status->encodedFrames / status->seconds : 0.0f;
+    status->outputPath = exp->outputPath;
+    status->errorMessage = exp->errorMessage;
+}
+
+void CloseVideoExport(void) {
+    CancelVideoExport();
+}
@@ -0,0 +1,151 @@
+#include "color_convert.h"
+#include "cpu_filter.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Vérifie que les noyaux de color_convert (scalaire, SSE4.1, AVX2) donnent les mêmes octets
+// et restent à 1 près de la formule exacte en double, pour les deux matrices, les deux
+// plages et les deux dispositions, sur des tailles impaires et non multiples des vecteurs.
+// Mesure ensuite le temps de conversion d'une frame 1080p par noyau.
+
+#define BENCH_FRAMES 50
+
+static const int gSizes[][2] = {
+    { 1, 1 }, { 3, 5 }, { 17, 9 }, { 33, 7 }, { 64, 64 }, { 127, 31 }, { 1281, 721 }, { 1920, 1080 }
+};
+
+static const CpuSimdLevel gLevels[] = { CPU_SIMD_SCALAR, CPU_SIMD_SSE2, CPU_SIMD_AVX2 };
+
+static double GetTestTime(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Formule de référence : Kr/Kb de la matrice, mise à l'échelle de la plage limitée
+static int ConvertReference(int y, int u, int v, int channel, YuvColorSpace colorSpace) {
+    double kr = colorSpace.matrix == YUV_MATRIX_BT709 ? 0.2126 : 0.299;
+    double kb = colorSpace.matrix == YUV_MATRIX_BT709 ? 0.0722 : 0.114;
+    double luma = y, cb = u - 128.0, cr = v - 128.0;
+    if (colorSpace.range == YUV_RANGE_LIMITED) {
+        luma = (y - 16.0) * 255.0 / 219.0;
+        cb *= 255.0 / 224.0;
+        cr *= 255.0 / 224.0;
+    }
+    double r = luma + 2.0 * (1.0 - kr) * cr;
+    double b = luma + 2.0 * (1.0 - kb) * cb;
+    double g = (luma - kr * r - kb * b) / (1.0 - kr - kb);
+    double value = floor((channel == 0 ? r : (channel == 1 ? g : b)) + 0.5);
+    return value < 0.0 ? 0 : (value > 255.0 ? 255 : (int)value);
+}
+
+// Jeu demandé effectivement disponible (SetCpuFilterSimd retombe sur le meilleur sinon)
+static bool SelectLevel(CpuSimdLevel level) {
+    SetCpuFilterSimd(level);
+    return GetCpuFilterSimd() == level;
+}
+
+static int CheckFrame(int width, int height, const unsigned char* data, YuvLayout layout, YuvColorSpace colorSpace) {
+    YuvImage image = GetPackedYuvImage(data, width, height, layout);
+    size_t bytes = (size_t)width * height * 4;
+    unsigned char* expected = (unsigned char*)malloc(bytes);
+    unsigned char* actual = (unsigned char*)malloc(bytes);
+    int failures = 0;
+
+    SelectLevel(CPU_SIMD_SCALAR);
+    ConvertYuvToRgba(&image, colorSpace, expected);
+    for (int row = 0; row < height && failures == 0; row++) {
+        for (int x = 0; x < width; x++) {
+            int y = image.y[row * image.yStride + x];
+            int u, v;
+            if (layout == YUV_LAYOUT_NV12) {
+                u = image.u[(row / 2) * image.uvStride + (x / 2) * 2];
+                v = image.u[(row / 2) * image.uvStride + (x / 2) * 2 + 1];
+            } else {
+                u = image.u[(row / 2) * image.uvStride + x / 2];
+                v = image.v[(row / 2) * image.uvStride + x / 2];
+            }
+            const unsigned char* pixel = expected + ((size_t)row * width + x) * 4;
+            for (int c = 0; c < 3; c++) {
+                if (abs(ConvertReference(y, u, v, c, colorSpace) - pixel[c]) > 1) {
+                    printf("FAIL  %dx%d: pixel (%d,%d) channel %d is %d, reference %d\n", width, height, x, row, c,
+                           pixel[c], ConvertReference(y, u, v, c, colorSpace));
+                    failures++;
+                    break;
+                }
+            }
+            if (pixel[3] != 255) {
+                printf("FAIL  %dx%d: pixel (%d,%d) alpha is %d\n", width, height, x, row, pixel[3]);
+                failures++;
+            }
+            if (failures > 0) break;
+        }
+    }
+
+    for (int l = 1; l < (int)(sizeof(gLevels) / sizeof(gLevels[0])); l++) {
+        if (!SelectLevel(gLevels[l])) continue;
+        ConvertYuvToRgba(&image, colorSpace, actual);
+        if (memcmp(expected, actual, bytes) != 0) {
+            printf("FAIL  %dx%d: %s kernel (%s level) differs from the scalar kernel\n", width, height, GetYuvKernelName(),
+                   GetCpuSimdName(gLevels[l]));
+            failures++;
+        }
+    }
+    free(expected);
+    free(actual);
+    return failures;
+}
+
+static void RunBenchmark(void) {
+    int width = 1920, height = 1080;
+    size_t frameSize = GetYuvFrameSize(width, height);
+    unsigned char* data = (unsigned char*)malloc(frameSize);
+    unsigned char* rgba = (unsigned char*)malloc((size_t)width * height * 4);
+    for (size_t i = 0; i < frameSize; i++) data[i] = (unsigned char)(rand() >> 7);
+    YuvImage image = GetPackedYuvImage(data, width, height, YUV_LAYOUT_I420);
+    YuvColorSpace colorSpace = { YUV_MATRIX_BT709, YUV_RANGE_LIMITED };
+
+    for (int pass = 0; pass < 2; pass++) {
+        SetCpuFilterThreadCount(pass == 0 ? 1 : 0);
+        for (int l = 0; l < (int)(sizeof(gLevels) / sizeof(gLevels[0])); l++) {
+            if (!SelectLevel(gLevels[l])) continue;
+            ConvertYuvToRgba(&image, colorSpace, rgba);
+            double start = GetTestTime();
+            for (int i = 0; i < BENCH_FRAMES; i++) ConvertYuvToRgba(&image, colorSpace, rgba);
+            double ms = (GetTestTime() - start) * 1000.0 / BENCH_FRAMES;
+            printf("BENCH 1080p I420, %s kernel (%s level), %d thread(s): %.3f ms/frame\n", GetYuvKernelName(),
+                   GetCpuSimdName(gLevels[l]), GetCpuFilterThreadCount(), ms);
+        }
+    }
+    SetCpuFilterThreadCount(0);
+    free(data);
+    free(rgba);
+}
+
+int main(void) {
+    srand(1);
+    int failures = 0;
+    for (int s = 0; s < (int)(sizeof(gSizes) / sizeof(gSizes[0])); s++) {
+        int width = gSizes[s][0], height = gSizes[s][1];
+        size_t frameSize = GetYuvFrameSize(width, height);
+        unsigned char* data = (unsigned char*)malloc(frameSize);
+        for (size_t i = 0; i < frameSize; i++) data[i] = (unsigned char)(rand() >> 7);
+        for (int layout = YUV_LAYOUT_I420; layout <= YUV_LAYOUT_NV12; layout++) {
+            for (int matrix = YUV_MATRIX_BT601; matrix <= YUV_MATRIX_BT709; matrix++) {
+                for (int range = YUV_RANGE_LIMITED; range <= YUV_RANGE_FULL; range++) {
+                    YuvColorSpace colorSpace = { (YuvMatrix)matrix, (YuvRange)range };
+                    failures += CheckFrame(width, height, data, (YuvLayout)layout, colorSpace);
+                }
+            }
+        }
+        free(data);
+    }
+    SetCpuFilterSimd(GetCpuSimdSupport());
+    if (failures == 0) RunBenchmark();
+
+    printf("%s\n", failures == 0 ? "PASSED" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+#include "cpu_filter.h"
+#include "cpu_shader.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Compare le filtre de netteté CPU (cpu_filter) au rendu de shaders/effect.glsl par la
+// VM de cpu_shader : les deux moteurs doivent donner les mêmes octets, y compris sur
+// le bord du cercle, pour que les images de référence ne dépendent pas du moteur.
+
+typedef struct {
+    int width;
+    int height;
+    Vector2 mousePos;
+    float radius;
+} SharpenCase;
+
+static const SharpenCase gCases[] = {
+    { 97, 61, { 48.5f, 30.5f }, 20.0f },   // Pixels exactement à radius*1.05 du curseur
+    { 97, 61, { 48.0f, 30.0f }, 20.0f },
+    { 64, 64, { 0.0f, 0.0f }, 30.0f },     // Bouclage des voisins en bord d'image
+    { 333, 211, { 120.25f, 99.75f }, 80.0f },
+    { 1920, 1080, { 960.5f, 540.5f }, 300.0f },
+    { 17, 9, { 8.5f, 4.5f }, 100.0f },     // Cercle plus grand que l'image
+};
+
+static Image MakeTestImage(int width, int height, unsigned int seed) {
+    Image image = { malloc((size_t)width * height * 4), width, height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    unsigned char* pixels = (unsigned char*)image.data;
+    for (size_t i = 0; i < (size_t)width * height * 4; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        pixels[i] = (i % 4 == 3) ? 255 : (unsigned char)(seed >> 24);
+    }
+    return image;
+}
+
+int main(void) {
+    char error[512] = {0};
+    CpuShaderGraph graph;
+    if (!LoadCpuShaderGraph("shaders/effect.glsl", &graph, error, sizeof(error))) {
+        printf("FAILED: cannot compile shaders/effect.glsl: %s\n", error);
+        return 1;
+    }
+
+    int failures = 0;
+    const CpuSimdLevel levels[] = { CPU_SIMD_SCALAR, CPU_SIMD_SSE2, CPU_SIMD_AVX2, CPU_SIMD_NEON };
+    for (int c = 0; c < (int)(sizeof(gCases) / sizeof(gCases[0])); c++) {
+        const SharpenCase* test = &gCases[c];
+        Image source = MakeTestImage(test->width, test->height, (unsigned int)c + 1);
+        Image expected = MakeTestImage(test->width, test->height, 0);
+        Image actual = MakeTestImage(test->width, test->height, 0);
+        EffectParams params = { 0.0f, test->mousePos, test->radius, 1.0f };
+        if (!RenderCpuShaderGraph(&graph, source, &expected, &params)) {
+            printf("FAIL  case %d: VM render failed\n", c);
+            failures++;
+        }
+
+        for (int l = 0; l < (int)(sizeof(levels) / sizeof(levels[0])); l++) {
+            // Jeu non supporté : SetCpuFilterSimd le remplace par le meilleur
+            SetCpuFilterSimd(levels[l]);
+            if (GetCpuFilterSimd() != levels[l]) continue;
+            CpuApplySharpenEffect(source, &actual, test->mousePos, test->radius);
+            const unsigned char* a = (const unsigned char*)actual.data;
+            const unsigned char* e = (const unsigned char*)expected.data;
+            int mismatches = 0;
+            for (int i = 0; i < test->width * test->height * 4; i++) {
+                if (a[i] == e[i]) continue;
+                if (mismatches == 0) {
+                    int pixel = i / 4;
+                    printf("FAIL  case %d (%dx%d, %s): pixel (%d,%d) channel %d is %d, VM gives %d\n", c, test->width,
+                           test->height, GetCpuSimdName(levels[l]), pixel % test->width, pixel / test->width, i % 4, a[i], e[i]);
+                }
+                mismatches++;
+            }
+            if (mismatches > 0) failures++;
+            else printf("OK    case %d (%dx%d, %s)\n", c, test->width, test->height, GetCpuSimdName(levels[l]));
+        }
+        UnloadImage(source);
+        UnloadImage(expected);
+        UnloadImage(actual);
+    }
+    SetCpuFilterSimd(GetCpuSimdSupport());
+    UnloadCpuShaderGraph(&graph);
+
+    printf("%s\n", failures == 0 ? "PASSED" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,306 @@
+#include "job_system.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h> // Pour Sleep
+#else
+#include <unistd.h> // Pour usleep
+#endif
+
+// Test de charge du système de tâches : couverture exacte des tuiles, ParallelForTiles
+// imbriqués, vol de tâches sous contention (une tâche qui en crée beaucoup, plusieurs
+// threads extérieurs en même temps), dépendances, tâches du thread principal, arrêt et
+// redémarrage pendant que les threads dorment. Un chien de garde fait échouer le test
+// s'il se bloque. Mesure ensuite l'accélération d'une charge CPU selon le nombre de threads.
+
+#define WATCHDOG_SECONDS 120
+#define SPAWN_CHILDREN 2000
+#define EXTERNAL_THREADS 4
+#define EXTERNAL_ROUNDS 50
+#define SCALING_WIDTH 1024
+#define SCALING_HEIGHT 1024
+
+static int gFailures = 0;
+
+static void Check(bool condition, const char* what) {
+    if (condition) {
+        printf("OK    %s\n", what);
+    } else {
+        printf("FAIL  %s\n", what);
+        gFailures++;
+    }
+}
+
+static double GetTestTime(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void SleepMilliseconds(int milliseconds) {
+    #ifdef _WIN32
+    Sleep(milliseconds);
+    #else
+    usleep(milliseconds * 1000);
+    #endif
+}
+
+static void* RunWatchdog(void* arg) {
+    (void)arg;
+    for (int i = 0; i < WATCHDOG_SECONDS * 10; i++) SleepMilliseconds(100);
+    printf("FAIL  no progress after %d s (deadlock?)\n", WATCHDOG_SECONDS);
+    fflush(stdout);
+    exit(1);
+}
+
+//------------------------------------------------------------------------------------
+// Couverture : chaque pixel traité exactement une fois
+//------------------------------------------------------------------------------------
+
+typedef struct {
+    int width;
+    atomic_int* hits;
+} CoverageContext;
+
+static void CountTile(void* context, JobTile tile) {
+    CoverageContext* coverage = (CoverageContext*)context;
+    for (int y = tile.y; y < tile.y + tile.height; y++) {
+        for (int x = tile.x; x < tile.x + tile.width; x++) atomic_fetch_add(&coverage->hits[y * coverage->width + x], 1);
+    }
+}
+
+static void TestCoverage(void) {
+    const int tileSizes[][2] = { { 1, 1 }, { 16, 16 }, { 64, 8 }, { 1000, 1 }, { 7, 300 } };
+    int width = 333, height = 217;
+    CoverageContext coverage = { width, (atomic_int*)malloc(sizeof(atomic_int) * width * height) };
+    bool isCovered = true;
+    for (int t = 0; t < (int)(sizeof(tileSizes) / sizeof(tileSizes[0])); t++) {
+        for (int i = 0; i < width * height; i++) atomic_init(&coverage.hits[i], 0);
+        ParallelForTiles(width, height, tileSizes[t][0], tileSizes[t][1], CountTile, &coverage);
+        for (int i = 0; i < width * height; i++) {
+            if (atomic_load(&coverage.hits[i]) != 1) isCovered = false;
+        }
+    }
+    free(coverage.hits);
+    Check(isCovered, "every pixel covered once, for several tile sizes");
+}
+
+//------------------------------------------------------------------------------------
+// Imbrication : chaque tuile extérieure lance ses propres ParallelForTiles
+//------------------------------------------------------------------------------------
+
+static atomic_int gInnerPixels;
+
+static void InnerTile(void* context, JobTile tile) {
+    (void)context;
+    atomic_fetch_add(&gInnerPixels, tile.width * tile.height);
+}
+
+static void OuterTile(void* context, JobTile tile) {
+    (void)context;
+    for (int i = 0; i < tile.height; i++) ParallelForTiles(50, 40, 7, 3, InnerTile, NULL);
+}
+
+static void NestedTile(void* context, JobTile tile) {
+    (void)context;
+    for (int i = 0; i < tile.width; i++) ParallelForTiles(1, 4, 1, 1, OuterTile, NULL);
+}
+
+static void TestNested(void) {
+    atomic_store(&gInnerPixels, 0);
+    ParallelForTiles(1, 20, 1, 2, OuterTile, NULL);
+    Check(atomic_load(&gInnerPixels) == 20 * 2000, "two levels of nested ParallelForTiles");
+
+    atomic_store(&gInnerPixels, 0);
+    ParallelForTiles(8, 1, 1, 1, NestedTile, NULL);
+    Check(atomic_load(&gInnerPixels) == 8 * 4 * 2000, "three levels of nested ParallelForTiles");
+}
+
+//------------------------------------------------------------------------------------
+// Vol : une tâche empile beaucoup d'enfants dans sa deque, les autres threads les volent
+//------------------------------------------------------------------------------------
+
+static atomic_int gChildCount;
+
+static void CountChild(void* context) {
+    (void)context;
+    // Un peu de travail pour que les voleurs aient le temps de se disputer la deque
+    volatile unsigned int value = 0;
+    for (int i = 0; i < 2000; i++) value += (unsigned int)i;
+    atomic_fetch_add(&gChildCount, 1);
+}
+
+static void SpawnChildren(void* context) {
+    (void)context;
+    // Au-delà de JOB_MAX_JOBS tâches en vol, ScheduleJob doit attendre sans se bloquer
+    JobHandle* children = (JobHandle*)malloc(sizeof(JobHandle) * SPAWN_CHILDREN);
+    for (int i = 0; i < SPAWN_CHILDREN; i++) children[i] = ScheduleJob(CountChild, NULL, NULL, 0);
+    for (int i = 0; i < SPAWN_CHILDREN; i++) WaitForJob(children[i]);
+    free(children);
+}
+
+static void* RunExternalThread(void* arg) {
+    (void)arg;
+    for (int round = 0; round < EXTERNAL_ROUNDS; round++) {
+        ParallelForTiles(50, 40, 7, 3, InnerTile, NULL);
+        JobHandle spawner = ScheduleJob(SpawnChildren, NULL, NULL, 0);
+        WaitForJob(spawner);
+    }
+    return NULL;
+}
+
+static void TestStealing(void) {
+    atomic_store(&gChildCount, 0);
+    JobHandle spawners[4];
+    for (int i = 0; i < 4; i++) spawners[i] = ScheduleJob(SpawnChildren, NULL, NULL, 0);
+    for (int i = 0; i < 4; i++) WaitForJob(spawners[i]);
+    Check(atomic_load(&gChildCount) == 4 * SPAWN_CHILDREN, "children spawned from jobs all run once");
+
+    atomic_store(&gChildCount, 0);
+    atomic_store(&gInnerPixels, 0);
+    pthread_t threads[EXTERNAL_THREADS];
+    int started = 0;
+    for (int i = 0; i < EXTERNAL_THREADS; i++) {
+        if (pthread_create(&threads[i], NULL, RunExternalThread, NULL) == 0) started++;
+    }
+    for (int i = 0; i < started; i++) pthread_join(threads[i], NULL);
+    Check(started == EXTERNAL_THREADS && atomic_load(&gInnerPixels) == EXTERNAL_THREADS * EXTERNAL_ROUNDS * 2000 &&
+          atomic_load(&gChildCount) == EXTERNAL_THREADS * EXTERNAL_ROUNDS * SPAWN_CHILDREN,
+          "concurrent external threads under steal contention");
+}
+
+//------------------------------------------------------------------------------------
+// Dépendances et tâches du thread principal
+//------------------------------------------------------------------------------------
+
+static atomic_int gOrder[64];
+static atomic_int gStamp;
+
+static void StampJob(void* context) {
+    int index = (int)(intptr_t)context;
+    atomic_store(&gOrder[index], atomic_fetch_add(&gStamp, 1) + 1);
+}
+
+static void TestDependencies(void) {
+    bool isOrdered = true;
+    for (int round = 0; round < 200; round++) {
+        for (int i = 0; i < 64; i++) atomic_store(&gOrder[i], 0);
+        atomic_store(&gStamp, 0);
+
+        // Losange 0 -> (1, 2) -> 3, puis chaîne 4..20, puis tâche du thread principal 21
+        JobHandle first = ScheduleJob(StampJob, (void*)(intptr_t)0, NULL, 0);
+        JobHandle middle[2] = {
+            ScheduleJob(StampJob, (void*)(intptr_t)1, &first, 1),
+            ScheduleJob(StampJob, (void*)(intptr_t)2, &first, 1)
+        };
+        JobHandle previous = ScheduleJob(StampJob, (void*)(intptr_t)3, middle, 2);
+        for (int i = 4; i <= 20; i++) previous = ScheduleJob(StampJob, (void*)(intptr_t)i, &previous, 1);
+        JobHandle mainJob = ScheduleMainThreadJob(StampJob, (void*)(intptr_t)21, &previous, 1);
+        // Plus de JOB_MAX_DEPENDENCIES tâches qui attendent la même
+        JobHandle fanOut[12];
+        for (int i = 0; i < 12; i++) fanOut[i] = ScheduleJob(StampJob, (void*)(intptr_t)(30 + i), &first, 1);
+
+        WaitForJob(mainJob);
+        for (int i = 0; i < 12; i++) WaitForJob(fanOut[i]);
+
+        int order[64];
+        for (int i = 0; i < 64; i++) order[i] = atomic_load(&gOrder[i]);
+        if (!(order[0] < order[1] && order[0] < order[2] && order[1] < order[3] && order[2] < order[3])) isOrdered = false;
+        for (int i = 4; i <= 21; i++) {
+            if (order[i] <= order[i - 1]) isOrdered = false;
+        }
+        for (int i = 0; i < 12; i++) {
+            if (order[30 + i] <= order[0]) isOrdered = false;
+        }
+    }
+    Check(isOrdered, "dependencies respected (diamond, chain, fan-out beyond the continuation limit)");
+
+    JobHandle mainJob = ScheduleMainThreadJob(StampJob, (void*)(intptr_t)50, NULL, 0);
+    int ran = RunMainThreadJobs(0.001);
+    Check(ran == 1 && IsJobDone(mainJob), "main-thread job runs from RunMainThreadJobs");
+    Check(IsJobDone(JOB_HANDLE_NULL), "JOB_HANDLE_NULL is always done");
+}
+
+//------------------------------------------------------------------------------------
+// Arrêt pendant que les threads dorment, changement de nombre de threads
+//------------------------------------------------------------------------------------
+
+static void TestShutdown(void) {
+    const int counts[] = { 1, 2, 3, 8, 0 };
+    bool isWorking = true;
+    for (int i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++) {
+        SetJobThreadCount(counts[i]);
+        InitJobSystem();
+        // Laisser les threads s'endormir avant l'arrêt
+        SleepMilliseconds(20);
+        CloseJobSystem();
+
+        // Redémarrage implicite à la première tâche
+        atomic_store(&gInnerPixels, 0);
+        ParallelForTiles(1, 20, 1, 2, OuterTile, NULL);
+        if (atomic_load(&gInnerPixels) != 20 * 2000) isWorking = false;
+        CloseJobSystem();
+        CloseJobSystem();
+    }
+    InitJobSystem();
+    Check(isWorking, "close while idle, restart on next use, thread count changes");
+}
+
+//------------------------------------------------------------------------------------
+// Accélération selon le nombre de threads
+//------------------------------------------------------------------------------------
+
+static void ComputeTile(void* context, JobTile tile) {
+    float* output = (float*)context;
+    for (int y = tile.y; y < tile.y + tile.height; y++) {
+        for (int x = tile.x; x < tile.x + tile.width; x++) {
+            float value = (float)(x ^ y);
+            for (int i = 0; i < 64; i++) value = value * 0.999f + 0.5f;
+            output[y * SCALING_WIDTH + x] = value;
+        }
+    }
+}
+
+static void MeasureScaling(void) {
+    float* output = (float*)malloc(sizeof(float) * SCALING_WIDTH * SCALING_HEIGHT);
+    SetJobThreadCount(0);
+    // 1, 2, 4 puis un par cœur ; au-delà du nombre de cœurs, mesure le surcoût de la sursouscription
+    int counts[] = { 1, 2, 4, GetJobThreadCount() };
+    double baseline = 0.0;
+    for (int c = 0; c < (int)(sizeof(counts) / sizeof(counts[0])); c++) {
+        if (c == 3 && (counts[3] == 1 || counts[3] == 2 || counts[3] == 4)) continue; // Déjà mesuré
+        SetJobThreadCount(counts[c]);
+        ParallelForTiles(SCALING_WIDTH, SCALING_HEIGHT, 64, 16, ComputeTile, output);
+        double start = GetTestTime();
+        for (int i = 0; i < 10; i++) ParallelForTiles(SCALING_WIDTH, SCALING_HEIGHT, 64, 16, ComputeTile, output);
+        double ms = (GetTestTime() - start) * 100.0;
+        if (c == 0) baseline = ms;
+        printf("BENCH %2d thread(s): %.2f ms, speedup %.2f\n", counts[c], ms, baseline / ms);
+    }
+    SetJobThreadCount(0);
+    free(output);
+}
+
+int main(void) {
+    pthread_t watchdog;
+    if (pthread_create(&watchdog, NULL, RunWatchdog, NULL) == 0) pthread_detach(watchdog);
+
+    // Assez de threads pour de la contention même sur une petite machine
+    SetJobThreadCount(8);
+    InitJobSystem();
+    TestCoverage();
+    TestNested();
+    TestStealing();
+    TestDependencies();
+    TestShutdown();
+    MeasureScaling();
+    CloseJobSystem();
+
+    printf("%s\n", gFailures == 0 ? "PASSED" : "FAILED");
+    return gFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,276 @@
+#include "logger.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h> // Pour Sleep
+#else
+#include <unistd.h> // Pour usleep
+#endif
+
+// Test du journal asynchrone (tampon circulaire sans verrou, plusieurs écrivains, un
+// lecteur). Chaque scénario démarre le journal, écrit, l'arrête puis relit debug.log :
+// plusieurs threads producteurs (aucun message perdu sans être compté, aucun message
+// coupé ou mélangé, ordre conservé par producteur), plusieurs tours du tampon, compte
+// exact des messages perdus quand le tampon est plein, regroupement des répétitions.
+// Écrase debug.log dans le dossier courant.
+
+#define PRODUCER_THREADS 4
+#define PRODUCER_MESSAGES 20000
+#define WRAP_ROUNDS 10
+#define FULL_BURST (LOG_RING_SIZE * 3)
+#define REPEAT_COUNT 2500
+#define MAX_LINES 200000
+
+static int gFailures = 0;
+
+static void Check(bool condition, const char* what) {
+    if (condition) {
+        printf("OK    %s\n", what);
+    } else {
+        printf("FAIL  %s\n", what);
+        gFailures++;
+    }
+    fflush(stdout);
+}
+
+static void SleepMilliseconds(int milliseconds) {
+    #ifdef _WIN32
+    Sleep(milliseconds);
+    #else
+    usleep(milliseconds * 1000);
+    #endif
+}
+
+static void LockStdout(void) {
+    #ifdef _WIN32
+    _lock_file(stdout);
+    #else
+    flockfile(stdout);
+    #endif
+}
+
+static void UnlockStdout(void) {
+    #ifdef _WIN32
+    _unlock_file(stdout);
+    #else
+    funlockfile(stdout);
+    #endif
+}
+
+// Lignes de debug.log, sans les marqueurs de début et de fin
+typedef struct {
+    char** lines;
+    int count;
+    bool hasMarkers;
+} LogLines;
+
+static LogLines ReadLogLines(void) {
+    LogLines log = { (char**)malloc(sizeof(char*) * MAX_LINES), 0, false };
+    FILE* file = fopen("debug.log", "r");
+    if (file == NULL) return log;
+    char line[LOG_MAX_MESSAGE_LENGTH + 64];
+    bool hasStart = false, hasEnd = false;
+    while (fgets(line, sizeof(line), file) != NULL && log.count < MAX_LINES) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (strcmp(line, "=== LOG START ===") == 0) hasStart = true;
+        else if (strcmp(line, "=== LOG END ===") == 0) hasEnd = true;
+        else log.lines[log.count++] = strdup(line);
+    }
+    fclose(file);
+    log.hasMarkers = hasStart && hasEnd;
+    return log;
+}
+
+static void FreeLogLines(LogLines* log) {
+    for (int i = 0; i < log->count; i++) free(log->lines[i]);
+    free(log->lines);
+}
+
+// Total des lignes "LOG n messages dropped"
+static int CountDropped(const LogLines* log) {
+    int total = 0;
+    for (int i = 0; i < log->count; i++) {
+        int dropped = 0;
+        if (sscanf(log->lines[i], "LOG %d messages dropped", &dropped) == 1) total += dropped;
+    }
+    return total;
+}
+
+//------------------------------------------------------------------------------------
+// Messages vérifiables : "T<thread> <numéro> <charge> #<longueur>", la charge répète
+// une lettre qui dépend du numéro ; un message coupé ou mélangé ne se relit pas
+//------------------------------------------------------------------------------------
+
+static void WriteCheckedMessage(int thread, int index) {
+    char payload[160];
+    int length = index % (int)(sizeof(payload) - 1);
+    memset(payload, 'a' + index % 26, length);
+    payload[length] = '\0';
+    LOG_INFOF("T%d %d %s #%d", thread, index, payload, length);
+}
+
+// Numéro du message, -1 si la ligne n'est pas un message intact de ce thread
+static int ParseCheckedMessage(const char* line, int thread) {
+    int lineThread = -1, index = -1, consumed = 0;
+    if (sscanf(line, "T%d %d %n", &lineThread, &index, &consumed) != 2 || lineThread != thread) return -1;
+    const char* payload = line + consumed;
+    int length = 0;
+    while (payload[length] == 'a' + index % 26) length++;
+    int declared = -1;
+    if (sscanf(payload + length, " #%d", &declared) != 1) return -1;
+    return length == index % 159 && declared == length ? index : -1;
+}
+
+static bool IsCheckedMessageLine(const char* line, int thread) {
+    int lineThread = -1;
+    return sscanf(line, "T%d ", &lineThread) == 1 && lineThread == thread;
+}
+
+static void* RunProducer(void* arg) {
+    int thread = (int)(size_t)arg;
+    for (int i = 0; i < PRODUCER_MESSAGES; i++) {
+        WriteCheckedMessage(thread, i);
+        // Pauses courtes : la plupart des messages passent, les rafales se chevauchent encore
+        if (i % 128 == 127) SleepMilliseconds(1);
+    }
+    return NULL;
+}
+
+static void TestProducers(void) {
+    InitLogger();
+    pthread_t threads[PRODUCER_THREADS];
+    int started = 0;
+    for (int t = 0; t < PRODUCER_THREADS; t++) {
+        if (pthread_create(&threads[t], NULL, RunProducer, (void*)(size_t)t) == 0) started++;
+    }
+    for (int t = 0; t < started; t++) pthread_join(threads[t], NULL);
+    CloseLogger();
+
+    LogLines log = ReadLogLines();
+    int written = 0;
+    bool isIntact = true, isOrdered = true;
+    for (int t = 0; t < PRODUCER_THREADS; t++) {
+        int previous = -1;
+        for (int i = 0; i < log.count; i++) {
+            if (!IsCheckedMessageLine(log.lines[i], t)) continue;
+            int index = ParseCheckedMessage(log.lines[i], t);
+            if (index < 0) {
+                if (isIntact) printf("      torn line: %.80s\n", log.lines[i]);
+                isIntact = false;
+                continue;
+            }
+            if (index <= previous) isOrdered = false;
+            previous = index;
+            written++;
+        }
+    }
+    int dropped = CountDropped(&log);
+    printf("      %d written, %d dropped (ring full)\n", written, dropped);
+    Check(started == PRODUCER_THREADS && log.hasMarkers, "producer threads and log file");
+    Check(isIntact, "no torn or interleaved message");
+    Check(isOrdered, "messages of each producer stay in order");
+    Check(written + dropped == PRODUCER_THREADS * PRODUCER_MESSAGES, "every message written or counted as dropped");
+    FreeLogLines(&log);
+}
+
+//------------------------------------------------------------------------------------
+// Plusieurs tours du tampon, au rythme du thread d'écriture : rien ne doit être perdu
+//------------------------------------------------------------------------------------
+
+static void TestWraparound(void) {
+    InitLogger();
+    int total = WRAP_ROUNDS * LOG_RING_SIZE;
+    for (int i = 0; i < total; i++) {
+        WriteCheckedMessage(0, i);
+        // Un quart du tampon, puis laisser le thread d'écriture passer (réveil toutes les 20 ms)
+        if (i % (LOG_RING_SIZE / 4) == LOG_RING_SIZE / 4 - 1) SleepMilliseconds(40);
+    }
+    CloseLogger();
+
+    LogLines log = ReadLogLines();
+    int expected = 0;
+    bool isComplete = CountDropped(&log) == 0;
+    for (int i = 0; i < log.count; i++) {
+        if (ParseCheckedMessage(log.lines[i], 0) != expected) isComplete = false;
+        else expected++;
+    }
+    Check(isComplete && expected == total, "ten rounds of the ring, every message once and in order");
+    FreeLogLines(&log);
+}
+
+//------------------------------------------------------------------------------------
+// Tampon plein : le thread d'écriture est bloqué dans l'écho console d'un avertissement
+// (stdout verrouillé ici), seuls LOG_RING_SIZE - 1 slots restent pour la rafale
+//------------------------------------------------------------------------------------
+
+static void TestDropped(void) {
+    InitLogger();
+    LockStdout();
+    LOG_WARNINGF("writer blocked on stdout");
+    SleepMilliseconds(200);
+    for (int i = 0; i < FULL_BURST; i++) WriteCheckedMessage(1, i);
+    UnlockStdout();
+    CloseLogger();
+
+    LogLines log = ReadLogLines();
+    int written = 0;
+    for (int i = 0; i < log.count; i++) {
+        if (ParseCheckedMessage(log.lines[i], 1) == written) written++;
+    }
+    int dropped = CountDropped(&log);
+    printf("      %d written, %d dropped\n", written, dropped);
+    Check(written == LOG_RING_SIZE - 1 && dropped == FULL_BURST - written,
+          "full ring drops the overflow and counts it exactly");
+    FreeLogLines(&log);
+}
+
+//------------------------------------------------------------------------------------
+// Répétitions : "message xN", écrit au plus toutes les 1000 occurrences ou chaque seconde
+//------------------------------------------------------------------------------------
+
+static void TestRepeats(void) {
+    InitLogger();
+    for (int i = 0; i < REPEAT_COUNT; i++) {
+        LogMessage("repeated line");
+        if (i % (LOG_RING_SIZE / 4) == LOG_RING_SIZE / 4 - 1) SleepMilliseconds(40);
+    }
+    LOG_INFOF("single line");
+    for (int i = 0; i < 3; i++) LOG_INFOF("short run");
+    LOG_INFOF("last line");
+    // Le dernier message ne doit pas attendre le message suivant ni l'arrêt
+    SleepMilliseconds(1500);
+    LogLines pending = ReadLogLines();
+    bool isLastWritten = pending.count > 0 && strcmp(pending.lines[pending.count - 1], "last line") == 0;
+    FreeLogLines(&pending);
+    CloseLogger();
+
+    LogLines log = ReadLogLines();
+    int repeats = 0, repeatLines = 0, index = 0;
+    bool isGrouped = true;
+    for (; index < log.count && strncmp(log.lines[index], "repeated line", 13) == 0; index++) {
+        int count = 1;
+        sscanf(log.lines[index], "repeated line x%d", &count);
+        if (count > 1000) isGrouped = false;
+        repeats += count;
+        repeatLines++;
+    }
+    isGrouped = isGrouped && repeats == REPEAT_COUNT && repeatLines >= 3 && index + 3 == log.count &&
+                strcmp(log.lines[index], "single line") == 0 && strcmp(log.lines[index + 1], "short run x3") == 0 &&
+                strcmp(log.lines[index + 2], "last line") == 0;
+    printf("      %d repeats on %d lines\n", repeats, repeatLines);
+    Check(isGrouped, "repeats collapsed into \"message xN\", at most 1000 per line");
+    Check(isLastWritten, "last message written within the time bound, before closing");
+    FreeLogLines(&log);
+}
+
+int main(void) {
+    TestProducers();
+    TestWraparound();
+    TestDropped();
+    TestRepeats();
+
+    printf("%s\n", gFailures == 0 ? "PASSED" : "FAILED");
+    return gFailures == 0 ? 0 : 1;
+}